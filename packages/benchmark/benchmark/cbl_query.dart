@@ -0,0 +1,270 @@
+import 'dart:async';
+import 'dart:io';
+import 'dart:math';
+
+import 'package:benchmark/database_benchmark.dart';
+import 'package:benchmark/parameter.dart';
+import 'package:cbl/cbl.dart';
+
+void main() => CblQueryBenchmark().report();
+
+/// Benchmarks a kind of query over a generated dataset.
+///
+/// Datasets are generated once per size and query kind and are cached in
+/// [_datasetsDirectory], because generating large datasets takes much longer
+/// than running the benchmark. Each run works on a copy of the dataset.
+class CblQueryBenchmark extends CblDatabaseBenchmark {
+  static const _datasetsDirectory = '.dart_tool/benchmark-datasets';
+  static const _datasetName = 'dataset';
+
+  late final QueryKind _queryKind;
+  late final int _datasetSize;
+  late final int _operationCount;
+  late final String _templateDatabasePath;
+
+  final _random = Random(0);
+
+  @override
+  String? get templateDatabasePath => _templateDatabasePath;
+
+  @override
+  Future<void> setup() async {
+    await super.setup();
+
+    _queryKind = queryKindParameter.current;
+    _datasetSize = datasetSizeParameter.current;
+    _operationCount = operationCountParameter.current;
+
+    _templateDatabasePath = await _ensureDataset();
+  }
+
+  @override
+  void runSync() {
+    if (_queryKind == QueryKind.liveQuery) {
+      throw UnsupportedError('Live queries can only be benchmarked async.');
+    }
+
+    withSyncDatabase((database) {
+      final query = database.createQuery(_queryKind.sql);
+
+      measureSync(() {
+        for (var i = 0; i < _operationCount; i++) {
+          final parameters = _nextParameters();
+          measureOperationSync(() {
+            if (parameters != null) {
+              query.setParameters(parameters);
+            }
+            var rows = 0;
+            for (final result in query.execute()) {
+              result.value(0);
+              rows++;
+            }
+            addRows(rows);
+          });
+        }
+      });
+    });
+  }
+
+  @override
+  Future<void> runAsync() async {
+    await withAsyncDatabase((database) async {
+      if (_queryKind == QueryKind.liveQuery) {
+        await _runLiveQuery(database);
+        return;
+      }
+
+      final query = await database.createQuery(_queryKind.sql);
+
+      await measureAsync(() async {
+        for (var i = 0; i < _operationCount; i++) {
+          final parameters = _nextParameters();
+          await measureOperationAsync(() async {
+            if (parameters != null) {
+              await query.setParameters(parameters);
+            }
+            var rows = 0;
+            final resultSet = await query.execute();
+            await for (final result in resultSet.asStream()) {
+              result.value(0);
+              rows++;
+            }
+            addRows(rows);
+          });
+        }
+      });
+    });
+  }
+
+  /// Measures the time from saving a document until a live query, which
+  /// matches the document, delivers updated results.
+  Future<void> _runLiveQuery(AsyncDatabase database) async {
+    final collection = await database.defaultCollection;
+    final query = await database.createQuery(_queryKind.sql);
+    await query.setParameters(Parameters({'first': _datasetSize}));
+
+    Completer<void>? countReached;
+    var expectedCount = 0;
+
+    final changes = query.changes();
+    final subscription = changes.listen((change) async {
+      final results = await change.results.allResults();
+      final count = results.single.integer('count');
+      if (count >= expectedCount) {
+        countReached?.complete();
+        countReached = null;
+      }
+    });
+    await changes.listening;
+
+    try {
+      await measureAsync(() async {
+        for (var i = 0; i < _operationCount; i++) {
+          expectedCount = i + 1;
+          final reached = (countReached = Completer<void>()).future;
+          await measureOperationAsync(() async {
+            await collection.saveDocument(
+              MutableDocument(_generateDocument(_datasetSize + i)),
+            );
+            await reached;
+          });
+          addRows(1);
+        }
+      });
+    } finally {
+      await subscription.cancel();
+    }
+  }
+
+  Parameters? _nextParameters() => switch (_queryKind) {
+    QueryKind.pointLookup => Parameters({
+      'userId': _random.nextInt(_datasetSize),
+    }),
+    QueryKind.rangeScan || QueryKind.rangeScanIndexed => _nextAgeRange(),
+    QueryKind.fullTextMatch => Parameters({
+      'term': _words[_random.nextInt(_words.length)],
+    }),
+    QueryKind.groupBy || QueryKind.liveQuery => null,
+  };
+
+  /// Returns parameters for a range of two ages, which matches about 2.5 % of
+  /// the documents.
+  Parameters _nextAgeRange() {
+    final min = _minAge + _random.nextInt(_ageRange - 1);
+    return Parameters({'min': min, 'max': min + 1});
+  }
+
+  /// Returns the path of the template database for the current dataset size
+  /// and query kind, generating it if necessary.
+  Future<String> _ensureDataset() async {
+    final key = '${_datasetSize}_${_queryKind.name}';
+    final directory = Directory('$_datasetsDirectory/$key').absolute;
+    final templatePath = '${directory.path}/$_datasetName.cblite2';
+    if (directory.existsSync()) {
+      return templatePath;
+    }
+
+    // The dataset is generated in a separate directory, so that a partially
+    // generated dataset is never used.
+    final partialDirectory = Directory('${directory.path}.partial');
+    if (partialDirectory.existsSync()) {
+      partialDirectory.deleteSync(recursive: true);
+    }
+    partialDirectory.createSync(recursive: true);
+
+    final database = Database.openSync(
+      _datasetName,
+      DatabaseConfiguration(directory: partialDirectory.path),
+    );
+    try {
+      final collection = database.defaultCollection;
+      _queryKind.createIndexes(collection);
+
+      const batchSize = 10000;
+      for (var i = 0; i < _datasetSize; i += batchSize) {
+        database.inBatchSync(() {
+          for (var j = i; j < min(i + batchSize, _datasetSize); j++) {
+            collection.saveDocument(
+              MutableDocument(_generateDocument(j), id: 'user-$j'),
+            );
+          }
+        });
+      }
+    } finally {
+      await database.close();
+    }
+
+    partialDirectory.renameSync(directory.path);
+    return templatePath;
+  }
+
+  static const _minAge = 18;
+  static const _ageRange = 80;
+
+  static final _cities = [for (var i = 0; i < 20; i++) 'City $i'];
+
+  /// Pseudo-words for the full-text index.
+  ///
+  /// With 512 words and 12 words per document, each word occurs in about 2 %
+  /// of the documents.
+  static final _words = [
+    for (final a in _syllables)
+      for (final b in _syllables)
+        for (final c in _syllables) '$a$b$c',
+  ];
+
+  static const _syllables = ['ka', 'lo', 'mi', 'ne', 'ru', 'sa', 'ti', 'vo'];
+
+  Map<String, Object?> _generateDocument(int index) {
+    // Each document is generated from its own seed, so that datasets of
+    // different sizes share their documents.
+    final random = Random(index);
+    return {
+      'userId': index,
+      'name': 'User $index',
+      'age': _minAge + random.nextInt(_ageRange),
+      'city': _cities[random.nextInt(_cities.length)],
+      'score': random.nextDouble() * 100,
+      'bio': [
+        for (var i = 0; i < 12; i++) _words[random.nextInt(_words.length)],
+      ].join(' '),
+    };
+  }
+}
+
+extension on QueryKind {
+  String get sql => switch (this) {
+    QueryKind.pointLookup =>
+      r'SELECT meta().id, name FROM _ WHERE userId = $userId',
+    QueryKind.rangeScan || QueryKind.rangeScanIndexed =>
+      r'SELECT meta().id, age FROM _ WHERE age BETWEEN $min AND $max',
+    QueryKind.fullTextMatch =>
+      r'SELECT meta().id FROM _ WHERE MATCH(bio_index, $term)',
+    QueryKind.groupBy =>
+      'SELECT city, count(*) AS count, avg(score) AS score '
+          'FROM _ GROUP BY city',
+    QueryKind.liveQuery =>
+      r'SELECT count(*) AS count FROM _ WHERE userId >= $first',
+  };
+
+  void createIndexes(SyncCollection collection) {
+    switch (this) {
+      case QueryKind.pointLookup:
+      case QueryKind.liveQuery:
+        collection.createIndex(
+          'userId_index',
+          ValueIndexConfiguration(['userId']),
+        );
+      case QueryKind.rangeScanIndexed:
+        collection.createIndex('age_index', ValueIndexConfiguration(['age']));
+      case QueryKind.fullTextMatch:
+        collection.createIndex(
+          'bio_index',
+          FullTextIndexConfiguration(['bio']),
+        );
+      case QueryKind.rangeScan:
+      case QueryKind.groupBy:
+        break;
+    }
+  }
+}
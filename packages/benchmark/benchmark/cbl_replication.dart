@@ -0,0 +1,207 @@
+import 'dart:async';
+import 'dart:math';
+
+import 'package:benchmark/database_benchmark.dart';
+import 'package:benchmark/parameter.dart';
+import 'package:cbl/cbl.dart';
+
+void main() => CblReplicationBenchmark().report();
+
+/// Benchmarks replicating documents between two databases in the same
+/// process, through a [UrlEndpointListener] on the loopback interface.
+///
+/// Each operation is a one-shot replication of all documents, measured until
+/// the replicator is idle and has stopped. The results include the document
+/// throughput as the row throughput and the byte throughput of the document
+/// payloads.
+///
+/// The [ReplicationVariant]s install Dart callbacks, which are invoked for
+/// every replicated document. Comparing their results with those of
+/// [ReplicationVariant.plain] shows the cost of calling into Dart from the
+/// replicator.
+///
+/// Requires the Enterprise Edition.
+class CblReplicationBenchmark extends CblDatabaseBenchmark {
+  late final ReplicatorType _replicatorType;
+  late final ReplicationVariant _variant;
+  late final int _documentCount;
+  late final int _documentSize;
+  late final int _operationCount;
+
+  @override
+  Future<void> setup() async {
+    await super.setup();
+
+    _replicatorType = replicatorTypeParameter.current;
+    _variant = replicationVariantParameter.current;
+    _documentCount = documentCountParameter.current;
+    _documentSize = documentSizeParameter.current;
+    _operationCount = operationCountParameter.current;
+
+    if (_variant == ReplicationVariant.conflictResolver &&
+        _replicatorType == ReplicatorType.push) {
+      throw UnsupportedError(
+        'Conflicts are only resolved when pulling documents.',
+      );
+    }
+  }
+
+  @override
+  void runSync() {
+    throw UnsupportedError('Replication can only be benchmarked async.');
+  }
+
+  @override
+  Future<void> runAsync() async {
+    for (var i = 0; i < _operationCount; i++) {
+      final listenerDatabase = await openAsyncDatabase();
+      final clientDatabase = await openAsyncDatabase();
+      try {
+        await _seedDocuments(
+          listenerDatabase: listenerDatabase,
+          clientDatabase: clientDatabase,
+        );
+
+        final listener = await UrlEndpointListener.create(
+          UrlEndpointListenerConfiguration(
+            collections: [await listenerDatabase.defaultCollection],
+            networkInterface: '127.0.0.1',
+            // TLS is disabled to measure the replication, not the encryption.
+            disableTls: true,
+          ),
+        );
+        await listener.start();
+        try {
+          final replicator = await Replicator.create(
+            ReplicatorConfiguration(
+              target: UrlEndpoint(listener.urls!.first),
+              replicatorType: _replicatorType,
+            )..addCollection(
+              await clientDatabase.defaultCollection,
+              _collectionConfiguration(),
+            ),
+          );
+          try {
+            await measureAsync(
+              () => measureOperationAsync(() => _replicate(replicator)),
+            );
+            addRows(_documentCount);
+            addBytes(_documentCount * _documentSize);
+          } finally {
+            await replicator.close();
+          }
+        } finally {
+          await listener.stop();
+        }
+      } finally {
+        await clientDatabase.close();
+        await listenerDatabase.close();
+      }
+    }
+  }
+
+  CollectionConfiguration _collectionConfiguration() => switch (_variant) {
+    ReplicationVariant.plain => CollectionConfiguration(),
+    ReplicationVariant.filters => CollectionConfiguration(
+      pushFilter: (document, flags) => true,
+      pullFilter: (document, flags) => true,
+    ),
+    ReplicationVariant.conflictResolver => CollectionConfiguration(
+      conflictResolver: ConflictResolver.from(
+        (conflict) => conflict.remoteDocument,
+      ),
+    ),
+  };
+
+  /// Saves the documents to replicate into the databases.
+  ///
+  /// When pushing and pulling, each side starts out with half of the
+  /// documents. For [ReplicationVariant.conflictResolver], both sides start
+  /// out with different revisions of every pulled document, so that each one
+  /// is in conflict.
+  Future<void> _seedDocuments({
+    required AsyncDatabase listenerDatabase,
+    required AsyncDatabase clientDatabase,
+  }) async {
+    final conflicts = _variant == ReplicationVariant.conflictResolver;
+
+    final (clientDocuments, listenerDocuments) = switch (_replicatorType) {
+      ReplicatorType.push => (_documentCount, 0),
+      ReplicatorType.pull => (conflicts ? _documentCount : 0, _documentCount),
+      ReplicatorType.pushAndPull =>
+        conflicts
+            ? (_documentCount, _documentCount)
+            : (_documentCount ~/ 2, _documentCount - _documentCount ~/ 2),
+    };
+
+    // Without conflicts, the documents of the two sides have distinct ids.
+    final listenerOffset = conflicts ? 0 : clientDocuments;
+
+    await _saveDocuments(clientDatabase, 0, clientDocuments, 'client');
+    await _saveDocuments(
+      listenerDatabase,
+      listenerOffset,
+      listenerDocuments,
+      'listener',
+    );
+  }
+
+  Future<void> _saveDocuments(
+    AsyncDatabase database,
+    int offset,
+    int count,
+    String origin,
+  ) async {
+    final collection = await database.defaultCollection;
+
+    const batchSize = 1000;
+    for (var i = offset; i < offset + count; i += batchSize) {
+      await database.inBatch(() async {
+        for (var j = i; j < min(i + batchSize, offset + count); j++) {
+          await collection.saveDocument(
+            MutableDocument({
+              'index': j,
+              'origin': origin,
+              'payload': _generatePayload(j),
+            }, id: 'doc-$j'),
+          );
+        }
+      });
+    }
+  }
+
+  /// Returns a payload of [_documentSize] random letters, which does not
+  /// compress well, so that the compression of the replication protocol does
+  /// not distort the byte throughput.
+  String _generatePayload(int index) {
+    final random = Random(index);
+    return String.fromCharCodes([
+      for (var i = 0; i < _documentSize; i++) 0x61 + random.nextInt(26),
+    ]);
+  }
+
+  /// Runs a one-shot replication and completes when the replicator has
+  /// stopped.
+  Future<void> _replicate(Replicator replicator) async {
+    final stopped = Completer<void>();
+    final token = await replicator.addChangeListener((change) {
+      final status = change.status;
+      if (status.activity != ReplicatorActivityLevel.stopped ||
+          stopped.isCompleted) {
+        return;
+      }
+      if (status.error case final error?) {
+        stopped.completeError(error);
+      } else {
+        stopped.complete();
+      }
+    });
+
+    try {
+      await replicator.start();
+      await stopped.future;
+    } finally {
+      await replicator.removeChangeListener(token);
+    }
+  }
+}
@@ -0,0 +1,94 @@
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:benchmark/utils.dart';
+import 'package:benchmark_harness/benchmark_harness.dart';
+import 'package:cbl/cbl.dart';
+import 'package:cbl/src/bindings.dart';
+
+/// Benchmark that measures the performance of reranking the candidates of a
+/// vector search, by finding the candidates which are closest to a query
+/// vector.
+abstract class TopKBenchmark extends BenchmarkBase {
+  TopKBenchmark(String name) : super('topk_$name');
+
+  static const dimensions = 768;
+  static const candidateCount = 1000;
+  static const k = 10;
+
+  final _random = Random(0);
+
+  late final query = _randomVector();
+  late final candidates = [
+    for (var i = 0; i < candidateCount; i++) _randomVector(),
+  ];
+
+  Float32List _randomVector() => Float32List.fromList([
+    for (var i = 0; i < dimensions; i++) _random.nextDouble() * 2 - 1,
+  ]);
+}
+
+/// Computes the cosine distances with scalar Dart code, which is how
+/// candidates are typically reranked without native kernels.
+class DartTopKBenchmark extends TopKBenchmark {
+  DartTopKBenchmark() : super('dart');
+
+  @override
+  void run() {
+    final distances = <(double, int)>[];
+    for (var i = 0; i < candidates.length; i++) {
+      final candidate = candidates[i];
+      var dot = 0.0;
+      var normA = 0.0;
+      var normB = 0.0;
+      for (var j = 0; j < query.length; j++) {
+        dot += query[j] * candidate[j];
+        normA += query[j] * query[j];
+        normB += candidate[j] * candidate[j];
+      }
+      distances.add((1 - dot / (sqrt(normA) * sqrt(normB)), i));
+    }
+    distances
+      ..sort((a, b) => a.$1.compareTo(b.$1))
+      ..length = TopKBenchmark.k;
+  }
+}
+
+class NativeTopKBenchmark extends TopKBenchmark {
+  NativeTopKBenchmark(this.level) : super(level.name);
+
+  final CBLDartSimdLevel level;
+
+  late final CBLDartSimdLevel _defaultLevel;
+
+  @override
+  void setup() {
+    _defaultLevel = VectorDistanceBindings.simdLevel;
+    VectorDistanceBindings.setSimdLevel(level);
+  }
+
+  @override
+  void teardown() {
+    VectorDistanceBindings.setSimdLevel(_defaultLevel);
+  }
+
+  @override
+  void run() {
+    VectorDistance.topK(query, candidates, k: TopKBenchmark.k);
+  }
+}
+
+Future<void> main() async {
+  await configureCouchbaseLite();
+
+  final benchmarks = [
+    DartTopKBenchmark(),
+    for (final level in CBLDartSimdLevel.values)
+      if (VectorDistanceBindings.setSimdLevel(level))
+        NativeTopKBenchmark(level),
+  ];
+
+  for (final benchmark in benchmarks) {
+    benchmark.report();
+  }
+}
@@ -1,17 +1,55 @@
 // ignore_for_file: avoid_print
 
+import 'dart:convert';
 import 'dart:io';
 
+import 'package:args/args.dart';
+import 'package:benchmark/comparison.dart';
 import 'package:benchmark/parameter.dart';
 import 'package:benchmark/result.dart';
 import 'package:benchmark/runner.dart';
 import 'package:benchmark/utils.dart';
+import 'package:cbl/cbl.dart' show ReplicatorType;
 import 'package:pool/pool.dart';
 
-void main() async {
+final _argParser = ArgParser()
+  ..addOption(
+    'runs',
+    help: 'How many times to run each benchmark.',
+    defaultsTo: '3',
+  )
+  ..addOption(
+    'baseline',
+    help:
+        'A samples file of a previous invocation to compare the results '
+        'against. Exits with code 1 if a benchmark regressed.',
+    valueHelp: 'path',
+  )
+  ..addOption(
+    'threshold',
+    help: 'The change in percent, beyond which a benchmark has regressed.',
+    defaultsTo: '5',
+  )
+  ..addFlag('help', abbr: 'h', negatable: false, help: 'Print this usage.');
+
+void main(List<String> arguments) async {
+  final args = _argParser.parse(arguments);
+  if (args.flag('help')) {
+    print(_argParser.usage);
+    return;
+  }
+  final runs = int.parse(args.option('runs')!);
+  final baselinePath = args.option('baseline');
+  final threshold = double.parse(args.option('threshold')!) / 100;
+
   final benchmarks = [
     // Micro benchmarks
-    for (final benchmark in ['document', 'data_encoding', 'data_decoding'])
+    for (final benchmark in [
+      'document',
+      'data_encoding',
+      'data_decoding',
+      'vector_distance',
+    ])
       for (final mode in ExecutionMode.values)
         MicroBenchmarkRunner(executionMode: mode, benchmark: benchmark),
 
@@ -29,14 +67,48 @@ void main() async {
               operationCount: operationCount,
               batchSize: batchSize,
             ),
+
+    // Query benchmarks
+    for (final mode in ExecutionMode.values)
+      for (final api in ApiType.values)
+        for (final queryKind in QueryKind.values)
+          // Live query updates are delivered asynchronously.
+          if (api == ApiType.async || queryKind != QueryKind.liveQuery)
+            for (final datasetSize in [10000, 100000, 1000000])
+              QueryBenchmarkRunner(
+                executionMode: mode,
+                apiType: api,
+                queryKind: queryKind,
+                datasetSize: datasetSize,
+                operationCount: _queryOperationCount(queryKind),
+              ),
+
+    // Replication benchmarks
+    for (final mode in ExecutionMode.values)
+      for (final replicatorType in ReplicatorType.values)
+        for (final variant in ReplicationVariant.values)
+          // Conflicts are only resolved when pulling documents.
+          if (replicatorType != ReplicatorType.push ||
+              variant != ReplicationVariant.conflictResolver)
+            for (final documentCount in [1000, 10000])
+              for (final documentSize in [100, 10000])
+                ReplicationBenchmarkRunner(
+                  executionMode: mode,
+                  replicatorType: replicatorType,
+                  variant: variant,
+                  documentCount: documentCount,
+                  documentSize: documentSize,
+                  operationCount: 3,
+                ),
+
+    // Native benchmarks of the shim layer, if they have been built.
+    if (NativeBenchmarkRunner.findExecutable() != null) NativeBenchmarkRunner(),
   ];
 
   await Pool(
     Platform.numberOfProcessors,
   ).forEach(benchmarks, (benchmark) => benchmark.setupAllRuns()).drain<void>();
 
-  const runs = 3;
-
   final runResults = <BenchmarkResults>[];
 
   for (var i = 0; i < runs; i++) {
@@ -52,4 +124,44 @@ void main() async {
   final results = BenchmarkResults.combine(runResults, statistic: average);
 
   File('results.json').writeAsStringSync(jsonEncodePretty(results.toJson()));
+
+  // The samples of each run are kept to compare later runs against.
+  final samples = BenchmarkSamples.fromRuns(runResults);
+  File('samples.json').writeAsStringSync(jsonEncodePretty(samples.toJson()));
+
+  if (baselinePath != null) {
+    final baseline = BenchmarkSamples.fromJson(
+      jsonDecode(File(baselinePath).readAsStringSync()) as Map<String, Object?>,
+    );
+    final comparisons = compareSamples(
+      baseline: baseline,
+      current: samples,
+      threshold: threshold,
+    );
+
+    print('Comparison with $baselinePath:');
+    comparisons.forEach(print);
+
+    final regressions = comparisons.where(
+      (comparison) => comparison.isRegression,
+    );
+    if (regressions.isNotEmpty) {
+      print(
+        '${regressions.length} measures regressed by more than '
+        '${args.option('threshold')} %.',
+      );
+      exitCode = 1;
+    }
+  }
 }
+
+/// The number of queries to run per benchmark, balanced against the cost of
+/// a single query on the largest dataset.
+int _queryOperationCount(QueryKind queryKind) => switch (queryKind) {
+  QueryKind.pointLookup => 1000,
+  QueryKind.rangeScan ||
+  QueryKind.rangeScanIndexed ||
+  QueryKind.fullTextMatch => 100,
+  QueryKind.groupBy => 10,
+  QueryKind.liveQuery => 20,
+};
@@ -0,0 +1,328 @@
+import 'dart:math';
+
+import 'result.dart';
+
+/// The values of the measures of benchmark invocations, collected over
+/// multiple runs.
+///
+/// Samples are keyed by the invocation id and the name of the measure. In
+/// contrast to [BenchmarkResults], which combine the runs into a single value,
+/// samples keep the value of every run, so that they can be compared
+/// statistically.
+class BenchmarkSamples {
+  BenchmarkSamples([this.samples = const {}]);
+
+  factory BenchmarkSamples.fromRuns(List<BenchmarkResults> runs) {
+    final samples = <String, Map<String, List<double>>>{};
+    for (final run in runs) {
+      for (final MapEntry(key: invocationId, value: result)
+          in run.results.entries) {
+        final measures = samples.putIfAbsent(invocationId, () => {});
+        for (final measure in result.measures) {
+          measures.putIfAbsent(measure.name, () => []).add(measure.value);
+        }
+      }
+    }
+    return BenchmarkSamples(samples);
+  }
+
+  BenchmarkSamples.fromJson(Map<String, Object?> json)
+    : samples = json.map(
+        (invocationId, measures) => MapEntry(
+          invocationId,
+          (measures! as Map<String, Object?>).map(
+            (name, values) => MapEntry(name, [
+              for (final value in values! as List<Object?>)
+                (value! as num).toDouble(),
+            ]),
+          ),
+        ),
+      );
+
+  final Map<String, Map<String, List<double>>> samples;
+
+  Map<String, Object?> toJson() => samples;
+}
+
+/// Returns whether lower values of the measure with the given [name] are
+/// better.
+///
+/// Throughput measures are better when they are higher, all other measures,
+/// such as latencies, are better when they are lower.
+bool isLowerBetter(String name) => !name.endsWith('throughput');
+
+/// The comparison of the samples of a measure between a baseline and the
+/// current run.
+class MeasureComparison {
+  MeasureComparison({
+    required this.invocationId,
+    required this.measure,
+    required this.baseline,
+    required this.current,
+    required this.change,
+    required this.lowerChange,
+    required this.upperChange,
+    required this.isRegression,
+  });
+
+  final String invocationId;
+  final String measure;
+
+  /// The mean of the baseline samples.
+  final double baseline;
+
+  /// The mean of the current samples.
+  final double current;
+
+  /// The relative change from [baseline] to [current].
+  final double change;
+
+  /// The lower bound of the confidence interval of [change].
+  final double lowerChange;
+
+  /// The upper bound of the confidence interval of [change].
+  final double upperChange;
+
+  /// Whether the whole confidence interval of [change] lies beyond the
+  /// regression threshold, in the direction in which the measure gets worse.
+  final bool isRegression;
+
+  @override
+  String toString() {
+    String percent(double value) =>
+        '${value >= 0 ? '+' : ''}${(value * 100).toStringAsFixed(1)} %';
+
+    return [
+      if (isRegression) 'REGRESSION ' else '',
+      '$invocationId $measure: ',
+      '${baseline.toStringAsFixed(1)} -> ${current.toStringAsFixed(1)} ',
+      '(${percent(change)}, ',
+      'CI ${percent(lowerChange)} .. ${percent(upperChange)})',
+    ].join();
+  }
+}
+
+/// Compares the [current] samples with the [baseline] samples.
+///
+/// Only measures which are present in both are compared. The confidence
+/// interval of the relative change is estimated with Welch's t interval for
+/// the difference of the means of the logarithms of the samples, which is
+/// transformed back into a ratio. With the few runs of a benchmark, the t
+/// distribution widens the interval to account for the uncertainty of the
+/// estimated variances, which a bootstrap does not. With fewer than two
+/// samples on either side, the variance can not be estimated and the interval
+/// is unbounded.
+///
+/// Measures with values which are not positive are not compared.
+///
+/// A measure has regressed if it got worse by more than [threshold], as a
+/// fraction of the baseline, with the given [confidence].
+List<MeasureComparison> compareSamples({
+  required BenchmarkSamples baseline,
+  required BenchmarkSamples current,
+  required double threshold,
+  double confidence = 0.95,
+}) {
+  final comparisons = <MeasureComparison>[];
+  for (final MapEntry(key: invocationId, value: currentMeasures)
+      in current.samples.entries) {
+    final baselineMeasures = baseline.samples[invocationId];
+    if (baselineMeasures == null) {
+      continue;
+    }
+
+    for (final MapEntry(key: measure, value: currentValues)
+        in currentMeasures.entries) {
+      final baselineValues = baselineMeasures[measure];
+      if (baselineValues == null ||
+          baselineValues.isEmpty ||
+          currentValues.isEmpty ||
+          baselineValues.any((value) => value <= 0) ||
+          currentValues.any((value) => value <= 0)) {
+        continue;
+      }
+
+      final baselineMean = average(baselineValues);
+      final currentMean = average(currentValues);
+
+      final (lowerLogRatio, upperLogRatio) = _welchInterval(
+        [for (final value in baselineValues) log(value)],
+        [for (final value in currentValues) log(value)],
+        confidence,
+      );
+      final lowerChange = exp(lowerLogRatio) - 1;
+      final upperChange = exp(upperLogRatio) - 1;
+
+      comparisons.add(
+        MeasureComparison(
+          invocationId: invocationId,
+          measure: measure,
+          baseline: baselineMean,
+          current: currentMean,
+          change: currentMean / baselineMean - 1,
+          lowerChange: lowerChange,
+          upperChange: upperChange,
+          isRegression: isLowerBetter(measure)
+              ? lowerChange > threshold
+              : upperChange < -threshold,
+        ),
+      );
+    }
+  }
+  return comparisons;
+}
+
+/// Returns Welch's t interval with the given [confidence] for the difference
+/// of the mean of [b] and the mean of [a].
+(double, double) _welchInterval(
+  List<double> a,
+  List<double> b,
+  double confidence,
+) {
+  final difference = average(b) - average(a);
+  if (a.length < 2 || b.length < 2) {
+    return (double.negativeInfinity, double.infinity);
+  }
+
+  final aError = _variance(a) / a.length;
+  final bError = _variance(b) / b.length;
+  final standardError = sqrt(aError + bError);
+  if (standardError == 0) {
+    return (difference, difference);
+  }
+
+  // Welch–Satterthwaite approximation of the degrees of freedom.
+  final degreesOfFreedom =
+      (aError + bError) *
+      (aError + bError) /
+      (aError * aError / (a.length - 1) + bError * bError / (b.length - 1));
+  final margin =
+      _studentTQuantile((1 + confidence) / 2, degreesOfFreedom) *
+      standardError;
+  return (difference - margin, difference + margin);
+}
+
+/// The unbiased sample variance of [values].
+double _variance(List<double> values) {
+  final mean = average(values);
+  var sum = 0.0;
+  for (final value in values) {
+    sum += (value - mean) * (value - mean);
+  }
+  return sum / (values.length - 1);
+}
+
+/// Returns the quantile [p] of Student's t distribution with
+/// [degreesOfFreedom], for `0.5 <= p < 1`, found by bisection of its
+/// cumulative distribution function.
+double _studentTQuantile(double p, double degreesOfFreedom) {
+  var lower = 0.0;
+  var upper = 1.0;
+  while (_studentTCdf(upper, degreesOfFreedom) < p) {
+    upper *= 2;
+  }
+  for (var i = 0; i < 100; i++) {
+    final middle = (lower + upper) / 2;
+    if (_studentTCdf(middle, degreesOfFreedom) < p) {
+      lower = middle;
+    } else {
+      upper = middle;
+    }
+  }
+  return (lower + upper) / 2;
+}
+
+double _studentTCdf(double t, double degreesOfFreedom) {
+  final tail =
+      _regularizedIncompleteBeta(
+        degreesOfFreedom / (degreesOfFreedom + t * t),
+        degreesOfFreedom / 2,
+        0.5,
+      ) /
+      2;
+  return t > 0 ? 1 - tail : tail;
+}
+
+/// The regularized incomplete beta function I_x(a, b), evaluated with a
+/// continued fraction, as described in Numerical Recipes.
+double _regularizedIncompleteBeta(double x, double a, double b) {
+  if (x <= 0) {
+    return 0;
+  }
+  if (x >= 1) {
+    return 1;
+  }
+
+  final front = exp(
+    _logGamma(a + b) -
+        _logGamma(a) -
+        _logGamma(b) +
+        a * log(x) +
+        b * log(1 - x),
+  );
+  if (x < (a + 1) / (a + b + 2)) {
+    return front * _betaContinuedFraction(x, a, b) / a;
+  }
+  return 1 - front * _betaContinuedFraction(1 - x, b, a) / b;
+}
+
+double _betaContinuedFraction(double x, double a, double b) {
+  const maxIterations = 200;
+  const epsilon = 1e-14;
+  const tiny = 1e-300;
+
+  double nonZero(double value) => value.abs() < tiny ? tiny : value;
+
+  var c = 1.0;
+  var d = 1 / nonZero(1 - (a + b) * x / (a + 1));
+  var result = d;
+  for (var m = 1; m <= maxIterations; m++) {
+    // Even step of the continued fraction.
+    var coefficient = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m));
+    d = 1 / nonZero(1 + coefficient * d);
+    c = nonZero(1 + coefficient / c);
+    result *= d * c;
+
+    // Odd step of the continued fraction.
+    coefficient =
+        -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+    d = 1 / nonZero(1 + coefficient * d);
+    c = nonZero(1 + coefficient / c);
+    final delta = d * c;
+    result *= delta;
+
+    if ((delta - 1).abs() < epsilon) {
+      break;
+    }
+  }
+  return result;
+}
+
+/// The natural logarithm of the gamma function, computed with the Lanczos
+/// approximation.
+double _logGamma(double x) {
+  const coefficients = [
+    0.99999999999980993,
+    676.5203681218851,
+    -1259.1392167224028,
+    771.32342877765313,
+    -176.61502916214059,
+    12.507343278686905,
+    -0.13857109526572012,
+    9.9843695780195716e-6,
+    1.5056327351493116e-7,
+  ];
+
+  if (x < 0.5) {
+    // Reflection formula.
+    return log(pi / sin(pi * x)) - _logGamma(1 - x);
+  }
+
+  final z = x - 1;
+  var sum = coefficients[0];
+  for (var i = 1; i < coefficients.length; i++) {
+    sum += coefficients[i] / (z + i);
+  }
+  final t = z + 7.5;
+  return 0.5 * log(2 * pi) + (z + 0.5) * log(t) - t + log(sum);
+}
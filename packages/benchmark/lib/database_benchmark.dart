@@ -12,6 +12,8 @@ import 'utils.dart';
 abstract class DatabaseBenchmarkBase {
   final _operationDurations = <Duration>[];
   final _totalDurationStopwatch = Stopwatch();
+  int? _rows;
+  int? _bytes;
 
   /// Runs the benchmark and prints the results to stdout.
   Future<void> report() async {
@@ -25,6 +27,8 @@ abstract class DatabaseBenchmarkBase {
 
       _operationDurations.clear();
       _totalDurationStopwatch.reset();
+      _rows = null;
+      _bytes = null;
 
       await _run();
 
@@ -32,6 +36,8 @@ abstract class DatabaseBenchmarkBase {
         latencies: _operationDurations,
         latencyStatistic: median,
         totalDuration: _totalDurationStopwatch.elapsed,
+        rows: _rows,
+        bytes: _bytes,
       );
 
       // ignore: avoid_print
@@ -122,6 +128,24 @@ abstract class DatabaseBenchmarkBase {
     stopwatch.stop();
     _operationDurations.add(stopwatch.elapsed);
   }
+
+  /// Records that an operation within the benchmarked workload produced the
+  /// given number of [rows].
+  ///
+  /// If rows are recorded, the results include the row throughput.
+  @protected
+  void addRows(int rows) {
+    _rows = (_rows ?? 0) + rows;
+  }
+
+  /// Records that an operation within the benchmarked workload transferred
+  /// the given number of [bytes].
+  ///
+  /// If bytes are recorded, the results include the byte throughput.
+  @protected
+  void addBytes(int bytes) {
+    _bytes = (_bytes ?? 0) + bytes;
+  }
 }
 
 /// Base class for Couchbase Lite database benchmarks.
@@ -142,6 +166,12 @@ abstract class CblDatabaseBenchmark extends DatabaseBenchmarkBase {
   DatabaseConfiguration createDatabaseConfiguration(Directory tempDirectory) =>
       DatabaseConfiguration(directory: tempDirectory.path);
 
+  /// The path of a database which is copied to create each opened database.
+  ///
+  /// If this is `null`, opened databases are empty.
+  @visibleForOverriding
+  String? get templateDatabasePath => null;
+
   @override
   Future<void> setup() async {
     await super.setup();
@@ -158,12 +188,30 @@ abstract class CblDatabaseBenchmark extends DatabaseBenchmarkBase {
   }
 
   @protected
-  SyncDatabase openSyncDatabase() =>
-      Database.openSync(_nextDatabaseName(), _databaseConfiguration);
+  SyncDatabase openSyncDatabase() {
+    final name = _nextDatabaseName();
+    if (templateDatabasePath case final templateDatabasePath?) {
+      Database.copySync(
+        from: templateDatabasePath,
+        name: name,
+        config: _databaseConfiguration,
+      );
+    }
+    return Database.openSync(name, _databaseConfiguration);
+  }
 
   @protected
-  Future<AsyncDatabase> openAsyncDatabase() =>
-      Database.openAsync(_nextDatabaseName(), _databaseConfiguration);
+  Future<AsyncDatabase> openAsyncDatabase() async {
+    final name = _nextDatabaseName();
+    if (templateDatabasePath case final templateDatabasePath?) {
+      await Database.copy(
+        from: templateDatabasePath,
+        name: name,
+        config: _databaseConfiguration,
+      );
+    }
+    return Database.openAsync(name, _databaseConfiguration);
+  }
 
   @protected
   void withSyncDatabase(void Function(SyncDatabase database) fn) {
@@ -1,5 +1,7 @@
 import 'dart:io';
 
+import 'package:cbl/cbl.dart' show ReplicatorType;
+
 abstract class BenchmarkParameter<T> {
   BenchmarkParameter({required this.name});
 
@@ -55,6 +57,28 @@ enum ExecutionMode { jit, aot }
 
 enum ApiType { sync, async }
 
+enum QueryKind {
+  pointLookup,
+  rangeScan,
+  rangeScanIndexed,
+  fullTextMatch,
+  groupBy,
+  liveQuery,
+}
+
+/// The callbacks into Dart, which a replication benchmark installs.
+enum ReplicationVariant {
+  /// No callbacks.
+  plain,
+
+  /// Push and pull filters, which accept all documents.
+  filters,
+
+  /// A conflict resolver, which resolves conflicts created for every
+  /// replicated document.
+  conflictResolver,
+}
+
 final executionModeParameter = EnumParameter(
   name: 'EXECUTION_MODE',
   values: ExecutionMode.values,
@@ -70,3 +94,24 @@ final operationCountParameter = IntParameter(name: 'OPERATION_COUNT');
 final batchSizeParameter = IntParameter(name: 'BATCH_SIZE');
 
 final fixtureParameter = StringParameter(name: 'FIXTURE');
+
+final queryKindParameter = EnumParameter(
+  name: 'QUERY_KIND',
+  values: QueryKind.values,
+);
+
+final datasetSizeParameter = IntParameter(name: 'DATASET_SIZE');
+
+final replicatorTypeParameter = EnumParameter(
+  name: 'REPLICATOR_TYPE',
+  values: ReplicatorType.values,
+);
+
+final replicationVariantParameter = EnumParameter(
+  name: 'REPLICATION_VARIANT',
+  values: ReplicationVariant.values,
+);
+
+final documentCountParameter = IntParameter(name: 'DOCUMENT_COUNT');
+
+final documentSizeParameter = IntParameter(name: 'DOCUMENT_SIZE');
@@ -13,6 +13,17 @@ double median(List<double> values) {
   return sorted[middle];
 }
 
+/// Returns a [StatisticFunction] which computes the [percent] percentile of
+/// values, using the nearest rank method.
+StatisticFunction percentile(double percent) => (values) {
+  if (values.isEmpty) {
+    throw ArgumentError.value(values, 'values', 'must not be empty');
+  }
+  final sorted = List.of(values)..sort();
+  final rank = (percent / 100 * sorted.length).ceil();
+  return sorted[max(rank - 1, 0)];
+};
+
 double average(List<double> values) {
   if (values.isEmpty) {
     throw ArgumentError.value(values, 'values', 'must not be empty');
@@ -93,12 +104,33 @@ class Measure {
     );
   }
 
+  factory Measure.latencyPercentile(List<Duration> latencies, double percent) {
+    final latenciesInNanoseconds = latencies
+        .map((duration) => duration.inMicroseconds * 1000.0)
+        .toList();
+    return Measure(
+      name: 'latency_p${percent.toStringAsFixed(0)}',
+      value: percentile(percent)(latenciesInNanoseconds),
+    );
+  }
+
   factory Measure.throughput({
     required int operations,
     required Duration totalDuration,
   }) =>
       Measure(name: 'throughput', value: throughput(operations, totalDuration));
 
+  factory Measure.rowThroughput({
+    required int rows,
+    required Duration totalDuration,
+  }) => Measure(name: 'row_throughput', value: throughput(rows, totalDuration));
+
+  factory Measure.byteThroughput({
+    required int bytes,
+    required Duration totalDuration,
+  }) =>
+      Measure(name: 'byte_throughput', value: throughput(bytes, totalDuration));
+
   final String name;
   final double value;
   final double? upperValue;
@@ -134,17 +166,31 @@ class BenchmarkResult {
         .toList(),
   );
 
+  /// Creates the result of a workload of operations with the given
+  /// [latencies].
+  ///
+  /// If the operations produced [rows], for example query results, the row
+  /// throughput is included. If the operations transferred [bytes], the byte
+  /// throughput is included.
   factory BenchmarkResult.workload({
     required List<Duration> latencies,
     required StatisticFunction latencyStatistic,
     required Duration totalDuration,
+    int? rows,
+    int? bytes,
   }) => BenchmarkResult(
     measures: [
       Measure.combinedLatency(latencies, statistic: latencyStatistic),
+      Measure.latencyPercentile(latencies, 50),
+      Measure.latencyPercentile(latencies, 99),
       Measure.throughput(
         operations: latencies.length,
         totalDuration: totalDuration,
       ),
+      if (rows != null)
+        Measure.rowThroughput(rows: rows, totalDuration: totalDuration),
+      if (bytes != null)
+        Measure.byteThroughput(bytes: bytes, totalDuration: totalDuration),
     ],
   );
 
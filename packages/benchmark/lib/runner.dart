@@ -3,6 +3,8 @@
 import 'dart:convert';
 import 'dart:io';
 
+import 'package:cbl/cbl.dart' show ReplicatorType;
+
 import 'parameter.dart';
 import 'result.dart';
 import 'utils.dart';
@@ -191,3 +193,188 @@ class DatabaseBenchmarkRunner extends BenchmarkRunnerBase {
     });
   }
 }
+
+/// Runs a query benchmark over a generated dataset.
+class QueryBenchmarkRunner extends DatabaseBenchmarkRunner {
+  QueryBenchmarkRunner({
+    required super.executionMode,
+    required super.apiType,
+    required this.queryKind,
+    required this.datasetSize,
+    required super.operationCount,
+  }) : super(
+         database: 'cbl',
+         operation: 'query',
+         fixture: 'generated',
+         batchSize: 1,
+       );
+
+  final QueryKind queryKind;
+  final int datasetSize;
+
+  @override
+  String get invocationId => [
+    executionMode.name,
+    apiType.name,
+    benchmark,
+    queryKind.name,
+    '$datasetSize/$operationCount',
+  ].join('_');
+
+  @override
+  List<MapEntry<String, String>> get parameters => [
+    apiTypeParameter.envEntry(apiType),
+    queryKindParameter.envEntry(queryKind),
+    datasetSizeParameter.envEntry(datasetSize),
+    operationCountParameter.envEntry(operationCount),
+  ];
+}
+
+class ReplicationBenchmarkRunner extends DatabaseBenchmarkRunner {
+  ReplicationBenchmarkRunner({
+    required super.executionMode,
+    required this.replicatorType,
+    required this.variant,
+    required this.documentCount,
+    required this.documentSize,
+    required super.operationCount,
+  }) : super(
+         // Replication can only be benchmarked with the async API.
+         apiType: ApiType.async,
+         database: 'cbl',
+         operation: 'replication',
+         fixture: 'generated',
+         batchSize: 1,
+       );
+
+  final ReplicatorType replicatorType;
+  final ReplicationVariant variant;
+  final int documentCount;
+  final int documentSize;
+
+  @override
+  String get invocationId => [
+    executionMode.name,
+    apiType.name,
+    benchmark,
+    replicatorType.name,
+    variant.name,
+    '$documentCount/$documentSize',
+  ].join('_');
+
+  @override
+  List<MapEntry<String, String>> get parameters => [
+    apiTypeParameter.envEntry(apiType),
+    replicatorTypeParameter.envEntry(replicatorType),
+    replicationVariantParameter.envEntry(variant),
+    documentCountParameter.envEntry(documentCount),
+    documentSizeParameter.envEntry(documentSize),
+    operationCountParameter.envEntry(operationCount),
+  ];
+}
+
+/// Runs the native microbenchmarks of the cblitedart shim layer.
+///
+/// The benchmark executable is built by the build hook of `package:cbl` when
+/// `hooks.user_defines.cbl.native_benchmark` is `true` in the workspace
+/// `pubspec.yaml`.
+class NativeBenchmarkRunner extends BenchmarkRunnerBase {
+  NativeBenchmarkRunner({this.filter})
+    : super(executionMode: ExecutionMode.aot);
+
+  static const _executableName = 'cblitedart_benchmark';
+
+  /// Only runs the benchmarks whose name contains this string.
+  final String? filter;
+
+  @override
+  String get benchmark => 'native';
+
+  @override
+  String get invocationId => benchmark;
+
+  late final String _executable;
+
+  /// Finds the most recently built benchmark executable in the build outputs
+  /// of the build hooks of the workspace, or returns `null` if it has not been
+  /// built.
+  static String? findExecutable() {
+    final fileName = Platform.isWindows
+        ? '$_executableName.exe'
+        : _executableName;
+
+    for (
+      var directory = Directory.current.absolute;
+      directory.parent.path != directory.path;
+      directory = directory.parent
+    ) {
+      final hooksRunner = Directory(
+        '${directory.path}/.dart_tool/hooks_runner',
+      );
+      if (!hooksRunner.existsSync()) {
+        continue;
+      }
+
+      final executables =
+          hooksRunner
+              .listSync(recursive: true)
+              .whereType<File>()
+              .where((file) => file.uri.pathSegments.last == fileName)
+              .toList()
+            ..sort(
+              (a, b) => b.lastModifiedSync().compareTo(a.lastModifiedSync()),
+            );
+      if (executables.isNotEmpty) {
+        return executables.first.path;
+      }
+    }
+
+    return null;
+  }
+
+  @override
+  Future<void> setupAllRuns() async {
+    final executable = findExecutable();
+    if (executable == null) {
+      throw StateError(
+        'The native benchmark executable has not been built. Set '
+        'hooks.user_defines.cbl.native_benchmark to true in the workspace '
+        'pubspec.yaml.',
+      );
+    }
+    _executable = executable;
+  }
+
+  @override
+  Future<BenchmarkResults> run() async {
+    print('Running $invocationId ...');
+
+    final libraryDirectory = File(_executable).parent.uri.resolve('lib');
+    final runResult = await Process.run(
+      _executable,
+      [if (filter case final filter?) ...['--filter', filter]],
+      environment: {
+        // On Windows, the staged libraries are found through the PATH.
+        if (Platform.isWindows)
+          'PATH':
+              '${libraryDirectory.toFilePath()};'
+              '${Platform.environment['PATH']}',
+      },
+    );
+
+    if (runResult.exitCode != 0) {
+      throw Exception('Failed to run benchmark: ${runResult.stderr}');
+    }
+
+    final benchmarkResult = parseResults(runResult.stdout as String);
+
+    print('Completed $invocationId');
+    print(jsonEncodePretty(benchmarkResult.toJson()));
+
+    return benchmarkResult;
+  }
+
+  @override
+  BenchmarkResults parseResults(String stdout) =>
+      BenchmarkResults.fromJson(jsonDecode(stdout) as Map<String, Object?>);
+}
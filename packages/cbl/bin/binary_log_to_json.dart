@@ -0,0 +1,31 @@
+// Converts binary log segments, which have been written by the binary logger,
+// to JSON Lines.
+//
+// Usage: dart run cbl:binary_log_to_json <directory or segment>...
+import 'dart:convert';
+import 'dart:io';
+
+import 'package:cbl/cbl.dart';
+
+void main(List<String> arguments) {
+  if (arguments.isEmpty) {
+    stderr.writeln(
+      'Usage: dart run cbl:binary_log_to_json <directory or segment>...',
+    );
+    exitCode = 64;
+    return;
+  }
+
+  for (final path in arguments) {
+    final Iterable<BinaryLogEntry> entries;
+    if (FileSystemEntity.isDirectorySync(path)) {
+      entries = BinaryLogReader.readDirectory(path);
+    } else {
+      entries = BinaryLogReader.readSegment(File(path).readAsBytesSync());
+    }
+
+    for (final entry in entries) {
+      stdout.writeln(jsonEncode(entry.toJson()));
+    }
+  }
+}
@@ -10,6 +10,34 @@ import '../src/install/download.dart' as dl;
 const _cbliteRelease = '4.0.3';
 const _vectorSearchRelease = '2.0.0';
 
+const _cblitedartSources = [
+  'native/couchbase-lite-dart/src/CBL+Dart.cpp',
+  'native/couchbase-lite-dart/src/Fleece+Dart.cpp',
+  'native/couchbase-lite-dart/src/AsyncCallback.cpp',
+  'native/couchbase-lite-dart/src/BinaryLogSink.cpp',
+  'native/couchbase-lite-dart/src/BlobReadStreamer.cpp',
+  'native/couchbase-lite-dart/src/BlobWriteStreamer.cpp',
+  'native/couchbase-lite-dart/src/BulkDocumentWorker.cpp',
+  'native/couchbase-lite-dart/src/Utils.cpp',
+  'native/couchbase-lite-dart/src/CpuSupport.cpp',
+  'native/couchbase-lite-dart/src/DatabasePool.cpp',
+  'native/couchbase-lite-dart/src/DatabaseRegistry.cpp',
+  'native/couchbase-lite-dart/src/MaintenanceScheduler.cpp',
+  'native/couchbase-lite-dart/src/IndexUpdaterWorker.cpp',
+  'native/couchbase-lite-dart/src/LogBuffer.cpp',
+  'native/couchbase-lite-dart/src/Metrics.cpp',
+  'native/couchbase-lite-dart/src/PredictiveModel.cpp',
+  'native/couchbase-lite-dart/src/QueryProfiler.cpp',
+  'native/couchbase-lite-dart/src/Tracer.cpp',
+  'native/couchbase-lite-dart/src/VectorDistance.cpp',
+  'native/couchbase-lite-dart/src/dart_api_dl.cpp',
+];
+
+const _cblitedartIncludes = [
+  'native/vendor/dart/include',
+  'native/couchbase-lite-dart/include',
+];
+
 void main(List<String> args) async {
   await build(args, buildHook);
 }
@@ -17,6 +45,10 @@ void main(List<String> args) async {
 Future<void> buildHook(BuildInput input, BuildOutputBuilder output) async {
   final edition = (input.userDefines['edition'] as String?) ?? 'community';
   final vectorSearch = input.userDefines['vector_search']?.toString() == 'true';
+  final nativeBenchmark =
+      input.userDefines['native_benchmark']?.toString() == 'true';
+  // Native metrics are compiled in unless they are explicitly disabled.
+  final metrics = input.userDefines['metrics']?.toString() != 'false';
 
   if (edition != 'community' && edition != 'enterprise') {
     throw BuildError(
@@ -74,18 +106,8 @@ Future<void> buildHook(BuildInput input, BuildOutputBuilder output) async {
   final builder = CBuilder.library(
     name: 'cblitedart',
     assetName: 'src/bindings/cblitedart.dart',
-    sources: [
-      'native/couchbase-lite-dart/src/CBL+Dart.cpp',
-      'native/couchbase-lite-dart/src/Fleece+Dart.cpp',
-      'native/couchbase-lite-dart/src/AsyncCallback.cpp',
-      'native/couchbase-lite-dart/src/Utils.cpp',
-      'native/couchbase-lite-dart/src/CpuSupport.cpp',
-      'native/couchbase-lite-dart/src/dart_api_dl.cpp',
-    ],
-    includes: [
-      'native/vendor/dart/include',
-      'native/couchbase-lite-dart/include',
-    ],
+    sources: _cblitedartSources,
+    includes: _cblitedartIncludes,
     libraries: [if (targetOS != OS.iOS) 'cblite'],
     libraryDirectories: [if (targetOS != OS.iOS) libDir],
     flags: [
@@ -97,7 +119,10 @@ Future<void> buildHook(BuildInput input, BuildOutputBuilder output) async {
         'CouchbaseLite',
       ],
     ],
-    defines: {if (edition == 'enterprise') 'COUCHBASE_ENTERPRISE': '1'},
+    defines: {
+      if (edition == 'enterprise') 'COUCHBASE_ENTERPRISE': '1',
+      if (!metrics) 'CBLDART_METRICS': '0',
+    },
     language: Language.cpp,
     std: 'c++17',
     // Use static libc++ on Android to avoid needing to bundle
@@ -106,6 +131,36 @@ Future<void> buildHook(BuildInput input, BuildOutputBuilder output) async {
   );
   await builder.run(input: input, output: output);
 
+  // Optionally build the microbenchmarks for cblitedart. The executable is not
+  // bundled. It finds the staged libraries through its rpath, or on Windows
+  // through the PATH.
+  if (nativeBenchmark &&
+      (targetOS == OS.linux ||
+          targetOS == OS.macOS ||
+          targetOS == OS.windows)) {
+    await CBuilder.executable(
+      name: 'cblitedart_benchmark',
+      sources: [
+        ..._cblitedartSources,
+        'native/couchbase-lite-dart/benchmark/ShimBenchmark.cpp',
+      ],
+      includes: _cblitedartIncludes,
+      libraries: const ['cblite'],
+      libraryDirectories: const [libDir],
+      flags: [
+        '-I${cblite.includeDir}',
+        if (targetOS == OS.linux) r'-Wl,-rpath,$ORIGIN/lib',
+        if (targetOS == OS.macOS) '-Wl,-rpath,@executable_path/lib',
+      ],
+      defines: {
+        if (edition == 'enterprise') 'COUCHBASE_ENTERPRISE': '1',
+        if (!metrics) 'CBLDART_METRICS': '0',
+      },
+      language: Language.cpp,
+      std: 'c++17',
+    ).run(input: input, output: output);
+  }
+
   // 3. Optionally download vector search extension.
   // Vector search is supported on ARM64 and x86-64.
   final vectorSearchSupported =
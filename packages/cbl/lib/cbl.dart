@@ -3,6 +3,9 @@ export 'src/document.dart';
 export 'src/errors.dart';
 export 'src/extension.dart';
 export 'src/log.dart';
+export 'src/native_metrics.dart'
+    show NativeMetrics, NativeMetricsHistogram, NativeMetricsSnapshot;
+export 'src/native_tracing.dart';
 export 'src/query.dart';
 export 'src/replication.dart';
 export 'src/support/listener_token.dart' show ListenerToken;
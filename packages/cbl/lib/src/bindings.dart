@@ -36,6 +36,11 @@ export 'bindings/slice.dart'
         sliceResultAllocator;
 export 'bindings/tls_identity.dart';
 export 'bindings/tracing.dart'
-    show TracedCallHandler, TracedNativeCall, cblIncludeTracePoints;
+    show
+        MetricsBindings,
+        TraceBindings,
+        TracedCallHandler,
+        TracedNativeCall,
+        cblIncludeTracePoints;
 export 'bindings/url_endpoint_listener.dart';
 export 'bindings/utils.dart' show cblReachabilityFence;
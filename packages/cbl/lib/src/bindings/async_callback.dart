@@ -37,4 +37,13 @@ final class AsyncCallbackBindings {
   ) {
     cblitedart.CBLDart_AsyncCallback_CallForTest(callback, result);
   }
+
+  static int get blockingCallThresholdMicros =>
+      cblitedart.CBLDart_AsyncCallback_GetBlockingCallThreshold();
+
+  static set blockingCallThresholdMicros(int value) =>
+      cblitedart.CBLDart_AsyncCallback_SetBlockingCallThreshold(value);
+
+  static int get blockingCallsInFlight =>
+      cblitedart.CBLDart_AsyncCallback_BlockingCallsInFlight();
 }
@@ -1,4 +1,5 @@
 import 'dart:ffi';
+import 'dart:typed_data';
 
 import '../support/isolate.dart';
 import 'base.dart';
@@ -11,6 +12,8 @@ import 'slice.dart';
 import 'utils.dart';
 
 export 'cblite.dart' show CBLBlob, CBLBlobReadStream;
+export 'cblitedart.dart'
+    show CBLDart_BlobReadStreamer, CBLDart_BlobWriteStreamer;
 
 // === CBLBlob =================================================================
 
@@ -73,51 +76,156 @@ final class BlobReadStreamBindings {
     _finalizer.attach(object, pointer.cast());
   }
 
-  static Data? read(Pointer<cblite.CBLBlobReadStream> stream, int bufferSize) {
-    final buffer = cblitedart.CBLDart_CBLBlobReader_Read(
+  /// Reads the next chunk of the [stream] into [buffer] and returns the number
+  /// of bytes read, which is `0` at the end of the stream.
+  ///
+  /// The bytes are read directly into [buffer], without allocating an
+  /// intermediate native buffer.
+  static int readInto(
+    Pointer<cblite.CBLBlobReadStream> stream,
+    Uint8List buffer,
+  ) {
+    final bytesRead = cblitedart.CBLDart_CBLBlobReader_ReadInto(
       stream,
-      bufferSize,
+      buffer.address,
+      buffer.length,
       globalCBLError,
     );
 
-    // A null slice signals an error.
-    if (buffer.buf == nullptr) {
+    if (bytesRead == -1) {
       throwError();
     }
 
-    // Empty buffer means stream has been fully read, but it's important to
-    // create a SliceResult to ensure the FLSliceResult is freed.
-    final sliceResult = SliceResult.fromFLSliceResult(buffer)!;
-    return sliceResult.size == 0 ? null : sliceResult.toData();
+    return bytesRead;
   }
 }
 
-// === CBLBlobWriteStream ======================================================
+// === BlobReadStreamer ========================================================
+
+enum CBLDartBlobReadStreamerEvent {
+  chunk(
+    cblitedart.CBLDart_BlobReadStreamerEvent.kCBLDart_BlobReadStreamerChunk,
+  ),
+  done(cblitedart.CBLDart_BlobReadStreamerEvent.kCBLDart_BlobReadStreamerDone),
+  error(
+    cblitedart.CBLDart_BlobReadStreamerEvent.kCBLDart_BlobReadStreamerError,
+  );
+
+  const CBLDartBlobReadStreamerEvent(this.value);
+
+  factory CBLDartBlobReadStreamerEvent.fromValue(int value) =>
+      values.firstWhere((event) => event.value == value);
 
-final class BlobWriteStreamBindings {
-  static Pointer<cblite.CBLBlobWriteStream> create(
-    Pointer<cblite.CBLDatabase> db,
-  ) => cblite.CBLBlobWriter_Create(db, globalCBLError).checkError();
+  final int value;
+}
 
-  static void close(Pointer<cblite.CBLBlobWriteStream> stream) {
-    cblite.CBLBlobWriter_Close(stream);
+final class BlobReadStreamerBindings {
+  static final _finalizer = NativeFinalizer(
+    cblitedart.addresses.CBLDart_BlobReadStreamer_Delete.cast(),
+  );
+
+  static cblitedart.CBLDart_BlobReadStreamer start(
+    Pointer<cblite.CBLDatabase> database,
+    Pointer<cblite.CBLBlob> blob, {
+    required int chunkSize,
+    required int queueDepth,
+    required cblitedart.CBLDart_AsyncCallback callback,
+  }) => cblitedart.CBLDart_BlobReadStreamer_Start(
+    database,
+    blob,
+    chunkSize,
+    queueDepth,
+    callback,
+    globalCBLError,
+  ).checkError();
+
+  static void bindToDartObject(
+    Finalizable object,
+    cblitedart.CBLDart_BlobReadStreamer streamer,
+  ) => _finalizer.attach(object, streamer.cast());
+
+  static void request(
+    cblitedart.CBLDart_BlobReadStreamer streamer,
+    int chunks,
+  ) => cblitedart.CBLDart_BlobReadStreamer_Request(streamer, chunks);
+
+  static Never throwStreamerError(
+    cblitedart.CBLDart_BlobReadStreamer streamer,
+  ) {
+    cblitedart.CBLDart_BlobReadStreamer_GetError(streamer, globalCBLError);
+    throwError();
   }
+}
 
-  static bool write(Pointer<cblite.CBLBlobWriteStream> stream, Data data) {
+// === BlobWriteStreamer =======================================================
+
+enum CBLDartBlobWriteStreamerEvent {
+  written(
+    cblitedart
+        .CBLDart_BlobWriteStreamerEvent
+        .kCBLDart_BlobWriteStreamerWritten,
+  ),
+  done(
+    cblitedart.CBLDart_BlobWriteStreamerEvent.kCBLDart_BlobWriteStreamerDone,
+  ),
+  error(
+    cblitedart.CBLDart_BlobWriteStreamerEvent.kCBLDart_BlobWriteStreamerError,
+  );
+
+  const CBLDartBlobWriteStreamerEvent(this.value);
+
+  factory CBLDartBlobWriteStreamerEvent.fromValue(int value) =>
+      values.firstWhere((event) => event.value == value);
+
+  final int value;
+}
+
+final class BlobWriteStreamerBindings {
+  static final _finalizer = NativeFinalizer(
+    cblitedart.addresses.CBLDart_BlobWriteStreamer_Delete.cast(),
+  );
+
+  static cblitedart.CBLDart_BlobWriteStreamer start(
+    Pointer<cblite.CBLDatabase> db, {
+    required int bufferSize,
+    required cblitedart.CBLDart_AsyncCallback callback,
+  }) => cblitedart.CBLDart_BlobWriteStreamer_Start(
+    db,
+    bufferSize,
+    callback,
+    globalCBLError,
+  ).checkError();
+
+  static void bindToDartObject(
+    Finalizable object,
+    cblitedart.CBLDart_BlobWriteStreamer streamer,
+  ) => _finalizer.attach(object, streamer.cast());
+
+  /// Queues [data] to be written by the [streamer].
+  ///
+  /// The native side retains the slice of [data] until it has been written,
+  /// so [data] is not copied again.
+  static void write(cblitedart.CBLDart_BlobWriteStreamer streamer, Data data) {
     final slice = data.toSliceResult();
-    return cblite.CBLBlobWriter_Write(
-      stream,
-      slice.buf,
-      slice.size,
-      globalCBLError,
-    ).checkError();
+    cblitedart.CBLDart_BlobWriteStreamer_Write(
+      streamer,
+      slice.makeGlobalResult().ref,
+    );
   }
 
-  static Pointer<cblite.CBLBlob> createBlobWithStream(
+  static void finish(
+    cblitedart.CBLDart_BlobWriteStreamer streamer,
     String? contentType,
-    Pointer<cblite.CBLBlobWriteStream> stream,
   ) => runWithSingleFLString(
     contentType,
-    (flContentType) => cblite.CBLBlob_CreateWithStream(flContentType, stream),
+    (flContentType) =>
+        cblitedart.CBLDart_BlobWriteStreamer_Finish(streamer, flContentType),
   );
+
+  static Never throwStreamerError(
+    cblitedart.CBLDart_BlobWriteStreamer streamer,
+  ) {
+    cblitedart.CBLDart_BlobWriteStreamer_GetError(streamer, globalCBLError);
+    throwError();
+  }
 }
@@ -15,6 +15,16 @@ external void CBLDart_FLSliceResult_RetainByBuf(ffi.Pointer<ffi.Void> buf);
 @ffi.Native<NativeCBLDart_FLSliceResult_ReleaseByBuf>(isLeaf: true)
 external void CBLDart_FLSliceResult_ReleaseByBuf(ffi.Pointer<ffi.Void> buf);
 
+@ffi.Native<NativeCBLDart_FLSliceResult_RetainForTransfer>(isLeaf: true)
+external void CBLDart_FLSliceResult_RetainForTransfer(
+  ffi.Pointer<ffi.Void> buf,
+);
+
+@ffi.Native<NativeCBLDart_FLSliceResult_ReleaseTransferred>(isLeaf: true)
+external void CBLDart_FLSliceResult_ReleaseTransferred(
+  ffi.Pointer<ffi.Void> buf,
+);
+
 @ffi.Native<NativeCBLDart_KnownSharedKeys_New>(isLeaf: true)
 external ffi.Pointer<KnownSharedKeys> CBLDart_KnownSharedKeys_New();
 
@@ -117,6 +127,21 @@ external void CBLDart_AsyncCallback_CallForTest(
   int argument,
 );
 
+@ffi.Native<NativeCBLDart_AsyncCallback_SetBlockingCallThreshold>(
+  isLeaf: true,
+)
+external void CBLDart_AsyncCallback_SetBlockingCallThreshold(
+  int thresholdMicros,
+);
+
+@ffi.Native<NativeCBLDart_AsyncCallback_GetBlockingCallThreshold>(
+  isLeaf: true,
+)
+external int CBLDart_AsyncCallback_GetBlockingCallThreshold();
+
+@ffi.Native<NativeCBLDart_AsyncCallback_BlockingCallsInFlight>(isLeaf: true)
+external int CBLDart_AsyncCallback_BlockingCallsInFlight();
+
 @ffi.Native<NativeCBLDart_Completer_Complete>(isLeaf: true)
 external void CBLDart_Completer_Complete(
   CBLDart_Completer completer,
@@ -144,12 +169,35 @@ external void CBLDart_CBLLog_SetCallbackLevel(
   imp$1.DartCBLLogLevel level,
 );
 
+@ffi.Native<NativeCBLDart_CBLLog_SetCallbackDomainLevel>(isLeaf: true)
+external void CBLDart_CBLLog_SetCallbackDomainLevel(
+  CBLDart_AsyncCallback callback,
+  imp$1.DartCBLLogDomain domain,
+  imp$1.DartCBLLogLevel level,
+);
+
+@ffi.Native<NativeCBLDart_CBLLog_SetCallbackDomainRateLimit>(isLeaf: true)
+external void CBLDart_CBLLog_SetCallbackDomainRateLimit(
+  CBLDart_AsyncCallback callback,
+  imp$1.DartCBLLogDomain domain,
+  int maxRecordsPerSecond,
+);
+
 @ffi.Native<NativeCBLDart_CBLLog_SetFileSink>(isLeaf: true)
 external void CBLDart_CBLLog_SetFileSink(ffi.Pointer<CBLFileLogSink> sink);
 
 @ffi.Native<NativeCBLDart_CBLLog_GetFileSink>(isLeaf: true)
 external ffi.Pointer<CBLFileLogSink> CBLDart_CBLLog_GetFileSink();
 
+@ffi.Native<NativeCBLDart_CBLLog_SetBinarySink>()
+external bool CBLDart_CBLLog_SetBinarySink(
+  imp$1.DartCBLLogLevel level,
+  imp$1.FLString directory,
+  int segmentSize,
+  int maxSegments,
+  ffi.Pointer<CBLError> errorOut,
+);
+
 @ffi.Native<NativeCBLDart_CBLDatabaseConfiguration_Default>(isLeaf: true)
 external CBLDart_CBLDatabaseConfiguration
 CBLDart_CBLDatabaseConfiguration_Default();
@@ -172,13 +220,56 @@ external ffi.Pointer<CBLDatabase> CBLDart_CBLDatabase_Open(
 @ffi.Native<NativeCBLDart_CBLDatabase_Release>(isLeaf: true)
 external void CBLDart_CBLDatabase_Release(ffi.Pointer<CBLDatabase> database);
 
-@ffi.Native<NativeCBLDart_CBLDatabase_Close>(isLeaf: true)
+@ffi.Native<NativeCBLDart_CBLDatabase_Close>()
 external bool CBLDart_CBLDatabase_Close(
   ffi.Pointer<CBLDatabase> database,
   bool andDelete,
   ffi.Pointer<CBLError> errorOut,
 );
 
+@ffi.Native<NativeCBLDart_CBLDatabase_CloseAndRelease>()
+external bool CBLDart_CBLDatabase_CloseAndRelease(
+  ffi.Pointer<CBLDatabase> database,
+  ffi.Pointer<CBLError> errorOut,
+);
+
+@ffi.Native<NativeCBLDart_CBL_DeleteDatabase>(isLeaf: true)
+external bool CBLDart_CBL_DeleteDatabase(
+  imp$1.FLString name,
+  imp$1.FLString inDirectory,
+  ffi.Pointer<CBLError> errorOut,
+);
+
+@ffi.Native<NativeCBLDart_DatabasePool_Configure>()
+external void CBLDart_DatabasePool_Configure(
+  int capacity,
+  int timeToLiveMillis,
+);
+
+@ffi.Native<NativeCBLDart_DatabasePool_Size>(isLeaf: true)
+external int CBLDart_DatabasePool_Size();
+
+@ffi.Native<NativeCBLDart_DatabasePool_Clear>()
+external void CBLDart_DatabasePool_Clear();
+
+@ffi.Native<NativeCBLDart_MaintenanceScheduler_Schedule>(isLeaf: true)
+external void CBLDart_MaintenanceScheduler_Schedule(
+  ffi.Pointer<CBLDatabase> database,
+  int type,
+  int writeThreshold,
+  int idleMillis,
+);
+
+@ffi.Native<NativeCBLDart_MaintenanceScheduler_Unschedule>(isLeaf: true)
+external void CBLDart_MaintenanceScheduler_Unschedule(
+  ffi.Pointer<CBLDatabase> database,
+);
+
+@ffi.Native<NativeCBLDart_MaintenanceScheduler_PendingWrites>(isLeaf: true)
+external int CBLDart_MaintenanceScheduler_PendingWrites(
+  ffi.Pointer<CBLDatabase> database,
+);
+
 @ffi.Native<NativeCBLDart_CBLCollection_AddDocumentChangeListener>(isLeaf: true)
 external void CBLDart_CBLCollection_AddDocumentChangeListener(
   ffi.Pointer<CBLDatabase> db,
@@ -202,6 +293,45 @@ external bool CBLDart_CBLCollection_CreateIndex(
   ffi.Pointer<CBLError> errorOut,
 );
 
+@ffi.Native<NativeCBLDart_CBLCollection_SaveDocuments>()
+external bool CBLDart_CBLCollection_SaveDocuments(
+  ffi.Pointer<CBLCollection> collection,
+  ffi.Pointer<CBLDart_SaveDocumentEntry> entries,
+  int count,
+  FLSlice properties,
+  ffi.Pointer<CBLError> errorOut,
+);
+
+@ffi.Native<NativeCBLDart_CBLCollection_GetDocuments>()
+external FLSliceResult CBLDart_CBLCollection_GetDocuments(
+  ffi.Pointer<CBLCollection> collection,
+  ffi.Pointer<imp$1.FLString> ids,
+  int count,
+  ffi.Pointer<CBLError> errorOut,
+);
+
+@ffi.Native<NativeCBLDart_BulkDocumentWorker_Start>(isLeaf: true)
+external CBLDart_BulkDocumentWorker CBLDart_BulkDocumentWorker_Start(
+  ffi.Pointer<CBLCollection> collection,
+  int operation,
+  FLSlice ids,
+  int expiration,
+  int chunkSize,
+  CBLDart_AsyncCallback callback,
+  ffi.Pointer<CBLError> errorOut,
+);
+
+@ffi.Native<NativeCBLDart_BulkDocumentWorker_GetError>(isLeaf: true)
+external void CBLDart_BulkDocumentWorker_GetError(
+  CBLDart_BulkDocumentWorker worker,
+  ffi.Pointer<CBLError> errorOut,
+);
+
+@ffi.Native<NativeCBLDart_BulkDocumentWorker_Delete>(isLeaf: true)
+external void CBLDart_BulkDocumentWorker_Delete(
+  CBLDart_BulkDocumentWorker worker,
+);
+
 @ffi.Native<NativeCBLDart_CBLQuery_AddChangeListener>(isLeaf: true)
 external ffi.Pointer<CBLListenerToken> CBLDart_CBLQuery_AddChangeListener(
   ffi.Pointer<CBLDatabase> db,
@@ -209,25 +339,230 @@ external ffi.Pointer<CBLListenerToken> CBLDart_CBLQuery_AddChangeListener(
   CBLDart_AsyncCallback listener,
 );
 
+@ffi.Native<NativeCBLDart_CBLDatabase_CreateQuery>(isLeaf: true)
+external ffi.Pointer<CBLQuery> CBLDart_CBLDatabase_CreateQuery(
+  ffi.Pointer<CBLDatabase> db,
+  int language,
+  imp$1.FLString queryString,
+  ffi.Pointer<ffi.Int> errorPosOut,
+  ffi.Pointer<CBLError> errorOut,
+);
+
+@ffi.Native<NativeCBLDart_CBLQuery_Release>(isLeaf: true)
+external void CBLDart_CBLQuery_Release(ffi.Pointer<CBLQuery> query);
+
+@ffi.Native<NativeCBLDart_CBLQuery_Execute>()
+external ffi.Pointer<CBLResultSet> CBLDart_CBLQuery_Execute(
+  ffi.Pointer<CBLQuery> query,
+  ffi.Pointer<CBLDart_QueryExecution> executionOut,
+  ffi.Pointer<CBLError> errorOut,
+);
+
+@ffi.Native<NativeCBLDart_CBLResultSet_Next>()
+external bool CBLDart_CBLResultSet_Next(
+  ffi.Pointer<CBLResultSet> resultSet,
+  CBLDart_QueryExecution execution,
+);
+
+@ffi.Native<NativeCBLDart_CBLResultSet_Release>(isLeaf: true)
+external void CBLDart_CBLResultSet_Release(
+  ffi.Pointer<CBLResultSet> resultSet,
+);
+
+@ffi.Native<NativeCBLDart_QueryProfiler_Enable>(isLeaf: true)
+external void CBLDart_QueryProfiler_Enable(int capacity);
+
+@ffi.Native<NativeCBLDart_QueryProfiler_Disable>(isLeaf: true)
+external void CBLDart_QueryProfiler_Disable();
+
+@ffi.Native<NativeCBLDart_QueryProfiler_IsEnabled>(isLeaf: true)
+external bool CBLDart_QueryProfiler_IsEnabled();
+
+@ffi.Native<NativeCBLDart_QueryProfiler_Clear>(isLeaf: true)
+external void CBLDart_QueryProfiler_Clear();
+
+@ffi.Native<NativeCBLDart_QueryProfiler_Snapshot>(isLeaf: true)
+external FLSliceResult CBLDart_QueryProfiler_Snapshot();
+
+@ffi.Native<NativeCBLDart_QueryProfiler_ChromeTrace>(isLeaf: true)
+external FLSliceResult CBLDart_QueryProfiler_ChromeTrace();
+
+@ffi.Native<NativeCBLDart_Metrics_Snapshot>(isLeaf: true)
+external FLSliceResult CBLDart_Metrics_Snapshot();
+
+@ffi.Native<NativeCBLDart_Metrics_Reset>(isLeaf: true)
+external void CBLDart_Metrics_Reset();
+
+@ffi.Native<NativeCBLDart_Trace_Enable>(isLeaf: true)
+external void CBLDart_Trace_Enable(int capacityPerThread);
+
+@ffi.Native<NativeCBLDart_Trace_Disable>(isLeaf: true)
+external void CBLDart_Trace_Disable();
+
+@ffi.Native<NativeCBLDart_Trace_IsEnabled>(isLeaf: true)
+external bool CBLDart_Trace_IsEnabled();
+
+@ffi.Native<NativeCBLDart_Trace_Clear>(isLeaf: true)
+external void CBLDart_Trace_Clear();
+
+@ffi.Native<NativeCBLDart_Trace_Dump>(isLeaf: true)
+external FLSliceResult CBLDart_Trace_Dump();
+
+@ffi.Native<NativeCBLDart_IndexUpdaterWorker_Start>(isLeaf: true)
+external CBLDart_IndexUpdaterWorker CBLDart_IndexUpdaterWorker_Start(
+  ffi.Pointer<CBLQueryIndex> index,
+  int batchSize,
+  CBLDart_IndexUpdaterWorker_Embed embed,
+  CBLDart_IndexUpdaterWorker_Done done,
+  ffi.Pointer<CBLError> errorOut,
+);
+
+@ffi.Native<NativeCBLDart_IndexUpdaterWorker_Stop>(isLeaf: true)
+external void CBLDart_IndexUpdaterWorker_Stop(
+  CBLDart_IndexUpdaterWorker worker,
+);
+
+@ffi.Native<NativeCBLDart_IndexUpdaterWorker_GetProgress>(isLeaf: true)
+external void CBLDart_IndexUpdaterWorker_GetProgress(
+  CBLDart_IndexUpdaterWorker worker,
+  ffi.Pointer<CBLDart_IndexUpdaterWorkerProgress> progressOut,
+);
+
+@ffi.Native<NativeCBLDart_IndexUpdaterWorker_Delete>(isLeaf: true)
+external void CBLDart_IndexUpdaterWorker_Delete(
+  CBLDart_IndexUpdaterWorker worker,
+);
+
+@ffi.Native<NativeCBLDart_VectorDistance_GetSimdLevel>(isLeaf: true)
+external int CBLDart_VectorDistance_GetSimdLevel();
+
+@ffi.Native<NativeCBLDart_VectorDistance_SetSimdLevel>(isLeaf: true)
+external bool CBLDart_VectorDistance_SetSimdLevel(int level);
+
+@ffi.Native<NativeCBLDart_VectorDistance>(isLeaf: true)
+external double CBLDart_VectorDistance(
+  int metric,
+  int elementType,
+  ffi.Pointer<ffi.Void> a,
+  ffi.Pointer<ffi.Void> b,
+  int dimensions,
+);
+
+@ffi.Native<NativeCBLDart_VectorDistance_Batch>(isLeaf: true)
+external void CBLDart_VectorDistance_Batch(
+  int metric,
+  int elementType,
+  ffi.Pointer<ffi.Void> query,
+  ffi.Pointer<ffi.Void> candidates,
+  int count,
+  int dimensions,
+  ffi.Pointer<ffi.Float> distancesOut,
+);
+
+@ffi.Native<NativeCBLDart_VectorDistance_TopK>(isLeaf: true)
+external int CBLDart_VectorDistance_TopK(
+  int metric,
+  int elementType,
+  ffi.Pointer<ffi.Void> query,
+  ffi.Pointer<ffi.Void> candidates,
+  int count,
+  int dimensions,
+  int k,
+  ffi.Pointer<ffi.Uint32> indexesOut,
+  ffi.Pointer<ffi.Float> distancesOut,
+);
+
 @ffi.Native<NativeCBLDart_PredictiveModel_New>(isLeaf: true)
 external CBLDart_PredictiveModel CBLDart_PredictiveModel_New(
   imp$1.FLString name,
   int isolateId,
   CBLDart_PredictiveModel_PredictionSync predictionSync,
   CBLDart_PredictiveModel_PredictionAsync predictionAsync,
+  CBLDart_PredictiveModel_PredictionBatchAsync predictionBatchAsync,
+  int maxBatchSize,
+  int cacheMaxSize,
+  int cacheTtl,
   CBLDart_PredictiveModel_Unregistered unregistered,
 );
 
+@ffi.Native<NativeCBLDart_PredictiveModel_GetCacheStats>(isLeaf: true)
+external bool CBLDart_PredictiveModel_GetCacheStats(
+  CBLDart_PredictiveModel model,
+  ffi.Pointer<CBLDart_PredictionCacheStats> statsOut,
+);
+
+@ffi.Native<NativeCBLDart_PredictiveModel_ClearCache>(isLeaf: true)
+external void CBLDart_PredictiveModel_ClearCache(CBLDart_PredictiveModel model);
+
 @ffi.Native<NativeCBLDart_PredictiveModel_Delete>()
 external void CBLDart_PredictiveModel_Delete(CBLDart_PredictiveModel model);
 
-@ffi.Native<NativeCBLDart_CBLBlobReader_Read>(isLeaf: true)
-external FLSliceResult CBLDart_CBLBlobReader_Read(
+@ffi.Native<NativeCBLDart_CBLBlobReader_ReadInto>(isLeaf: true)
+external int CBLDart_CBLBlobReader_ReadInto(
   ffi.Pointer<CBLBlobReadStream> stream,
+  ffi.Pointer<ffi.Uint8> buffer,
   int bufferSize,
   ffi.Pointer<CBLError> outError,
 );
 
+@ffi.Native<NativeCBLDart_BlobReadStreamer_Start>(isLeaf: true)
+external CBLDart_BlobReadStreamer CBLDart_BlobReadStreamer_Start(
+  ffi.Pointer<CBLDatabase> database,
+  ffi.Pointer<CBLBlob> blob,
+  int chunkSize,
+  int queueDepth,
+  CBLDart_AsyncCallback callback,
+  ffi.Pointer<CBLError> errorOut,
+);
+
+@ffi.Native<NativeCBLDart_BlobReadStreamer_Request>(isLeaf: true)
+external void CBLDart_BlobReadStreamer_Request(
+  CBLDart_BlobReadStreamer streamer,
+  int chunks,
+);
+
+@ffi.Native<NativeCBLDart_BlobReadStreamer_GetError>(isLeaf: true)
+external void CBLDart_BlobReadStreamer_GetError(
+  CBLDart_BlobReadStreamer streamer,
+  ffi.Pointer<CBLError> errorOut,
+);
+
+@ffi.Native<NativeCBLDart_BlobReadStreamer_Delete>(isLeaf: true)
+external void CBLDart_BlobReadStreamer_Delete(
+  CBLDart_BlobReadStreamer streamer,
+);
+
+@ffi.Native<NativeCBLDart_BlobWriteStreamer_Start>(isLeaf: true)
+external CBLDart_BlobWriteStreamer CBLDart_BlobWriteStreamer_Start(
+  ffi.Pointer<CBLDatabase> db,
+  int bufferSize,
+  CBLDart_AsyncCallback callback,
+  ffi.Pointer<CBLError> errorOut,
+);
+
+@ffi.Native<NativeCBLDart_BlobWriteStreamer_Write>(isLeaf: true)
+external void CBLDart_BlobWriteStreamer_Write(
+  CBLDart_BlobWriteStreamer streamer,
+  FLSliceResult chunk,
+);
+
+@ffi.Native<NativeCBLDart_BlobWriteStreamer_Finish>(isLeaf: true)
+external void CBLDart_BlobWriteStreamer_Finish(
+  CBLDart_BlobWriteStreamer streamer,
+  imp$1.FLString contentType,
+);
+
+@ffi.Native<NativeCBLDart_BlobWriteStreamer_GetError>(isLeaf: true)
+external void CBLDart_BlobWriteStreamer_GetError(
+  CBLDart_BlobWriteStreamer streamer,
+  ffi.Pointer<CBLError> errorOut,
+);
+
+@ffi.Native<NativeCBLDart_BlobWriteStreamer_Delete>(isLeaf: true)
+external void CBLDart_BlobWriteStreamer_Delete(
+  CBLDart_BlobWriteStreamer streamer,
+);
+
 @ffi.Native<NativeCBLDart_CBLReplicator_Create>(isLeaf: true)
 external ffi.Pointer<CBLReplicator> CBLDart_CBLReplicator_Create(
   ffi.Pointer<CBLDart_ReplicatorConfiguration> config,
@@ -285,6 +620,11 @@ class _SymbolAddresses {
   ffi.Pointer<ffi.NativeFunction<NativeCBLDart_FLSliceResult_ReleaseByBuf>>
   get CBLDart_FLSliceResult_ReleaseByBuf =>
       ffi.Native.addressOf(self.CBLDart_FLSliceResult_ReleaseByBuf);
+  ffi.Pointer<
+    ffi.NativeFunction<NativeCBLDart_FLSliceResult_ReleaseTransferred>
+  >
+  get CBLDart_FLSliceResult_ReleaseTransferred =>
+      ffi.Native.addressOf(self.CBLDart_FLSliceResult_ReleaseTransferred);
   ffi.Pointer<ffi.NativeFunction<NativeCBLDart_KnownSharedKeys_Delete>>
   get CBLDart_KnownSharedKeys_Delete =>
       ffi.Native.addressOf(self.CBLDart_KnownSharedKeys_Delete);
@@ -300,9 +640,27 @@ class _SymbolAddresses {
   ffi.Pointer<ffi.NativeFunction<NativeCBLDart_CBLDatabase_Release>>
   get CBLDart_CBLDatabase_Release =>
       ffi.Native.addressOf(self.CBLDart_CBLDatabase_Release);
+  ffi.Pointer<ffi.NativeFunction<NativeCBLDart_BulkDocumentWorker_Delete>>
+  get CBLDart_BulkDocumentWorker_Delete =>
+      ffi.Native.addressOf(self.CBLDart_BulkDocumentWorker_Delete);
+  ffi.Pointer<ffi.NativeFunction<NativeCBLDart_CBLQuery_Release>>
+  get CBLDart_CBLQuery_Release =>
+      ffi.Native.addressOf(self.CBLDart_CBLQuery_Release);
+  ffi.Pointer<ffi.NativeFunction<NativeCBLDart_CBLResultSet_Release>>
+  get CBLDart_CBLResultSet_Release =>
+      ffi.Native.addressOf(self.CBLDart_CBLResultSet_Release);
+  ffi.Pointer<ffi.NativeFunction<NativeCBLDart_IndexUpdaterWorker_Delete>>
+  get CBLDart_IndexUpdaterWorker_Delete =>
+      ffi.Native.addressOf(self.CBLDart_IndexUpdaterWorker_Delete);
   ffi.Pointer<ffi.NativeFunction<NativeCBLDart_PredictiveModel_Delete>>
   get CBLDart_PredictiveModel_Delete =>
       ffi.Native.addressOf(self.CBLDart_PredictiveModel_Delete);
+  ffi.Pointer<ffi.NativeFunction<NativeCBLDart_BlobReadStreamer_Delete>>
+  get CBLDart_BlobReadStreamer_Delete =>
+      ffi.Native.addressOf(self.CBLDart_BlobReadStreamer_Delete);
+  ffi.Pointer<ffi.NativeFunction<NativeCBLDart_BlobWriteStreamer_Delete>>
+  get CBLDart_BlobWriteStreamer_Delete =>
+      ffi.Native.addressOf(self.CBLDart_BlobWriteStreamer_Delete);
   ffi.Pointer<ffi.NativeFunction<NativeCBLDart_CBLReplicator_Release>>
   get CBLDart_CBLReplicator_Release =>
       ffi.Native.addressOf(self.CBLDart_CBLReplicator_Release);
@@ -326,6 +684,14 @@ typedef NativeCBLDart_FLSliceResult_ReleaseByBuf =
     ffi.Void Function(ffi.Pointer<ffi.Void> buf);
 typedef DartCBLDart_FLSliceResult_ReleaseByBuf =
     void Function(ffi.Pointer<ffi.Void> buf);
+typedef NativeCBLDart_FLSliceResult_RetainForTransfer =
+    ffi.Void Function(ffi.Pointer<ffi.Void> buf);
+typedef DartCBLDart_FLSliceResult_RetainForTransfer =
+    void Function(ffi.Pointer<ffi.Void> buf);
+typedef NativeCBLDart_FLSliceResult_ReleaseTransferred =
+    ffi.Void Function(ffi.Pointer<ffi.Void> buf);
+typedef DartCBLDart_FLSliceResult_ReleaseTransferred =
+    void Function(ffi.Pointer<ffi.Void> buf);
 
 final class KnownSharedKeys extends ffi.Opaque {}
 
@@ -528,6 +894,15 @@ typedef NativeCBLDart_AsyncCallback_CallForTest =
     ffi.Void Function(CBLDart_AsyncCallback callback, ffi.Int64 argument);
 typedef DartCBLDart_AsyncCallback_CallForTest =
     void Function(CBLDart_AsyncCallback callback, int argument);
+typedef NativeCBLDart_AsyncCallback_SetBlockingCallThreshold =
+    ffi.Void Function(ffi.Int64 thresholdMicros);
+typedef DartCBLDart_AsyncCallback_SetBlockingCallThreshold =
+    void Function(int thresholdMicros);
+typedef NativeCBLDart_AsyncCallback_GetBlockingCallThreshold =
+    ffi.Int64 Function();
+typedef DartCBLDart_AsyncCallback_GetBlockingCallThreshold = int Function();
+typedef NativeCBLDart_AsyncCallback_BlockingCallsInFlight = ffi.Size Function();
+typedef DartCBLDart_AsyncCallback_BlockingCallsInFlight = int Function();
 
 final class _CBLDart_Completer extends ffi.Opaque {}
 
@@ -553,6 +928,30 @@ typedef NativeCBLDart_CBLLog_SetCallbackLevel =
     ffi.Void Function(CBLDart_AsyncCallback callback, imp$1.CBLLogLevel level);
 typedef DartCBLDart_CBLLog_SetCallbackLevel =
     void Function(CBLDart_AsyncCallback callback, imp$1.DartCBLLogLevel level);
+typedef NativeCBLDart_CBLLog_SetCallbackDomainLevel =
+    ffi.Void Function(
+      CBLDart_AsyncCallback callback,
+      imp$1.CBLLogDomain domain,
+      imp$1.CBLLogLevel level,
+    );
+typedef DartCBLDart_CBLLog_SetCallbackDomainLevel =
+    void Function(
+      CBLDart_AsyncCallback callback,
+      imp$1.DartCBLLogDomain domain,
+      imp$1.DartCBLLogLevel level,
+    );
+typedef NativeCBLDart_CBLLog_SetCallbackDomainRateLimit =
+    ffi.Void Function(
+      CBLDart_AsyncCallback callback,
+      imp$1.CBLLogDomain domain,
+      ffi.Uint32 maxRecordsPerSecond,
+    );
+typedef DartCBLDart_CBLLog_SetCallbackDomainRateLimit =
+    void Function(
+      CBLDart_AsyncCallback callback,
+      imp$1.DartCBLLogDomain domain,
+      int maxRecordsPerSecond,
+    );
 typedef CBLFileLogSink = imp$1.CBLFileLogSink;
 typedef NativeCBLDart_CBLLog_SetFileSink =
     ffi.Void Function(ffi.Pointer<CBLFileLogSink> sink);
@@ -561,6 +960,22 @@ typedef DartCBLDart_CBLLog_SetFileSink =
 typedef NativeCBLDart_CBLLog_GetFileSink =
     ffi.Pointer<CBLFileLogSink> Function();
 typedef DartCBLDart_CBLLog_GetFileSink = ffi.Pointer<CBLFileLogSink> Function();
+typedef NativeCBLDart_CBLLog_SetBinarySink =
+    ffi.Bool Function(
+      imp$1.CBLLogLevel level,
+      imp$1.FLString directory,
+      ffi.Uint64 segmentSize,
+      ffi.Uint32 maxSegments,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_CBLLog_SetBinarySink =
+    bool Function(
+      imp$1.DartCBLLogLevel level,
+      imp$1.FLString directory,
+      int segmentSize,
+      int maxSegments,
+      ffi.Pointer<CBLError> errorOut,
+    );
 
 final class CBLDart_CBLEncryptionKey extends ffi.Struct {
   @ffi.Uint32()
@@ -626,6 +1041,58 @@ typedef DartCBLDart_CBLDatabase_Close =
       bool andDelete,
       ffi.Pointer<CBLError> errorOut,
     );
+typedef NativeCBLDart_CBLDatabase_CloseAndRelease =
+    ffi.Bool Function(
+      ffi.Pointer<CBLDatabase> database,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_CBLDatabase_CloseAndRelease =
+    bool Function(
+      ffi.Pointer<CBLDatabase> database,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef NativeCBLDart_CBL_DeleteDatabase =
+    ffi.Bool Function(
+      imp$1.FLString name,
+      imp$1.FLString inDirectory,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_CBL_DeleteDatabase =
+    bool Function(
+      imp$1.FLString name,
+      imp$1.FLString inDirectory,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef NativeCBLDart_DatabasePool_Configure =
+    ffi.Void Function(ffi.Size capacity, ffi.Int64 timeToLiveMillis);
+typedef DartCBLDart_DatabasePool_Configure =
+    void Function(int capacity, int timeToLiveMillis);
+typedef NativeCBLDart_DatabasePool_Size = ffi.Size Function();
+typedef DartCBLDart_DatabasePool_Size = int Function();
+typedef NativeCBLDart_DatabasePool_Clear = ffi.Void Function();
+typedef DartCBLDart_DatabasePool_Clear = void Function();
+typedef NativeCBLDart_MaintenanceScheduler_Schedule =
+    ffi.Void Function(
+      ffi.Pointer<CBLDatabase> database,
+      imp$1.CBLMaintenanceType type,
+      ffi.Uint64 writeThreshold,
+      ffi.Int64 idleMillis,
+    );
+typedef DartCBLDart_MaintenanceScheduler_Schedule =
+    void Function(
+      ffi.Pointer<CBLDatabase> database,
+      imp$1.DartCBLMaintenanceType type,
+      int writeThreshold,
+      int idleMillis,
+    );
+typedef NativeCBLDart_MaintenanceScheduler_Unschedule =
+    ffi.Void Function(ffi.Pointer<CBLDatabase> database);
+typedef DartCBLDart_MaintenanceScheduler_Unschedule =
+    void Function(ffi.Pointer<CBLDatabase> database);
+typedef NativeCBLDart_MaintenanceScheduler_PendingWrites =
+    ffi.Int64 Function(ffi.Pointer<CBLDatabase> database);
+typedef DartCBLDart_MaintenanceScheduler_PendingWrites =
+    int Function(ffi.Pointer<CBLDatabase> database);
 typedef CBLCollection = imp$1.CBLCollection;
 typedef NativeCBLDart_CBLCollection_AddDocumentChangeListener =
     ffi.Void Function(
@@ -712,6 +1179,97 @@ typedef DartCBLDart_CBLCollection_CreateIndex =
       CBLDart_CBLIndexSpec indexSpec,
       ffi.Pointer<CBLError> errorOut,
     );
+
+final class CBLDart_SaveDocumentEntry extends ffi.Struct {
+  external ffi.Pointer<CBLDocument> document;
+
+  @imp$1.CBLConcurrencyControl()
+  external imp$1.DartCBLConcurrencyControl concurrencyControl;
+
+  @ffi.Bool()
+  external bool saved;
+}
+
+typedef CBLDocument = imp$1.CBLDocument;
+typedef NativeCBLDart_CBLCollection_SaveDocuments =
+    ffi.Bool Function(
+      ffi.Pointer<CBLCollection> collection,
+      ffi.Pointer<CBLDart_SaveDocumentEntry> entries,
+      ffi.Size count,
+      FLSlice properties,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_CBLCollection_SaveDocuments =
+    bool Function(
+      ffi.Pointer<CBLCollection> collection,
+      ffi.Pointer<CBLDart_SaveDocumentEntry> entries,
+      int count,
+      FLSlice properties,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef NativeCBLDart_CBLCollection_GetDocuments =
+    FLSliceResult Function(
+      ffi.Pointer<CBLCollection> collection,
+      ffi.Pointer<imp$1.FLString> ids,
+      ffi.Size count,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_CBLCollection_GetDocuments =
+    FLSliceResult Function(
+      ffi.Pointer<CBLCollection> collection,
+      ffi.Pointer<imp$1.FLString> ids,
+      int count,
+      ffi.Pointer<CBLError> errorOut,
+    );
+
+sealed class CBLDart_BulkDocumentOperation {
+  static const kCBLDart_BulkDocumentOperationPurge = 0;
+  static const kCBLDart_BulkDocumentOperationSetExpiration = 1;
+}
+
+sealed class CBLDart_BulkDocumentWorkerEvent {
+  static const kCBLDart_BulkDocumentWorkerProgress = 0;
+  static const kCBLDart_BulkDocumentWorkerDone = 1;
+  static const kCBLDart_BulkDocumentWorkerError = 2;
+}
+
+final class _CBLDart_BulkDocumentWorker extends ffi.Opaque {}
+
+typedef CBLDart_BulkDocumentWorker = ffi.Pointer<_CBLDart_BulkDocumentWorker>;
+typedef NativeCBLDart_BulkDocumentWorker_Start =
+    CBLDart_BulkDocumentWorker Function(
+      ffi.Pointer<CBLCollection> collection,
+      ffi.Uint8 operation,
+      FLSlice ids,
+      imp$1.CBLTimestamp expiration,
+      ffi.Uint32 chunkSize,
+      CBLDart_AsyncCallback callback,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_BulkDocumentWorker_Start =
+    CBLDart_BulkDocumentWorker Function(
+      ffi.Pointer<CBLCollection> collection,
+      int operation,
+      FLSlice ids,
+      int expiration,
+      int chunkSize,
+      CBLDart_AsyncCallback callback,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef NativeCBLDart_BulkDocumentWorker_GetError =
+    ffi.Void Function(
+      CBLDart_BulkDocumentWorker worker,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_BulkDocumentWorker_GetError =
+    void Function(
+      CBLDart_BulkDocumentWorker worker,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef NativeCBLDart_BulkDocumentWorker_Delete =
+    ffi.Void Function(CBLDart_BulkDocumentWorker worker);
+typedef DartCBLDart_BulkDocumentWorker_Delete =
+    void Function(CBLDart_BulkDocumentWorker worker);
 typedef CBLListenerToken = imp$1.CBLListenerToken;
 typedef CBLQuery = imp$1.CBLQuery;
 typedef NativeCBLDart_CBLQuery_AddChangeListener =
@@ -726,6 +1284,285 @@ typedef DartCBLDart_CBLQuery_AddChangeListener =
       ffi.Pointer<CBLQuery> query,
       CBLDart_AsyncCallback listener,
     );
+typedef NativeCBLDart_CBLDatabase_CreateQuery =
+    ffi.Pointer<CBLQuery> Function(
+      ffi.Pointer<CBLDatabase> db,
+      imp$1.CBLQueryLanguage language,
+      imp$1.FLString queryString,
+      ffi.Pointer<ffi.Int> errorPosOut,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_CBLDatabase_CreateQuery =
+    ffi.Pointer<CBLQuery> Function(
+      ffi.Pointer<CBLDatabase> db,
+      int language,
+      imp$1.FLString queryString,
+      ffi.Pointer<ffi.Int> errorPosOut,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef NativeCBLDart_CBLQuery_Release =
+    ffi.Void Function(ffi.Pointer<CBLQuery> query);
+typedef DartCBLDart_CBLQuery_Release =
+    void Function(ffi.Pointer<CBLQuery> query);
+
+final class _CBLDart_QueryExecution extends ffi.Opaque {}
+
+/// A profiled execution of a query, which is valid until its result set is
+/// released.
+typedef CBLDart_QueryExecution = ffi.Pointer<_CBLDart_QueryExecution>;
+typedef CBLResultSet = imp$1.CBLResultSet;
+typedef NativeCBLDart_CBLQuery_Execute =
+    ffi.Pointer<CBLResultSet> Function(
+      ffi.Pointer<CBLQuery> query,
+      ffi.Pointer<CBLDart_QueryExecution> executionOut,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_CBLQuery_Execute =
+    ffi.Pointer<CBLResultSet> Function(
+      ffi.Pointer<CBLQuery> query,
+      ffi.Pointer<CBLDart_QueryExecution> executionOut,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef NativeCBLDart_CBLResultSet_Next =
+    ffi.Bool Function(
+      ffi.Pointer<CBLResultSet> resultSet,
+      CBLDart_QueryExecution execution,
+    );
+typedef DartCBLDart_CBLResultSet_Next =
+    bool Function(
+      ffi.Pointer<CBLResultSet> resultSet,
+      CBLDart_QueryExecution execution,
+    );
+typedef NativeCBLDart_CBLResultSet_Release =
+    ffi.Void Function(ffi.Pointer<CBLResultSet> resultSet);
+typedef DartCBLDart_CBLResultSet_Release =
+    void Function(ffi.Pointer<CBLResultSet> resultSet);
+typedef NativeCBLDart_QueryProfiler_Enable =
+    ffi.Void Function(ffi.Size capacity);
+typedef DartCBLDart_QueryProfiler_Enable = void Function(int capacity);
+typedef NativeCBLDart_QueryProfiler_Disable = ffi.Void Function();
+typedef DartCBLDart_QueryProfiler_Disable = void Function();
+typedef NativeCBLDart_QueryProfiler_IsEnabled = ffi.Bool Function();
+typedef DartCBLDart_QueryProfiler_IsEnabled = bool Function();
+typedef NativeCBLDart_QueryProfiler_Clear = ffi.Void Function();
+typedef DartCBLDart_QueryProfiler_Clear = void Function();
+typedef FLSliceResult = imp$1.FLSliceResult;
+typedef NativeCBLDart_QueryProfiler_Snapshot = FLSliceResult Function();
+typedef DartCBLDart_QueryProfiler_Snapshot = FLSliceResult Function();
+typedef NativeCBLDart_QueryProfiler_ChromeTrace = FLSliceResult Function();
+typedef DartCBLDart_QueryProfiler_ChromeTrace = FLSliceResult Function();
+typedef NativeCBLDart_Metrics_Snapshot = FLSliceResult Function();
+typedef DartCBLDart_Metrics_Snapshot = FLSliceResult Function();
+typedef NativeCBLDart_Metrics_Reset = ffi.Void Function();
+typedef DartCBLDart_Metrics_Reset = void Function();
+typedef NativeCBLDart_Trace_Enable =
+    ffi.Void Function(ffi.Size capacityPerThread);
+typedef DartCBLDart_Trace_Enable = void Function(int capacityPerThread);
+typedef NativeCBLDart_Trace_Disable = ffi.Void Function();
+typedef DartCBLDart_Trace_Disable = void Function();
+typedef NativeCBLDart_Trace_IsEnabled = ffi.Bool Function();
+typedef DartCBLDart_Trace_IsEnabled = bool Function();
+typedef NativeCBLDart_Trace_Clear = ffi.Void Function();
+typedef DartCBLDart_Trace_Clear = void Function();
+typedef NativeCBLDart_Trace_Dump = FLSliceResult Function();
+typedef DartCBLDart_Trace_Dump = FLSliceResult Function();
+
+sealed class CBLDart_IndexVectorStatus {
+  static const kCBLDart_IndexVectorSkip = 0;
+  static const kCBLDart_IndexVectorSet = 1;
+  static const kCBLDart_IndexVectorRemove = 2;
+}
+
+final class CBLDart_IndexUpdateBatch extends ffi.Struct {
+  external imp$1.FLSlice values;
+
+  @ffi.Uint32()
+  external int count;
+
+  @ffi.Uint32()
+  external int dimensions;
+
+  external FLSliceResult statuses;
+
+  external FLSliceResult vectors;
+}
+
+final class CBLDart_IndexUpdaterWorkerProgress extends ffi.Struct {
+  @ffi.Bool()
+  external bool isRunning;
+
+  @ffi.Uint64()
+  external int batches;
+
+  @ffi.Uint64()
+  external int values;
+
+  @ffi.Uint64()
+  external int vectorsSet;
+
+  @ffi.Uint64()
+  external int vectorsRemoved;
+
+  @ffi.Uint64()
+  external int vectorsSkipped;
+
+  @ffi.Uint64()
+  external int vectorsFailed;
+
+  @ffi.Int64()
+  external int elapsedTime;
+
+  @ffi.Int64()
+  external int embeddingTime;
+
+  @ffi.Int64()
+  external int indexingTime;
+
+  external CBLError error;
+}
+
+typedef CBLDart_IndexUpdaterWorker_EmbedFunction =
+    ffi.Void Function(
+      ffi.Pointer<CBLDart_IndexUpdateBatch> batch,
+      CBLDart_Completer completer,
+    );
+typedef DartCBLDart_IndexUpdaterWorker_EmbedFunction =
+    void Function(
+      ffi.Pointer<CBLDart_IndexUpdateBatch> batch,
+      CBLDart_Completer completer,
+    );
+typedef CBLDart_IndexUpdaterWorker_Embed =
+    ffi.Pointer<ffi.NativeFunction<CBLDart_IndexUpdaterWorker_EmbedFunction>>;
+typedef CBLDart_IndexUpdaterWorker_DoneFunction = ffi.Void Function();
+typedef DartCBLDart_IndexUpdaterWorker_DoneFunction = void Function();
+typedef CBLDart_IndexUpdaterWorker_Done =
+    ffi.Pointer<ffi.NativeFunction<CBLDart_IndexUpdaterWorker_DoneFunction>>;
+
+final class _CBLDart_IndexUpdaterWorker extends ffi.Opaque {}
+
+typedef CBLDart_IndexUpdaterWorker = ffi.Pointer<_CBLDart_IndexUpdaterWorker>;
+typedef CBLQueryIndex = imp$1.CBLQueryIndex;
+typedef NativeCBLDart_IndexUpdaterWorker_Start =
+    CBLDart_IndexUpdaterWorker Function(
+      ffi.Pointer<CBLQueryIndex> index,
+      ffi.Uint32 batchSize,
+      CBLDart_IndexUpdaterWorker_Embed embed,
+      CBLDart_IndexUpdaterWorker_Done done,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_IndexUpdaterWorker_Start =
+    CBLDart_IndexUpdaterWorker Function(
+      ffi.Pointer<CBLQueryIndex> index,
+      int batchSize,
+      CBLDart_IndexUpdaterWorker_Embed embed,
+      CBLDart_IndexUpdaterWorker_Done done,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef NativeCBLDart_IndexUpdaterWorker_Stop =
+    ffi.Void Function(CBLDart_IndexUpdaterWorker worker);
+typedef DartCBLDart_IndexUpdaterWorker_Stop =
+    void Function(CBLDart_IndexUpdaterWorker worker);
+typedef NativeCBLDart_IndexUpdaterWorker_GetProgress =
+    ffi.Void Function(
+      CBLDart_IndexUpdaterWorker worker,
+      ffi.Pointer<CBLDart_IndexUpdaterWorkerProgress> progressOut,
+    );
+typedef DartCBLDart_IndexUpdaterWorker_GetProgress =
+    void Function(
+      CBLDart_IndexUpdaterWorker worker,
+      ffi.Pointer<CBLDart_IndexUpdaterWorkerProgress> progressOut,
+    );
+typedef NativeCBLDart_IndexUpdaterWorker_Delete =
+    ffi.Void Function(CBLDart_IndexUpdaterWorker worker);
+typedef DartCBLDart_IndexUpdaterWorker_Delete =
+    void Function(CBLDart_IndexUpdaterWorker worker);
+
+sealed class CBLDart_VectorDistanceMetric {
+  static const kCBLDart_VectorDistanceEuclideanSquared = 0;
+  static const kCBLDart_VectorDistanceEuclidean = 1;
+  static const kCBLDart_VectorDistanceCosine = 2;
+  static const kCBLDart_VectorDistanceDot = 3;
+  static const kCBLDart_VectorDistanceHamming = 4;
+}
+
+sealed class CBLDart_VectorElementType {
+  static const kCBLDart_VectorElementFloat32 = 0;
+  static const kCBLDart_VectorElementFloat16 = 1;
+  static const kCBLDart_VectorElementInt8 = 2;
+}
+
+sealed class CBLDart_SimdLevel {
+  static const kCBLDart_SimdScalar = 0;
+  static const kCBLDart_SimdSSE = 1;
+  static const kCBLDart_SimdAVX2 = 2;
+  static const kCBLDart_SimdNEON = 3;
+}
+
+typedef NativeCBLDart_VectorDistance_GetSimdLevel = ffi.Uint8 Function();
+typedef DartCBLDart_VectorDistance_GetSimdLevel = int Function();
+typedef NativeCBLDart_VectorDistance_SetSimdLevel =
+    ffi.Bool Function(ffi.Uint8 level);
+typedef DartCBLDart_VectorDistance_SetSimdLevel = bool Function(int level);
+typedef NativeCBLDart_VectorDistance =
+    ffi.Float Function(
+      ffi.Uint8 metric,
+      ffi.Uint8 elementType,
+      ffi.Pointer<ffi.Void> a,
+      ffi.Pointer<ffi.Void> b,
+      ffi.Uint32 dimensions,
+    );
+typedef DartCBLDart_VectorDistance =
+    double Function(
+      int metric,
+      int elementType,
+      ffi.Pointer<ffi.Void> a,
+      ffi.Pointer<ffi.Void> b,
+      int dimensions,
+    );
+typedef NativeCBLDart_VectorDistance_Batch =
+    ffi.Void Function(
+      ffi.Uint8 metric,
+      ffi.Uint8 elementType,
+      ffi.Pointer<ffi.Void> query,
+      ffi.Pointer<ffi.Void> candidates,
+      ffi.Uint32 count,
+      ffi.Uint32 dimensions,
+      ffi.Pointer<ffi.Float> distancesOut,
+    );
+typedef DartCBLDart_VectorDistance_Batch =
+    void Function(
+      int metric,
+      int elementType,
+      ffi.Pointer<ffi.Void> query,
+      ffi.Pointer<ffi.Void> candidates,
+      int count,
+      int dimensions,
+      ffi.Pointer<ffi.Float> distancesOut,
+    );
+typedef NativeCBLDart_VectorDistance_TopK =
+    ffi.Uint32 Function(
+      ffi.Uint8 metric,
+      ffi.Uint8 elementType,
+      ffi.Pointer<ffi.Void> query,
+      ffi.Pointer<ffi.Void> candidates,
+      ffi.Uint32 count,
+      ffi.Uint32 dimensions,
+      ffi.Uint32 k,
+      ffi.Pointer<ffi.Uint32> indexesOut,
+      ffi.Pointer<ffi.Float> distancesOut,
+    );
+typedef DartCBLDart_VectorDistance_TopK =
+    int Function(
+      int metric,
+      int elementType,
+      ffi.Pointer<ffi.Void> query,
+      ffi.Pointer<ffi.Void> candidates,
+      int count,
+      int dimensions,
+      int k,
+      ffi.Pointer<ffi.Uint32> indexesOut,
+      ffi.Pointer<ffi.Float> distancesOut,
+    );
 typedef CBLDart_PredictiveModel_PredictionSyncFunction =
     imp$1.FLMutableDict Function(imp$1.FLDict input);
 typedef CBLDart_PredictiveModel_PredictionSync =
@@ -740,6 +1577,24 @@ typedef CBLDart_PredictiveModel_PredictionAsync =
     ffi.Pointer<
       ffi.NativeFunction<CBLDart_PredictiveModel_PredictionAsyncFunction>
     >;
+typedef CBLDart_PredictiveModel_PredictionBatchAsyncFunction =
+    ffi.Void Function(
+      ffi.Pointer<imp$1.FLDict> inputs,
+      ffi.Pointer<imp$1.FLMutableDict> outputs,
+      ffi.Uint32 count,
+      CBLDart_Completer completer,
+    );
+typedef DartCBLDart_PredictiveModel_PredictionBatchAsyncFunction =
+    void Function(
+      ffi.Pointer<imp$1.FLDict> inputs,
+      ffi.Pointer<imp$1.FLMutableDict> outputs,
+      int count,
+      CBLDart_Completer completer,
+    );
+typedef CBLDart_PredictiveModel_PredictionBatchAsync =
+    ffi.Pointer<
+      ffi.NativeFunction<CBLDart_PredictiveModel_PredictionBatchAsyncFunction>
+    >;
 typedef CBLDart_PredictiveModel_UnregisteredFunction = ffi.Void Function();
 typedef DartCBLDart_PredictiveModel_UnregisteredFunction = void Function();
 typedef CBLDart_PredictiveModel_Unregistered =
@@ -750,12 +1605,34 @@ typedef CBLDart_PredictiveModel_Unregistered =
 final class _CBLDart_PredictiveModel extends ffi.Opaque {}
 
 typedef CBLDart_PredictiveModel = ffi.Pointer<_CBLDart_PredictiveModel>;
+
+final class CBLDart_PredictionCacheStats extends ffi.Struct {
+  @ffi.Uint64()
+  external int hits;
+
+  @ffi.Uint64()
+  external int misses;
+
+  @ffi.Uint64()
+  external int evictions;
+
+  @ffi.Uint64()
+  external int entryCount;
+
+  @ffi.Uint64()
+  external int size;
+}
+
 typedef NativeCBLDart_PredictiveModel_New =
     CBLDart_PredictiveModel Function(
       imp$1.FLString name,
       CBLDart_IsolateId isolateId,
       CBLDart_PredictiveModel_PredictionSync predictionSync,
       CBLDart_PredictiveModel_PredictionAsync predictionAsync,
+      CBLDart_PredictiveModel_PredictionBatchAsync predictionBatchAsync,
+      ffi.Uint32 maxBatchSize,
+      ffi.Uint64 cacheMaxSize,
+      ffi.Uint64 cacheTtl,
       CBLDart_PredictiveModel_Unregistered unregistered,
     );
 typedef DartCBLDart_PredictiveModel_New =
@@ -764,27 +1641,145 @@ typedef DartCBLDart_PredictiveModel_New =
       int isolateId,
       CBLDart_PredictiveModel_PredictionSync predictionSync,
       CBLDart_PredictiveModel_PredictionAsync predictionAsync,
+      CBLDart_PredictiveModel_PredictionBatchAsync predictionBatchAsync,
+      int maxBatchSize,
+      int cacheMaxSize,
+      int cacheTtl,
       CBLDart_PredictiveModel_Unregistered unregistered,
     );
+typedef NativeCBLDart_PredictiveModel_GetCacheStats =
+    ffi.Bool Function(
+      CBLDart_PredictiveModel model,
+      ffi.Pointer<CBLDart_PredictionCacheStats> statsOut,
+    );
+typedef DartCBLDart_PredictiveModel_GetCacheStats =
+    bool Function(
+      CBLDart_PredictiveModel model,
+      ffi.Pointer<CBLDart_PredictionCacheStats> statsOut,
+    );
+typedef NativeCBLDart_PredictiveModel_ClearCache =
+    ffi.Void Function(CBLDart_PredictiveModel model);
+typedef DartCBLDart_PredictiveModel_ClearCache =
+    void Function(CBLDart_PredictiveModel model);
 typedef NativeCBLDart_PredictiveModel_Delete =
     ffi.Void Function(CBLDart_PredictiveModel model);
 typedef DartCBLDart_PredictiveModel_Delete =
     void Function(CBLDart_PredictiveModel model);
-typedef FLSliceResult = imp$1.FLSliceResult;
 typedef CBLBlobReadStream = imp$1.CBLBlobReadStream;
-typedef NativeCBLDart_CBLBlobReader_Read =
-    FLSliceResult Function(
+typedef NativeCBLDart_CBLBlobReader_ReadInto =
+    ffi.Int64 Function(
       ffi.Pointer<CBLBlobReadStream> stream,
+      ffi.Pointer<ffi.Uint8> buffer,
       ffi.Uint64 bufferSize,
       ffi.Pointer<CBLError> outError,
     );
-typedef DartCBLDart_CBLBlobReader_Read =
-    FLSliceResult Function(
+typedef DartCBLDart_CBLBlobReader_ReadInto =
+    int Function(
       ffi.Pointer<CBLBlobReadStream> stream,
+      ffi.Pointer<ffi.Uint8> buffer,
       int bufferSize,
       ffi.Pointer<CBLError> outError,
     );
 
+sealed class CBLDart_BlobReadStreamerEvent {
+  static const kCBLDart_BlobReadStreamerChunk = 0;
+  static const kCBLDart_BlobReadStreamerDone = 1;
+  static const kCBLDart_BlobReadStreamerError = 2;
+}
+
+final class _CBLDart_BlobReadStreamer extends ffi.Opaque {}
+
+typedef CBLDart_BlobReadStreamer = ffi.Pointer<_CBLDart_BlobReadStreamer>;
+typedef CBLBlob = imp$1.CBLBlob;
+typedef NativeCBLDart_BlobReadStreamer_Start =
+    CBLDart_BlobReadStreamer Function(
+      ffi.Pointer<CBLDatabase> database,
+      ffi.Pointer<CBLBlob> blob,
+      ffi.Uint64 chunkSize,
+      ffi.Uint32 queueDepth,
+      CBLDart_AsyncCallback callback,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_BlobReadStreamer_Start =
+    CBLDart_BlobReadStreamer Function(
+      ffi.Pointer<CBLDatabase> database,
+      ffi.Pointer<CBLBlob> blob,
+      int chunkSize,
+      int queueDepth,
+      CBLDart_AsyncCallback callback,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef NativeCBLDart_BlobReadStreamer_Request =
+    ffi.Void Function(CBLDart_BlobReadStreamer streamer, ffi.Uint32 chunks);
+typedef DartCBLDart_BlobReadStreamer_Request =
+    void Function(CBLDart_BlobReadStreamer streamer, int chunks);
+typedef NativeCBLDart_BlobReadStreamer_GetError =
+    ffi.Void Function(
+      CBLDart_BlobReadStreamer streamer,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_BlobReadStreamer_GetError =
+    void Function(
+      CBLDart_BlobReadStreamer streamer,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef NativeCBLDart_BlobReadStreamer_Delete =
+    ffi.Void Function(CBLDart_BlobReadStreamer streamer);
+typedef DartCBLDart_BlobReadStreamer_Delete =
+    void Function(CBLDart_BlobReadStreamer streamer);
+
+sealed class CBLDart_BlobWriteStreamerEvent {
+  static const kCBLDart_BlobWriteStreamerWritten = 0;
+  static const kCBLDart_BlobWriteStreamerDone = 1;
+  static const kCBLDart_BlobWriteStreamerError = 2;
+}
+
+final class _CBLDart_BlobWriteStreamer extends ffi.Opaque {}
+
+typedef CBLDart_BlobWriteStreamer = ffi.Pointer<_CBLDart_BlobWriteStreamer>;
+typedef NativeCBLDart_BlobWriteStreamer_Start =
+    CBLDart_BlobWriteStreamer Function(
+      ffi.Pointer<CBLDatabase> db,
+      ffi.Uint64 bufferSize,
+      CBLDart_AsyncCallback callback,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_BlobWriteStreamer_Start =
+    CBLDart_BlobWriteStreamer Function(
+      ffi.Pointer<CBLDatabase> db,
+      int bufferSize,
+      CBLDart_AsyncCallback callback,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef NativeCBLDart_BlobWriteStreamer_Write =
+    ffi.Void Function(CBLDart_BlobWriteStreamer streamer, FLSliceResult chunk);
+typedef DartCBLDart_BlobWriteStreamer_Write =
+    void Function(CBLDart_BlobWriteStreamer streamer, FLSliceResult chunk);
+typedef NativeCBLDart_BlobWriteStreamer_Finish =
+    ffi.Void Function(
+      CBLDart_BlobWriteStreamer streamer,
+      imp$1.FLString contentType,
+    );
+typedef DartCBLDart_BlobWriteStreamer_Finish =
+    void Function(
+      CBLDart_BlobWriteStreamer streamer,
+      imp$1.FLString contentType,
+    );
+typedef NativeCBLDart_BlobWriteStreamer_GetError =
+    ffi.Void Function(
+      CBLDart_BlobWriteStreamer streamer,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef DartCBLDart_BlobWriteStreamer_GetError =
+    void Function(
+      CBLDart_BlobWriteStreamer streamer,
+      ffi.Pointer<CBLError> errorOut,
+    );
+typedef NativeCBLDart_BlobWriteStreamer_Delete =
+    ffi.Void Function(CBLDart_BlobWriteStreamer streamer);
+typedef DartCBLDart_BlobWriteStreamer_Delete =
+    void Function(CBLDart_BlobWriteStreamer streamer);
+
 final class CBLDart_ReplicationCollection extends ffi.Struct {
   external ffi.Pointer<CBLCollection> collection;
 
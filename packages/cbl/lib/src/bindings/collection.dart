@@ -5,13 +5,17 @@ import 'dart:typed_data';
 import 'base.dart';
 import 'cblite.dart' as cblite;
 import 'cblitedart.dart' as cblitedart;
+import 'data.dart';
 import 'database.dart';
+import 'fleece.dart';
 import 'global.dart';
+import 'native_utf8_string.dart';
 import 'query.dart';
 import 'tracing.dart';
 import 'utils.dart';
 
 export 'cblite.dart' show CBLCollection, CBLScope;
+export 'cblitedart.dart' show CBLDart_BulkDocumentWorker;
 
 final class CBLIndexSpec {
   CBLIndexSpec({
@@ -62,6 +66,46 @@ final class CollectionChangeCallbackMessage {
   final List<String> documentIds;
 }
 
+enum CBLDartBulkDocumentOperation {
+  purge(
+    cblitedart
+        .CBLDart_BulkDocumentOperation
+        .kCBLDart_BulkDocumentOperationPurge,
+  ),
+  setExpiration(
+    cblitedart
+        .CBLDart_BulkDocumentOperation
+        .kCBLDart_BulkDocumentOperationSetExpiration,
+  );
+
+  const CBLDartBulkDocumentOperation(this.value);
+
+  final int value;
+}
+
+enum CBLDartBulkDocumentWorkerEvent {
+  progress(
+    cblitedart
+        .CBLDart_BulkDocumentWorkerEvent
+        .kCBLDart_BulkDocumentWorkerProgress,
+  ),
+  done(
+    cblitedart.CBLDart_BulkDocumentWorkerEvent.kCBLDart_BulkDocumentWorkerDone,
+  ),
+  error(
+    cblitedart
+        .CBLDart_BulkDocumentWorkerEvent
+        .kCBLDart_BulkDocumentWorkerError,
+  );
+
+  const CBLDartBulkDocumentWorkerEvent(this.value);
+
+  factory CBLDartBulkDocumentWorkerEvent.fromValue(int value) =>
+      values.firstWhere((event) => event.value == value);
+
+  final int value;
+}
+
 final class CollectionBindings {
   static cblite.FLMutableArray databaseScopeNames(
     Pointer<cblite.CBLDatabase> db,
@@ -156,6 +200,68 @@ final class CollectionBindings {
     ).checkError();
   }
 
+  /// Saves the [documents] with the encoded [properties], using the
+  /// [concurrencyControls] at the same indices.
+  ///
+  /// Must be called in a transaction, which has to be aborted if an exception
+  /// is thrown.
+  ///
+  /// [properties] is an encoded Fleece array, which contains the properties of
+  /// each document. Returns for each document whether it was saved, which is
+  /// not the case if it conflicts with the stored revision.
+  static List<bool> saveDocuments(
+    Pointer<cblite.CBLCollection> collection,
+    List<Pointer<cblite.CBLDocument>> documents,
+    List<CBLConcurrencyControl> concurrencyControls,
+    Data properties,
+  ) => withGlobalArena(() {
+    final entries = globalArena<cblitedart.CBLDart_SaveDocumentEntry>(
+      documents.length,
+    );
+    for (var i = 0; i < documents.length; i++) {
+      entries[i]
+        ..document = documents[i]
+        ..concurrencyControl = concurrencyControls[i].value
+        ..saved = false;
+    }
+
+    final slice = properties.toSliceResult();
+    cblitedart.CBLDart_CBLCollection_SaveDocuments(
+      collection,
+      entries,
+      documents.length,
+      slice.makeGlobal().ref,
+      globalCBLError,
+    ).checkError();
+
+    return [for (var i = 0; i < documents.length; i++) entries[i].saved];
+  });
+
+  /// Loads the documents with the given [ids] with a single native call.
+  ///
+  /// Returns an encoded Fleece array, which contains for each id either `null`,
+  /// if the document does not exist, or an array of the revision id, sequence,
+  /// timestamp and properties of the document.
+  static Data getDocuments(
+    Pointer<cblite.CBLCollection> collection,
+    List<String> ids,
+  ) => withGlobalArena(() {
+    final flIds = globalArena<cblite.FLString>(ids.length);
+    for (var i = 0; i < ids.length; i++) {
+      final id = nativeUtf8StringEncoder.encode(ids[i], globalArena);
+      flIds[i]
+        ..buf = id.buffer.cast()
+        ..size = id.size;
+    }
+
+    return cblitedart.CBLDart_CBLCollection_GetDocuments(
+      collection,
+      flIds,
+      ids.length,
+      globalCBLError,
+    ).checkError().toData()!;
+  });
+
   static bool deleteDocumentWithConcurrencyControl(
     Pointer<cblite.CBLCollection> collection,
     Pointer<cblite.CBLDocument> document,
@@ -333,3 +439,41 @@ final class CollectionBindings {
     );
   }
 }
+
+final class BulkDocumentWorkerBindings {
+  static final _finalizer = NativeFinalizer(
+    cblitedart.addresses.CBLDart_BulkDocumentWorker_Delete.cast(),
+  );
+
+  /// Starts applying [operation] to the documents with the given [ids] on a
+  /// background thread, in transactions of [chunkSize] documents.
+  static cblitedart.CBLDart_BulkDocumentWorker start(
+    Pointer<cblite.CBLCollection> collection,
+    CBLDartBulkDocumentOperation operation, {
+    required Data ids,
+    DateTime? expiration,
+    required int chunkSize,
+    required cblitedart.CBLDart_AsyncCallback callback,
+  }) {
+    final slice = ids.toSliceResult();
+    return cblitedart.CBLDart_BulkDocumentWorker_Start(
+      collection,
+      operation.value,
+      slice.makeGlobal().ref,
+      expiration?.millisecondsSinceEpoch ?? 0,
+      chunkSize,
+      callback,
+      globalCBLError,
+    ).checkError();
+  }
+
+  static void bindToDartObject(
+    Finalizable object,
+    cblitedart.CBLDart_BulkDocumentWorker worker,
+  ) => _finalizer.attach(object, worker.cast());
+
+  static Never throwWorkerError(cblitedart.CBLDart_BulkDocumentWorker worker) {
+    cblitedart.CBLDart_BulkDocumentWorker_GetError(worker, globalCBLError);
+    throwError();
+  }
+}
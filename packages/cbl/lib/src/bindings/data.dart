@@ -11,6 +11,14 @@ abstract final class Data {
 
   factory Data.fromSliceResult(SliceResult slice) => _SliceResultData(slice);
 
+  /// Creates [Data] which exposes the content of [slice] as a typed list,
+  /// without copying it.
+  ///
+  /// In contrast to [Data.fromSliceResult], [toTypedList] returns a mutable
+  /// view of [slice], so [slice] must not be shared with other code.
+  factory Data.fromSliceResultView(SliceResult slice) =>
+      _TypedListData(slice.asTypedList())..slice = slice;
+
   int get size;
 
   Uint8List toTypedList();
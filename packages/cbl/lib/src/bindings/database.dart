@@ -113,7 +113,7 @@ final class DatabaseBindings {
   static bool deleteDatabase(String name, String? inDirectory) {
     ensureInitializedForCurrentIsolate();
     return withGlobalArena(
-      () => cblite.CBL_DeleteDatabase(
+      () => cblitedart.CBLDart_CBL_DeleteDatabase(
         name.toFLString(),
         inDirectory.toFLString(),
         globalCBLError,
@@ -163,16 +163,43 @@ final class DatabaseBindings {
     Finalizable object,
     Pointer<cblite.CBLDatabase> db,
   ) {
-    _finalizer.attach(object, db.cast());
+    _finalizer.attach(object, db.cast(), detach: object);
   }
 
-  static void close(Pointer<cblite.CBLDatabase> db) {
+  /// Closes the database and releases the reference which is owned by
+  /// [object].
+  ///
+  /// [db] must not be used after this call, since the database handle might
+  /// be handed out again by the database pool.
+  static void closeAndRelease(
+    Finalizable object,
+    Pointer<cblite.CBLDatabase> db,
+  ) {
+    _finalizer.detach(object);
     nativeCallTracePoint(
       TracedNativeCall.databaseClose,
-      () => cblitedart.CBLDart_CBLDatabase_Close(db, false, globalCBLError),
+      () => cblitedart.CBLDart_CBLDatabase_CloseAndRelease(db, globalCBLError),
     ).checkError();
   }
 
+  static void configurePool({
+    required int capacity,
+    required int timeToLiveMillis,
+  }) {
+    ensureInitializedForCurrentIsolate();
+    cblitedart.CBLDart_DatabasePool_Configure(capacity, timeToLiveMillis);
+  }
+
+  static int poolSize() {
+    ensureInitializedForCurrentIsolate();
+    return cblitedart.CBLDart_DatabasePool_Size();
+  }
+
+  static void clearPool() {
+    ensureInitializedForCurrentIsolate();
+    cblitedart.CBLDart_DatabasePool_Clear();
+  }
+
   static void delete(Pointer<cblite.CBLDatabase> db) {
     cblitedart.CBLDart_CBLDatabase_Close(db, true, globalCBLError).checkError();
   }
@@ -188,6 +215,27 @@ final class DatabaseBindings {
     ).checkError();
   }
 
+  static void scheduleMaintenance(
+    Pointer<cblite.CBLDatabase> db,
+    CBLMaintenanceType type, {
+    required int writeThreshold,
+    required int idleMillis,
+  }) {
+    cblitedart.CBLDart_MaintenanceScheduler_Schedule(
+      db,
+      type.value,
+      writeThreshold,
+      idleMillis,
+    );
+  }
+
+  static void unscheduleMaintenance(Pointer<cblite.CBLDatabase> db) {
+    cblitedart.CBLDart_MaintenanceScheduler_Unschedule(db);
+  }
+
+  static int pendingMaintenanceWrites(Pointer<cblite.CBLDatabase> db) =>
+      cblitedart.CBLDart_MaintenanceScheduler_PendingWrites(db);
+
   static void beginTransaction(Pointer<cblite.CBLDatabase> db) {
     nativeCallTracePoint(
       TracedNativeCall.databaseBeginTransaction,
@@ -145,6 +145,10 @@ final class SliceBindings {
     sliceResultReleaseByBufPtr,
   );
 
+  static final _transferredSliceResultFinalizer = NativeFinalizer(
+    cblitedart.addresses.CBLDart_FLSliceResult_ReleaseTransferred.cast(),
+  );
+
   static bool equal(cblite.FLSlice a, cblite.FLSlice b) =>
       cblite.FLSlice_Equal(a, b);
 
@@ -176,6 +180,19 @@ final class SliceBindings {
   static void releaseSliceResultByBuf(Pointer<Void> buf) {
     cblitedart.CBLDart_FLSliceResult_ReleaseByBuf(buf);
   }
+
+  static void retainSliceResultForTransfer(Pointer<Void> buf) {
+    cblitedart.CBLDart_FLSliceResult_RetainForTransfer(buf);
+  }
+
+  /// Binds the reference to a slice result which was retained with
+  /// [retainSliceResultForTransfer] to [object].
+  static void bindTransferredToDartObject(
+    Finalizable object, {
+    required Pointer<Void> buf,
+  }) {
+    _transferredSliceResultFinalizer.attach(object, buf.cast());
+  }
 }
 
 // === SharedKeys ==============================================================
@@ -36,3 +36,5 @@ final globalLoadedFLValue =
 
 final globalCBLError = sliceResultAllocator<cblite.CBLError>();
 final globalErrorPosition = sliceResultAllocator<Int>();
+final globalQueryExecution =
+    sliceResultAllocator<cblitedart.CBLDart_QueryExecution>();
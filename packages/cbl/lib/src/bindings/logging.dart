@@ -5,6 +5,7 @@ import 'dart:typed_data';
 import 'package:meta/meta.dart';
 
 import '../support/isolate.dart';
+import 'base.dart';
 import 'cblite.dart' as cblite;
 import 'cblitedart.dart' as cblitedart;
 import 'fleece.dart';
@@ -56,20 +57,43 @@ enum CBLLogLevel {
 }
 
 final class LogCallbackMessage {
-  LogCallbackMessage(this.domain, this.level, this.message);
-
-  LogCallbackMessage.fromArguments(List<Object?> arguments)
-    : this(
-        CBLLogDomain.fromValue(arguments[0]! as int),
-        CBLLogLevel.fromValue(arguments[1]! as int),
-        utf8.decode(arguments[2]! as Uint8List, allowMalformed: true),
-      );
+  LogCallbackMessage(this.domain, this.level, this.timestamp, this.message);
 
   final CBLLogDomain domain;
   final CBLLogLevel level;
+  final DateTime timestamp;
   final String message;
 }
 
+/// A batch of log messages, which have been buffered natively and are
+/// delivered to a log callback at once.
+final class LogCallbackBatch {
+  LogCallbackBatch(this.dropped, this.messages);
+
+  /// The arguments are the number of dropped messages, followed by the
+  /// domain, level, timestamp and message of each message in the batch.
+  factory LogCallbackBatch.fromArguments(List<Object?> arguments) {
+    final messages = <LogCallbackMessage>[];
+    for (var i = 1; i < arguments.length; i += 4) {
+      messages.add(
+        LogCallbackMessage(
+          CBLLogDomain.fromValue(arguments[i]! as int),
+          CBLLogLevel.fromValue(arguments[i + 1]! as int),
+          DateTime.fromMillisecondsSinceEpoch(arguments[i + 2]! as int),
+          utf8.decode(arguments[i + 3]! as Uint8List, allowMalformed: true),
+        ),
+      );
+    }
+    return LogCallbackBatch(arguments[0]! as int, messages);
+  }
+
+  /// The number of messages which have been dropped since the last batch,
+  /// because the native log buffer was full.
+  final int dropped;
+
+  final List<LogCallbackMessage> messages;
+}
+
 extension on cblite.CBLFileLogSink {
   CBLLogFileConfiguration toCBLLogFileConfiguration() =>
       CBLLogFileConfiguration(
@@ -164,6 +188,32 @@ final class LoggingBindings {
     cblitedart.CBLDart_CBLLog_SetCallbackLevel(callback, logLevel.value);
   }
 
+  static void setCallbackDomainLevel(
+    cblitedart.CBLDart_AsyncCallback callback,
+    CBLLogDomain domain,
+    CBLLogLevel logLevel,
+  ) {
+    ensureInitializedForCurrentIsolate();
+    cblitedart.CBLDart_CBLLog_SetCallbackDomainLevel(
+      callback,
+      domain.value,
+      logLevel.value,
+    );
+  }
+
+  static void setCallbackDomainRateLimit(
+    cblitedart.CBLDart_AsyncCallback callback,
+    CBLLogDomain domain,
+    int maxRecordsPerSecond,
+  ) {
+    ensureInitializedForCurrentIsolate();
+    cblitedart.CBLDart_CBLLog_SetCallbackDomainRateLimit(
+      callback,
+      domain.value,
+      maxRecordsPerSecond,
+    );
+  }
+
   static void addCallback(
     cblitedart.CBLDart_AsyncCallback callback,
     CBLLogLevel logLevel,
@@ -179,6 +229,25 @@ final class LoggingBindings {
     });
   }
 
+  static void setBinaryLogSink(
+    CBLLogLevel level, {
+    required String directory,
+    required int segmentSize,
+    required int maxSegments,
+  }) {
+    ensureInitializedForCurrentIsolate();
+    runWithSingleFLString(
+      directory,
+      (flDirectory) => cblitedart.CBLDart_CBLLog_SetBinarySink(
+        level.value,
+        flDirectory,
+        segmentSize,
+        maxSegments,
+        globalCBLError,
+      ).checkError(),
+    );
+  }
+
   static CBLLogFileConfiguration? getLogFileConfiguration() {
     ensureInitializedForCurrentIsolate();
     return cblitedart.CBLDart_CBLLog_GetFileSink()
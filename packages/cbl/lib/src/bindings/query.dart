@@ -1,9 +1,12 @@
 import 'dart:ffi';
+import 'dart:typed_data';
 
+import '../errors.dart';
 import '../support/isolate.dart';
 import 'base.dart';
 import 'cblite.dart' as cblite;
 import 'cblitedart.dart' as cblitedart;
+import 'data.dart';
 import 'fleece.dart';
 import 'global.dart';
 import 'tracing.dart';
@@ -24,7 +27,15 @@ export 'cblite.dart'
         kCBLSQ4,
         kCBLSQ6,
         kCBLSQ8;
-export 'cblitedart.dart' show CBLDart_IndexType;
+export 'cblitedart.dart'
+    show
+        CBLDart_IndexType,
+        CBLDart_IndexUpdateBatch,
+        CBLDart_IndexUpdaterWorker,
+        CBLDart_IndexUpdaterWorker_DoneFunction,
+        CBLDart_IndexUpdaterWorker_EmbedFunction,
+        CBLDart_PredictiveModel,
+        CBLDart_QueryExecution;
 
 enum CBLQueryLanguage {
   json(cblite.kCBLJSONLanguage),
@@ -53,10 +64,21 @@ enum CBLDartIndexType {
 }
 
 final class QueryBindings {
+  static final _finalizer = NativeFinalizer(
+    cblitedart.addresses.CBLDart_CBLQuery_Release.cast(),
+  );
+
   static final _predictiveModelFinalizer = NativeFinalizer(
     cblitedart.addresses.CBLDart_PredictiveModel_Delete.cast(),
   );
 
+  static void bindToDartObject(
+    Finalizable object,
+    Pointer<cblite.CBLQuery> query,
+  ) {
+    _finalizer.attach(object, query.cast());
+  }
+
   static Pointer<cblite.CBLQuery> create(
     Pointer<cblite.CBLDatabase> db,
     CBLQueryLanguage language,
@@ -64,7 +86,7 @@ final class QueryBindings {
   ) => withGlobalArena(
     () => nativeCallTracePoint(
       TracedNativeCall.queryCreate,
-      () => cblite.CBLDatabase_CreateQuery(
+      () => cblitedart.CBLDart_CBLDatabase_CreateQuery(
         db,
         language.value,
         queryString.makeGlobalFLString(),
@@ -84,11 +106,24 @@ final class QueryBindings {
   static cblite.FLDict parameters(Pointer<cblite.CBLQuery> query) =>
       cblite.CBLQuery_Parameters(query);
 
-  static Pointer<cblite.CBLResultSet> execute(Pointer<cblite.CBLQuery> query) =>
-      nativeCallTracePoint(
-        TracedNativeCall.queryExecute,
-        () => cblite.CBLQuery_Execute(query, globalCBLError),
-      ).checkError();
+  /// Executes [query] and returns the result set together with the execution
+  /// which the query profiler uses to track it, which has to be passed to
+  /// [ResultSetBindings.next].
+  static ({
+    Pointer<cblite.CBLResultSet> resultSet,
+    cblitedart.CBLDart_QueryExecution execution,
+  })
+  execute(Pointer<cblite.CBLQuery> query) {
+    final resultSet = nativeCallTracePoint(
+      TracedNativeCall.queryExecute,
+      () => cblitedart.CBLDart_CBLQuery_Execute(
+        query,
+        globalQueryExecution,
+        globalCBLError,
+      ),
+    ).checkError();
+    return (resultSet: resultSet, execution: globalQueryExecution.value);
+  }
 
   static String explain(Pointer<cblite.CBLQuery> query) =>
       cblite.CBLQuery_Explain(query).toDartStringAndRelease()!;
@@ -118,6 +153,11 @@ final class QueryBindings {
     String name,
     cblitedart.CBLDart_PredictiveModel_PredictionSync predictionSync,
     cblitedart.CBLDart_PredictiveModel_PredictionAsync predictionAsync,
+    cblitedart.CBLDart_PredictiveModel_PredictionBatchAsync?
+    predictionBatchAsync,
+    int maxBatchSize,
+    int cacheMaxSize,
+    Duration? cacheTtl,
     cblitedart.CBLDart_PredictiveModel_Unregistered unregistered,
   ) {
     ensureInitializedForCurrentIsolate();
@@ -128,11 +168,36 @@ final class QueryBindings {
         BaseBindings.isolateId,
         predictionSync,
         predictionAsync,
+        predictionBatchAsync ?? nullptr,
+        maxBatchSize,
+        cacheMaxSize,
+        cacheTtl?.inMilliseconds ?? 0,
         unregistered,
       ),
     );
   }
 
+  static CBLDartPredictionCacheStats? predictiveModelCacheStats(
+    cblitedart.CBLDart_PredictiveModel model,
+  ) => withGlobalArena(() {
+    final stats = globalArena<cblitedart.CBLDart_PredictionCacheStats>();
+    if (!cblitedart.CBLDart_PredictiveModel_GetCacheStats(model, stats)) {
+      return null;
+    }
+    final ref = stats.ref;
+    return CBLDartPredictionCacheStats(
+      ref.hits,
+      ref.misses,
+      ref.evictions,
+      ref.entryCount,
+      ref.size,
+    );
+  });
+
+  static void clearPredictiveModelCache(
+    cblitedart.CBLDart_PredictiveModel model,
+  ) => cblitedart.CBLDart_PredictiveModel_ClearCache(model);
+
   static void bindCBLDartPredictiveModelToDartObject(
     Finalizable object,
     cblitedart.CBLDart_PredictiveModel model,
@@ -144,9 +209,38 @@ final class QueryBindings {
   }
 }
 
+final class CBLDartPredictionCacheStats {
+  CBLDartPredictionCacheStats(
+    this.hits,
+    this.misses,
+    this.evictions,
+    this.entryCount,
+    this.size,
+  );
+
+  final int hits;
+  final int misses;
+  final int evictions;
+  final int entryCount;
+  final int size;
+}
+
 final class ResultSetBindings {
-  static bool next(Pointer<cblite.CBLResultSet> resultSet) =>
-      cblite.CBLResultSet_Next(resultSet);
+  static final _finalizer = NativeFinalizer(
+    cblitedart.addresses.CBLDart_CBLResultSet_Release.cast(),
+  );
+
+  static void bindToDartObject(
+    Finalizable object,
+    Pointer<cblite.CBLResultSet> resultSet,
+  ) {
+    _finalizer.attach(object, resultSet.cast());
+  }
+
+  static bool next(
+    Pointer<cblite.CBLResultSet> resultSet,
+    cblitedart.CBLDart_QueryExecution execution,
+  ) => cblitedart.CBLDart_CBLResultSet_Next(resultSet, execution);
 
   static cblite.FLValue valueAtIndex(
     Pointer<cblite.CBLResultSet> resultSet,
@@ -221,3 +315,351 @@ final class IndexUpdaterBindings {
   static void finish(Pointer<cblite.CBLIndexUpdater> updater) =>
       cblite.CBLIndexUpdater_Finish(updater, globalCBLError).checkError();
 }
+
+final class CBLDartIndexUpdaterWorkerProgress {
+  CBLDartIndexUpdaterWorkerProgress(
+    this.isRunning,
+    this.batches,
+    this.values,
+    this.vectorsSet,
+    this.vectorsRemoved,
+    this.vectorsSkipped,
+    this.vectorsFailed,
+    this.elapsedTime,
+    this.embeddingTime,
+    this.indexingTime,
+    this.error,
+  );
+
+  final bool isRunning;
+  final int batches;
+  final int values;
+  final int vectorsSet;
+  final int vectorsRemoved;
+  final int vectorsSkipped;
+  final int vectorsFailed;
+  final Duration elapsedTime;
+  final Duration embeddingTime;
+  final Duration indexingTime;
+  final CouchbaseLiteException? error;
+}
+
+final class IndexUpdaterWorkerBindings {
+  static const _vectorSet =
+      cblitedart.CBLDart_IndexVectorStatus.kCBLDart_IndexVectorSet;
+  static const _vectorRemove =
+      cblitedart.CBLDart_IndexVectorStatus.kCBLDart_IndexVectorRemove;
+
+  static final _finalizer = NativeFinalizer(
+    cblitedart.addresses.CBLDart_IndexUpdaterWorker_Delete.cast(),
+  );
+
+  static cblitedart.CBLDart_IndexUpdaterWorker start(
+    Pointer<cblite.CBLQueryIndex> index,
+    int batchSize,
+    cblitedart.CBLDart_IndexUpdaterWorker_Embed embed,
+    cblitedart.CBLDart_IndexUpdaterWorker_Done done,
+  ) => cblitedart.CBLDart_IndexUpdaterWorker_Start(
+    index,
+    batchSize,
+    embed,
+    done,
+    globalCBLError,
+  ).checkError();
+
+  static void bindToDartObject(
+    Finalizable object,
+    cblitedart.CBLDart_IndexUpdaterWorker worker,
+  ) => _finalizer.attach(object, worker.cast());
+
+  static void stop(cblitedart.CBLDart_IndexUpdaterWorker worker) =>
+      cblitedart.CBLDart_IndexUpdaterWorker_Stop(worker);
+
+  static CBLDartIndexUpdaterWorkerProgress progress(
+    cblitedart.CBLDart_IndexUpdaterWorker worker,
+  ) => withGlobalArena(() {
+    final progress =
+        globalArena<cblitedart.CBLDart_IndexUpdaterWorkerProgress>();
+    cblitedart.CBLDart_IndexUpdaterWorker_GetProgress(worker, progress);
+    final ref = progress.ref;
+
+    CouchbaseLiteException? error;
+    if (!ref.error.isOk) {
+      ref.error.copyToGlobal();
+      error = globalCBLError.toCouchbaseLiteException();
+    }
+
+    return CBLDartIndexUpdaterWorkerProgress(
+      ref.isRunning,
+      ref.batches,
+      ref.values,
+      ref.vectorsSet,
+      ref.vectorsRemoved,
+      ref.vectorsSkipped,
+      ref.vectorsFailed,
+      Duration(microseconds: ref.elapsedTime),
+      Duration(microseconds: ref.embeddingTime),
+      Duration(microseconds: ref.indexingTime),
+      error,
+    );
+  });
+
+  /// Returns a copy of the Fleece encoded array of values of [batch].
+  static Data batchValues(
+    Pointer<cblitedart.CBLDart_IndexUpdateBatch> batch,
+  ) => batch.ref.values.toData()!;
+
+  /// Sets the [vectors] as the result of [batch] and signals the worker
+  /// through [completer] that it can continue.
+  ///
+  /// A `null` vector removes the vector of the corresponding value from the
+  /// index.
+  static void completeBatch(
+    Pointer<cblitedart.CBLDart_IndexUpdateBatch> batch,
+    cblitedart.CBLDart_Completer completer,
+    List<List<double>?> vectors,
+  ) {
+    final count = batch.ref.count;
+    if (vectors.length != count) {
+      throw ArgumentError.value(
+        vectors.length,
+        'vectors.length',
+        'must be equal to the number of values ($count)',
+      );
+    }
+
+    final dimensions = vectors.nonNulls.firstOrNull?.length ?? 0;
+    if (vectors.nonNulls.any((vector) => vector.length != dimensions)) {
+      throw ArgumentError.value(
+        vectors,
+        'vectors',
+        'must all have the same number of dimensions',
+      );
+    }
+
+    // The worker takes ownership of the slices and releases them.
+    final statuses = SliceBindings.create(count);
+    final vectorData = SliceBindings.create(
+      count * dimensions * sizeOf<Float>(),
+    );
+    final statusList = statuses.buf.cast<Uint8>().asTypedList(count);
+    final vectorList = vectorData.buf.cast<Float>().asTypedList(
+      count * dimensions,
+    );
+
+    for (var i = 0; i < count; i++) {
+      final vector = vectors[i];
+      if (vector == null) {
+        statusList[i] = _vectorRemove;
+      } else {
+        statusList[i] = _vectorSet;
+        vectorList.setAll(i * dimensions, vector);
+      }
+    }
+
+    batch.ref
+      ..dimensions = dimensions
+      ..statuses.buf = statuses.buf
+      ..statuses.size = statuses.size
+      ..vectors.buf = vectorData.buf
+      ..vectors.size = vectorData.size;
+
+    cblitedart.CBLDart_Completer_Complete(completer, 1);
+  }
+
+  /// Signals the worker through [completer] that the embedding of a batch
+  /// failed and that it should stop.
+  static void failBatch(cblitedart.CBLDart_Completer completer) =>
+      cblitedart.CBLDart_Completer_Complete(completer, 0);
+}
+
+final class QueryProfilerBindings {
+  static void enable(int capacity) =>
+      cblitedart.CBLDart_QueryProfiler_Enable(capacity);
+
+  static void disable() => cblitedart.CBLDart_QueryProfiler_Disable();
+
+  static bool isEnabled() => cblitedart.CBLDart_QueryProfiler_IsEnabled();
+
+  static void clear() => cblitedart.CBLDart_QueryProfiler_Clear();
+
+  static String snapshot() =>
+      cblitedart.CBLDart_QueryProfiler_Snapshot().toDartStringAndRelease()!;
+
+  static String chromeTrace() =>
+      cblitedart.CBLDart_QueryProfiler_ChromeTrace().toDartStringAndRelease()!;
+}
+
+enum CBLDartVectorDistanceMetric {
+  euclideanSquared(
+    cblitedart
+        .CBLDart_VectorDistanceMetric
+        .kCBLDart_VectorDistanceEuclideanSquared,
+  ),
+  euclidean(
+    cblitedart.CBLDart_VectorDistanceMetric.kCBLDart_VectorDistanceEuclidean,
+  ),
+  cosine(cblitedart.CBLDart_VectorDistanceMetric.kCBLDart_VectorDistanceCosine),
+  dot(cblitedart.CBLDart_VectorDistanceMetric.kCBLDart_VectorDistanceDot),
+  hamming(
+    cblitedart.CBLDart_VectorDistanceMetric.kCBLDart_VectorDistanceHamming,
+  );
+
+  const CBLDartVectorDistanceMetric(this.value);
+
+  final int value;
+}
+
+enum CBLDartVectorElementType {
+  float32(
+    cblitedart.CBLDart_VectorElementType.kCBLDart_VectorElementFloat32,
+    4,
+  ),
+  float16(
+    cblitedart.CBLDart_VectorElementType.kCBLDart_VectorElementFloat16,
+    2,
+  ),
+  int8(cblitedart.CBLDart_VectorElementType.kCBLDart_VectorElementInt8, 1);
+
+  const CBLDartVectorElementType(this.value, this.size);
+
+  final int value;
+  final int size;
+}
+
+enum CBLDartSimdLevel {
+  scalar(cblitedart.CBLDart_SimdLevel.kCBLDart_SimdScalar),
+  sse(cblitedart.CBLDart_SimdLevel.kCBLDart_SimdSSE),
+  avx2(cblitedart.CBLDart_SimdLevel.kCBLDart_SimdAVX2),
+  neon(cblitedart.CBLDart_SimdLevel.kCBLDart_SimdNEON);
+
+  const CBLDartSimdLevel(this.value);
+
+  factory CBLDartSimdLevel.fromValue(int value) =>
+      values.firstWhere((level) => level.value == value);
+
+  final int value;
+}
+
+final class VectorDistanceBindings {
+  static CBLDartSimdLevel get simdLevel => CBLDartSimdLevel.fromValue(
+    cblitedart.CBLDart_VectorDistance_GetSimdLevel(),
+  );
+
+  static bool setSimdLevel(CBLDartSimdLevel level) =>
+      cblitedart.CBLDart_VectorDistance_SetSimdLevel(level.value);
+
+  static double distance(
+    CBLDartVectorDistanceMetric metric,
+    CBLDartVectorElementType elementType,
+    TypedData a,
+    TypedData b,
+    int dimensions,
+  ) => cblitedart.CBLDart_VectorDistance(
+    metric.value,
+    elementType.value,
+    _bytesOf(a).address.cast(),
+    _bytesOf(b).address.cast(),
+    dimensions,
+  );
+
+  /// Computes the distances between [query] and each of the [candidates].
+  static Float32List batch(
+    CBLDartVectorDistanceMetric metric,
+    CBLDartVectorElementType elementType,
+    TypedData query,
+    List<TypedData> candidates,
+    int dimensions,
+  ) {
+    final count = candidates.length;
+    final distances = Float32List(count);
+    cblitedart.CBLDart_VectorDistance_Batch(
+      metric.value,
+      elementType.value,
+      _bytesOf(query).address.cast(),
+      _contiguousBytesOf(
+        candidates,
+        dimensions * elementType.size,
+      ).address.cast(),
+      count,
+      dimensions,
+      distances.address,
+    );
+    return distances;
+  }
+
+  /// Finds the [k] vectors in [candidates] which are closest to [query] and
+  /// returns their indexes and distances, ordered from closest to farthest.
+  static (Uint32List, Float32List) topK(
+    CBLDartVectorDistanceMetric metric,
+    CBLDartVectorElementType elementType,
+    TypedData query,
+    List<TypedData> candidates,
+    int dimensions,
+    int k,
+  ) {
+    final count = candidates.length;
+    final indexes = Uint32List(k);
+    final distances = Float32List(k);
+    final found = cblitedart.CBLDart_VectorDistance_TopK(
+      metric.value,
+      elementType.value,
+      _bytesOf(query).address.cast(),
+      _contiguousBytesOf(
+        candidates,
+        dimensions * elementType.size,
+      ).address.cast(),
+      count,
+      dimensions,
+      k,
+      indexes.address,
+      distances.address,
+    );
+    return (
+      Uint32List.sublistView(indexes, 0, found),
+      Float32List.sublistView(distances, 0, found),
+    );
+  }
+
+  static Uint8List _bytesOf(TypedData data) =>
+      data.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes);
+
+  /// Returns the bytes of [vectors], which all have [stride] bytes, back to
+  /// back.
+  ///
+  /// Vectors which are views of consecutive ranges of the same buffer, as is
+  /// the case for vectors which have been split off a single list, are passed
+  /// to native code as a view of that buffer. Otherwise the vectors are copied
+  /// into a new buffer.
+  static Uint8List _contiguousBytesOf(List<TypedData> vectors, int stride) {
+    if (vectors.isEmpty) {
+      return Uint8List(0);
+    }
+
+    final first = vectors.first;
+    final buffer = first.buffer;
+    final offset = first.offsetInBytes;
+    var isContiguous = true;
+    for (var i = 1; i < vectors.length; i++) {
+      final vector = vectors[i];
+      if (vector.buffer != buffer ||
+          vector.offsetInBytes != offset + i * stride) {
+        isContiguous = false;
+        break;
+      }
+    }
+    if (isContiguous) {
+      return buffer.asUint8List(offset, vectors.length * stride);
+    }
+
+    final bytes = Uint8List(vectors.length * stride);
+    for (var i = 0; i < vectors.length; i++) {
+      final vector = vectors[i];
+      bytes.setAll(
+        i * stride,
+        vector.buffer.asUint8List(vector.offsetInBytes, stride),
+      );
+    }
+    return bytes;
+  }
+}
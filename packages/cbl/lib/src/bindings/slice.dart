@@ -159,6 +159,15 @@ final class SliceResult extends Slice {
     SliceBindings.bindToDartObject(this, buf: buf, retain: retain);
   }
 
+  SliceResult._transferred(super.buf, super.size) : super._() {
+    SliceBindings.bindTransferredToDartObject(this, buf: buf);
+  }
+
+  /// Creates a [SliceResult] for the buffer of a native `FLSliceResult` at
+  /// [address], which is retained until this object is garbage collected.
+  SliceResult.retainByBufAddress(int address, int size)
+    : this._(Pointer.fromAddress(address), size, retain: true);
+
   /// Returns a [SliceResult] which has the content and size of [list].
   factory SliceResult.fromTypedList(Uint8List list) =>
       SliceResult(list.lengthInBytes)..asTypedList().setAll(0, list);
@@ -228,14 +237,14 @@ final class TransferableSliceResult {
       _size = sliceResult.size {
     // Retain the slice now, in case `sliceResult` is garbage collected
     // before this transferable slice result is materialized.
-    SliceBindings.retainSliceResultByBuf(sliceResult.buf);
+    SliceBindings.retainSliceResultForTransfer(sliceResult.buf);
   }
 
   final int _bufAddress;
   final int _size;
 
   SliceResult materialize() =>
-      SliceResult._(Pointer.fromAddress(_bufAddress), _size);
+      SliceResult._transferred(Pointer.fromAddress(_bufAddress), _size);
 }
 
 final sliceResultAllocator = SliceResultAllocator();
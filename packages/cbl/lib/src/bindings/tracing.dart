@@ -1,3 +1,6 @@
+import 'cblitedart.dart' as cblitedart;
+import 'fleece.dart';
+
 /// Whether CBL Dart trace points should be included when compiling a Dart
 /// program.
 ///
@@ -15,7 +18,7 @@ const cblIncludeTracePoints =
 
 enum TracedNativeCall {
   databaseOpen('CBLDart_CBLDatabase_Open'),
-  databaseClose('CBLDart_CBLDatabase_Close'),
+  databaseClose('CBLDart_CBLDatabase_CloseAndRelease'),
   databaseBeginTransaction('CBLDatabase_BeginTransaction'),
   databaseEndTransaction('CBLDatabase_EndTransaction'),
   collectionGetDocument('CBLCollection_GetDocument'),
@@ -53,3 +56,24 @@ T nativeCallTracePoint<T>(TracedNativeCall call, T Function() execute) {
 
   return onTracedCall(call, execute);
 }
+
+final class MetricsBindings {
+  static String snapshot() =>
+      cblitedart.CBLDart_Metrics_Snapshot().toDartStringAndRelease()!;
+
+  static void reset() => cblitedart.CBLDart_Metrics_Reset();
+}
+
+final class TraceBindings {
+  static void enable(int capacityPerThread) =>
+      cblitedart.CBLDart_Trace_Enable(capacityPerThread);
+
+  static void disable() => cblitedart.CBLDart_Trace_Disable();
+
+  static bool isEnabled() => cblitedart.CBLDart_Trace_IsEnabled();
+
+  static void clear() => cblitedart.CBLDart_Trace_Clear();
+
+  static String dump() =>
+      cblitedart.CBLDart_Trace_Dump().toDartStringAndRelease()!;
+}
@@ -1,3 +1,4 @@
+export 'database/bulk_document_progress.dart' show BulkDocumentProgress;
 export 'database/collection.dart'
     show
         AsyncCollection,
@@ -20,7 +21,10 @@ export 'database/database.dart'
         Database,
         MaintenanceType,
         SyncDatabase;
+export 'database/database_pool.dart' show DatabasePool;
 export 'database/database_configuration.dart'
     show DatabaseConfiguration, EncryptionKey;
 export 'database/document_change.dart' show DocumentChange;
+export 'database/maintenance_scheduler.dart'
+    show MaintenanceSchedule, MaintenanceScheduler;
 export 'database/scope.dart' show AsyncScope, Scope, SyncScope;
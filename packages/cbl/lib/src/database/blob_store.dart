@@ -1,6 +1,7 @@
 import 'dart:async';
 
 import '../bindings.dart';
+import '../document/blob.dart';
 
 abstract interface class BlobStore {
   Future<Map<String, Object?>> saveBlobFromData(String contentType, Data data);
@@ -12,7 +13,10 @@ abstract interface class BlobStore {
 
   FutureOr<bool> blobExists(Map<String, Object?> properties);
 
-  Stream<Data>? readBlob(Map<String, Object?> properties);
+  Stream<Data>? readBlob(
+    Map<String, Object?> properties, [
+    BlobReadOptions options = const BlobReadOptions(),
+  ]);
 }
 
 abstract interface class SyncBlobStore extends BlobStore {
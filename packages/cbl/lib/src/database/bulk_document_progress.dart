@@ -0,0 +1,55 @@
+import 'package:meta/meta.dart';
+
+import 'collection.dart';
+
+/// The progress of a bulk operation on the documents of a [Collection].
+///
+/// See:
+///
+/// - [Collection.purgeDocuments] for purging documents in bulk.
+/// - [Collection.setDocumentsExpiration] for setting the expiration of
+///   documents in bulk.
+///
+/// {@category Database}
+@immutable
+final class BulkDocumentProgress {
+  /// Creates the progress of a bulk operation on documents.
+  const BulkDocumentProgress({
+    required this.processed,
+    required this.affected,
+    required this.total,
+  });
+
+  /// The number of document ids which have been processed so far.
+  final int processed;
+
+  /// The number of existing documents which have been affected by the
+  /// operation so far.
+  ///
+  /// Ids of documents which don't exist are processed but don't affect any
+  /// document.
+  final int affected;
+
+  /// The total number of document ids to process.
+  final int total;
+
+  /// Whether all document ids have been processed.
+  bool get isDone => processed == total;
+
+  @override
+  bool operator ==(Object other) =>
+      identical(this, other) ||
+      other is BulkDocumentProgress &&
+          runtimeType == other.runtimeType &&
+          processed == other.processed &&
+          affected == other.affected &&
+          total == other.total;
+
+  @override
+  int get hashCode => processed.hashCode ^ affected.hashCode ^ total.hashCode;
+
+  @override
+  String toString() =>
+      'BulkDocumentProgress(processed: $processed, affected: $affected, '
+      'total: $total)';
+}
@@ -8,6 +8,7 @@ import '../query.dart';
 import '../support/listener_token.dart';
 import '../support/streams.dart';
 import '../typed_data/typed_object.dart';
+import 'bulk_document_progress.dart';
 import 'collection_change.dart';
 import 'database.dart';
 import 'document_change.dart';
@@ -260,6 +261,13 @@ abstract interface class Collection {
   /// Returns the [Document] with the given [id], if it exists.
   FutureOr<Document?> document(String id);
 
+  /// Returns the [Document]s with the given [ids], in the same order, or
+  /// `null` for documents which do not exist.
+  ///
+  /// This is considerably faster than loading the documents one by one, because
+  /// all documents are loaded with a single native call.
+  FutureOr<List<Document?>> documents(List<String> ids);
+
   /// Returns the [DocumentFragment] for the [Document] with the given [id].
   FutureOr<DocumentFragment> operator [](String id);
 
@@ -282,6 +290,32 @@ abstract interface class Collection {
     ConcurrencyControl concurrencyControl = .lastWriteWins,
   ]);
 
+  /// Saves [documents] to this collection in a single transaction, resolving
+  /// conflicts through [ConcurrencyControl].
+  ///
+  /// This is considerably faster than saving the documents one by one, because
+  /// all documents are saved with a single native call.
+  ///
+  /// Returns for each document whether it has been saved. With
+  /// [ConcurrencyControl.failOnConflict], documents which conflict with the
+  /// revision in the database are not saved, while the other documents are.
+  /// If saving a document fails for any other reason, none of the [documents]
+  /// are saved and the error is thrown.
+  FutureOr<List<bool>> saveDocuments(
+    List<MutableDocument> documents, [
+    ConcurrencyControl concurrencyControl = .lastWriteWins,
+  ]);
+
+  /// Saves [documents] to this collection in a single transaction, resolving
+  /// the conflicts of each document through the [ConcurrencyControl] at the
+  /// same index in [concurrencyControls].
+  ///
+  /// Otherwise this method behaves like [saveDocuments].
+  FutureOr<List<bool>> saveDocumentsWithConcurrencyControl(
+    List<MutableDocument> documents,
+    List<ConcurrencyControl> concurrencyControls,
+  );
+
   /// Saves a [document] to this collection, resolving conflicts with a
   /// [conflictHandler].
   ///
@@ -371,6 +405,39 @@ abstract interface class Collection {
   /// The purge will **not** be replicated to other databases.
   FutureOr<void> setDocumentExpiration(String id, DateTime? expiration);
 
+  /// Purges the [Document]s with the given [ids] from this collection in the
+  /// background.
+  ///
+  /// The purge starts when the returned stream is listened to. The documents
+  /// are purged in chunks of [chunkSize] documents, each in its own
+  /// transaction, so that other writers to the database are not blocked for
+  /// the whole operation. Ids of documents which don't exist are skipped.
+  ///
+  /// The stream emits a [BulkDocumentProgress] after each chunk and closes
+  /// once all documents have been processed. Canceling the subscription or
+  /// closing the database stops the purge after the current chunk. Chunks
+  /// which have already been processed are not rolled back.
+  ///
+  /// This is more drastic than deletion: It removes all traces of the
+  /// documents. The purge will **not** be replicated to other databases.
+  Stream<BulkDocumentProgress> purgeDocuments(
+    List<String> ids, {
+    int chunkSize = 1000,
+  });
+
+  /// Sets an [expiration] date for the [Document]s with the given [ids] in the
+  /// background.
+  ///
+  /// Passing `null` as the [expiration] removes the expiration date of the
+  /// documents.
+  ///
+  /// The operation is performed in the same way as [purgeDocuments].
+  Stream<BulkDocumentProgress> setDocumentsExpiration(
+    List<String> ids,
+    DateTime? expiration, {
+    int chunkSize = 1000,
+  });
+
   /// Gets the expiration date of a [Document] by its [id], if it exists.
   FutureOr<DateTime?> getDocumentExpiration(String id);
 
@@ -494,6 +561,9 @@ abstract interface class SyncCollection extends Collection {
   @override
   Document? document(String id);
 
+  @override
+  List<Document?> documents(List<String> ids);
+
   @override
   DocumentFragment operator [](String id);
 
@@ -506,6 +576,18 @@ abstract interface class SyncCollection extends Collection {
     ConcurrencyControl concurrencyControl = .lastWriteWins,
   ]);
 
+  @override
+  List<bool> saveDocuments(
+    List<MutableDocument> documents, [
+    ConcurrencyControl concurrencyControl = .lastWriteWins,
+  ]);
+
+  @override
+  List<bool> saveDocumentsWithConcurrencyControl(
+    List<MutableDocument> documents,
+    List<ConcurrencyControl> concurrencyControls,
+  );
+
   /// Saves a [document] to this database, resolving conflicts with a sync
   /// [conflictHandler].
   ///
@@ -589,6 +671,9 @@ abstract interface class AsyncCollection extends Collection {
   @override
   Future<Document?> document(String id);
 
+  @override
+  Future<List<Document?>> documents(List<String> ids);
+
   @override
   Future<DocumentFragment> operator [](String id);
 
@@ -601,6 +686,18 @@ abstract interface class AsyncCollection extends Collection {
     ConcurrencyControl concurrencyControl = .lastWriteWins,
   ]);
 
+  @override
+  Future<List<bool>> saveDocuments(
+    List<MutableDocument> documents, [
+    ConcurrencyControl concurrencyControl = .lastWriteWins,
+  ]);
+
+  @override
+  Future<List<bool>> saveDocumentsWithConcurrencyControl(
+    List<MutableDocument> documents,
+    List<ConcurrencyControl> concurrencyControls,
+  );
+
   @override
   Future<bool> saveDocumentWithConflictHandler(
     MutableDocument document,
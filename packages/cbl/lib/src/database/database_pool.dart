@@ -0,0 +1,58 @@
+import 'dart:math';
+
+import '../bindings.dart';
+import 'database.dart';
+
+/// A process wide pool of database handles, which are kept open for a while
+/// after a [Database] has been closed.
+///
+/// Opening a database is comparatively expensive. Applications which
+/// frequently close and reopen the same databases, for example a server which
+/// opens a database per tenant, can use the pool to make reopening a database
+/// nearly free. When a pooled database is closed, its handle is kept open in
+/// the pool. Opening a database with the same name and configuration then
+/// reuses the handle.
+///
+/// Handles are closed when they have been pooled for longer than their time to
+/// live, or when the pool is full, starting with the least recently closed
+/// handle. Deleting a database closes its pooled handles first.
+///
+/// Databases are pooled when they are closed while the pool is enabled. The
+/// pool is disabled by default.
+///
+/// {@category Database}
+abstract final class DatabasePool {
+  /// The default time to live of [configure].
+  static const defaultTimeToLive = Duration(minutes: 5);
+
+  /// Enables the pool and configures it to keep at most [capacity] database
+  /// handles open, each for at most [timeToLive].
+  ///
+  /// A [capacity] of 0 disables the pool and closes all pooled handles.
+  /// Handles which are already pooled keep the time to live they were pooled
+  /// with.
+  static void configure({
+    required int capacity,
+    Duration timeToLive = defaultTimeToLive,
+  }) {
+    if (capacity < 0) {
+      throw ArgumentError.value(capacity, 'capacity', 'must not be negative');
+    }
+    if (timeToLive <= Duration.zero) {
+      throw ArgumentError.value(timeToLive, 'timeToLive', 'must be positive');
+    }
+    DatabaseBindings.configurePool(
+      capacity: capacity,
+      timeToLiveMillis: max(timeToLive.inMilliseconds, 1),
+    );
+  }
+
+  /// Disables the pool and closes all pooled handles.
+  static void disable() => configure(capacity: 0);
+
+  /// The number of database handles which are currently kept open.
+  static int get size => DatabaseBindings.poolSize();
+
+  /// Closes all pooled database handles.
+  static void clear() => DatabaseBindings.clearPool();
+}
@@ -1,9 +1,12 @@
 import 'dart:async';
 import 'dart:ffi';
+import 'dart:typed_data';
 
 import '../bindings.dart';
 import '../document/blob.dart';
+import '../errors.dart';
 import '../fleece/containers.dart';
+import '../support/async_callback.dart';
 import '../support/native_object.dart';
 import '../support/resource.dart';
 import '../support/streams.dart';
@@ -84,8 +87,14 @@ final class FfiBlobStore implements BlobStore, SyncBlobStore {
       _getBlob(properties)?.content();
 
   @override
-  Stream<Data>? readBlob(Map<String, Object?> properties) =>
-      _getBlob(properties)?.let((it) => _BlobReadStream(database, it));
+  Stream<Data>? readBlob(
+    Map<String, Object?> properties, [
+    BlobReadOptions options = const BlobReadOptions(),
+  ]) => _getBlob(properties)?.let(
+    (it) => BlobBindings.length(it.pointer) >= options.minReadAheadLength
+        ? _BlobStreamerReadStream(database, it, options)
+        : _BlobReadStream(database, it),
+  );
 
   void _saveBlob(_FfiBlob blob) =>
       DatabaseBindings.saveBlob(database.pointer, blob.pointer);
@@ -104,21 +113,121 @@ Future<_FfiBlob> _createBlobFromStream(
   FfiDatabase database,
   Stream<Data> stream,
   String contentType,
-) async {
-  final writeStream = BlobWriteStreamBindings.create(database.pointer);
+) => _BlobStreamWriter(database, contentType).write(stream);
+
+/// Writes the content of a new blob on a native background thread, so that
+/// writing and hashing the content does not block the isolate.
+final class _BlobStreamWriter
+    with ClosableResourceMixin
+    implements Finalizable {
+  _BlobStreamWriter(this.database, this.contentType);
+
+  /// Size of the writes into which small chunks are coalesced.
+  static const _bufferSize = 256 * 1024;
+
+  /// Number of bytes which can be queued for writing, before the source
+  /// stream is paused.
+  static const _maxQueuedBytes = 4 * 1024 * 1024;
+
+  final FfiDatabase database;
+  final String contentType;
+
+  final _result = Completer<_FfiBlob>();
+  late final AsyncCallback _callback;
+  late final CBLDart_BlobWriteStreamer _streamer;
+  late final StreamSubscription<Data> _subscription;
+  var _queuedBytes = 0;
+  var _isPaused = false;
 
-  try {
-    await stream.forEach(
-      (data) => BlobWriteStreamBindings.write(writeStream, data),
+  Future<_FfiBlob> write(Stream<Data> stream) {
+    _callback = AsyncCallback(
+      _handleEvent,
+      debugName: 'FfiBlobStore.saveBlobFromStream',
     );
 
-    return _FfiBlob.fromPointer(
-      BlobWriteStreamBindings.createBlobWithStream(contentType, writeStream),
-      adopt: true,
+    try {
+      _streamer = BlobWriteStreamerBindings.start(
+        database.pointer,
+        bufferSize: _bufferSize,
+        callback: _callback.pointer,
+      );
+    } catch (e) {
+      _callback.close();
+      rethrow;
+    }
+    BlobWriteStreamerBindings.bindToDartObject(this, _streamer);
+
+    // Closing the database fails a blob which has not been finished yet,
+    // instead of waiting for the rest of the stream.
+    attachTo(database);
+
+    _subscription = stream.listen(
+      (data) {
+        BlobWriteStreamerBindings.write(_streamer, data);
+        _queuedBytes += data.size;
+        if (_queuedBytes > _maxQueuedBytes && !_isPaused) {
+          _isPaused = true;
+          _subscription.pause();
+        }
+      },
+      onError: _fail,
+      onDone: () => BlobWriteStreamerBindings.finish(_streamer, contentType),
+      cancelOnError: true,
     );
-  } catch (e) {
-    BlobWriteStreamBindings.close(writeStream);
-    rethrow;
+
+    return _result.future;
+  }
+
+  Object? _handleEvent(List<Object?> arguments) {
+    switch (CBLDartBlobWriteStreamerEvent.fromValue(arguments[0]! as int)) {
+      case CBLDartBlobWriteStreamerEvent.written:
+        _queuedBytes -= arguments[1]! as int;
+        if (_queuedBytes <= _maxQueuedBytes && _isPaused) {
+          _isPaused = false;
+          _subscription.resume();
+        }
+      case CBLDartBlobWriteStreamerEvent.done:
+        _callback.close();
+        _result.complete(
+          _FfiBlob.fromPointer(
+            Pointer.fromAddress(arguments[1]! as int),
+            adopt: true,
+          ),
+        );
+        unawaited(close());
+      case CBLDartBlobWriteStreamerEvent.error:
+        try {
+          BlobWriteStreamerBindings.throwStreamerError(_streamer);
+          // ignore: avoid_catches_without_on_clauses
+        } catch (error, stackTrace) {
+          _fail(error, stackTrace);
+        }
+    }
+    return null;
+  }
+
+  @override
+  void performClose() {
+    if (!_result.isCompleted) {
+      _fail(
+        DatabaseException(
+          'The database was closed while writing the blob.',
+          DatabaseErrorCode.notOpen,
+        ),
+        StackTrace.current,
+      );
+    }
+  }
+
+  void _fail(Object error, StackTrace stackTrace) {
+    // Closing the callback also stops the streamer, which discards the
+    // content that has been written so far.
+    _callback.close();
+    unawaited(_subscription.cancel());
+    if (!_result.isCompleted) {
+      _result.completeError(error, stackTrace);
+    }
+    unawaited(close());
   }
 }
 
@@ -151,18 +260,24 @@ final class _BlobReadStream extends Stream<Data> implements Finalizable {
       _isPaused = false;
 
       while (!_isPaused) {
-        final buffer = BlobReadStreamBindings.read(
-          pointer,
-          _readStreamChunkSize,
-        );
+        // Chunks are read directly into the list which is emitted, because the
+        // listener takes ownership of each chunk.
+        final buffer = Uint8List(_readStreamChunkSize);
+        final bytesRead = BlobReadStreamBindings.readInto(pointer, buffer);
 
         // The read stream is done (EOF).
-        if (buffer == null) {
+        if (bytesRead == 0) {
           unawaited(_controller.close());
           break;
         }
 
-        _controller.add(buffer);
+        _controller.add(
+          Data.fromTypedList(
+            bytesRead == buffer.length
+                ? buffer
+                : Uint8List.sublistView(buffer, 0, bytesRead),
+          ),
+        );
       }
       // ignore: avoid_catches_without_on_clauses
     } catch (error, stackTrace) {
@@ -188,3 +303,113 @@ final class _BlobReadStream extends Stream<Data> implements Finalizable {
         cancelOnError: cancelOnError,
       );
 }
+
+/// A blob read stream which reads ahead on a native background thread, so
+/// that disk I/O does not block the isolate.
+final class _BlobStreamerReadStream extends Stream<Data>
+    implements Finalizable {
+  _BlobStreamerReadStream(this.database, this.blob, this.options);
+
+  final FfiDatabase database;
+  final _FfiBlob blob;
+  final BlobReadOptions options;
+
+  late final _controller = StreamController<Data>(
+    onListen: _start,
+    onResume: _resume,
+    onCancel: _stop,
+  );
+
+  late final AsyncCallback _callback;
+  late final CBLDart_BlobReadStreamer _streamer;
+
+  /// Number of chunks which have been emitted while the stream was paused and
+  /// have not been requested from the streamer again.
+  var _unrequestedChunks = 0;
+
+  void _start() {
+    _callback = AsyncCallback(
+      _handleEvent,
+      debugName: 'FfiBlobStore.readBlob',
+    );
+    try {
+      _streamer = BlobReadStreamerBindings.start(
+        database.pointer,
+        blob.pointer,
+        chunkSize: options.readAheadChunkSize,
+        queueDepth: options.readAheadChunks,
+        callback: _callback.pointer,
+      );
+      // ignore: avoid_catches_without_on_clauses
+    } catch (error, stackTrace) {
+      _controller.addError(error, stackTrace);
+      _callback.close();
+      unawaited(_controller.close());
+      return;
+    }
+    BlobReadStreamerBindings.bindToDartObject(this, _streamer);
+  }
+
+  Object? _handleEvent(List<Object?> arguments) {
+    switch (CBLDartBlobReadStreamerEvent.fromValue(arguments[0]! as int)) {
+      case CBLDartBlobReadStreamerEvent.chunk:
+        // The chunk is exposed as a slice result, so that it can be sent to
+        // another isolate or passed to native code without copying it.
+        final chunk = arguments[1]! as Uint8List;
+        _controller.add(
+          Data.fromSliceResultView(
+            SliceResult.retainByBufAddress(arguments[2]! as int, chunk.length),
+          ),
+        );
+
+        // Only allow the streamer to read more chunks once the listener has
+        // consumed the ones it has already received.
+        if (_controller.isPaused) {
+          _unrequestedChunks++;
+        } else {
+          BlobReadStreamerBindings.request(_streamer, 1);
+        }
+      case CBLDartBlobReadStreamerEvent.done:
+        _close();
+      case CBLDartBlobReadStreamerEvent.error:
+        try {
+          BlobReadStreamerBindings.throwStreamerError(_streamer);
+          // ignore: avoid_catches_without_on_clauses
+        } catch (error, stackTrace) {
+          _controller.addError(error, stackTrace);
+        }
+        _close();
+    }
+    return null;
+  }
+
+  void _resume() {
+    if (_unrequestedChunks > 0) {
+      BlobReadStreamerBindings.request(_streamer, _unrequestedChunks);
+      _unrequestedChunks = 0;
+    }
+  }
+
+  // Closing the callback also stops the streamer.
+  void _stop() => _callback.close();
+
+  void _close() {
+    _stop();
+    unawaited(_controller.close());
+  }
+
+  @override
+  StreamSubscription<Data> listen(
+    void Function(Data event)? onData, {
+    Function? onError,
+    void Function()? onDone,
+    bool? cancelOnError,
+  }) => _controller.stream
+      .transform(ResourceStreamTransformer(parent: database, blocking: true))
+      .listen(
+        onData,
+        onError: onError,
+        onDone: onDone,
+        cancelOnError: cancelOnError,
+      );
+}
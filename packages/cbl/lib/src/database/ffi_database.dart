@@ -9,9 +9,11 @@ import '../document/blob.dart';
 import '../document/document.dart';
 import '../document/ffi_document.dart';
 import '../document/fragment.dart';
+import '../errors.dart';
 import '../fleece/containers.dart' as fl;
 import '../fleece/decoder.dart';
 import '../fleece/dict_key.dart';
+import '../fleece/encoder.dart';
 import '../query.dart';
 import '../query/ffi_query.dart';
 import '../query/index/ffi_query_index.dart';
@@ -28,6 +30,7 @@ import '../tracing.dart';
 import '../typed_data.dart';
 import '../typed_data/adapter.dart';
 import 'blob_store.dart';
+import 'bulk_document_progress.dart';
 import 'collection.dart';
 import 'collection_change.dart';
 import 'database.dart';
@@ -221,7 +224,7 @@ final class FfiDatabase
     if (_deleteOnClose) {
       DatabaseBindings.delete(pointer);
     } else {
-      DatabaseBindings.close(pointer);
+      DatabaseBindings.closeAndRelease(this, pointer);
     }
   }
 
@@ -353,6 +356,82 @@ final class FfiCollection
     }),
   );
 
+  @override
+  List<Document?> documents(List<String> ids) => useSync(() {
+    final batch = fl.Doc.fromResultData(
+      CollectionBindings.getDocuments(pointer, ids),
+      FLTrust.trusted,
+    );
+    final results = batch.root.asArray!;
+
+    return [
+      for (var i = 0; i < ids.length; i++)
+        if (results[i].asArray case final result?)
+          DelegateDocument(
+            FfiDocumentDelegate.fromSnapshot(_documentSnapshot(ids[i], result)),
+            collection: this,
+          )
+        else
+          null,
+    ];
+  });
+
+  FfiDocumentSnapshot _documentSnapshot(String id, fl.Array result) {
+    final revisionId = result[0].asString;
+    final properties = result[3].asDict!;
+
+    return FfiDocumentSnapshot(
+      id: id,
+      revisionId: revisionId,
+      sequence: result[1].asInt,
+      timestamp: result[2].asInt,
+      properties: properties,
+      load: () {
+        final document = CollectionBindings.getDocument(pointer, id);
+        if (document != null &&
+            DocumentBindings.revisionId(document) == revisionId) {
+          return document;
+        }
+
+        // The document has changed since the snapshot was loaded. The native
+        // document is loaded at the current revision, or created if the
+        // document has been deleted, but with the properties of the snapshot.
+        // The delegate reports the revision of the snapshot as stale, so that
+        // saving or deleting with ConcurrencyControl.failOnConflict fails, as
+        // it would for the revision of the snapshot, while
+        // ConcurrencyControl.lastWriteWins overwrites the current revision.
+        final staleDocument = document != null
+            ? MutableDocumentBindings.mutableCopy(document)
+            : MutableDocumentBindings.createWithID(id);
+        if (document != null) {
+          BaseBindings.releaseRefCounted(document.cast());
+        }
+        MutableDocumentBindings.setProperties(
+          staleDocument,
+          fl.MutableDict.mutableCopy(properties).pointer.cast(),
+        );
+        return staleDocument;
+      },
+    );
+  }
+
+  /// Throws a conflict if [delegate] is stale and [concurrencyControl] does
+  /// not allow to overwrite the current revision.
+  ///
+  /// See [FfiDocumentDelegate.staleRevisionId].
+  static void _checkStaleRevision(
+    FfiDocumentDelegate delegate,
+    ConcurrencyControl concurrencyControl,
+  ) {
+    if (concurrencyControl == ConcurrencyControl.failOnConflict &&
+        delegate.staleRevisionId != null) {
+      throw DatabaseException(
+        'The document has been changed since it was loaded.',
+        DatabaseErrorCode.conflict,
+      );
+    }
+  }
+
   @override
   DocumentFragment operator [](String id) => DocumentFragmentImpl(document(id));
 
@@ -373,15 +452,97 @@ final class FfiCollection
           () => prepareDocument(document) as FfiDocumentDelegate,
         );
 
+        _checkStaleRevision(delegate, concurrencyControl);
         CollectionBindings.saveDocumentWithConcurrencyControl(
           pointer,
           delegate.pointer.cast(),
           concurrencyControl.toCBLConcurrencyControl(),
         );
+        delegate.clearStaleRevisionId();
       }),
     ),
   );
 
+  @override
+  List<bool> saveDocuments(
+    List<MutableDocument> documents, [
+    ConcurrencyControl concurrencyControl = .lastWriteWins,
+  ]) => saveDocumentsWithConcurrencyControl(
+    documents,
+    List.filled(documents.length, concurrencyControl),
+  );
+
+  @override
+  List<bool> saveDocumentsWithConcurrencyControl(
+    List<MutableDocument> documents,
+    List<ConcurrencyControl> concurrencyControls,
+  ) => useSync(() {
+    if (concurrencyControls.length != documents.length) {
+      throw ArgumentError.value(
+        concurrencyControls,
+        'concurrencyControls',
+        'must have the same length as documents',
+      );
+    }
+
+    // The native side saves the documents in the transaction of this
+    // database, which is also used to save external data, such as blobs.
+    return database.runInTransactionSync(() {
+      final delegateDocuments = documents.cast<MutableDelegateDocument>();
+      final delegates = [
+        for (final document in delegateDocuments)
+          prepareDocument(document, updateEncodedProperties: false)
+              as FfiDocumentDelegate,
+      ];
+
+      // Stale documents conflict with ConcurrencyControl.failOnConflict
+      // without being passed to the native side, which would not detect it.
+      final toSave = [
+        for (var i = 0; i < delegates.length; i++)
+          if (concurrencyControls[i] != ConcurrencyControl.failOnConflict ||
+              delegates[i].staleRevisionId == null)
+            i,
+      ];
+
+      // External data has to be saved before the shared encoder is used.
+      for (final i in toSave) {
+        delegateDocuments[i].saveExternalData();
+      }
+
+      final properties = FleeceEncoder.fleece.encodeWith((encoder) {
+        encoder.beginArray(toSave.length);
+        for (final i in toSave) {
+          delegateDocuments[i].encodePropertiesTo(encoder);
+        }
+        encoder.endArray();
+      });
+
+      final saved = toSave.isEmpty
+          ? const <bool>[]
+          : CollectionBindings.saveDocuments(
+              pointer,
+              [for (final i in toSave) delegates[i].pointer],
+              [
+                for (final i in toSave)
+                  concurrencyControls[i].toCBLConcurrencyControl(),
+              ],
+              properties,
+            );
+
+      final results = List.filled(documents.length, false);
+      for (var j = 0; j < toSave.length; j++) {
+        final delegate = delegates[toSave[j]];
+        delegate.invalidateEncodedProperties();
+        if (saved[j]) {
+          delegate.clearStaleRevisionId();
+          results[toSave[j]] = true;
+        }
+      }
+
+      return results;
+    });
+  });
+
   @override
   FutureOr<bool> saveDocumentWithConflictHandler(
     covariant MutableDelegateDocument document,
@@ -430,11 +591,19 @@ final class FfiCollection
                   as FfiDocumentDelegate,
         );
 
+        if (delegate.staleRevisionId != null) {
+          _checkStaleRevision(delegate, concurrencyControl);
+          if (DocumentBindings.revisionId(delegate.pointer) == null) {
+            // The document has been deleted since it was loaded.
+            return;
+          }
+        }
         CollectionBindings.deleteDocumentWithConcurrencyControl(
           pointer,
           delegate.pointer.cast(),
           concurrencyControl.toCBLConcurrencyControl(),
         );
+        delegate.clearStaleRevisionId();
       }),
     ),
   );
@@ -476,6 +645,34 @@ final class FfiCollection
   DateTime? getDocumentExpiration(String id) =>
       useSync(() => CollectionBindings.getDocumentExpiration(pointer, id));
 
+  @override
+  Stream<BulkDocumentProgress> purgeDocuments(
+    List<String> ids, {
+    int chunkSize = 1000,
+  }) => useSync(
+    () => _BulkDocumentStream(
+      this,
+      CBLDartBulkDocumentOperation.purge,
+      ids,
+      chunkSize: chunkSize,
+    ).transform(ResourceStreamTransformer(parent: this)),
+  );
+
+  @override
+  Stream<BulkDocumentProgress> setDocumentsExpiration(
+    List<String> ids,
+    DateTime? expiration, {
+    int chunkSize = 1000,
+  }) => useSync(
+    () => _BulkDocumentStream(
+      this,
+      CBLDartBulkDocumentOperation.setExpiration,
+      ids,
+      expiration: expiration,
+      chunkSize: chunkSize,
+    ).transform(ResourceStreamTransformer(parent: this)),
+  );
+
   @override
   List<String> get indexes => useSync(
     () => fl.Array.fromPointer(
@@ -583,6 +780,114 @@ final class FfiCollection
       FfiDocumentDelegate.create(oldDelegate.id);
 }
 
+/// Purges documents or sets their expiration on a native background thread.
+///
+/// The worker is started when the stream is listened to and stopped when the
+/// subscription is canceled.
+final class _BulkDocumentStream extends Stream<BulkDocumentProgress>
+    implements Finalizable {
+  _BulkDocumentStream(
+    this.collection,
+    this.operation,
+    this.ids, {
+    this.expiration,
+    required this.chunkSize,
+  });
+
+  final FfiCollection collection;
+  final CBLDartBulkDocumentOperation operation;
+  final List<String> ids;
+  final DateTime? expiration;
+  final int chunkSize;
+
+  late final _controller = StreamController<BulkDocumentProgress>(
+    onListen: _start,
+    onCancel: _stop,
+  );
+  AsyncCallback? _callback;
+  late final CBLDart_BulkDocumentWorker _worker;
+
+  void _start() {
+    if (ids.isEmpty) {
+      _controller
+        ..add(const BulkDocumentProgress(processed: 0, affected: 0, total: 0))
+        ..close();
+      return;
+    }
+
+    final callback = _callback = AsyncCallback(
+      _handleEvent,
+      debugName: 'FfiCollection.bulkDocumentWorker',
+    );
+
+    try {
+      _worker = BulkDocumentWorkerBindings.start(
+        collection.pointer,
+        operation,
+        ids: FleeceEncoder.fleece.convertDartObject(ids),
+        expiration: expiration,
+        chunkSize: chunkSize,
+        callback: callback.pointer,
+      );
+      // ignore: avoid_catches_without_on_clauses
+    } catch (error, stackTrace) {
+      _fail(error, stackTrace);
+      return;
+    }
+    BulkDocumentWorkerBindings.bindToDartObject(this, _worker);
+  }
+
+  void _stop() {
+    // Closing the callback also stops the worker.
+    _callback?.close();
+  }
+
+  Object? _handleEvent(List<Object?> arguments) {
+    switch (CBLDartBulkDocumentWorkerEvent.fromValue(arguments[0]! as int)) {
+      case CBLDartBulkDocumentWorkerEvent.progress:
+        _controller.add(_progress(arguments));
+      case CBLDartBulkDocumentWorkerEvent.done:
+        _stop();
+        _controller.close();
+      case CBLDartBulkDocumentWorkerEvent.error:
+        try {
+          BulkDocumentWorkerBindings.throwWorkerError(_worker);
+          // ignore: avoid_catches_without_on_clauses
+        } catch (error, stackTrace) {
+          _fail(error, stackTrace);
+        }
+    }
+    return null;
+  }
+
+  BulkDocumentProgress _progress(List<Object?> arguments) =>
+      BulkDocumentProgress(
+        processed: arguments[1]! as int,
+        affected: arguments[2]! as int,
+        total: ids.length,
+      );
+
+  void _fail(Object error, StackTrace stackTrace) {
+    _stop();
+    _controller
+      ..addError(error, stackTrace)
+      ..close();
+  }
+
+  @override
+  StreamSubscription<BulkDocumentProgress> listen(
+    void Function(BulkDocumentProgress event)? onData, {
+    Function? onError,
+    void Function()? onDone,
+    bool? cancelOnError,
+  }) => _controller.stream.listen(
+    onData,
+    onError: onError,
+    onDone: onDone,
+    cancelOnError: cancelOnError,
+  );
+}
+
 extension on MaintenanceType {
   CBLMaintenanceType toCBLMaintenanceType() => CBLMaintenanceType.values[index];
 }
@@ -0,0 +1,137 @@
+import '../bindings.dart';
+import 'database.dart';
+import 'ffi_database.dart';
+
+/// When and what kind of maintenance the [MaintenanceScheduler] performs for a
+/// database.
+///
+/// {@category Database}
+final class MaintenanceSchedule {
+  /// Creates a schedule which performs maintenance of the given [type] after
+  /// [writeThreshold] documents have been written, or after no documents have
+  /// been written for [idleDelay].
+  ///
+  /// Passing `null` disables the respective trigger, but at least one of them
+  /// must be enabled.
+  const MaintenanceSchedule({
+    this.type = MaintenanceType.compact,
+    this.writeThreshold = defaultWriteThreshold,
+    this.idleDelay = defaultIdleDelay,
+  });
+
+  /// The default of [writeThreshold].
+  static const defaultWriteThreshold = 10000;
+
+  /// The default of [idleDelay].
+  static const defaultIdleDelay = Duration(minutes: 1);
+
+  /// The type of maintenance to perform.
+  final MaintenanceType type;
+
+  /// The number of documents which have to be written since maintenance was
+  /// last performed, for it to be performed again.
+  final int? writeThreshold;
+
+  /// The time after the last write without further writes, after which
+  /// maintenance is performed.
+  final Duration? idleDelay;
+
+  @override
+  bool operator ==(Object other) =>
+      identical(this, other) ||
+      other is MaintenanceSchedule &&
+          type == other.type &&
+          writeThreshold == other.writeThreshold &&
+          idleDelay == other.idleDelay;
+
+  @override
+  int get hashCode => Object.hash(type, writeThreshold, idleDelay);
+
+  @override
+  String toString() => [
+    'MaintenanceSchedule(',
+    [
+      'type: ${type.name}',
+      if (writeThreshold != null) 'writeThreshold: $writeThreshold',
+      if (idleDelay != null) 'idleDelay: $idleDelay',
+    ].join(', '),
+    ')',
+  ].join();
+}
+
+/// Performs database maintenance in the background, so that databases do not
+/// degrade until [Database.performMaintenance] is called explicitly.
+///
+/// The scheduler counts the documents which are written to a scheduled
+/// database, including documents written by replicators, and performs
+/// maintenance on a background thread according to the database's
+/// [MaintenanceSchedule]. Maintenance does not run concurrently with closing
+/// the database. Closing the database unschedules it.
+///
+/// Only writes to collections which exist when a database is first scheduled
+/// are counted.
+///
+/// {@category Database}
+abstract final class MaintenanceScheduler {
+  /// Schedules maintenance for [database] according to [schedule], replacing
+  /// the current schedule of the database, if any.
+  static void schedule(
+    SyncDatabase database, [
+    MaintenanceSchedule schedule = const MaintenanceSchedule(),
+  ]) {
+    final writeThreshold = schedule.writeThreshold;
+    final idleDelay = schedule.idleDelay;
+    if (writeThreshold == null && idleDelay == null) {
+      throw ArgumentError.value(
+        schedule,
+        'schedule',
+        'must have a writeThreshold or an idleDelay',
+      );
+    }
+    if (writeThreshold != null && writeThreshold <= 0) {
+      throw ArgumentError.value(
+        writeThreshold,
+        'schedule.writeThreshold',
+        'must be positive',
+      );
+    }
+    if (idleDelay != null && idleDelay < const Duration(milliseconds: 1)) {
+      throw ArgumentError.value(
+        idleDelay,
+        'schedule.idleDelay',
+        'must be at least one millisecond',
+      );
+    }
+
+    final ffiDatabase = database as FfiDatabase;
+    ffiDatabase.useSync(() {
+      DatabaseBindings.scheduleMaintenance(
+        ffiDatabase.pointer,
+        CBLMaintenanceType.values[schedule.type.index],
+        writeThreshold: writeThreshold ?? 0,
+        idleMillis: idleDelay?.inMilliseconds ?? 0,
+      );
+    });
+  }
+
+  /// Stops performing maintenance for [database] in the background.
+  static void unschedule(SyncDatabase database) {
+    final ffiDatabase = database as FfiDatabase;
+    ffiDatabase.useSync(() {
+      DatabaseBindings.unscheduleMaintenance(ffiDatabase.pointer);
+    });
+  }
+
+  /// The number of documents which have been written to [database] since
+  /// maintenance was last performed, or `null` if the database is not
+  /// scheduled.
+  static int? pendingWrites(SyncDatabase database) {
+    final ffiDatabase = database as FfiDatabase;
+    return ffiDatabase.useSync(() {
+      final writes = DatabaseBindings.pendingMaintenanceWrites(
+        ffiDatabase.pointer,
+      );
+      return writes < 0 ? null : writes;
+    });
+  }
+}
@@ -1,4 +1,5 @@
 import '../bindings.dart';
+import '../document/blob.dart';
 import '../service/cbl_service_api.dart';
 import 'blob_store.dart';
 import 'proxy_database.dart';
@@ -13,8 +14,17 @@ final class ProxyBlobStore implements BlobStore {
       .call(BlobExists(databaseId: database.objectId, properties: properties));
 
   @override
-  Stream<Data>? readBlob(Map<String, Object?> properties) => database.channel
-      .stream(ReadBlob(databaseId: database.objectId, properties: properties))
+  Stream<Data>? readBlob(
+    Map<String, Object?> properties, [
+    BlobReadOptions options = const BlobReadOptions(),
+  ]) => database.channel
+      .stream(
+        ReadBlob(
+          databaseId: database.objectId,
+          properties: properties,
+          options: options,
+        ),
+      )
       .map((event) => event.data);
 
   @override
@@ -31,6 +31,7 @@ import '../tracing.dart';
 import '../typed_data.dart';
 import '../typed_data/adapter.dart';
 import 'blob_store.dart';
+import 'bulk_document_progress.dart';
 import 'collection.dart';
 import 'collection_change.dart';
 import 'database.dart';
@@ -434,6 +435,22 @@ final class ProxyCollection extends ProxyObject
     }),
   );
 
+  @override
+  Future<List<Document?>> documents(List<String> ids) => use(() async {
+    final states = await channel.call(GetDocuments(objectId, ids));
+
+    return [
+      for (final state in states.states)
+        if (state != null)
+          DelegateDocument(
+            ProxyDocumentDelegate.fromState(state, database: database),
+            collection: this,
+          )
+        else
+          null,
+    ];
+  });
+
   @override
   Future<DocumentFragment> operator [](String id) async =>
       DocumentFragmentImpl(await document(id));
@@ -472,6 +489,50 @@ final class ProxyCollection extends ProxyObject
     ),
   );
 
+  @override
+  Future<List<bool>> saveDocuments(
+    List<MutableDocument> documents, [
+    ConcurrencyControl concurrencyControl = .lastWriteWins,
+  ]) => saveDocumentsWithConcurrencyControl(
+    documents,
+    List.filled(documents.length, concurrencyControl),
+  );
+
+  @override
+  Future<List<bool>> saveDocumentsWithConcurrencyControl(
+    List<MutableDocument> documents,
+    List<ConcurrencyControl> concurrencyControls,
+  ) => use(() {
+    if (concurrencyControls.length != documents.length) {
+      throw ArgumentError.value(
+        concurrencyControls,
+        'concurrencyControls',
+        'must have the same length as documents',
+      );
+    }
+
+    return database.runInTransactionAsync(() async {
+      final delegates = [
+        for (final document in documents.cast<MutableDelegateDocument>())
+          await prepareDocument(document),
+      ];
+
+      final states = await channel.call(
+        SaveDocuments(objectId, [
+          for (final delegate in delegates) delegate.getState(),
+        ], concurrencyControls),
+      );
+
+      for (var i = 0; i < delegates.length; i++) {
+        if (states[i] case final state?) {
+          delegates[i].updateMetadata(state, database: database);
+        }
+      }
+
+      return [for (final state in states) state != null];
+    });
+  });
+
   @override
   Future<bool> saveDocumentWithConflictHandler(
     covariant MutableDelegateDocument document,
@@ -568,6 +629,40 @@ final class ProxyCollection extends ProxyObject
     ),
   );
 
+  @override
+  Stream<BulkDocumentProgress> purgeDocuments(
+    List<String> ids, {
+    int chunkSize = 1000,
+  }) => useSync(
+    () => channel
+        .stream(
+          PurgeDocuments(
+            collectionId: objectId,
+            documentIds: ids,
+            chunkSize: chunkSize,
+          ),
+        )
+        .transform(ResourceStreamTransformer(parent: this)),
+  );
+
+  @override
+  Stream<BulkDocumentProgress> setDocumentsExpiration(
+    List<String> ids,
+    DateTime? expiration, {
+    int chunkSize = 1000,
+  }) => useSync(
+    () => channel
+        .stream(
+          SetDocumentsExpiration(
+            collectionId: objectId,
+            documentIds: ids,
+            expiration: expiration,
+            chunkSize: chunkSize,
+          ),
+        )
+        .transform(ResourceStreamTransformer(parent: this)),
+  );
+
   @override
   Future<DateTime?> getDocumentExpiration(String id) => use(
     () => channel.call(
@@ -1,6 +1,6 @@
 export 'document/array.dart'
     show Array, ArrayInterface, MutableArray, MutableArrayInterface;
-export 'document/blob.dart' show Blob;
+export 'document/blob.dart' show Blob, BlobReadOptions;
 export 'document/dictionary.dart'
     show
         Dictionary,
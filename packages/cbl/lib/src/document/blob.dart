@@ -62,7 +62,12 @@ abstract final class Blob {
   Future<Uint8List> content();
 
   /// A stream of the content of this [Blob].
-  Stream<Uint8List> contentStream();
+  ///
+  /// The [options] control how the content of a [Blob] which is stored in a
+  /// database is read.
+  Stream<Uint8List> contentStream({
+    BlobReadOptions options = const BlobReadOptions(),
+  });
 
   /// The type of content this [Blob] represents.
   ///
@@ -119,6 +124,88 @@ abstract final class Blob {
   }
 }
 
+/// Options for reading the content of a [Blob] with [Blob.contentStream].
+///
+/// The content of large blobs is read ahead on a background thread, so that
+/// disk I/O does not block the isolate which consumes the stream.
+///
+/// {@category Document}
+final class BlobReadOptions {
+  /// Creates options for reading the content of a [Blob].
+  const BlobReadOptions({
+    this.readAheadChunkSize = defaultReadAheadChunkSize,
+    this.readAheadChunks = defaultReadAheadChunks,
+    this.minReadAheadLength = defaultMinReadAheadLength,
+  });
+
+  /// The default of [readAheadChunkSize].
+  static const defaultReadAheadChunkSize = 64 * 1024;
+
+  /// The default of [readAheadChunks].
+  static const defaultReadAheadChunks = 4;
+
+  /// The default of [minReadAheadLength].
+  static const defaultMinReadAheadLength = 8 * defaultReadAheadChunkSize;
+
+  /// The size in bytes of the chunks which are read ahead.
+  final int readAheadChunkSize;
+
+  /// The number of chunks which are read ahead of the listener of the stream.
+  final int readAheadChunks;
+
+  /// The minimum length in bytes of a blob, for which its content is read
+  /// ahead.
+  ///
+  /// Below this length, the cost of starting to read ahead outweighs its
+  /// benefits and the content is read on the isolate which consumes the
+  /// stream.
+  final int minReadAheadLength;
+
+  void _validate() {
+    if (readAheadChunkSize <= 0) {
+      throw ArgumentError.value(
+        readAheadChunkSize,
+        'options.readAheadChunkSize',
+        'must be positive',
+      );
+    }
+    if (readAheadChunks <= 0) {
+      throw ArgumentError.value(
+        readAheadChunks,
+        'options.readAheadChunks',
+        'must be positive',
+      );
+    }
+    if (minReadAheadLength < 0) {
+      throw ArgumentError.value(
+        minReadAheadLength,
+        'options.minReadAheadLength',
+        'must not be negative',
+      );
+    }
+  }
+
+  @override
+  bool operator ==(Object other) =>
+      identical(this, other) ||
+      other is BlobReadOptions &&
+          readAheadChunkSize == other.readAheadChunkSize &&
+          readAheadChunks == other.readAheadChunks &&
+          minReadAheadLength == other.minReadAheadLength;
+
+  @override
+  int get hashCode =>
+      Object.hash(readAheadChunkSize, readAheadChunks, minReadAheadLength);
+
+  @override
+  String toString() =>
+      'BlobReadOptions('
+      'readAheadChunkSize: $readAheadChunkSize, '
+      'readAheadChunks: $readAheadChunks, '
+      'minReadAheadLength: $minReadAheadLength'
+      ')';
+}
+
 // The semantics of a Blob are that it is immutable but the implementation is
 // not.
 final class BlobImpl implements Blob, FleeceEncodable, CblConversions {
@@ -176,7 +263,11 @@ final class BlobImpl implements Blob, FleeceEncodable, CblConversions {
   Future<Uint8List> content() => byteStreamToFuture(contentStream());
 
   @override
-  Stream<Uint8List> contentStream() {
+  Stream<Uint8List> contentStream({
+    BlobReadOptions options = const BlobReadOptions(),
+  }) {
+    options._validate();
+
     final content = _content;
     if (content != null) {
       return Stream.value(content);
@@ -192,7 +283,7 @@ final class BlobImpl implements Blob, FleeceEncodable, CblConversions {
 
     if (_digest != null && _blobStore != null) {
       final stream = _blobStore!
-          .readBlob(_blobProperties())
+          .readBlob(_blobProperties(), options)
           ?.map((data) => data.toTypedList());
       if (stream == null) {
         _throwNotFoundError();
@@ -229,21 +229,28 @@ final class DelegateDocument with IterableMixin<String> implements Document {
   }
 
   FutureOr<Data> encodeProperties({bool saveExternalData = false}) {
-    final externalDataSaved = saveExternalData
-        ? _root.saveExternalData(database!)
-        : null;
+    final externalDataSaved = saveExternalData ? this.saveExternalData() : null;
 
     return externalDataSaved.then(
-      (_) => FleeceEncoder.fleece.encodeWith((encoder) {
-        encoder.extraInfo = FleeceEncoderContext(
-          database: database,
-          encodeUnsavedBlobWithData: true,
-        );
-        _root.encodeTo(encoder);
-      }),
+      (_) => FleeceEncoder.fleece.encodeWith(encodePropertiesTo),
     );
   }
 
+  /// Saves the external data, such as blobs, of the properties.
+  FutureOr<void> saveExternalData() => _root.saveExternalData(database!);
+
+  /// Writes the properties to [encoder], which allows encoding the properties
+  /// of multiple documents with one encoder.
+  ///
+  /// The external data of the properties must have been saved before.
+  void encodePropertiesTo(FleeceEncoder encoder) {
+    encoder.extraInfo = FleeceEncoderContext(
+      database: database,
+      encodeUnsavedBlobWithData: true,
+    );
+    _root.encodeTo(encoder);
+  }
+
   FutureOr<void> updateEncodedProperties() => encodeProperties(
     saveExternalData: true,
   ).then((properties) => delegate.encodedProperties = properties);
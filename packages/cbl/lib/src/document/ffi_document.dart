@@ -9,10 +9,23 @@ import '../support/native_object.dart';
 import 'document.dart';
 
 final class FfiDocumentDelegate implements DocumentDelegate, Finalizable {
-  FfiDocumentDelegate.fromPointer(this.pointer, {bool adopt = false}) {
-    bindCBLRefCountedToDartObject(this, pointer: pointer, adopt: adopt);
+  FfiDocumentDelegate.fromPointer(
+    Pointer<CBLDocument> pointer, {
+    bool adopt = false,
+    String? staleRevisionId,
+  }) : _snapshot = null,
+       _staleRevisionId = staleRevisionId {
+    _bindPointer(pointer, adopt: adopt);
   }
 
+  /// Creates a delegate for a document which has been loaded together with
+  /// other documents, through [CollectionBindings.getDocuments].
+  ///
+  /// The native document is only loaded when it is needed, for example to
+  /// create a mutable copy of the document.
+  FfiDocumentDelegate.fromSnapshot(FfiDocumentSnapshot this._snapshot)
+    : _staleRevisionId = null;
+
   FfiDocumentDelegate.create([String? id])
     : this.fromPointer(
         MutableDocumentBindings.createWithID(id).cast(),
@@ -23,21 +36,53 @@ final class FfiDocumentDelegate implements DocumentDelegate, Finalizable {
       FfiDocumentDelegate.fromPointer(
         MutableDocumentBindings.mutableCopy(delegate.pointer).cast(),
         adopt: true,
+        staleRevisionId: delegate.staleRevisionId,
       );
 
-  final Pointer<CBLDocument> pointer;
+  final FfiDocumentSnapshot? _snapshot;
+
+  /// The revision of this document, if the native document has been loaded
+  /// at a newer revision.
+  ///
+  /// This is the case when a document which has been loaded through
+  /// [CollectionBindings.getDocuments] has changed before its native document
+  /// was loaded. The native document then has the newer revision, but the
+  /// properties of the older one. Saving or deleting the document with
+  /// `ConcurrencyControl.failOnConflict` has to fail, as it would for the
+  /// older revision.
+  String? get staleRevisionId {
+    if (_snapshot case final snapshot?) {
+      return DocumentBindings.revisionId(pointer) != snapshot.revisionId
+          ? snapshot.revisionId
+          : null;
+    }
+    return _staleRevisionId;
+  }
+
+  String? _staleRevisionId;
+
+  /// Must be called after the native document has been saved or deleted, at
+  /// which point it is no longer stale.
+  void clearStaleRevisionId() => _staleRevisionId = null;
+
+  Pointer<CBLDocument> get pointer =>
+      _pointer ?? _bindPointer(_snapshot!.load(), adopt: true);
+  Pointer<CBLDocument>? _pointer;
 
   @override
-  String get id => DocumentBindings.id(pointer);
+  String get id => _snapshot?.id ?? DocumentBindings.id(pointer);
 
   @override
-  String? get revisionId => DocumentBindings.revisionId(pointer);
+  String? get revisionId => _snapshot != null
+      ? _snapshot.revisionId
+      : _staleRevisionId ?? DocumentBindings.revisionId(pointer);
 
   @override
-  int get sequence => DocumentBindings.sequence(pointer);
+  int get sequence => _snapshot?.sequence ?? DocumentBindings.sequence(pointer);
 
   @override
-  int get timestamp => DocumentBindings.timestamp(pointer);
+  int get timestamp =>
+      _snapshot?.timestamp ?? DocumentBindings.timestamp(pointer);
 
   @override
   Data? get encodedProperties =>
@@ -45,29 +90,39 @@ final class FfiDocumentDelegate implements DocumentDelegate, Finalizable {
   Data? _encodedProperties;
 
   fl.Dict get propertiesDict =>
+      _snapshot?.properties ??
       fl.Dict.fromPointer(DocumentBindings.properties(pointer));
 
+  FLDict get _propertiesPointer =>
+      _snapshot?.properties.pointer.cast() ??
+      DocumentBindings.properties(pointer);
+
   @override
   set encodedProperties(Data? value) {
     _writeEncodedProperties(value!);
     _encodedProperties = value;
   }
 
+  /// Must be called after the properties of the native document have been
+  /// set without going through [encodedProperties].
+  void invalidateEncodedProperties() => _encodedProperties = null;
+
   @override
   MRoot createMRoot(DelegateDocument document, {required bool isMutable}) =>
       MRoot.fromContext(
         DocumentMContext(
           document,
-          data: Value.fromPointer(DocumentBindings.properties(pointer).cast()),
+          data: Value.fromPointer(_propertiesPointer.cast()),
         ),
         isMutable: isMutable,
       );
 
   Data _readEncodedProperties() => FleeceEncoder.fleece.encodeWith((encoder) {
-    encoder.writeValue(DocumentBindings.properties(pointer).cast());
+    encoder.writeValue(_propertiesPointer.cast());
   });
 
   void _writeEncodedProperties(Data value) {
+    assert(_snapshot == null, 'a document snapshot is immutable');
     final doc = fl.Doc.fromResultData(value, FLTrust.trusted);
     final dict = fl.MutableDict.mutableCopy(doc.root.asDict!);
     MutableDocumentBindings.setProperties(pointer.cast(), dict.pointer.cast());
@@ -75,4 +130,36 @@ final class FfiDocumentDelegate implements DocumentDelegate, Finalizable {
 
   @override
   DocumentDelegate toMutable() => FfiDocumentDelegate.mutableCopy(this);
+
+  Pointer<CBLDocument> _bindPointer(
+    Pointer<CBLDocument> pointer, {
+    required bool adopt,
+  }) {
+    bindCBLRefCountedToDartObject(this, pointer: pointer, adopt: adopt);
+    return _pointer = pointer;
+  }
+}
+
+/// The state of a document, as loaded by [CollectionBindings.getDocuments].
+final class FfiDocumentSnapshot {
+  FfiDocumentSnapshot({
+    required this.id,
+    required this.revisionId,
+    required this.sequence,
+    required this.timestamp,
+    required this.properties,
+    required this.load,
+  });
+
+  final String id;
+  final String? revisionId;
+  final int sequence;
+  final int timestamp;
+
+  /// The properties of the document, which keep the encoded documents they
+  /// have been loaded with alive.
+  final fl.Dict properties;
+
+  /// Loads the native document, when it is needed.
+  final Pointer<CBLDocument> Function() load;
 }
@@ -1,3 +1,10 @@
+export 'log/binary_log_reader.dart'
+    show
+        BinaryLogDroppedRecords,
+        BinaryLogEntry,
+        BinaryLogReader,
+        BinaryLogRecord;
+export 'log/binary_logger.dart' show BinaryLogConfiguration, BinaryLogger;
 export 'log/console_logger.dart' show ConsoleLogger;
 export 'log/file_logger.dart' show FileLogger, LogFileConfiguration;
 export 'log/log.dart' show Log;
@@ -0,0 +1,261 @@
+import 'dart:convert';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:meta/meta.dart';
+
+import 'binary_logger.dart';
+import 'logger.dart';
+
+/// An entry of a binary log, which has been written by the [BinaryLogger].
+///
+/// {@category Logging}
+@immutable
+sealed class BinaryLogEntry {
+  const BinaryLogEntry();
+
+  /// Returns a JSON representation of this entry.
+  Map<String, Object?> toJson();
+}
+
+/// A log message, which has been read from a binary log.
+///
+/// {@category Logging}
+final class BinaryLogRecord extends BinaryLogEntry {
+  /// Creates a log message, which has been read from a binary log.
+  const BinaryLogRecord({
+    required this.timestamp,
+    required this.threadId,
+    required this.domain,
+    required this.level,
+    required this.message,
+  });
+
+  /// The time at which the message was logged.
+  final DateTime timestamp;
+
+  /// The id of the thread which logged the message.
+  ///
+  /// Ids are assigned in the order in which threads first log and are only
+  /// unique within a process.
+  final int threadId;
+
+  /// The sub system which emitted this message.
+  final LogDomain domain;
+
+  /// The importance of this message.
+  final LogLevel level;
+
+  /// The log message.
+  final String message;
+
+  @override
+  Map<String, Object?> toJson() => {
+    'timestamp': timestamp.toUtc().toIso8601String(),
+    'threadId': threadId,
+    'domain': domain.name,
+    'level': level.name,
+    'message': message,
+  };
+
+  @override
+  bool operator ==(Object other) =>
+      identical(this, other) ||
+      other is BinaryLogRecord &&
+          runtimeType == other.runtimeType &&
+          timestamp == other.timestamp &&
+          threadId == other.threadId &&
+          domain == other.domain &&
+          level == other.level &&
+          message == other.message;
+
+  @override
+  int get hashCode =>
+      timestamp.hashCode ^
+      threadId.hashCode ^
+      domain.hashCode ^
+      level.hashCode ^
+      message.hashCode;
+
+  @override
+  String toString() =>
+      'BinaryLogRecord(timestamp: $timestamp, threadId: $threadId, '
+      'domain: ${domain.name}, level: ${level.name}, message: $message)';
+}
+
+/// Marks a position in a binary log, at which messages have been dropped
+/// because they were logged faster than they could be written.
+///
+/// {@category Logging}
+final class BinaryLogDroppedRecords extends BinaryLogEntry {
+  /// Creates a marker for dropped messages.
+  const BinaryLogDroppedRecords(this.count);
+
+  /// The number of messages which have been dropped.
+  final int count;
+
+  @override
+  Map<String, Object?> toJson() => {'dropped': count};
+
+  @override
+  bool operator ==(Object other) =>
+      identical(this, other) ||
+      other is BinaryLogDroppedRecords &&
+          runtimeType == other.runtimeType &&
+          count == other.count;
+
+  @override
+  int get hashCode => count.hashCode;
+
+  @override
+  String toString() => 'BinaryLogDroppedRecords($count)';
+}
+
+/// Reads the log segments which have been written by the [BinaryLogger].
+///
+/// {@category Logging}
+abstract final class BinaryLogReader {
+  static const _magic = 'CBLDLOG';
+  static const _version = 1;
+  static const _headerSize = 16;
+  static const _segmentPrefix = 'cbldart-';
+  static const _segmentExtension = '.binlog';
+
+  static const _tagEnd = 0;
+  static const _tagString = 1;
+  static const _tagLog = 2;
+  static const _tagDropped = 3;
+
+  /// Returns the paths of the log segments in [directory], from oldest to
+  /// newest.
+  static List<String> segmentsInDirectory(String directory) {
+    final segments =
+        Directory(directory)
+            .listSync()
+            .whereType<File>()
+            .map((file) => file.path)
+            .where((path) {
+              final name = path.split(Platform.pathSeparator).last;
+              return name.startsWith(_segmentPrefix) &&
+                  name.endsWith(_segmentExtension);
+            })
+            .toList()
+          // Segment names are zero padded, so they sort in the order in which
+          // the segments have been created.
+          ..sort();
+    return segments;
+  }
+
+  /// Reads the entries of all log segments in [directory], from oldest to
+  /// newest.
+  static Iterable<BinaryLogEntry> readDirectory(String directory) sync* {
+    for (final segment in segmentsInDirectory(directory)) {
+      yield* readSegment(File(segment).readAsBytesSync());
+    }
+  }
+
+  /// Reads the entries of a single log segment.
+  ///
+  /// Throws a [FormatException] if [bytes] is not a valid log segment.
+  static Iterable<BinaryLogEntry> readSegment(Uint8List bytes) sync* {
+    if (bytes.length < _headerSize ||
+        ascii.decode(bytes.sublist(0, _magic.length), allowInvalid: true) !=
+            _magic) {
+      throw const FormatException('Not a binary log segment.');
+    }
+    if (bytes[_magic.length] != _version) {
+      throw FormatException(
+        'Unsupported binary log version: ${bytes[_magic.length]}',
+      );
+    }
+
+    final reader = _SegmentReader(bytes, _headerSize);
+    final strings = <String>[];
+    var timestamp = 0;
+
+    while (!reader.isDone) {
+      switch (reader.readByte()) {
+        case _tagEnd:
+          // The rest of the segment has not been written yet.
+          return;
+        case _tagString:
+          final length = reader.readVarint();
+          strings.add(
+            utf8.decode(reader.readBytes(length), allowMalformed: true),
+          );
+        case _tagLog:
+          timestamp += _decodeZigZag(reader.readVarint());
+          final threadId = reader.readVarint();
+          final domain = reader.readByte();
+          final level = reader.readByte();
+          final stringIndex = reader.readVarint();
+          if (domain >= LogDomain.values.length ||
+              level >= LogLevel.values.length ||
+              stringIndex >= strings.length) {
+            throw FormatException(
+              'Invalid binary log record.',
+              bytes,
+              reader.offset,
+            );
+          }
+          yield BinaryLogRecord(
+            timestamp: DateTime.fromMillisecondsSinceEpoch(timestamp),
+            threadId: threadId,
+            domain: LogDomain.values[domain],
+            level: LogLevel.values[level],
+            message: strings[stringIndex],
+          );
+        case _tagDropped:
+          yield BinaryLogDroppedRecords(reader.readVarint());
+        case final tag:
+          throw FormatException(
+            'Unknown binary log record tag: $tag',
+            bytes,
+            reader.offset - 1,
+          );
+      }
+    }
+  }
+
+  static int _decodeZigZag(int value) => (value >>> 1) ^ -(value & 1);
+}
+
+final class _SegmentReader {
+  _SegmentReader(this.bytes, this.offset);
+
+  final Uint8List bytes;
+  int offset;
+
+  bool get isDone => offset >= bytes.length;
+
+  int readByte() {
+    _ensureAvailable(1);
+    return bytes[offset++];
+  }
+
+  int readVarint() {
+    var result = 0;
+    var shift = 0;
+    while (true) {
+      final byte = readByte();
+      result |= (byte & 0x7f) << shift;
+      if (byte < 0x80) {
+        return result;
+      }
+      shift += 7;
+    }
+  }
+
+  Uint8List readBytes(int length) {
+    _ensureAvailable(length);
+    final result = Uint8List.sublistView(bytes, offset, offset + length);
+    offset += length;
+    return result;
+  }
+
+  void _ensureAvailable(int length) {
+    if (offset + length > bytes.length) {
+      throw FormatException('Truncated binary log segment.', bytes, offset);
+    }
+  }
+}
@@ -0,0 +1,157 @@
+import 'dart:io';
+
+import 'package:meta/meta.dart';
+
+import '../bindings.dart';
+import 'binary_log_reader.dart';
+import 'file_logger.dart';
+import 'logger.dart';
+
+/// The configuration for binary log segments.
+///
+/// {@category Logging}
+@immutable
+final class BinaryLogConfiguration {
+  /// Creates the configuration for binary log segments.
+  BinaryLogConfiguration({
+    required this.directory,
+    this.segmentSize = _defaultSegmentSize,
+    this.maxSegments = _defaultMaxSegments,
+  }) {
+    if (segmentSize < _minSegmentSize) {
+      throw RangeError.range(segmentSize, _minSegmentSize, null, 'segmentSize');
+    }
+    if (maxSegments < 1) {
+      throw RangeError.range(maxSegments, 1, null, 'maxSegments');
+    }
+  }
+
+  static const _minSegmentSize = 4 * 1024;
+  static const _defaultSegmentSize = 1024 * 1024;
+  static const _defaultMaxSegments = 8;
+
+  /// The directory to store the log segments in.
+  final String directory;
+
+  /// The size of a log segment before a new segment is started, in bytes.
+  ///
+  /// The default is 1 MB. The minimum is 4 KB.
+  final int segmentSize;
+
+  /// The maximum number of log segments to keep in [directory].
+  ///
+  /// When a new segment is started, the oldest segments are deleted. The
+  /// default is 8.
+  final int maxSegments;
+
+  @override
+  bool operator ==(Object other) =>
+      identical(this, other) ||
+      other is BinaryLogConfiguration &&
+          runtimeType == other.runtimeType &&
+          directory == other.directory &&
+          segmentSize == other.segmentSize &&
+          maxSegments == other.maxSegments;
+
+  @override
+  int get hashCode =>
+      directory.hashCode ^ segmentSize.hashCode ^ maxSegments.hashCode;
+
+  @override
+  String toString() => [
+    'BinaryLogConfiguration(',
+    [
+      'directory: $directory',
+      'segmentSize: ${(segmentSize / 1024).toStringAsFixed(1)} KB',
+      'maxSegments: $maxSegments',
+    ].join(', '),
+    ')',
+  ].join();
+}
+
+/// Logger for writing log messages in a compact binary format to rotating
+/// segment files.
+///
+/// In contrast to the [FileLogger], the logging thread only
+/// copies messages into a native buffer. Messages are encoded and written
+/// through memory mapped files on a background thread, which makes this
+/// logger suitable for high-volume diagnostic logging. Repeated messages are
+/// only stored once per segment.
+///
+/// Messages are dropped instead of blocking the logging thread, if they are
+/// logged faster than they can be written. The number of dropped messages is
+/// recorded in the log.
+///
+/// Log segments can be read with [BinaryLogReader] or
+/// converted to JSON with `dart run cbl:binary_log_to_json <directory>`.
+///
+/// {@category Logging}
+abstract final class BinaryLogger {
+  /// The configuration the logger currently uses.
+  ///
+  /// This property is `null` by default. Setting it to `null` disables binary
+  /// logging.
+  BinaryLogConfiguration? get config;
+  set config(BinaryLogConfiguration? value);
+
+  /// The minimum log level of the messages to be logged.
+  ///
+  /// The default log level for the binary logger is [LogLevel.none], which
+  /// means no logging at all.
+  LogLevel get level;
+  set level(LogLevel value);
+}
+
+// === Impl ====================================================================
+
+final class BinaryLoggerImpl extends BinaryLogger {
+  @override
+  BinaryLogConfiguration? get config => _config;
+  BinaryLogConfiguration? _config;
+
+  @override
+  set config(BinaryLogConfiguration? config) {
+    if (_config != config) {
+      _config = config;
+      _update();
+    }
+  }
+
+  @override
+  LogLevel get level => _level;
+  LogLevel _level = .none;
+
+  @override
+  set level(LogLevel level) {
+    if (_level != level) {
+      _level = level;
+      _update();
+    }
+  }
+
+  void _update() {
+    final config = _config;
+    if (config == null) {
+      LoggingBindings.setBinaryLogSink(
+        CBLLogLevel.none,
+        directory: '',
+        segmentSize: 0,
+        maxSegments: 0,
+      );
+      return;
+    }
+
+    // Ensure that the directory exists.
+    final directory = Directory(config.directory);
+    if (!directory.existsSync()) {
+      directory.createSync(recursive: true);
+    }
+
+    LoggingBindings.setBinaryLogSink(
+      _level.toCBLLogLevel(),
+      directory: config.directory,
+      segmentSize: config.segmentSize,
+      maxSegments: config.maxSegments,
+    );
+  }
+}
@@ -1,8 +1,10 @@
+import 'binary_logger.dart';
 import 'console_logger.dart';
 import 'file_logger.dart';
 import 'logger.dart';
 
-/// Configuration of the [ConsoleLogger], [FileLogger] and a custom [Logger].
+/// Configuration of the [ConsoleLogger], [FileLogger], [BinaryLogger] and a
+/// custom [Logger].
 ///
 /// {@category Logging}
 abstract final class Log {
@@ -12,6 +14,9 @@ abstract final class Log {
   /// File logger writing log messages to files.
   FileLogger get file;
 
+  /// Binary logger writing log messages to rotating segment files.
+  BinaryLogger get binary;
+
   /// The currently set custom [Logger].
   Logger? get custom;
   set custom(Logger? value);
@@ -26,6 +31,10 @@ final class LogImpl extends Log {
   @override
   final file = FileLoggerImpl();
 
+  /// Binary logger writing log messages to rotating segment files.
+  @override
+  final binary = BinaryLoggerImpl();
+
   /// The currently set custom [Logger].
   @override
   Logger? get custom => _custom;
@@ -41,6 +41,9 @@ abstract base class Logger {
   void Function()? _levelChanged;
 
   /// The minimum log level for which [log] will be called.
+  ///
+  /// The level can be overridden for individual domains through
+  /// [domainLevels].
   LogLevel get level => _level;
   LogLevel _level;
 
@@ -51,7 +54,52 @@ abstract base class Logger {
     }
   }
 
+  /// The minimum log levels for individual [LogDomain]s, which take
+  /// precedence over [level].
+  ///
+  /// Messages are filtered natively, before they are sent to Dart. This
+  /// allows to receive verbose messages from one domain, without paying for
+  /// verbose messages from all other domains:
+  ///
+  /// ```dart
+  /// logger
+  ///   ..level = LogLevel.warning
+  ///   ..domainLevels = {LogDomain.replicator: LogLevel.verbose};
+  /// ```
+  Map<LogDomain, LogLevel> get domainLevels => _domainLevels;
+  Map<LogDomain, LogLevel> _domainLevels = const {};
+
+  set domainLevels(Map<LogDomain, LogLevel> domainLevels) {
+    _domainLevels = Map.unmodifiable(domainLevels);
+    _levelChanged?.call();
+  }
+
+  /// The maximum number of messages per second for which [log] will be
+  /// called, for individual [LogDomain]s.
+  ///
+  /// Messages which exceed the limit are discarded natively. Domains without
+  /// a limit are not rate limited.
+  Map<LogDomain, int> get rateLimits => _rateLimits;
+  Map<LogDomain, int> _rateLimits = const {};
+
+  set rateLimits(Map<LogDomain, int> rateLimits) {
+    if (rateLimits.values.any((limit) => limit <= 0)) {
+      throw ArgumentError.value(
+        rateLimits,
+        'rateLimits',
+        'must only contain positive limits',
+      );
+    }
+    _rateLimits = Map.unmodifiable(rateLimits);
+    _levelChanged?.call();
+  }
+
   /// The callback which is invoked for each log message.
+  ///
+  /// Messages are buffered natively and delivered in batches, in the order in
+  /// which they were logged. If messages are logged faster than they can be
+  /// delivered, excess messages are dropped and a warning which reports the
+  /// number of dropped messages is logged instead.
   void log(LogLevel level, LogDomain domain, String message);
 }
 
@@ -124,6 +172,7 @@ void setupCustomLogger(Logger? logger) {
   } else {
     _setupLogger(logger);
     _setupCallback();
+    _updateLogLevel();
   }
 }
 
@@ -132,12 +181,22 @@ void _setupLogger(Logger logger) {
   // The AsyncCallback is not created every time a Logger is set.
   // The Logger should still be called in the Zone in which it was set.
   _loggerCallback = Zone.current.bindUnaryCallbackGuarded((arguments) {
-    final message = LogCallbackMessage.fromArguments(arguments);
-    logger.log(
-      message.level.toLogLevel(),
-      message.domain.toLogDomain(),
-      message.message,
-    );
+    final batch = LogCallbackBatch.fromArguments(arguments);
+    if (batch.dropped > 0) {
+      logger.log(
+        LogLevel.warning,
+        LogDomain.database,
+        'Dropped ${batch.dropped} log messages because the native log '
+        'buffer was full.',
+      );
+    }
+    for (final message in batch.messages) {
+      logger.log(
+        message.level.toLogLevel(),
+        message.domain.toLogDomain(),
+        message.message,
+      );
+    }
   });
   _logger!._levelChanged = _updateLogLevel;
 }
@@ -148,10 +207,27 @@ void _cleanUpLogger() {
   _logger = null;
 }
 
-void _updateLogLevel() => LoggingBindings.setCallbackLevel(
-  _callback!.pointer,
-  _logger!._level.toCBLLogLevel(),
-);
+void _updateLogLevel() {
+  final callback = _callback!.pointer;
+  final logger = _logger!;
+
+  LoggingBindings.setCallbackLevel(callback, logger._level.toCBLLogLevel());
+  for (final domain in LogDomain.values) {
+    final level = logger._domainLevels[domain];
+    if (level != null) {
+      LoggingBindings.setCallbackDomainLevel(
+        callback,
+        domain.toCBLLogDomain(),
+        level.toCBLLogLevel(),
+      );
+    }
+    LoggingBindings.setCallbackDomainRateLimit(
+      callback,
+      domain.toCBLLogDomain(),
+      logger._rateLimits[domain] ?? 0,
+    );
+  }
+}
 
 void _setupCallback() {
   if (_callback != null) {
@@ -0,0 +1,229 @@
+import 'dart:convert';
+
+import 'package:meta/meta.dart';
+
+import 'bindings.dart';
+
+/// A latency histogram of [NativeMetrics].
+///
+/// {@category Tracing}
+@immutable
+final class NativeMetricsHistogram {
+  NativeMetricsHistogram._({
+    required this.count,
+    required this.total,
+    required this.buckets,
+  });
+
+  factory NativeMetricsHistogram._fromJson(Map<String, Object?> json) =>
+      NativeMetricsHistogram._(
+        count: json['count']! as int,
+        total: Duration(microseconds: (json['sum']! as int) ~/ 1000),
+        buckets: List.unmodifiable(
+          (json['buckets']! as List<Object?>).cast<int>(),
+        ),
+      );
+
+  /// The number of recorded durations.
+  final int count;
+
+  /// The sum of all recorded durations.
+  final Duration total;
+
+  /// The number of recorded durations per bucket.
+  ///
+  /// Bucket `i` counts the durations which are shorter than `2^(i+1)`
+  /// nanoseconds and are not counted by a lower bucket. Trailing empty buckets
+  /// are omitted.
+  final List<int> buckets;
+
+  /// The mean of the recorded durations, or `null` if no durations have been
+  /// recorded.
+  Duration? get mean => count == 0 ? null : total ~/ count;
+
+  /// Returns an upper bound for the [percent] percentile of the recorded
+  /// durations, or `null` if no durations have been recorded.
+  ///
+  /// The precision is limited to the power of two bounds of the [buckets].
+  Duration? percentile(double percent) {
+    if (count == 0) {
+      return null;
+    }
+    final rank = (percent / 100 * count).ceil().clamp(1, count);
+    var seen = 0;
+    for (var i = 0; i < buckets.length; i++) {
+      seen += buckets[i];
+      if (seen >= rank) {
+        return Duration(microseconds: ((1 << (i + 1)) / 1000).ceil());
+      }
+    }
+    return null;
+  }
+
+  @override
+  String toString() => 'NativeMetricsHistogram(count: $count, mean: $mean)';
+}
+
+/// A snapshot of the [NativeMetrics].
+///
+/// {@category Tracing}
+@immutable
+final class NativeMetricsSnapshot {
+  NativeMetricsSnapshot._({
+    required this.enabled,
+    required this.callbacksPosted,
+    required this.blockingCalls,
+    required this.slowBlockingCalls,
+    required this.databaseLocksAcquired,
+    required this.bytesDecoded,
+    required this.dictIteratorsAllocated,
+    required this.arrayIteratorsAllocated,
+    required this.sliceResultsTransferred,
+    required this.transferredSliceResultsReleased,
+    required this.blockingCallWait,
+    required this.databaseLockWait,
+  });
+
+  factory NativeMetricsSnapshot._fromJson(Map<String, Object?> json) {
+    final counters = json['counters']! as Map<String, Object?>;
+    final histograms = json['histograms']! as Map<String, Object?>;
+
+    NativeMetricsHistogram histogram(String name) =>
+        NativeMetricsHistogram._fromJson(
+          histograms[name]! as Map<String, Object?>,
+        );
+
+    return NativeMetricsSnapshot._(
+      enabled: json['enabled']! as bool,
+      callbacksPosted: counters['callbacksPosted']! as int,
+      blockingCalls: counters['blockingCalls']! as int,
+      slowBlockingCalls: counters['slowBlockingCalls']! as int,
+      databaseLocksAcquired: counters['databaseLocksAcquired']! as int,
+      bytesDecoded: counters['bytesDecoded']! as int,
+      dictIteratorsAllocated: counters['dictIteratorsAllocated']! as int,
+      arrayIteratorsAllocated: counters['arrayIteratorsAllocated']! as int,
+      sliceResultsTransferred: counters['sliceResultsTransferred']! as int,
+      transferredSliceResultsReleased:
+          counters['transferredSliceResultsReleased']! as int,
+      blockingCallWait: histogram('blockingCallWait'),
+      databaseLockWait: histogram('databaseLockWait'),
+    );
+  }
+
+  /// Whether the native metrics have been compiled into the native library.
+  ///
+  /// If this is `false`, all values are 0.
+  final bool enabled;
+
+  /// The number of requests which have been posted from native code to Dart
+  /// callbacks, for example to call listeners or replication filters.
+  final int callbacksPosted;
+
+  /// The number of callback requests for which native code blocked until
+  /// Dart returned a result.
+  final int blockingCalls;
+
+  /// The number of [blockingCalls] which waited for longer than
+  /// [NativeMetrics.blockingCallThreshold].
+  final int slowBlockingCalls;
+
+  /// The number of times a database level lock has been acquired.
+  final int databaseLocksAcquired;
+
+  /// The number of bytes of strings and data which have been loaded from
+  /// Fleece values, to be decoded in Dart.
+  final int bytesDecoded;
+
+  /// The number of native dictionary iterators which have been allocated.
+  final int dictIteratorsAllocated;
+
+  /// The number of native array iterators which have been allocated.
+  final int arrayIteratorsAllocated;
+
+  /// The number of native buffers which have been sent by address to another
+  /// isolate, for example to transfer blob chunks or encoded Fleece data.
+  final int sliceResultsTransferred;
+
+  /// The number of [sliceResultsTransferred] which have been released by the
+  /// receiving isolate.
+  final int transferredSliceResultsReleased;
+
+  /// How long native code waited for Dart to return the result of blocking
+  /// callback requests.
+  final NativeMetricsHistogram blockingCallWait;
+
+  /// How long it took to acquire database level locks.
+  final NativeMetricsHistogram databaseLockWait;
+
+  @override
+  String toString() => [
+    'NativeMetricsSnapshot(',
+    [
+      if (!enabled) 'disabled',
+      'callbacksPosted: $callbacksPosted',
+      'blockingCalls: $blockingCalls',
+      'slowBlockingCalls: $slowBlockingCalls',
+      'databaseLocksAcquired: $databaseLocksAcquired',
+      'bytesDecoded: $bytesDecoded',
+      'dictIteratorsAllocated: $dictIteratorsAllocated',
+      'arrayIteratorsAllocated: $arrayIteratorsAllocated',
+      'sliceResultsTransferred: $sliceResultsTransferred',
+      'transferredSliceResultsReleased: $transferredSliceResultsReleased',
+      'blockingCallWait: $blockingCallWait',
+      'databaseLockWait: $databaseLockWait',
+    ].join(', '),
+    ')',
+  ].join();
+}
+
+/// Counters and latency histograms, which are recorded by the native code of
+/// CBL Dart on its hot paths.
+///
+/// The metrics are recorded per thread, for all isolates of the process, and
+/// are summed up when a [snapshot] is taken. Recording a value does not
+/// contend with other threads, so the metrics are always recorded.
+///
+/// The metrics can be compiled out of the native library, by setting
+/// `metrics: false` in the `hooks.user_defines.cbl` section of the
+/// `pubspec.yaml` of the application.
+///
+/// {@category Tracing}
+abstract final class NativeMetrics {
+  /// Returns the metrics which have been recorded since the last [reset].
+  static NativeMetricsSnapshot snapshot() => NativeMetricsSnapshot._fromJson(
+    jsonDecode(MetricsBindings.snapshot()) as Map<String, Object?>,
+  );
+
+  /// Resets all metrics to 0.
+  static void reset() => MetricsBindings.reset();
+
+  /// How long a blocking callback call can wait for Dart to return a result,
+  /// before it is reported as slow.
+  ///
+  /// Blocking calls are made by native code, for example to call replication
+  /// filters and conflict resolvers, and block the native thread until the
+  /// callback returns. When a call has been waiting for longer than this
+  /// threshold, a warning with the ID of the callback and the elapsed time is
+  /// logged while the call is still waiting, and again when it returns. This
+  /// makes stalls visible, which are caused by slow callbacks or isolates which
+  /// are busy with other work.
+  ///
+  /// Setting this to `null` disables reporting. The default is 1 second.
+  static Duration? get blockingCallThreshold {
+    final micros = AsyncCallbackBindings.blockingCallThresholdMicros;
+    return micros == 0 ? null : Duration(microseconds: micros);
+  }
+
+  static set blockingCallThreshold(Duration? value) {
+    if (value != null && value <= Duration.zero) {
+      throw ArgumentError.value(value, 'value', 'must be positive');
+    }
+    AsyncCallbackBindings.blockingCallThresholdMicros =
+        value?.inMicroseconds ?? 0;
+  }
+
+  /// The number of blocking callback calls which are currently waiting for
+  /// Dart to return a result.
+  static int get blockingCallsInFlight =>
+      AsyncCallbackBindings.blockingCallsInFlight;
+}
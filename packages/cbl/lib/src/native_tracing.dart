@@ -0,0 +1,91 @@
+import 'dart:convert';
+
+import 'bindings.dart';
+
+/// Trace events, which are recorded by the native code of CBL Dart.
+///
+/// When enabled, trace events are recorded for the dispatch of listeners,
+/// calls which block native code until a Dart callback returns (for example
+/// replication filters and conflict resolvers), query compilation and
+/// execution and blob I/O.
+///
+/// The events are recorded per thread, for all isolates of the process, and
+/// only the most recent events of each thread are kept. When tracing is
+/// disabled, the overhead of a trace point is negligible.
+///
+/// Events are exported with [dump] in the Chrome trace event format, which can
+/// be loaded into [Perfetto](https://ui.perfetto.dev) or `chrome://tracing`.
+/// Timestamps are taken from the same monotonic clock that is used by the
+/// timeline of the Dart VM, so the native events line up with Dart spans in
+/// the same trace.
+///
+/// {@category Tracing}
+abstract final class NativeTracing {
+  /// The default number of events which are kept per thread.
+  static const defaultCapacityPerThread = 10000;
+
+  /// Whether native trace events are currently being recorded.
+  static bool get isEnabled => TraceBindings.isEnabled();
+
+  /// Starts recording native trace events, keeping the last
+  /// [capacityPerThread] events of each thread.
+  ///
+  /// If [capacityPerThread] differs from the capacity of a previous call,
+  /// previously recorded events are discarded.
+  static void enable({int capacityPerThread = defaultCapacityPerThread}) {
+    if (capacityPerThread <= 0) {
+      throw ArgumentError.value(
+        capacityPerThread,
+        'capacityPerThread',
+        'must be greater than 0',
+      );
+    }
+    TraceBindings.enable(capacityPerThread);
+  }
+
+  /// Stops recording native trace events.
+  ///
+  /// Events which have already been recorded are kept until [clear] is called.
+  static void disable() => TraceBindings.disable();
+
+  /// Discards all recorded native trace events.
+  static void clear() => TraceBindings.clear();
+
+  /// Returns the recorded native trace events as a JSON trace in the Chrome
+  /// trace event format.
+  ///
+  /// If [mergeWith] is provided, it must be a trace in the Chrome trace event
+  /// format, either in the object or in the array form, for example a trace
+  /// of Dart spans. The native events are appended to the events of that
+  /// trace and the merged trace is returned.
+  static String dump({String? mergeWith}) {
+    final nativeTrace = TraceBindings.dump();
+    if (mergeWith == null) {
+      return nativeTrace;
+    }
+
+    final nativeEvents =
+        (jsonDecode(nativeTrace) as Map<String, Object?>)['traceEvents']!
+            as List<Object?>;
+
+    final Object? trace;
+    switch (jsonDecode(mergeWith)) {
+      case final List<Object?> events:
+        trace = [...events, ...nativeEvents];
+      case final Map<String, Object?> object:
+        final events = object['traceEvents'] as List<Object?>? ?? const [];
+        trace = {
+          ...object,
+          'traceEvents': [...events, ...nativeEvents],
+        };
+      default:
+        throw ArgumentError.value(
+          mergeWith,
+          'mergeWith',
+          'is not a trace in the Chrome trace event format',
+        );
+    }
+
+    return jsonEncode(trace);
+  }
+}
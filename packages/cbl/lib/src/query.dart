@@ -35,6 +35,8 @@ export 'query/index/index_configuration.dart'
         ValueIndexConfiguration,
         VectorEncoding,
         VectorIndexConfiguration;
+export 'query/index/index_update_worker.dart'
+    show IndexEmbedder, IndexUpdateProgress, IndexUpdateWorker;
 export 'query/index/index_updater.dart'
     show AsyncIndexUpdater, IndexUpdater, SyncIndexUpdater;
 export 'query/index/query_index.dart'
@@ -45,11 +47,19 @@ export 'query/limit.dart' show AsyncLimit, Limit, SyncLimit;
 export 'query/order_by.dart' show AsyncOrderBy, OrderBy, SyncOrderBy;
 export 'query/ordering.dart' show Ordering, OrderingInterface, SortOrder;
 export 'query/parameters.dart' show Parameters;
-export 'query/prediction.dart' show Prediction, PredictiveModel;
+export 'query/prediction.dart'
+    show
+        BatchPredictiveModel,
+        Prediction,
+        PredictionCacheConfiguration,
+        PredictionCacheStats,
+        PredictiveModel;
 export 'query/query.dart' show AsyncQuery, Query, SyncQuery;
 export 'query/query_builder.dart'
     show AsyncQueryBuilder, QueryBuilder, SyncQueryBuilder;
 export 'query/query_change.dart' show QueryChange;
+export 'query/query_profiler.dart'
+    show QueryProfile, QueryProfileKind, QueryProfiler;
 export 'query/result.dart' show Result;
 export 'query/result_set.dart' show AsyncResultSet, ResultSet, SyncResultSet;
 export 'query/router/from_router.dart'
@@ -69,4 +79,6 @@ export 'query/router/where_router.dart'
 export 'query/select.dart' show AsyncSelect, Select, SyncSelect;
 export 'query/select_result.dart'
     show SelectResult, SelectResultAs, SelectResultFrom, SelectResultInterface;
+export 'query/vector_distance.dart'
+    show VectorDistance, VectorDistanceMetric, VectorMatch;
 export 'query/where.dart' show AsyncWhere, SyncWhere, Where;
@@ -10,7 +10,6 @@ import '../fleece/containers.dart' as fl;
 import '../fleece/encoder.dart';
 import '../support/async_callback.dart';
 import '../support/listener_token.dart';
-import '../support/native_object.dart';
 import '../support/streams.dart';
 import '../support/tracing.dart';
 import '../support/utils.dart';
@@ -64,13 +63,17 @@ base class FfiQuery extends QueryBase implements SyncQuery, Finalizable {
   @override
   SyncResultSet execute() => syncOperationTracePoint(
     () => ExecuteQueryOp(this),
-    () => useSync(
-      () => FfiResultSet(
-        BaseBindings.runWithIsolateId(() => QueryBindings.execute(_pointer)),
+    () => useSync(() {
+      final (:resultSet, :execution) = BaseBindings.runWithIsolateId(
+        () => QueryBindings.execute(_pointer),
+      );
+      return FfiResultSet(
+        resultSet,
+        execution: execution,
         query: this,
         columnNames: _columnNames,
-      ),
-    ),
+      );
+    }),
   );
 
   @override
@@ -140,7 +143,7 @@ base class FfiQuery extends QueryBase implements SyncQuery, Finalizable {
     syncOperationTracePoint(() => PrepareQueryOp(this), () {
       _pointer = QueryBindings.create(database!.pointer, language, definition!);
 
-      bindCBLRefCountedToDartObject(this, pointer: _pointer);
+      QueryBindings.bindToDartObject(this, _pointer);
 
       _columnNames = List.generate(
         QueryBindings.columnCount(_pointer),
@@ -169,11 +172,12 @@ base class FfiQuery extends QueryBase implements SyncQuery, Finalizable {
 final class FfiResultSet with IterableMixin<Result> implements SyncResultSet {
   FfiResultSet(
     Pointer<CBLResultSet> pointer, {
+    CBLDart_QueryExecution? execution,
     required FfiQuery query,
     required List<String> columnNames,
   }) : _database = query.database!,
        _columnNames = columnNames,
-       _iterator = ResultSetIterator.fromPointer(pointer),
+       _iterator = ResultSetIterator.fromPointer(pointer, execution: execution),
        _context = createResultSetMContext(query.database!);
 
   final DatabaseBase _database;
@@ -230,12 +234,17 @@ final class FfiResultSet with IterableMixin<Result> implements SyncResultSet {
 final class ResultSetIterator
     with IterableMixin<fl.Array>
     implements Iterator<fl.Array>, Finalizable {
-  ResultSetIterator.fromPointer(this._pointer, {this.encodeArray = false}) {
-    bindCBLRefCountedToDartObject(this, pointer: _pointer);
+  ResultSetIterator.fromPointer(
+    this._pointer, {
+    CBLDart_QueryExecution? execution,
+    this.encodeArray = false,
+  }) : _execution = execution ?? nullptr {
+    ResultSetBindings.bindToDartObject(this, _pointer);
   }
 
   final bool encodeArray;
   final Pointer<CBLResultSet> _pointer;
+  final CBLDart_QueryExecution _execution;
   var _isDone = false;
   fl.Array? _current;
 
@@ -257,7 +266,7 @@ final class ResultSetIterator
       return false;
     }
     _current = null;
-    _isDone = !ResultSetBindings.next(_pointer);
+    _isDone = !ResultSetBindings.next(_pointer, _execution);
     return !_isDone;
   }
 }
@@ -0,0 +1,128 @@
+import 'dart:async';
+import 'dart:ffi';
+
+import '../../bindings.dart';
+import '../../document/array.dart';
+import '../../fleece/containers.dart';
+import '../../fleece/integration/integration.dart';
+import '../../support/resource.dart';
+import 'ffi_query_index.dart';
+import 'index_update_worker.dart';
+
+final class FfiIndexUpdateWorker
+    with ClosableResourceMixin
+    implements IndexUpdateWorker, Finalizable {
+  FfiIndexUpdateWorker.start(
+    FfiQueryIndex index, {
+    required IndexEmbedder embed,
+    required int batchSize,
+  }) : _embed = embed {
+    try {
+      _pointer = IndexUpdaterWorkerBindings.start(
+        index.pointer,
+        batchSize,
+        _embedCallable.nativeFunction,
+        _doneCallable.nativeFunction,
+      );
+    } catch (_) {
+      _embedCallable.close();
+      _doneCallable.close();
+      rethrow;
+    }
+    IndexUpdaterWorkerBindings.bindToDartObject(this, _pointer);
+    // Keep the worker alive while the native thread can still call back.
+    _running.add(this);
+    // Closing the database stops the worker.
+    attachTo(index);
+  }
+
+  static final _running = <FfiIndexUpdateWorker>{};
+
+  final IndexEmbedder _embed;
+  late final CBLDart_IndexUpdaterWorker _pointer;
+  late final NativeCallable<CBLDart_IndexUpdaterWorker_EmbedFunction>
+  _embedCallable = NativeCallable.listener(_embedBatch);
+  late final NativeCallable<CBLDart_IndexUpdaterWorker_DoneFunction>
+  _doneCallable = NativeCallable.listener(_done);
+  final _doneCompleter = Completer<IndexUpdateProgress>();
+  Object? _embedError;
+  StackTrace? _embedStackTrace;
+
+  @override
+  IndexUpdateProgress get progress {
+    final progress = IndexUpdaterWorkerBindings.progress(_pointer);
+    return IndexUpdateProgress(
+      isRunning: progress.isRunning,
+      batches: progress.batches,
+      values: progress.values,
+      vectorsSet: progress.vectorsSet,
+      vectorsRemoved: progress.vectorsRemoved,
+      vectorsSkipped: progress.vectorsSkipped,
+      vectorsFailed: progress.vectorsFailed,
+      elapsedTime: progress.elapsedTime,
+      embeddingTime: progress.embeddingTime,
+      indexingTime: progress.indexingTime,
+      error: _embedError ?? progress.error,
+    );
+  }
+
+  @override
+  Future<IndexUpdateProgress> get done => _doneCompleter.future;
+
+  @override
+  void stop() => IndexUpdaterWorkerBindings.stop(_pointer);
+
+  @override
+  Future<void> performClose() async {
+    stop();
+    // Errors of the worker are reported through [done] and don't prevent it
+    // from being closed.
+    await done.then((_) {}, onError: (_) {});
+  }
+
+  void _embedBatch(
+    Pointer<CBLDart_IndexUpdateBatch> batch,
+    CBLDart_Completer completer,
+  ) => unawaited(_computeBatch(batch, completer));
+
+  Future<void> _computeBatch(
+    Pointer<CBLDart_IndexUpdateBatch> batch,
+    CBLDart_Completer completer,
+  ) async {
+    try {
+      final values = MRoot.fromContext(
+        MContext(
+          data: Doc.fromResultData(
+            IndexUpdaterWorkerBindings.batchValues(batch),
+            FLTrust.trusted,
+          ),
+        ),
+        isMutable: false,
+      ).asNative! as Array;
+
+      final vectors = await _embed(values.toPlainList());
+      IndexUpdaterWorkerBindings.completeBatch(batch, completer, vectors);
+      // ignore: avoid_catches_without_on_clauses
+    } catch (error, stackTrace) {
+      _embedError = error;
+      _embedStackTrace = stackTrace;
+      IndexUpdaterWorkerBindings.failBatch(completer);
+    }
+  }
+
+  void _done() {
+    _embedCallable.close();
+    _doneCallable.close();
+    _running.remove(this);
+
+    final progress = this.progress;
+    if (progress.error case final error?) {
+      _doneCompleter.completeError(error, _embedStackTrace);
+    } else {
+      _doneCompleter.complete(progress);
+    }
+
+    // Detach the finished worker from the index.
+    unawaited(close());
+  }
+}
@@ -3,9 +3,12 @@ import 'dart:ffi';
 import '../../bindings.dart';
 import '../../database/ffi_database.dart';
 import '../../query.dart';
+import '../../support/edition.dart';
 import '../../support/resource.dart';
 import '../../support/utils.dart';
+import 'ffi_index_update_worker.dart';
 import 'ffi_index_updater.dart';
+import 'index_update_worker.dart';
 
 final class FfiQueryIndex
     with ClosableResourceMixin
@@ -35,4 +38,22 @@ final class FfiQueryIndex
       limit,
     )?.let((updater) => FfiIndexUpdater.fromPointer(updater, index: this)),
   );
+
+  @override
+  IndexUpdateWorker startUpdateWorker({
+    required IndexEmbedder embed,
+    int batchSize = 64,
+  }) {
+    requireEnterprise('IndexUpdateWorker');
+    if (batchSize <= 0) {
+      throw ArgumentError.value(batchSize, 'batchSize', 'must be positive');
+    }
+    return useSync(
+      () => FfiIndexUpdateWorker.start(
+        this,
+        embed: embed,
+        batchSize: batchSize,
+      ),
+    );
+  }
 }
@@ -0,0 +1,131 @@
+import 'dart:async';
+
+import 'index_configuration.dart';
+import 'query_index.dart';
+
+/// Function which computes the vectors for a batch of [values] of a lazy
+/// vector index.
+///
+/// The returned list must contain one vector for each value, in the same
+/// order. A `null` vector means that there is no vector for the value, and
+/// any existing vector of the value is removed from the index.
+///
+/// {@category Query}
+/// {@category Enterprise Edition}
+typedef IndexEmbedder =
+    FutureOr<List<List<double>?>> Function(List<Object?> values);
+
+/// The progress of an [IndexUpdateWorker].
+///
+/// {@category Query}
+/// {@category Enterprise Edition}
+final class IndexUpdateProgress {
+  /// Creates the progress of an [IndexUpdateWorker].
+  IndexUpdateProgress({
+    required this.isRunning,
+    required this.batches,
+    required this.values,
+    required this.vectorsSet,
+    required this.vectorsRemoved,
+    required this.vectorsSkipped,
+    this.vectorsFailed = 0,
+    required this.elapsedTime,
+    required this.embeddingTime,
+    required this.indexingTime,
+    this.error,
+  });
+
+  /// Whether the worker is still updating the index.
+  final bool isRunning;
+
+  /// The number of batches which have been indexed.
+  final int batches;
+
+  /// The number of values which have been indexed.
+  final int values;
+
+  /// The number of vectors which have been set.
+  final int vectorsSet;
+
+  /// The number of vectors which have been removed.
+  final int vectorsRemoved;
+
+  /// The number of values which have been skipped.
+  final int vectorsSkipped;
+
+  /// The number of vectors which could not be set or removed.
+  ///
+  /// The values of these vectors are skipped and [error] is the error of the
+  /// last vector which failed.
+  final int vectorsFailed;
+
+  /// The time since the worker was started, until it stopped.
+  final Duration elapsedTime;
+
+  /// The time which was spent waiting for the [IndexEmbedder].
+  final Duration embeddingTime;
+
+  /// The time which was spent updating the index with the computed vectors.
+  final Duration indexingTime;
+
+  /// The error which caused the worker to stop or the last vector to fail, if
+  /// any.
+  final Object? error;
+
+  /// The number of values which have been indexed per second.
+  double get valuesPerSecond => elapsedTime == Duration.zero
+      ? 0
+      : values / (elapsedTime.inMicroseconds / Duration.microsecondsPerSecond);
+
+  @override
+  String toString() => [
+    'IndexUpdateProgress(',
+    [
+      if (isRunning) 'RUNNING',
+      'batches: $batches',
+      'values: $values',
+      'vectorsSet: $vectorsSet',
+      'vectorsRemoved: $vectorsRemoved',
+      if (vectorsSkipped > 0) 'vectorsSkipped: $vectorsSkipped',
+      if (vectorsFailed > 0) 'vectorsFailed: $vectorsFailed',
+      'elapsedTime: $elapsedTime',
+      'embeddingTime: $embeddingTime',
+      'indexingTime: $indexingTime',
+      'valuesPerSecond: ${valuesPerSecond.toStringAsFixed(1)}',
+      if (error != null) 'error: $error',
+    ].join(', '),
+    ')',
+  ].join();
+}
+
+/// Worker which updates a lazy vector index in the background, until it is
+/// up-to-date.
+///
+/// {@macro cbl.EncryptionKey.enterpriseFeature}
+///
+/// Only vector indexes can be lazy ([VectorIndexConfiguration.lazy]).
+///
+/// The worker runs on a native thread and repeatedly begins an update of the
+/// index, passes the values which need to be indexed as one batch to an
+/// [IndexEmbedder] and updates the index with the returned vectors. Only the
+/// embedding of the values happens on the isolate which started the worker.
+///
+/// Workers are started with [SyncQueryIndex.startUpdateWorker].
+///
+/// {@category Query}
+/// {@category Enterprise Edition}
+abstract interface class IndexUpdateWorker {
+  /// The current progress of the worker.
+  IndexUpdateProgress get progress;
+
+  /// Completes with the final progress of the worker, once it has stopped.
+  ///
+  /// If the worker stopped because of an error, the future completes with
+  /// that error.
+  Future<IndexUpdateProgress> get done;
+
+  /// Requests the worker to stop after the current batch.
+  ///
+  /// Use [done] to wait for the worker to stop.
+  void stop();
+}
@@ -4,6 +4,7 @@ import 'package:meta/meta.dart';
 
 import '../../database.dart';
 import 'index_configuration.dart';
+import 'index_update_worker.dart';
 import 'index_updater.dart';
 
 /// An existing index in a [Collection].
@@ -41,6 +42,18 @@ abstract interface class SyncQueryIndex implements QueryIndex {
   @override
   @useResult
   SyncIndexUpdater? beginUpdate({required int limit});
+
+  /// Starts an [IndexUpdateWorker] which updates this lazy index in the
+  /// background, until it is up-to-date.
+  ///
+  /// {@macro cbl.EncryptionKey.enterpriseFeature}
+  ///
+  /// The values which need to be indexed are passed to [embed] in batches of
+  /// up to [batchSize] values.
+  IndexUpdateWorker startUpdateWorker({
+    required IndexEmbedder embed,
+    int batchSize = 64,
+  });
 }
 
 /// A [QueryIndex] with a primarily asynchronous API.
@@ -92,6 +92,110 @@ abstract interface class PredictiveModel {
   Dictionary? predict(Dictionary input);
 }
 
+/// A [PredictiveModel] which can compute multiple predictions at once.
+///
+/// {@macro cbl.EncryptionKey.enterpriseFeature}
+///
+/// Predictions are requested one input at a time while a query is executed.
+/// When predictions are requested concurrently from threads other than the one
+/// of the isolate in which the model is registered, the inputs are combined
+/// into batches and passed to [predictBatch], instead of calling [predict] for
+/// each input. This reduces the overhead of calling into the isolate and allows
+/// the model to process multiple inputs at once, for example on a GPU.
+///
+/// Predictions which are requested on the thread of the isolate in which the
+/// model is registered are always computed with [predict].
+///
+/// {@category Query}
+/// {@category Enterprise Edition}
+abstract interface class BatchPredictiveModel implements PredictiveModel {
+  /// Invokes the model with the given [inputs] and returns the prediction
+  /// results in the same order.
+  ///
+  /// The returned list must have the same length as [inputs]. A `null` result
+  /// is evaluated as `MISSING`.
+  ///
+  /// If the model throws an exception, the exception will be caught and logged
+  /// and all predictions of the batch will be evaluated as `MISSING`.
+  List<Dictionary?> predictBatch(List<Dictionary> inputs);
+}
+
+/// Configuration of the cache of a [PredictiveModel].
+///
+/// {@macro cbl.EncryptionKey.enterpriseFeature}
+///
+/// Queries and indexes which use a model often request predictions for the
+/// same inputs repeatedly. The cache stores the outputs of the model natively,
+/// so that predictions for inputs which are found in the cache are returned
+/// without calling the model.
+///
+/// Inputs are compared by their content. Outputs which are `null` are not
+/// cached.
+///
+/// {@category Query}
+/// {@category Enterprise Edition}
+final class PredictionCacheConfiguration {
+  /// Creates a configuration for the cache of a [PredictiveModel].
+  const PredictionCacheConfiguration({required this.maxSize, this.timeToLive});
+
+  /// The maximum number of bytes that are used by the cached entries.
+  ///
+  /// When the cache is full, the least recently used entries are evicted.
+  final int maxSize;
+
+  /// The duration after which cached entries expire, or `null` if entries
+  /// don't expire.
+  final Duration? timeToLive;
+}
+
+/// Statistics of the cache of a [PredictiveModel].
+///
+/// {@macro cbl.EncryptionKey.enterpriseFeature}
+///
+/// {@category Query}
+/// {@category Enterprise Edition}
+final class PredictionCacheStats {
+  /// Creates statistics of the cache of a [PredictiveModel].
+  const PredictionCacheStats({
+    required this.hits,
+    required this.misses,
+    required this.evictions,
+    required this.entryCount,
+    required this.size,
+  });
+
+  /// The number of predictions which were found in the cache.
+  final int hits;
+
+  /// The number of predictions which were not found in the cache.
+  final int misses;
+
+  /// The number of entries which were evicted because the cache was full.
+  final int evictions;
+
+  /// The number of entries in the cache.
+  final int entryCount;
+
+  /// The approximate number of bytes used by the entries in the cache.
+  final int size;
+
+  /// The ratio of [hits] to all lookups, or `0` if there have been no lookups.
+  double get hitRate {
+    final lookups = hits + misses;
+    return lookups == 0 ? 0 : hits / lookups;
+  }
+
+  @override
+  String toString() =>
+      'PredictionCacheStats('
+      'hits: $hits, '
+      'misses: $misses, '
+      'evictions: $evictions, '
+      'entryCount: $entryCount, '
+      'size: $size'
+      ')';
+}
+
 /// Manager for registering and unregistering [PredictiveModel]s.
 ///
 /// {@macro cbl.EncryptionKey.enterpriseFeature}
@@ -111,26 +215,110 @@ abstract final class Prediction {
   /// perform their predictions in the isolate where they are registered in. To
   /// offload the prediction work from the main isolate, consider registering
   /// the model in a separate isolate.
-  void registerModel(String name, PredictiveModel model);
+  ///
+  /// If [model] is a [BatchPredictiveModel], [maxBatchSize] limits the number
+  /// of inputs which are passed to [BatchPredictiveModel.predictBatch] at once.
+  ///
+  /// If [cache] is provided, the outputs of the model are cached as described
+  /// by [PredictionCacheConfiguration].
+  void registerModel(
+    String name,
+    PredictiveModel model, {
+    int maxBatchSize = 64,
+    PredictionCacheConfiguration? cache,
+  });
 
   /// Unregisters the [PredictiveModel] with the given [name].
   ///
   /// If no model is registered with the given [name], this method does nothing.
   void unregisterModel(String name);
+
+  /// Returns the statistics of the cache of the [PredictiveModel] with the
+  /// given [name].
+  ///
+  /// Returns `null` if no model with a cache is registered with the given
+  /// [name] in the current [Isolate].
+  PredictionCacheStats? cacheStats(String name);
+
+  /// Removes all entries from the cache of the [PredictiveModel] with the given
+  /// [name].
+  ///
+  /// If no model with a cache is registered with the given [name] in the
+  /// current [Isolate], this method does nothing.
+  void clearCache(String name);
 }
 
 final class PredictionImpl implements Prediction {
   @override
-  void registerModel(String name, PredictiveModel model) {
+  void registerModel(
+    String name,
+    PredictiveModel model, {
+    int maxBatchSize = 64,
+    PredictionCacheConfiguration? cache,
+  }) {
     requireEnterprise('Prediction');
-    _FfiPredictiveModel(name, model);
+    if (maxBatchSize <= 0) {
+      throw ArgumentError.value(
+        maxBatchSize,
+        'maxBatchSize',
+        'must be positive',
+      );
+    }
+    if (cache != null) {
+      if (cache.maxSize <= 0) {
+        throw ArgumentError.value(
+          cache.maxSize,
+          'cache.maxSize',
+          'must be positive',
+        );
+      }
+      final timeToLive = cache.timeToLive;
+      if (timeToLive != null && timeToLive.inMilliseconds <= 0) {
+        throw ArgumentError.value(
+          timeToLive,
+          'cache.timeToLive',
+          'must be at least one millisecond',
+        );
+      }
+    }
+    _FfiPredictiveModel(name, model, maxBatchSize, cache);
   }
 
   @override
   void unregisterModel(String name) {
     requireEnterprise('Prediction');
+    _FfiPredictiveModel._registered.remove(name);
     QueryBindings.unregisterPredictiveModel(name);
   }
+
+  @override
+  PredictionCacheStats? cacheStats(String name) {
+    requireEnterprise('Prediction');
+    final model = _FfiPredictiveModel._registered[name];
+    if (model == null) {
+      return null;
+    }
+    final stats = QueryBindings.predictiveModelCacheStats(model._pointer);
+    if (stats == null) {
+      return null;
+    }
+    return PredictionCacheStats(
+      hits: stats.hits,
+      misses: stats.misses,
+      evictions: stats.evictions,
+      entryCount: stats.entryCount,
+      size: stats.size,
+    );
+  }
+
+  @override
+  void clearCache(String name) {
+    requireEnterprise('Prediction');
+    final model = _FfiPredictiveModel._registered[name];
+    if (model != null) {
+      QueryBindings.clearPredictiveModelCache(model._pointer);
+    }
+  }
 }
 
 // ignore: avoid_private_typedef_functions
@@ -138,74 +326,144 @@ typedef _CBLPredictionFunctionSync = FLMutableDict Function(FLDict input);
 // ignore: avoid_private_typedef_functions
 typedef _CBLPredictionFunctionAsync =
     Void Function(FLDict input, CBLDart_Completer completer);
+// ignore: avoid_private_typedef_functions
+typedef _CBLPredictionFunctionBatchAsync =
+    Void Function(
+      Pointer<FLDict> inputs,
+      Pointer<FLMutableDict> outputs,
+      Uint32 count,
+      CBLDart_Completer completer,
+    );
 
 class _FfiPredictiveModel implements Finalizable {
-  _FfiPredictiveModel(this._name, this._model) {
-    final model = QueryBindings.createPredictiveModel(
+  _FfiPredictiveModel(
+    this._name,
+    this._model,
+    int maxBatchSize,
+    PredictionCacheConfiguration? cache,
+  ) {
+    _pointer = QueryBindings.createPredictiveModel(
       _name,
       _predictionSyncCallable.nativeFunction,
       _predictionAsyncCallable.nativeFunction,
+      _predictionBatchAsyncCallable?.nativeFunction,
+      maxBatchSize,
+      cache?.maxSize ?? 0,
+      cache?.timeToLive,
       _unregisteredCallable.nativeFunction,
     );
-    QueryBindings.bindCBLDartPredictiveModelToDartObject(this, model);
+    QueryBindings.bindCBLDartPredictiveModelToDartObject(this, _pointer);
+    _registered[_name] = this;
   }
 
+  /// The models which are currently registered in this isolate, by name.
+  static final _registered = <String, _FfiPredictiveModel>{};
+
+  late final CBLDart_PredictiveModel _pointer;
   final String _name;
   final PredictiveModel _model;
   late final NativeCallable<_CBLPredictionFunctionSync>
   _predictionSyncCallable = NativeCallable.isolateLocal(_predictionSync);
   late final NativeCallable<_CBLPredictionFunctionAsync>
   _predictionAsyncCallable = NativeCallable.listener(_predictionAsync);
+  late final NativeCallable<_CBLPredictionFunctionBatchAsync>?
+  _predictionBatchAsyncCallable = _model is BatchPredictiveModel
+      ? NativeCallable.listener(_predictionBatchAsync)
+      : null;
   late final NativeCallable<Void Function()> _unregisteredCallable =
       NativeCallable.listener(_unregistered);
 
   FLMutableDict _predictionSync(FLDict input) {
     try {
-      final inputRoot = MRoot.fromContext(
-        MContext(data: fl.Dict.fromPointer(input, isRefCounted: false)),
-        isMutable: false,
-      );
-
-      final outputDict =
-          _model.predict(inputRoot.asNative! as Dictionary) as DictionaryImpl?;
-
-      if (outputDict == null) {
-        return nullptr;
-      }
+      return _encodeOutput(_model.predict(_decodeInput(input)));
+      // ignore: avoid_catches_without_on_clauses
+    } catch (error, stackTrace) {
+      _logError(error, stackTrace);
+      return nullptr;
+    }
+  }
 
-      final outputData = FleeceEncoder.fleece.encodeWith(outputDict.encodeTo);
+  void _predictionAsync(FLDict input, CBLDart_Completer completer) {
+    final result = _predictionSync(input);
+    BaseBindings.completeCompleterWithPointer(completer, result.cast());
+  }
 
-      final outputDoc = fl.Doc.fromResultData(outputData, FLTrust.trusted);
-      final outputMutableDict = fl.MutableDict.mutableCopy(
-        outputDoc.root.asDict!,
-      );
+  void _predictionBatchAsync(
+    Pointer<FLDict> inputs,
+    Pointer<FLMutableDict> outputs,
+    int count,
+    CBLDart_Completer completer,
+  ) {
+    try {
+      final outputDicts = (_model as BatchPredictiveModel).predictBatch([
+        for (var i = 0; i < count; i++) _decodeInput(inputs[i]),
+      ]);
 
-      // The caller is responsible for releasing the returned value.
-      ValueBindings.retain(outputMutableDict.pointer.cast());
+      if (outputDicts.length != count) {
+        throw StateError(
+          'predictBatch returned ${outputDicts.length} results for $count '
+          'inputs.',
+        );
+      }
 
-      return outputMutableDict.pointer.cast();
+      // Outputs which have been stored are owned by the caller, even if
+      // encoding a later output fails.
+      for (var i = 0; i < count; i++) {
+        outputs[i] = _encodeOutput(outputDicts[i]);
+      }
       // ignore: avoid_catches_without_on_clauses
     } catch (error, stackTrace) {
-      LoggingBindings.logMessage(
-        CBLLogDomain.database,
-        CBLLogLevel.error,
-        'Uncaught exception in predictive model:\n'
-        '$_model\n'
-        '$error\n'
-        '$stackTrace',
-      );
+      _logError(error, stackTrace);
+    } finally {
+      BaseBindings.completeCompleterWithPointer(completer, nullptr);
+    }
+  }
+
+  Dictionary _decodeInput(FLDict input) {
+    final inputRoot = MRoot.fromContext(
+      MContext(data: fl.Dict.fromPointer(input, isRefCounted: false)),
+      isMutable: false,
+    );
+    return inputRoot.asNative! as Dictionary;
+  }
+
+  FLMutableDict _encodeOutput(Dictionary? output) {
+    final outputDict = output as DictionaryImpl?;
+    if (outputDict == null) {
       return nullptr;
     }
+
+    final outputData = FleeceEncoder.fleece.encodeWith(outputDict.encodeTo);
+
+    final outputDoc = fl.Doc.fromResultData(outputData, FLTrust.trusted);
+    final outputMutableDict = fl.MutableDict.mutableCopy(
+      outputDoc.root.asDict!,
+    );
+
+    // The caller is responsible for releasing the returned value.
+    ValueBindings.retain(outputMutableDict.pointer.cast());
+
+    return outputMutableDict.pointer.cast();
   }
 
-  void _predictionAsync(FLDict input, CBLDart_Completer completer) {
-    final result = _predictionSync(input);
-    BaseBindings.completeCompleterWithPointer(completer, result.cast());
+  void _logError(Object error, StackTrace stackTrace) {
+    LoggingBindings.logMessage(
+      CBLLogDomain.database,
+      CBLLogLevel.error,
+      'Uncaught exception in predictive model:\n'
+      '$_model\n'
+      '$error\n'
+      '$stackTrace',
+    );
   }
 
   void _unregistered() {
+    if (identical(_registered[_name], this)) {
+      _registered.remove(_name);
+    }
     _predictionSyncCallable.close();
     _predictionAsyncCallable.close();
+    _predictionBatchAsyncCallable?.close();
     _unregisteredCallable.close();
   }
 }
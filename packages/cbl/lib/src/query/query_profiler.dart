@@ -0,0 +1,161 @@
+import 'dart:convert';
+
+import '../bindings.dart';
+
+/// The kind of operation a [QueryProfile] was recorded for.
+///
+/// {@category Query}
+enum QueryProfileKind {
+  /// The compilation of a query.
+  compile,
+
+  /// The execution of a query and the iteration over its results.
+  execute,
+}
+
+/// A profile of the compilation or execution of a query, recorded by the
+/// [QueryProfiler].
+///
+/// {@category Query}
+final class QueryProfile {
+  QueryProfile._({
+    required this.kind,
+    required this.queryId,
+    required this.query,
+    required this.plan,
+    required this.startTime,
+    required this.duration,
+    required this.firstRowLatency,
+    required this.iterationTime,
+    required this.rows,
+    required this.bytes,
+    required this.exhausted,
+  });
+
+  factory QueryProfile._fromJson(Map<String, Object?> json) => QueryProfile._(
+    kind: QueryProfileKind.values.byName(json['kind']! as String),
+    queryId: json['queryId']! as int,
+    query: json['query'] as String?,
+    plan: json['plan'] as String?,
+    startTime: json['startTime']! as int,
+    duration: Duration(microseconds: json['duration']! as int),
+    firstRowLatency: switch (json['firstRowTime'] as int?) {
+      final time? when time >= 0 => Duration(microseconds: time),
+      _ => null,
+    },
+    iterationTime: switch (json['iterationTime'] as int?) {
+      final time? => Duration(microseconds: time),
+      null => null,
+    },
+    rows: json['rows'] as int? ?? 0,
+    bytes: json['bytes'] as int? ?? 0,
+    exhausted: json['exhausted'] as bool? ?? false,
+  );
+
+  /// The kind of operation this profile was recorded for.
+  final QueryProfileKind kind;
+
+  /// An id which identifies the query across multiple profiles.
+  final int queryId;
+
+  /// The query string of the query, if it was compiled while the profiler was
+  /// enabled.
+  final String? query;
+
+  /// The query plan of the query, if it was compiled while the profiler was
+  /// enabled.
+  final String? plan;
+
+  /// The start of the operation in microseconds on the monotonic clock, which
+  /// is also used by `dart:developer`'s `Timeline`.
+  final int startTime;
+
+  /// How long it took to compile or execute the query.
+  final Duration duration;
+
+  /// How long it took from the start of the execution until the first row was
+  /// available, or `null` if no rows were read.
+  final Duration? firstRowLatency;
+
+  /// How long the results were iterated over after the execution.
+  final Duration? iterationTime;
+
+  /// The number of rows which were read from the results.
+  final int rows;
+
+  /// The approximate number of bytes of the values of all rows which were
+  /// read from the results.
+  final int bytes;
+
+  /// Whether all rows of the results were read.
+  final bool exhausted;
+
+  @override
+  String toString() => [
+    'QueryProfile(',
+    [
+      kind.name,
+      'queryId: $queryId',
+      'duration: $duration',
+      if (firstRowLatency != null) 'firstRowLatency: $firstRowLatency',
+      if (iterationTime != null) 'iterationTime: $iterationTime',
+      if (kind == QueryProfileKind.execute) ...[
+        'rows: $rows',
+        'bytes: $bytes',
+        'exhausted: $exhausted',
+      ],
+      if (query != null) 'query: $query',
+    ].join(', '),
+    ')',
+  ].join();
+}
+
+/// Profiler which records how long it takes to compile and execute queries.
+///
+/// The profiler is implemented natively and records all queries of the
+/// process, including queries which are executed in worker isolates. The most
+/// recent profiles are kept in a fixed size ring buffer.
+///
+/// While the profiler is disabled, it has practically no overhead.
+///
+/// {@category Query}
+abstract final class QueryProfiler {
+  /// Whether the profiler is currently enabled.
+  static bool get isEnabled => QueryProfilerBindings.isEnabled();
+
+  /// Enables the profiler, which keeps the most recent [capacity] profiles.
+  ///
+  /// Profiles which have been recorded before are discarded if [capacity]
+  /// differs from the capacity the profiler was previously enabled with.
+  static void enable({int capacity = 1024}) {
+    if (capacity <= 0) {
+      throw ArgumentError.value(capacity, 'capacity', 'must be positive');
+    }
+    QueryProfilerBindings.enable(capacity);
+  }
+
+  /// Disables the profiler.
+  ///
+  /// Profiles which have already been recorded are kept.
+  static void disable() => QueryProfilerBindings.disable();
+
+  /// Discards all profiles which have been recorded so far.
+  static void clear() => QueryProfilerBindings.clear();
+
+  /// Returns the profiles which are currently held by the profiler, from
+  /// oldest to newest.
+  static List<QueryProfile> snapshot() {
+    final json =
+        jsonDecode(QueryProfilerBindings.snapshot()) as Map<String, Object?>;
+    return (json['records']! as List<Object?>)
+        .cast<Map<String, Object?>>()
+        .map(QueryProfile._fromJson)
+        .toList();
+  }
+
+  /// Returns the profiles which are currently held by the profiler in the
+  /// Chrome trace event JSON format.
+  ///
+  /// The result can be loaded into `chrome://tracing` or Perfetto.
+  static String chromeTrace() => QueryProfilerBindings.chromeTrace();
+}
@@ -0,0 +1,192 @@
+import 'dart:typed_data';
+
+import '../bindings.dart';
+
+/// A metric for the distance between two vectors.
+///
+/// {@category Query}
+enum VectorDistanceMetric {
+  /// The squared Euclidean distance.
+  euclideanSquared(CBLDartVectorDistanceMetric.euclideanSquared),
+
+  /// The Euclidean distance.
+  euclidean(CBLDartVectorDistanceMetric.euclidean),
+
+  /// One minus the cosine similarity.
+  cosine(CBLDartVectorDistanceMetric.cosine),
+
+  /// The negated dot product.
+  dot(CBLDartVectorDistanceMetric.dot),
+
+  /// The number of bits in which the binary representations of the vectors
+  /// differ.
+  ///
+  /// This metric is meant for binary vectors, which are packed into an
+  /// [Int8List].
+  hamming(CBLDartVectorDistanceMetric.hamming);
+
+  const VectorDistanceMetric(this._value);
+
+  final CBLDartVectorDistanceMetric _value;
+}
+
+/// A vector which has been found by [VectorDistance.topK].
+///
+/// {@category Query}
+final class VectorMatch {
+  /// Creates a vector match.
+  const VectorMatch(this.index, this.distance);
+
+  /// The index of the vector in the list of candidates.
+  final int index;
+
+  /// The distance of the vector to the query vector.
+  final double distance;
+
+  @override
+  bool operator ==(Object other) =>
+      identical(this, other) ||
+      other is VectorMatch &&
+          index == other.index &&
+          distance == other.distance;
+
+  @override
+  int get hashCode => Object.hash(index, distance);
+
+  @override
+  String toString() => 'VectorMatch(index: $index, distance: $distance)';
+}
+
+/// Functions for computing the distances between vectors, for example to
+/// rerank the results of a vector search.
+///
+/// The functions are implemented natively and use the SIMD instructions
+/// (AVX2, SSE or NEON) which are supported by the CPU.
+///
+/// Vectors can be given as:
+///
+/// - [Float32List] for single precision floats,
+/// - [Uint16List] for the bits of IEEE 754 half precision floats, and
+/// - [Int8List] for quantized or binary vectors.
+///
+/// All vectors which are compared must be of the same type and length.
+///
+/// {@category Query}
+abstract final class VectorDistance {
+  /// Returns the distance between the vectors [a] and [b].
+  static double distance(
+    TypedData a,
+    TypedData b, {
+    VectorDistanceMetric metric = VectorDistanceMetric.cosine,
+  }) {
+    final elementType = _elementType(a);
+    final dimensions = _dimensions(a, elementType);
+    _checkVector(b, elementType, dimensions, 'b');
+    return VectorDistanceBindings.distance(
+      metric._value,
+      elementType,
+      a,
+      b,
+      dimensions,
+    );
+  }
+
+  /// Returns the distances between [query] and each of the [candidates].
+  static Float32List distances(
+    TypedData query,
+    List<TypedData> candidates, {
+    VectorDistanceMetric metric = VectorDistanceMetric.cosine,
+  }) {
+    final elementType = _elementType(query);
+    final dimensions = _dimensions(query, elementType);
+    _checkCandidates(candidates, elementType, dimensions);
+    if (candidates.isEmpty) {
+      return Float32List(0);
+    }
+    return VectorDistanceBindings.batch(
+      metric._value,
+      elementType,
+      query,
+      candidates,
+      dimensions,
+    );
+  }
+
+  /// Returns the [k] [candidates] which are closest to [query], ordered from
+  /// closest to farthest.
+  ///
+  /// If there are fewer than [k] candidates, all candidates are returned.
+  static List<VectorMatch> topK(
+    TypedData query,
+    List<TypedData> candidates, {
+    required int k,
+    VectorDistanceMetric metric = VectorDistanceMetric.cosine,
+  }) {
+    if (k <= 0) {
+      throw ArgumentError.value(k, 'k', 'must be positive');
+    }
+
+    final elementType = _elementType(query);
+    final dimensions = _dimensions(query, elementType);
+    _checkCandidates(candidates, elementType, dimensions);
+    if (candidates.isEmpty) {
+      return [];
+    }
+    final (indexes, distances) = VectorDistanceBindings.topK(
+      metric._value,
+      elementType,
+      query,
+      candidates,
+      dimensions,
+      k,
+    );
+
+    return [
+      for (var i = 0; i < indexes.length; i++)
+        VectorMatch(indexes[i], distances[i]),
+    ];
+  }
+
+  static CBLDartVectorElementType _elementType(TypedData vector) =>
+      switch (vector) {
+        Float32List() => CBLDartVectorElementType.float32,
+        Uint16List() => CBLDartVectorElementType.float16,
+        Int8List() => CBLDartVectorElementType.int8,
+        _ => throw ArgumentError.value(
+          vector,
+          'vector',
+          'must be a Float32List, Uint16List or Int8List',
+        ),
+      };
+
+  static int _dimensions(
+    TypedData vector,
+    CBLDartVectorElementType elementType,
+  ) => vector.lengthInBytes ~/ elementType.size;
+
+  static void _checkVector(
+    TypedData vector,
+    CBLDartVectorElementType elementType,
+    int dimensions,
+    String name,
+  ) {
+    if (_elementType(vector) != elementType ||
+        _dimensions(vector, elementType) != dimensions) {
+      throw ArgumentError.value(
+        vector,
+        name,
+        'must have the same type and length as the other vectors',
+      );
+    }
+  }
+
+  static void _checkCandidates(
+    List<TypedData> candidates,
+    CBLDartVectorElementType elementType,
+    int dimensions,
+  ) {
+    for (var i = 0; i < candidates.length; i++) {
+      _checkVector(candidates[i], elementType, dimensions, 'candidates[$i]');
+    }
+  }
+}
@@ -2,6 +2,7 @@ import 'dart:async';
 import 'dart:convert';
 
 import '../bindings.dart';
+import '../database/bulk_document_progress.dart';
 import '../database/collection.dart';
 import '../database/database.dart';
 import '../database/database_configuration.dart';
@@ -149,7 +150,7 @@ final class CblServiceClient {
       _getDocumentChangeListenerById(request.listenerId)(request);
 
   Stream<SendableData> _readBlobUpload(ReadBlobUpload request) =>
-      _takeBlobUploadById(request.uploadId).map(SendableData.new);
+      _takeBlobUploadById(request.uploadId).map(SendableData.handOver);
 
   void _callQueryChangeListener(CallQueryChangeListener request) =>
       _getQueryChangeListenerById(request.listenerId)(request);
@@ -266,13 +267,17 @@ final class CblService {
       ..addCallEndpoint(_getCollectionIndexNames)
       ..addCallEndpoint(_getCollectionIndex)
       ..addCallEndpoint(_getDocument)
+      ..addCallEndpoint(_getDocuments)
       ..addCallEndpoint(_saveDocument)
+      ..addCallEndpoint(_saveDocuments)
       ..addCallEndpoint(_deleteDocument)
       ..addCallEndpoint(_purgeDocument)
       ..addCallEndpoint(_beginDatabaseTransaction)
       ..addCallEndpoint(_endDatabaseTransaction)
       ..addCallEndpoint(_setDocumentExpiration)
       ..addCallEndpoint(_getDocumentExpiration)
+      ..addStreamEndpoint(_purgeDocuments)
+      ..addStreamEndpoint(_setDocumentsExpiration)
       ..addCallEndpoint(_performDatabaseMaintenance)
       ..addCallEndpoint(_changeDatabaseEncryptionKey)
       ..addCallEndpoint(_addCollectionChangeListener)
@@ -473,6 +478,19 @@ final class CblService {
     );
   }
 
+  Future<DocumentStates> _getDocuments(GetDocuments request) async {
+    final collection = _getCollectionById(request.collectionId);
+    final documents = collection.documents(request.documentIds);
+
+    return DocumentStates([
+      for (final document in documents.cast<DelegateDocument?>())
+        await document?.createState(
+          withProperties: true,
+          objectRegistry: _objectRegistry,
+        ),
+    ]);
+  }
+
   Future<DocumentState?> _saveDocument(SaveDocument request) async {
     final collection = _getCollectionById(request.collectionId);
 
@@ -502,6 +520,39 @@ final class CblService {
     );
   }
 
+  Future<List<DocumentState?>> _saveDocuments(SaveDocuments request) async {
+    final collection = _getCollectionById(request.collectionId);
+
+    // Documents which already conflict are excluded from the batch.
+    final documents = [
+      for (var i = 0; i < request.states.length; i++)
+        _getDocumentForUpdate<MutableDelegateDocument>(
+          request.states[i],
+          concurrencyControl: request.concurrencyControls[i],
+        )?..setEncodedProperties(request.states[i].properties!.encodedValue!),
+    ];
+
+    final saved = collection.saveDocumentsWithConcurrencyControl(
+      documents.nonNulls.toList(),
+      [
+        for (var i = 0; i < documents.length; i++)
+          if (documents[i] != null) request.concurrencyControls[i],
+      ],
+    );
+
+    var i = 0;
+    return [
+      for (final document in documents)
+        if (document != null && saved[i++])
+          await document.createState(
+            withProperties: false,
+            objectRegistry: _objectRegistry,
+          )
+        else
+          null,
+    ];
+  }
+
   Future<DocumentState?> _deleteDocument(DeleteDocument request) async {
     final collection = _getCollectionById(request.collectionId);
 
@@ -551,6 +602,19 @@ final class CblService {
         request.collectionId,
       ).getDocumentExpiration(request.documentId);
 
+  Stream<BulkDocumentProgress> _purgeDocuments(PurgeDocuments request) =>
+      _getCollectionById(
+        request.collectionId,
+      ).purgeDocuments(request.documentIds, chunkSize: request.chunkSize);
+
+  Stream<BulkDocumentProgress> _setDocumentsExpiration(
+    SetDocumentsExpiration request,
+  ) => _getCollectionById(request.collectionId).setDocumentsExpiration(
+    request.documentIds,
+    request.expiration,
+    chunkSize: request.chunkSize,
+  );
+
   void _performDatabaseMaintenance(PerformDatabaseMaintenance request) =>
       _getDatabaseById(request.databaseId).performMaintenance(request.type);
 
@@ -598,9 +662,10 @@ final class CblService {
     request.databaseId,
   ).blobStore.blobExists(request.properties);
 
-  Stream<SendableData> _readBlob(ReadBlob request) => _getDatabaseById(
-    request.databaseId,
-  ).blobStore.readBlob(request.properties)!.map(SendableData.new);
+  Stream<SendableData> _readBlob(ReadBlob request) =>
+      _getDatabaseById(request.databaseId).blobStore
+          .readBlob(request.properties, request.options)!
+          .map(SendableData.handOver);
 
   Future<SaveBlobResponse> _saveBlob(SaveBlob request) async {
     final stream = channel
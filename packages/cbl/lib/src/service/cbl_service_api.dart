@@ -8,6 +8,7 @@ import '../bindings.dart';
 import '../bindings/cblite.dart' as cblite;
 import '../database.dart';
 import '../database/database_configuration.dart';
+import '../document/blob.dart' show BlobReadOptions;
 import '../fleece/containers.dart';
 import '../replication/authenticator.dart';
 import '../replication/configuration.dart';
@@ -163,6 +164,13 @@ final class GetDocument extends Request<DocumentState?> {
   final String documentId;
 }
 
+final class GetDocuments extends Request<DocumentStates> {
+  GetDocuments(this.collectionId, this.documentIds);
+
+  final int collectionId;
+  final List<String> documentIds;
+}
+
 final class SaveDocument extends Request<DocumentState?> implements SendAware {
   SaveDocument(this.collectionId, this.state, this.concurrencyControl);
 
@@ -177,6 +185,29 @@ final class SaveDocument extends Request<DocumentState?> implements SendAware {
   void didReceive() => state.didReceive();
 }
 
+final class SaveDocuments extends Request<List<DocumentState?>>
+    implements SendAware {
+  SaveDocuments(this.collectionId, this.states, this.concurrencyControls);
+
+  final int collectionId;
+  final List<DocumentState> states;
+  final List<ConcurrencyControl> concurrencyControls;
+
+  @override
+  void willSend() {
+    for (final state in states) {
+      state.willSend();
+    }
+  }
+
+  @override
+  void didReceive() {
+    for (final state in states) {
+      state.didReceive();
+    }
+  }
+}
+
 final class DeleteDocument extends Request<DocumentState?>
     implements SendAware {
   DeleteDocument(this.collectionId, this.state, this.concurrencyControl);
@@ -224,6 +255,32 @@ final class SetDocumentExpiration extends Request<Null> {
   final DateTime? expiration;
 }
 
+final class PurgeDocuments extends Request<BulkDocumentProgress> {
+  PurgeDocuments({
+    required this.collectionId,
+    required this.documentIds,
+    required this.chunkSize,
+  });
+
+  final int collectionId;
+  final List<String> documentIds;
+  final int chunkSize;
+}
+
+final class SetDocumentsExpiration extends Request<BulkDocumentProgress> {
+  SetDocumentsExpiration({
+    required this.collectionId,
+    required this.documentIds,
+    required this.expiration,
+    required this.chunkSize,
+  });
+
+  final int collectionId;
+  final List<String> documentIds;
+  final DateTime? expiration;
+  final int chunkSize;
+}
+
 final class GetDocumentExpiration extends Request<DateTime?> {
   GetDocumentExpiration({required this.collectionId, required this.documentId});
 
@@ -313,10 +370,15 @@ final class BlobExists extends Request<bool> {
 }
 
 final class ReadBlob extends Request<SendableData> {
-  ReadBlob({required this.databaseId, required this.properties});
+  ReadBlob({
+    required this.databaseId,
+    required this.properties,
+    required this.options,
+  });
 
   final int databaseId;
   final StringMap properties;
+  final BlobReadOptions options;
 }
 
 final class SaveBlob extends Request<SaveBlobResponse> {
@@ -720,11 +782,23 @@ final class ReplicatorPendingDocumentIds extends Request<List<String>> {
 // === Responses ===============================================================
 
 final class SendableData implements SendAware {
-  SendableData(Data data) : _data = data;
+  SendableData(Data data) : _data = data, _handOver = false;
+
+  /// Creates a [SendableData] whose native buffer is handed over to the
+  /// receiving isolate, instead of being copied.
+  ///
+  /// [data] is copied into a native buffer once, if it is not already backed
+  /// by one. The receiver gets a mutable view of the buffer, so the sender
+  /// must not use [data] after sending it.
+  SendableData.handOver(Data data)
+    : _data = Data.fromSliceResult(data.toSliceResult()),
+      _handOver = true;
 
   Data get data => _data!;
   Data? _data;
 
+  final bool _handOver;
+
   TransferableData? _transferableData;
 
   @override
@@ -735,7 +809,8 @@ final class SendableData implements SendAware {
 
   @override
   void didReceive() {
-    _data = _transferableData!.materialize();
+    final data = _transferableData!.materialize();
+    _data = _handOver ? Data.fromSliceResultView(data.toSliceResult()) : data;
     _transferableData = null;
   }
 }
@@ -883,6 +958,26 @@ final class DocumentReplicationEvent {
   final List<ReplicatedDocument> documents;
 }
 
+final class DocumentStates implements SendAware {
+  DocumentStates(this.states);
+
+  final List<DocumentState?> states;
+
+  @override
+  void willSend() {
+    for (final state in states) {
+      state?.willSend();
+    }
+  }
+
+  @override
+  void didReceive() {
+    for (final state in states) {
+      state?.didReceive();
+    }
+  }
+}
+
 final class SendableCertificate implements SendAware {
   SendableCertificate(this._certificate);
 
@@ -0,0 +1,613 @@
+/**
+ * Microbenchmarks for the cblitedart shim layer.
+ *
+ * The benchmarks call the shim functions directly, without a Dart VM. The
+ * Dart API functions which the shim uses to talk to Dart are replaced with
+ * stubs, so that the measurements only include the costs of the shim and of
+ * Couchbase Lite.
+ *
+ * Results are written to stdout as JSON, in the same format as the results of
+ * the Dart benchmarks in `packages/benchmark`. Progress is written to stderr.
+ *
+ * Usage: cblitedart_benchmark [--filter <substring>] [--samples <count>]
+ *                             [--list]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/AsyncCallback.h"
+#include "CBL+Dart.h"
+#include "Fleece+Dart.h"
+#include "dart/dart_api_dl.h"
+
+namespace fs = std::filesystem;
+
+using Clock = std::chrono::steady_clock;
+
+// === Dart API stubs =========================================================
+
+/**
+ * Stands in for the Dart VM on the other side of the ports the shim posts to.
+ *
+ * Requests of blocking callback calls are answered from a separate thread,
+ * like the Dart side would, by sending a `null` result to the native port of
+ * the call.
+ */
+class StubDart {
+ public:
+  static StubDart& instance() {
+    static auto instance = new StubDart();
+    return *instance;
+  }
+
+  static void install() {
+    // Starts the responder thread.
+    instance();
+    Dart_PostCObject_DL = &StubDart::postCObject;
+    Dart_NewNativePort_DL = &StubDart::newNativePort;
+    Dart_CloseNativePort_DL = &StubDart::closeNativePort;
+  }
+
+  /** The port to create async callbacks with. */
+  static constexpr Dart_Port kCallbackPort = 1;
+
+  /**
+   * The number of elements in the arguments of all requests which have been
+   * posted so far. For listeners, this is the number of changes which have
+   * been delivered.
+   */
+  uint64_t postedElements() const {
+    return postedElements_.load(std::memory_order_acquire);
+  }
+
+  /** Waits until at least [count] elements have been posted. */
+  bool waitForPostedElements(uint64_t count) {
+    std::unique_lock lock(postedMutex_);
+    return postedCondition_.wait_for(lock, std::chrono::seconds(10), [&]() {
+      return postedElements() >= count;
+    });
+  }
+
+ private:
+  StubDart() : responder_([this]() { respond(); }) { responder_.detach(); }
+
+  static bool postCObject(Dart_Port_DL port, Dart_CObject* message) {
+    return instance().post(port, message);
+  }
+
+  static Dart_Port_DL newNativePort(const char* /*name*/,
+                                    Dart_NativeMessageHandler_DL handler,
+                                    bool /*handleConcurrently*/) {
+    auto& stub = instance();
+    std::scoped_lock lock(stub.portsMutex_);
+    auto port = stub.nextPort_++;
+    stub.ports_[port] = handler;
+    return port;
+  }
+
+  static bool closeNativePort(Dart_Port_DL port) {
+    auto& stub = instance();
+    std::scoped_lock lock(stub.portsMutex_);
+    return stub.ports_.erase(port) == 1;
+  }
+
+  bool post(Dart_Port_DL /*port*/, Dart_CObject* message) {
+    // Requests of callback calls are arrays of the response port, the call
+    // pointer and the arguments.
+    auto values = message->value.as_array.values;
+    auto responsePort = values[0];
+    auto arguments = values[2];
+
+    if (responsePort->type == Dart_CObject_kSendPort) {
+      std::scoped_lock lock(responsesMutex_);
+      responses_.push_back({responsePort->value.as_send_port.id,
+                            values[1]->value.as_int64});
+      responsesCondition_.notify_one();
+    }
+
+    uint64_t elements = arguments->type == Dart_CObject_kArray
+                            ? arguments->value.as_array.length
+                            : 1;
+    {
+      std::scoped_lock lock(postedMutex_);
+      postedElements_.fetch_add(elements, std::memory_order_release);
+    }
+    postedCondition_.notify_all();
+    return true;
+  }
+
+  void respond() {
+    while (true) {
+      Response response;
+      {
+        std::unique_lock lock(responsesMutex_);
+        responsesCondition_.wait(lock,
+                                 [this]() { return !responses_.empty(); });
+        response = responses_.front();
+        responses_.pop_front();
+      }
+
+      Dart_NativeMessageHandler_DL handler = nullptr;
+      {
+        std::scoped_lock lock(portsMutex_);
+        auto it = ports_.find(response.port);
+        if (it != ports_.end()) {
+          handler = it->second;
+        }
+      }
+      if (!handler) {
+        continue;
+      }
+
+      Dart_CObject callPointer{};
+      callPointer.type = Dart_CObject_kInt64;
+      callPointer.value.as_int64 = response.call;
+
+      Dart_CObject result{};
+      result.type = Dart_CObject_kNull;
+
+      Dart_CObject* values[] = {&callPointer, &result};
+      Dart_CObject message{};
+      message.type = Dart_CObject_kArray;
+      message.value.as_array.length = 2;
+      message.value.as_array.values = values;
+
+      handler(response.port, &message);
+    }
+  }
+
+  struct Response {
+    Dart_Port_DL port;
+    int64_t call;
+  };
+
+  std::mutex portsMutex_;
+  std::map<Dart_Port_DL, Dart_NativeMessageHandler_DL> ports_;
+  Dart_Port_DL nextPort_ = kCallbackPort + 1;
+
+  std::mutex postedMutex_;
+  std::condition_variable postedCondition_;
+  std::atomic<uint64_t> postedElements_{0};
+
+  std::mutex responsesMutex_;
+  std::condition_variable responsesCondition_;
+  std::deque<Response> responses_;
+
+  std::thread responder_;
+};
+
+// === Harness ================================================================
+
+/**
+ * A benchmark which performs the given number of operations.
+ *
+ * [setUp] and [tearDown] are called once around all samples of the benchmark
+ * and are not measured.
+ */
+struct Benchmark {
+  std::string name;
+  std::function<void(uint64_t operations)> run;
+  std::function<void()> setUp = []() {};
+  std::function<void()> tearDown = []() {};
+};
+
+struct BenchmarkResult {
+  std::string name;
+  double medianNs;
+  double minNs;
+  double maxNs;
+  double throughput;
+};
+
+/** The minimum duration of a sample, to keep the timer resolution small. */
+static constexpr std::chrono::milliseconds kMinSampleTime{5};
+
+/** Doubles the operations per sample until a sample takes long enough. */
+static uint64_t calibrate(const Benchmark& benchmark) {
+  uint64_t operations = 1;
+  while (true) {
+    auto start = Clock::now();
+    benchmark.run(operations);
+    if (Clock::now() - start >= kMinSampleTime || operations >= (1ull << 30)) {
+      return operations;
+    }
+    operations *= 2;
+  }
+}
+
+static BenchmarkResult measure(const Benchmark& benchmark, uint32_t samples) {
+  benchmark.setUp();
+  auto operations = calibrate(benchmark);
+
+  std::vector<double> nsPerOperation;
+  nsPerOperation.reserve(samples);
+  Clock::duration total{};
+  for (uint32_t i = 0; i < samples; i++) {
+    auto start = Clock::now();
+    benchmark.run(operations);
+    auto elapsed = Clock::now() - start;
+    total += elapsed;
+    nsPerOperation.push_back(
+        std::chrono::duration<double, std::nano>(elapsed).count() /
+        static_cast<double>(operations));
+  }
+
+  benchmark.tearDown();
+
+  std::sort(nsPerOperation.begin(), nsPerOperation.end());
+  auto totalSeconds = std::chrono::duration<double>(total).count();
+  return {
+      benchmark.name,
+      nsPerOperation[nsPerOperation.size() / 2],
+      nsPerOperation.front(),
+      nsPerOperation.back(),
+      static_cast<double>(operations) * samples / totalSeconds,
+  };
+}
+
+static void printResults(const std::vector<BenchmarkResult>& results) {
+  std::printf("{");
+  for (size_t i = 0; i < results.size(); i++) {
+    auto& result = results[i];
+    std::printf(
+        "%s\n  \"native_%s\": {\n"
+        "    \"latency\": {\"name\": \"latency\", \"value\": %.3f, "
+        "\"upper_value\": %.3f, \"lower_value\": %.3f},\n"
+        "    \"throughput\": {\"name\": \"throughput\", \"value\": %.3f}\n"
+        "  }",
+        i == 0 ? "" : ",", result.name.c_str(), result.medianNs,
+        result.maxNs, result.minNs, result.throughput);
+  }
+  std::printf("\n}\n");
+}
+
+static void check(bool success, const CBLError& error, const char* what) {
+  if (success) {
+    return;
+  }
+  auto message = CBLError_Message(&error);
+  std::fprintf(stderr, "%s failed: %.*s\n", what,
+               static_cast<int>(message.size),
+               static_cast<const char*>(message.buf));
+  FLSliceResult_Release(message);
+  std::exit(1);
+}
+
+const void* volatile doNotOptimizeSink = nullptr;
+
+/** Prevents the compiler from optimizing away [value]. */
+template <typename T>
+static void doNotOptimize(const T& value) {
+  doNotOptimizeSink = &value;
+}
+
+// === Fixtures ===============================================================
+
+/** A Fleece document with a dict of mixed values and a nested array. */
+class FleeceFixture {
+ public:
+  FleeceFixture() {
+    auto encoder = FLEncoder_New();
+    FLEncoder_BeginDict(encoder, 24);
+    for (int i = 0; i < 8; i++) {
+      auto key = "int" + std::to_string(i);
+      FLEncoder_WriteKey(encoder, {key.data(), key.size()});
+      FLEncoder_WriteInt(encoder, i * 1000);
+    }
+    for (int i = 0; i < 8; i++) {
+      auto key = "string" + std::to_string(i);
+      auto value = "value of " + key;
+      FLEncoder_WriteKey(encoder, {key.data(), key.size()});
+      FLEncoder_WriteString(encoder, {value.data(), value.size()});
+    }
+    for (int i = 0; i < 7; i++) {
+      auto key = "double" + std::to_string(i);
+      FLEncoder_WriteKey(encoder, {key.data(), key.size()});
+      FLEncoder_WriteDouble(encoder, i * 0.5);
+    }
+    FLEncoder_WriteKey(encoder, FLSTR("array"));
+    FLEncoder_BeginArray(encoder, 100);
+    for (int i = 0; i < 100; i++) {
+      FLEncoder_WriteInt(encoder, i);
+    }
+    FLEncoder_EndArray(encoder);
+    FLEncoder_EndDict(encoder);
+
+    doc_ = FLEncoder_FinishDoc(encoder, nullptr);
+    FLEncoder_Free(encoder);
+
+    dict_ = FLValue_AsDict(FLDoc_GetRoot(doc_));
+    array_ = FLValue_AsArray(FLDict_Get(dict_, FLSTR("array")));
+
+    FLDictIterator iterator;
+    FLDictIterator_Begin(dict_, &iterator);
+    while (auto value = FLDictIterator_GetValue(&iterator)) {
+      values_.push_back(value);
+      FLDictIterator_Next(&iterator);
+    }
+  }
+
+  ~FleeceFixture() { FLDoc_Release(doc_); }
+
+  FLDict dict() const { return dict_; }
+  FLArray array() const { return array_; }
+  const std::vector<FLValue>& values() const { return values_; }
+
+ private:
+  FLDoc doc_;
+  FLDict dict_;
+  FLArray array_;
+  std::vector<FLValue> values_;
+};
+
+/** A database in a temporary directory, which is deleted afterwards. */
+class DatabaseFixture {
+ public:
+  DatabaseFixture() {
+    directory_ = (fs::temp_directory_path() /
+                  ("cblitedart_benchmark_" +
+                   std::to_string(Clock::now().time_since_epoch().count())))
+                     .u8string();
+    fs::create_directories(fs::u8path(directory_));
+
+    auto config = CBLDart_CBLDatabaseConfiguration_Default();
+    config.directory = {directory_.data(), directory_.size()};
+
+    CBLError error{};
+    database_ = CBLDart_CBLDatabase_Open(FLSTR("benchmark"), &config, &error);
+    check(database_ != nullptr, error, "Opening database");
+
+    collection_ = CBLDatabase_DefaultCollection(database_, &error);
+    check(collection_ != nullptr, error, "Getting default collection");
+  }
+
+  ~DatabaseFixture() {
+    CBLCollection_Release(collection_);
+    CBLError error{};
+    check(CBLDart_CBLDatabase_Close(database_, true, &error), error,
+          "Deleting database");
+    CBLDart_CBLDatabase_Release(database_);
+    std::error_code errorCode;
+    fs::remove_all(fs::u8path(directory_), errorCode);
+  }
+
+  void addChangeListener(CBLDart::AsyncCallback* listener) {
+    CBLDart_CBLCollection_AddChangeListener(
+        database_, collection_,
+        reinterpret_cast<CBLDart_AsyncCallback>(listener));
+  }
+
+  /** Saves a new document with a unique id. */
+  void saveDocument() {
+    auto id = "doc-" + std::to_string(nextDocument_++);
+    auto document = CBLDocument_CreateWithID({id.data(), id.size()});
+    auto properties = CBLDocument_MutableProperties(document);
+    FLMutableDict_SetInt(properties, FLSTR("value"), 42);
+
+    CBLError error{};
+    check(CBLCollection_SaveDocument(collection_, document, &error), error,
+          "Saving document");
+    CBLDocument_Release(document);
+  }
+
+ private:
+  std::string directory_;
+  CBLDatabase* database_ = nullptr;
+  CBLCollection* collection_ = nullptr;
+  uint64_t nextDocument_ = 0;
+};
+
+static CBLDart::AsyncCallback* newCallback() {
+  static uint32_t nextId = 0;
+  return new CBLDart::AsyncCallback(nextId++, StubDart::kCallbackPort, false);
+}
+
+/** Closes the callback, which also removes the listener it belongs to. */
+static void deleteCallback(CBLDart::AsyncCallback* callback) {
+  callback->close();
+  delete callback;
+}
+
+// === Benchmarks =============================================================
+
+static std::vector<Benchmark> createBenchmarks() {
+  auto fleece = std::make_shared<FleeceFixture>();
+  auto database = std::make_shared<DatabaseFixture>();
+  std::vector<Benchmark> benchmarks;
+
+  // === Fleece
+
+  auto getLoadedValue = [fleece](uint64_t n) {
+    auto& values = fleece->values();
+    CBLDart_LoadedFLValue loaded{};
+    for (uint64_t i = 0; i < n; i++) {
+      CBLDart_GetLoadedFLValue(values[i % values.size()], &loaded);
+      doNotOptimize(loaded);
+    }
+  };
+  benchmarks.push_back({"fleece_get_loaded_value", getLoadedValue});
+
+  auto iterateDict = [fleece](uint64_t n) {
+    auto knownSharedKeys = CBLDart_KnownSharedKeys_New();
+    CBLDart_LoadedDictKey key{};
+    CBLDart_LoadedFLValue value{};
+    for (uint64_t i = 0; i < n; i++) {
+      auto iterator = CBLDart_FLDictIterator_Begin(
+          fleece->dict(), knownSharedKeys, &key, &value, true, true);
+      while (CBLDart_FLDictIterator_Next(iterator)) {
+        doNotOptimize(value);
+      }
+    }
+    CBLDart_KnownSharedKeys_Delete(knownSharedKeys);
+  };
+  benchmarks.push_back({"fleece_dict_iterator", iterateDict});
+
+  auto iterateArray = [fleece](uint64_t n) {
+    CBLDart_LoadedFLValue value{};
+    for (uint64_t i = 0; i < n; i++) {
+      auto iterator =
+          CBLDart_FLArrayIterator_Begin(fleece->array(), &value, true);
+      while (CBLDart_FLArrayIterator_Next(iterator)) {
+        doNotOptimize(value);
+      }
+    }
+  };
+  benchmarks.push_back({"fleece_array_iterator", iterateArray});
+
+  // === AsyncCallback
+
+  auto callback = std::make_shared<CBLDart::AsyncCallback*>();
+  auto createCallback = [callback]() { *callback = newCallback(); };
+  auto deleteCallback_ = [callback]() { deleteCallback(*callback); };
+
+  auto executeCalls = [callback](uint64_t n) {
+    Dart_CObject arguments{};
+    arguments.type = Dart_CObject_kNull;
+    for (uint64_t i = 0; i < n; i++) {
+      CBLDart::AsyncCallbackCall(**callback).execute(arguments);
+    }
+  };
+  benchmarks.push_back(
+      {"async_callback_call", executeCalls, createCallback, deleteCallback_});
+
+  // Blocking calls are answered by the stub from another thread, so this
+  // includes the round trip between two threads.
+  auto executeBlockingCalls = [callback](uint64_t n) {
+    std::function<CBLDart::CallbackResultHandler> resultHandler =
+        [](Dart_CObject* result) { doNotOptimize(result); };
+    Dart_CObject arguments{};
+    arguments.type = Dart_CObject_kNull;
+    for (uint64_t i = 0; i < n; i++) {
+      CBLDart::AsyncCallbackCall(**callback, resultHandler).execute(arguments);
+    }
+  };
+  benchmarks.push_back({"async_callback_call_blocking", executeBlockingCalls,
+                        createCallback, deleteCallback_});
+
+  // === Database lock registry
+
+  // Each listener clones the database lock when it is added and acquires and
+  // releases it when it is removed.
+  auto addAndRemoveListeners = [database](uint64_t n) {
+    for (uint64_t i = 0; i < n; i++) {
+      auto listener = newCallback();
+      database->addChangeListener(listener);
+      deleteCallback(listener);
+    }
+  };
+  benchmarks.push_back({"database_lock_registry", addAndRemoveListeners});
+
+  // The same as above, but with many other listeners registered.
+  auto listeners = std::make_shared<std::vector<CBLDart::AsyncCallback*>>();
+  auto addListeners = [database, listeners]() {
+    for (int i = 0; i < 1000; i++) {
+      listeners->push_back(newCallback());
+      database->addChangeListener(listeners->back());
+    }
+  };
+  auto removeListeners = [listeners]() {
+    for (auto listener : *listeners) {
+      deleteCallback(listener);
+    }
+    listeners->clear();
+  };
+  benchmarks.push_back({"database_lock_registry_1000_listeners",
+                        addAndRemoveListeners, addListeners, removeListeners});
+
+  // === Listener wrappers
+
+  // The difference to the benchmark below is the cost of the listener wrapper.
+  auto saveDocuments = [database](uint64_t n) {
+    for (uint64_t i = 0; i < n; i++) {
+      database->saveDocument();
+    }
+  };
+  benchmarks.push_back({"collection_save_document", saveDocuments});
+
+  auto saveDocumentsWithListener = [database](uint64_t n) {
+    auto& stub = StubDart::instance();
+    auto expected = stub.postedElements() + n;
+    for (uint64_t i = 0; i < n; i++) {
+      database->saveDocument();
+    }
+    // Listeners can be notified asynchronously and changes can be coalesced,
+    // so wait until all changes have been delivered.
+    if (!stub.waitForPostedElements(expected)) {
+      std::fprintf(stderr, "Timed out waiting for the change listener.\n");
+      std::exit(1);
+    }
+  };
+  auto addListener = [database, callback]() {
+    *callback = newCallback();
+    database->addChangeListener(*callback);
+  };
+  benchmarks.push_back({"collection_save_document_with_listener",
+                        saveDocumentsWithListener, addListener,
+                        deleteCallback_});
+
+  return benchmarks;
+}
+
+// === Main ===================================================================
+
+int main(int argc, char** argv) {
+  std::string filter;
+  uint32_t samples = 20;
+  bool list = false;
+
+  for (int i = 1; i < argc; i++) {
+    auto arg = std::string(argv[i]);
+    if (arg == "--filter" && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (arg == "--samples" && i + 1 < argc) {
+      samples = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+    } else if (arg == "--list") {
+      list = true;
+    } else {
+      std::fprintf(stderr,
+                   "Usage: %s [--filter <substring>] [--samples <count>] "
+                   "[--list]\n",
+                   argv[0]);
+      return 64;
+    }
+  }
+
+  StubDart::install();
+  CBLLogSinks_SetConsole({kCBLLogWarning, kCBLLogDomainMaskAll});
+
+  std::vector<BenchmarkResult> results;
+  {
+    auto benchmarks = createBenchmarks();
+    for (auto& benchmark : benchmarks) {
+      if (benchmark.name.find(filter) == std::string::npos) {
+        continue;
+      }
+      if (list) {
+        std::printf("%s\n", benchmark.name.c_str());
+        continue;
+      }
+
+      std::fprintf(stderr, "Running %s ...\n", benchmark.name.c_str());
+      results.push_back(measure(benchmark, samples));
+    }
+  }
+
+  if (!list) {
+    printResults(results);
+  }
+  return 0;
+}
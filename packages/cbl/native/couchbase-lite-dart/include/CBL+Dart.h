@@ -67,6 +67,25 @@ CBLDART_EXPORT
 void CBLDart_AsyncCallback_CallForTest(CBLDart_AsyncCallback callback,
                                        int64_t argument);
 
+/**
+ * Sets the time in microseconds after which blocking calls, which are still
+ * waiting for Dart to return a result, are reported through the log.
+ *
+ * A threshold of 0 disables reporting. The default is 1 second.
+ */
+CBLDART_EXPORT
+void CBLDart_AsyncCallback_SetBlockingCallThreshold(int64_t thresholdMicros);
+
+CBLDART_EXPORT
+int64_t CBLDart_AsyncCallback_GetBlockingCallThreshold();
+
+/**
+ * Returns the number of blocking calls which are currently waiting for Dart
+ * to return a result.
+ */
+CBLDART_EXPORT
+size_t CBLDart_AsyncCallback_BlockingCallsInFlight();
+
 // === Completer
 
 typedef struct _CBLDart_Completer* CBLDart_Completer;
@@ -101,12 +120,47 @@ CBLDART_EXPORT
 void CBLDart_CBLLog_SetCallbackLevel(CBLDart_AsyncCallback callback,
                                      CBLLogLevel level);
 
+/**
+ * Sets the minimum level of records from the given [domain] which are
+ * delivered to the [callback], overriding the level for all domains.
+ *
+ * Passing kCBLLogNone disables the domain for the callback.
+ */
+CBLDART_EXPORT
+void CBLDart_CBLLog_SetCallbackDomainLevel(CBLDart_AsyncCallback callback,
+                                           CBLLogDomain domain,
+                                           CBLLogLevel level);
+
+/**
+ * Limits the number of records from the given [domain] which are delivered to
+ * the [callback] per second. Records exceeding the limit are discarded.
+ *
+ * Passing 0 for [maxRecordsPerSecond] removes the limit.
+ */
+CBLDART_EXPORT
+void CBLDart_CBLLog_SetCallbackDomainRateLimit(CBLDart_AsyncCallback callback,
+                                               CBLLogDomain domain,
+                                               uint32_t maxRecordsPerSecond);
+
 CBLDART_EXPORT
 void CBLDart_CBLLog_SetFileSink(CBLFileLogSink* sink);
 
 CBLDART_EXPORT
 CBLFileLogSink* CBLDart_CBLLog_GetFileSink();
 
+/**
+ * Configures a log sink which writes compact binary records of all domains
+ * into rotating, memory mapped segment files in [directory].
+ *
+ * Records are encoded and written on a background thread. Each segment file is
+ * [segmentSize] bytes large and at most [maxSegments] segment files are kept
+ * in the directory. Passing kCBLLogNone for [level] disables the sink.
+ */
+CBLDART_EXPORT
+bool CBLDart_CBLLog_SetBinarySink(CBLLogLevel level, FLString directory,
+                                  uint64_t segmentSize, uint32_t maxSegments,
+                                  CBLError* errorOut);
+
 // === Database
 
 typedef struct CBLDart_CBLEncryptionKey {
@@ -140,6 +194,82 @@ CBLDART_EXPORT
 bool CBLDart_CBLDatabase_Close(CBLDatabase* database, bool andDelete,
                                CBLError* errorOut);
 
+/**
+ * Closes the database and releases the reference of the caller.
+ *
+ * If the database pool is enabled, the database is kept open in the pool
+ * instead, which takes over the reference of the caller.
+ */
+CBLDART_EXPORT
+bool CBLDart_CBLDatabase_CloseAndRelease(CBLDatabase* database,
+                                         CBLError* errorOut);
+
+/**
+ * Deletes the database with the given [name] in [inDirectory], after closing
+ * the handles of the database which are kept open in the database pool.
+ */
+CBLDART_EXPORT
+bool CBLDart_CBL_DeleteDatabase(FLString name, FLString inDirectory,
+                                CBLError* errorOut);
+
+// === Database Pool
+
+/**
+ * Configures the pool of database handles which are kept open after they
+ * have been closed, so that they can be reopened without opening the
+ * database from scratch.
+ *
+ * At most [capacity] handles are kept open, each for at most
+ * [timeToLiveMillis] milliseconds. When the pool is full, the least recently
+ * pooled handle is closed. A capacity of 0 disables the pool, which is the
+ * default. A time to live of 0 keeps handles open until the pool is full.
+ */
+CBLDART_EXPORT
+void CBLDart_DatabasePool_Configure(size_t capacity, int64_t timeToLiveMillis);
+
+/**
+ * Returns the number of database handles which are currently pooled.
+ */
+CBLDART_EXPORT
+size_t CBLDart_DatabasePool_Size();
+
+/**
+ * Closes all pooled database handles.
+ */
+CBLDART_EXPORT
+void CBLDart_DatabasePool_Clear();
+
+// === Maintenance Scheduler
+
+/**
+ * Schedules maintenance of the given [type] for [database], which runs in the
+ * background when [writeThreshold] documents have been written since the last
+ * maintenance, or when no documents have been written for [idleMillis]
+ * milliseconds after a write. A value of 0 disables the respective trigger.
+ *
+ * Scheduling a database which is already scheduled updates its schedule.
+ * Only writes to collections which exist when the database is first
+ * scheduled are counted. Closing the database unschedules it.
+ */
+CBLDART_EXPORT
+void CBLDart_MaintenanceScheduler_Schedule(CBLDatabase* database,
+                                           CBLMaintenanceType type,
+                                           uint64_t writeThreshold,
+                                           int64_t idleMillis);
+
+/**
+ * Stops scheduling maintenance for [database].
+ */
+CBLDART_EXPORT
+void CBLDart_MaintenanceScheduler_Unschedule(CBLDatabase* database);
+
+/**
+ * Returns the number of documents written to [database] since scheduled
+ * maintenance last ran, or -1 if the database is not scheduled.
+ */
+CBLDART_EXPORT
+int64_t CBLDart_MaintenanceScheduler_PendingWrites(CBLDatabase* database);
+
 // === Collection
 
 CBLDART_EXPORT
@@ -183,37 +313,636 @@ bool CBLDart_CBLCollection_CreateIndex(CBLCollection* collection, FLString name,
                                        CBLDart_CBLIndexSpec indexSpec,
                                        CBLError* errorOut);
 
+struct CBLDart_SaveDocumentEntry {
+  CBLDocument* document;
+  CBLConcurrencyControl concurrencyControl;
+  /// Set to whether the document was saved. A document is not saved if it
+  /// conflicts with the stored revision of the document.
+  bool saved;
+};
+
+/**
+ * Saves the documents of the [count] [entries], each with the concurrency
+ * control of its entry.
+ *
+ * Must be called while a transaction of the database is open, so that all
+ * documents are saved in a single transaction. The caller opens the
+ * transaction, so that it can save other data, such as blobs, in it too.
+ *
+ * [properties] is an encoded Fleece array, which contains the new properties
+ * of each document, in the same order as [entries]. The properties are set on
+ * the documents before they are saved.
+ *
+ * Conflicts are reported per document, through the `saved` field of the
+ * entries. If saving a document fails with any other error, no further
+ * documents are saved and `false` is returned, in which case the caller must
+ * abort the transaction.
+ */
+CBLDART_EXPORT
+bool CBLDart_CBLCollection_SaveDocuments(CBLCollection* collection,
+                                         CBLDart_SaveDocumentEntry* entries,
+                                         size_t count, FLSlice properties,
+                                         CBLError* errorOut);
+
+/**
+ * Loads the documents with the [count] [ids] and encodes them into a single
+ * Fleece array, which contains one element for each id, in the same order.
+ *
+ * The element of a document which does not exist is `null`. The element of an
+ * existing document is an array of the revision id, sequence, timestamp and
+ * properties of the document.
+ *
+ * If loading a document fails, a null slice is returned and [errorOut] is set.
+ */
+CBLDART_EXPORT
+FLSliceResult CBLDart_CBLCollection_GetDocuments(CBLCollection* collection,
+                                                 const FLString* ids,
+                                                 size_t count,
+                                                 CBLError* errorOut);
+
+typedef enum : uint8_t {
+  kCBLDart_BulkDocumentOperationPurge,
+  kCBLDart_BulkDocumentOperationSetExpiration,
+} CBLDart_BulkDocumentOperation;
+
+typedef enum : uint8_t {
+  /// A chunk has been committed: `[event, int processed, int affected]`.
+  kCBLDart_BulkDocumentWorkerProgress,
+  /// All documents have been processed and the progress of the last chunk
+  /// has been sent: `[event]`.
+  kCBLDart_BulkDocumentWorkerDone,
+  /// Processing a chunk failed and it has been rolled back: `[event]`. The
+  /// error is available through `CBLDart_BulkDocumentWorker_GetError`.
+  kCBLDart_BulkDocumentWorkerError,
+} CBLDart_BulkDocumentWorkerEvent;
+
+typedef struct _CBLDart_BulkDocumentWorker* CBLDart_BulkDocumentWorker;
+
+/**
+ * Starts applying an [operation] to the documents with the given [ids] in
+ * [collection] on a background thread.
+ *
+ * [ids] is an encoded Fleece array of document ids. [expiration] is only used
+ * by kCBLDart_BulkDocumentOperationSetExpiration, with 0 clearing the
+ * expiration.
+ *
+ * The worker uses a secondary connection to the database and processes the
+ * documents in transactions of [chunkSize] documents each, so that the write
+ * lock is released between chunks. The connection is reused by later workers
+ * while the database is open. Closing the database stops its workers and
+ * waits for them, before the database is closed. Documents which do not exist
+ * are counted as processed, but not as affected. The progress of the worker is
+ * sent to the [callback] as described by CBLDart_BulkDocumentWorkerEvent.
+ *
+ * The worker stops after the current chunk, when the [callback] is closed or
+ * the worker is deleted. The current chunk is committed in that case.
+ */
+CBLDART_EXPORT
+CBLDart_BulkDocumentWorker CBLDart_BulkDocumentWorker_Start(
+    CBLCollection* collection, CBLDart_BulkDocumentOperation operation,
+    FLSlice ids, CBLTimestamp expiration, uint32_t chunkSize,
+    CBLDart_AsyncCallback callback, CBLError* errorOut);
+
+CBLDART_EXPORT
+void CBLDart_BulkDocumentWorker_GetError(CBLDart_BulkDocumentWorker worker,
+                                         CBLError* errorOut);
+
+/**
+ * Stops the [worker], if it is still running, and releases the handle to it.
+ */
+CBLDART_EXPORT
+void CBLDart_BulkDocumentWorker_Delete(CBLDart_BulkDocumentWorker worker);
+
 // === Query
 
 CBLDART_EXPORT
 CBLListenerToken* CBLDart_CBLQuery_AddChangeListener(
     const CBLDatabase* db, CBLQuery* query, CBLDart_AsyncCallback listener);
 
+/**
+ * Wrappers around the corresponding Couchbase Lite C functions, which record
+ * query profiles while the query profiler is enabled.
+ */
+CBLDART_EXPORT
+CBLQuery* CBLDart_CBLDatabase_CreateQuery(const CBLDatabase* db,
+                                          CBLQueryLanguage language,
+                                          FLString queryString,
+                                          int* errorPosOut,
+                                          CBLError* errorOut);
+
+/**
+ * Releases a query which was returned from CBLDart_CBLDatabase_CreateQuery.
+ *
+ * Can be used as a finalizer.
+ */
+CBLDART_EXPORT
+void CBLDart_CBLQuery_Release(CBLQuery* query);
+
+/**
+ * A profiled execution of a query, which is valid until its result set is
+ * released.
+ */
+typedef struct _CBLDart_QueryExecution* CBLDart_QueryExecution;
+
+/**
+ * Executes [query] and returns the execution which has to be passed to
+ * CBLDart_CBLResultSet_Next in [executionOut]. The execution is NULL if the
+ * query profiler is disabled.
+ */
+CBLDART_EXPORT
+CBLResultSet* CBLDart_CBLQuery_Execute(CBLQuery* query,
+                                       CBLDart_QueryExecution* executionOut,
+                                       CBLError* errorOut);
+
+/**
+ * Moves [resultSet] to the next row. [execution] is the execution which was
+ * returned together with the result set, or NULL.
+ */
+CBLDART_EXPORT
+bool CBLDart_CBLResultSet_Next(CBLResultSet* resultSet,
+                               CBLDart_QueryExecution execution);
+
+/**
+ * Releases a result set which was returned from CBLDart_CBLQuery_Execute.
+ *
+ * Can be used as a finalizer.
+ */
+CBLDART_EXPORT
+void CBLDart_CBLResultSet_Release(CBLResultSet* resultSet);
+
+// === Query Profiler
+
+/**
+ * Enables the query profiler, which keeps the most recent [capacity] records
+ * of query compilations and executions.
+ */
+CBLDART_EXPORT
+void CBLDart_QueryProfiler_Enable(size_t capacity);
+
+CBLDART_EXPORT
+void CBLDart_QueryProfiler_Disable();
+
+CBLDART_EXPORT
+bool CBLDart_QueryProfiler_IsEnabled();
+
+/**
+ * Discards all records which the query profiler currently holds.
+ */
+CBLDART_EXPORT
+void CBLDart_QueryProfiler_Clear();
+
+/**
+ * Returns the records which the query profiler currently holds, as JSON.
+ */
+CBLDART_EXPORT
+FLSliceResult CBLDart_QueryProfiler_Snapshot();
+
+/**
+ * Returns the records which the query profiler currently holds, in the Chrome
+ * trace event JSON format.
+ */
+CBLDART_EXPORT
+FLSliceResult CBLDart_QueryProfiler_ChromeTrace();
+
+// === Metrics
+
+/**
+ * Returns the native counters and latency histograms, summed up over all
+ * threads, as JSON.
+ *
+ * The result has the form
+ * `{"enabled": bool, "counters": {name: count}, "histograms": {name:
+ * {"count": count, "sum": nanos, "buckets": [count]}}}`. Bucket `i` of a
+ * histogram counts durations of less than `2^(i+1)` nanoseconds, which are
+ * not counted by a lower bucket.
+ *
+ * If the metrics have been compiled out, `enabled` is `false` and all values
+ * are 0.
+ */
+CBLDART_EXPORT
+FLSliceResult CBLDart_Metrics_Snapshot();
+
+/**
+ * Resets all native metrics to 0.
+ */
+CBLDART_EXPORT
+void CBLDart_Metrics_Reset();
+
+// === Trace
+
+/**
+ * Starts recording native trace events, keeping the last [capacityPerThread]
+ * events of each thread.
+ *
+ * If the capacity differs from the previous call, previously recorded events
+ * are discarded.
+ */
+CBLDART_EXPORT
+void CBLDart_Trace_Enable(size_t capacityPerThread);
+
+/**
+ * Stops recording native trace events. Recorded events are kept.
+ */
+CBLDART_EXPORT
+void CBLDart_Trace_Disable();
+
+CBLDART_EXPORT
+bool CBLDart_Trace_IsEnabled();
+
+/**
+ * Discards all recorded native trace events.
+ */
+CBLDART_EXPORT
+void CBLDart_Trace_Clear();
+
+/**
+ * Returns the recorded native trace events in the Chrome trace event JSON
+ * format.
+ *
+ * Timestamps are in microseconds on the same monotonic clock that is used by
+ * the timeline of the Dart VM, and threads are identified by their OS thread
+ * id.
+ */
+CBLDART_EXPORT
+FLSliceResult CBLDart_Trace_Dump();
+
+// === Index Updater Worker
+
+typedef enum : uint8_t {
+  kCBLDart_IndexVectorSkip,
+  kCBLDart_IndexVectorSet,
+  kCBLDart_IndexVectorRemove,
+} CBLDart_IndexVectorStatus;
+
+/**
+ * A batch of values of a lazy index, for which vectors need to be computed.
+ *
+ * The fields below `count` are set by the embedding function. [statuses] and
+ * [vectors] must be retained for and are released by the worker.
+ */
+struct CBLDart_IndexUpdateBatch {
+  /// Fleece encoded array of the values for which to compute vectors.
+  FLSlice values;
+  /// The number of values in [values].
+  uint32_t count;
+
+  /// The number of dimensions of the vectors in [vectors].
+  uint32_t dimensions;
+  /// One CBLDart_IndexVectorStatus for each value.
+  FLSliceResult statuses;
+  /// `count * dimensions` floats, with the vector of each value at the offset
+  /// `index * dimensions`.
+  FLSliceResult vectors;
+};
+
+struct CBLDart_IndexUpdaterWorkerProgress {
+  bool isRunning;
+  uint64_t batches;
+  uint64_t values;
+  uint64_t vectorsSet;
+  uint64_t vectorsRemoved;
+  uint64_t vectorsSkipped;
+  /// The number of vectors which could not be set or removed.
+  uint64_t vectorsFailed;
+  /// Time in microseconds since the worker was started, until it stopped.
+  int64_t elapsedTime;
+  /// Time in microseconds spent waiting for the embedding function.
+  int64_t embeddingTime;
+  /// Time in microseconds spent updating the index with the vectors.
+  int64_t indexingTime;
+  CBLError error;
+};
+
+/**
+ * Computes the vectors for a batch and completes the [completer] with `true`
+ * if the vectors have been set in [batch] or `false` if the worker should
+ * stop.
+ */
+typedef void (*CBLDart_IndexUpdaterWorker_Embed)(
+    CBLDart_IndexUpdateBatch* batch, CBLDart_Completer completer);
+typedef void (*CBLDart_IndexUpdaterWorker_Done)(void);
+
+typedef struct _CBLDart_IndexUpdaterWorker* CBLDart_IndexUpdaterWorker;
+
+/**
+ * Starts a background thread which updates the lazy [index] in batches of
+ * up to [batchSize] values, until it is up-to-date or the worker is stopped.
+ *
+ * The index is updated through a secondary connection to its database. The
+ * worker is stopped before the database is closed.
+ *
+ * [done] is called from the background thread after it has stopped.
+ *
+ * Returns `NULL` and sets [errorOut] if the database has been closed or the
+ * index does not exist anymore.
+ */
+CBLDART_EXPORT
+CBLDart_IndexUpdaterWorker CBLDart_IndexUpdaterWorker_Start(
+    CBLQueryIndex* index, uint32_t batchSize,
+    CBLDart_IndexUpdaterWorker_Embed embed,
+    CBLDart_IndexUpdaterWorker_Done done, CBLError* errorOut);
+
+/**
+ * Requests the worker to stop after the current batch.
+ *
+ * A batch for which no vectors have been returned yet is abandoned.
+ */
+CBLDART_EXPORT
+void CBLDart_IndexUpdaterWorker_Stop(CBLDart_IndexUpdaterWorker worker);
+
+CBLDART_EXPORT
+void CBLDart_IndexUpdaterWorker_GetProgress(
+    CBLDart_IndexUpdaterWorker worker,
+    CBLDart_IndexUpdaterWorkerProgress* progressOut);
+
+/**
+ * Stops the worker and releases the handle to it.
+ *
+ * The worker does not call [embed] or [done] after this function returns.
+ *
+ * Can be used as a finalizer.
+ */
+CBLDART_EXPORT
+void CBLDart_IndexUpdaterWorker_Delete(CBLDart_IndexUpdaterWorker worker);
+
+// === Vector Distance
+
+typedef enum : uint8_t {
+  kCBLDart_VectorDistanceEuclideanSquared,
+  kCBLDart_VectorDistanceEuclidean,
+  /// 1 - cosine similarity.
+  kCBLDart_VectorDistanceCosine,
+  /// The negated dot product.
+  kCBLDart_VectorDistanceDot,
+  /// The number of differing bits of the raw bytes of the vectors.
+  kCBLDart_VectorDistanceHamming,
+} CBLDart_VectorDistanceMetric;
+
+typedef enum : uint8_t {
+  kCBLDart_VectorElementFloat32,
+  /// IEEE 754 half precision floats.
+  kCBLDart_VectorElementFloat16,
+  kCBLDart_VectorElementInt8,
+} CBLDart_VectorElementType;
+
+typedef enum : uint8_t {
+  kCBLDart_SimdScalar,
+  kCBLDart_SimdSSE,
+  kCBLDart_SimdAVX2,
+  kCBLDart_SimdNEON,
+} CBLDart_SimdLevel;
+
+/**
+ * Returns the SIMD instruction set which is used by the vector distance
+ * functions.
+ *
+ * By default, the best instruction set which is supported by the CPU is used.
+ */
+CBLDART_EXPORT
+CBLDart_SimdLevel CBLDart_VectorDistance_GetSimdLevel();
+
+/**
+ * Sets the SIMD instruction set which is used by the vector distance
+ * functions.
+ *
+ * Returns `false` if [level] is not supported by the CPU, in which case the
+ * current instruction set is not changed.
+ */
+CBLDART_EXPORT
+bool CBLDart_VectorDistance_SetSimdLevel(CBLDart_SimdLevel level);
+
+/**
+ * Returns the distance between the vectors [a] and [b], which both have
+ * [dimensions] elements of [elementType].
+ */
+CBLDART_EXPORT
+float CBLDart_VectorDistance(CBLDart_VectorDistanceMetric metric,
+                             CBLDart_VectorElementType elementType,
+                             const void* a, const void* b,
+                             uint32_t dimensions);
+
+/**
+ * Computes the distances between [query] and each of the [count] vectors
+ * which are stored back to back in [candidates].
+ *
+ * [distancesOut] must have space for [count] floats.
+ */
+CBLDART_EXPORT
+void CBLDart_VectorDistance_Batch(CBLDart_VectorDistanceMetric metric,
+                                  CBLDart_VectorElementType elementType,
+                                  const void* query, const void* candidates,
+                                  uint32_t count, uint32_t dimensions,
+                                  float* distancesOut);
+
+/**
+ * Finds the [k] vectors in [candidates] which are closest to [query].
+ *
+ * The indexes and distances of the closest vectors are written to
+ * [indexesOut] and [distancesOut], ordered from closest to farthest. Both
+ * must have space for [k] elements.
+ *
+ * Returns the number of vectors which have been written, which is the
+ * smaller one of [k] and [count].
+ */
+CBLDART_EXPORT
+uint32_t CBLDart_VectorDistance_TopK(CBLDart_VectorDistanceMetric metric,
+                                     CBLDart_VectorElementType elementType,
+                                     const void* query, const void* candidates,
+                                     uint32_t count, uint32_t dimensions,
+                                     uint32_t k, uint32_t* indexesOut,
+                                     float* distancesOut);
+
 // === Prediction
 
 typedef FLMutableDict (*CBLDart_PredictiveModel_PredictionSync)(FLDict input);
 typedef void (*CBLDart_PredictiveModel_PredictionAsync)(
     FLDict input, CBLDart_Completer completer);
+/**
+ * Computes the predictions for a batch of [count] [inputs] and stores them in
+ * [outputs], before completing [completer].
+ *
+ * Each output must be a retained dictionary or `NULL` if there is no
+ * prediction for the corresponding input.
+ */
+typedef void (*CBLDart_PredictiveModel_PredictionBatchAsync)(
+    const FLDict* inputs, FLMutableDict* outputs, uint32_t count,
+    CBLDart_Completer completer);
 typedef void (*CBLDart_PredictiveModel_Unregistered)(void);
 
 typedef struct _CBLDart_PredictiveModel* CBLDart_PredictiveModel;
 
+struct CBLDart_PredictionCacheStats {
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t evictions;
+  uint64_t entryCount;
+  /// The approximate number of bytes used by the cached entries.
+  uint64_t size;
+};
+
+/**
+ * Creates and registers a predictive model.
+ *
+ * If [predictionBatchAsync] is not `NULL`, predictions which are requested
+ * concurrently from threads other than the one of the isolate are combined
+ * into batches of up to [maxBatchSize] inputs, so that Dart is called once per
+ * batch instead of once per input. Otherwise, [predictionAsync] is called for
+ * each input.
+ *
+ * If [cacheMaxSize] is greater than 0, predictions are cached in an LRU cache
+ * which uses at most [cacheMaxSize] bytes. Entries are keyed by the Fleece
+ * encoding of the input and expire after [cacheTtl] milliseconds, unless
+ * [cacheTtl] is 0.
+ */
 CBLDART_EXPORT
 CBLDart_PredictiveModel CBLDart_PredictiveModel_New(
     FLString name, CBLDart_IsolateId isolateId,
     CBLDart_PredictiveModel_PredictionSync predictionSync,
     CBLDart_PredictiveModel_PredictionAsync predictionAsync,
+    CBLDart_PredictiveModel_PredictionBatchAsync predictionBatchAsync,
+    uint32_t maxBatchSize, uint64_t cacheMaxSize, uint64_t cacheTtl,
     CBLDart_PredictiveModel_Unregistered unregistered);
 
+/**
+ * Writes the statistics of the cache of the [model] to [statsOut].
+ *
+ * Returns `false` if the model has no cache.
+ */
+CBLDART_EXPORT
+bool CBLDart_PredictiveModel_GetCacheStats(
+    CBLDart_PredictiveModel model, CBLDart_PredictionCacheStats* statsOut);
+
+/**
+ * Removes all entries from the cache of the [model], if it has one.
+ */
+CBLDART_EXPORT
+void CBLDart_PredictiveModel_ClearCache(CBLDart_PredictiveModel model);
+
 CBLDART_EXPORT
 void CBLDart_PredictiveModel_Delete(CBLDart_PredictiveModel model);
 
 // === Blob
 
+/**
+ * Reads up to [bufferSize] bytes from the [stream] into the caller owned
+ * [buffer], so that streaming a blob does not allocate a buffer for each
+ * chunk.
+ *
+ * Returns the number of bytes read, which is 0 at the end of the stream, or
+ * -1 if an error occurred.
+ */
+CBLDART_EXPORT
+int64_t CBLDart_CBLBlobReader_ReadInto(CBLBlobReadStream* stream,
+                                       uint8_t* buffer, uint64_t bufferSize,
+                                       CBLError* outError);
+
+typedef enum : uint8_t {
+  /// A chunk of the content: `[event, Uint8List chunk, int buf]`. The chunk
+  /// is backed by an FLSliceResult, whose buffer is at the address `buf`.
+  kCBLDart_BlobReadStreamerChunk,
+  /// The end of the content has been reached: `[event]`.
+  kCBLDart_BlobReadStreamerDone,
+  /// Reading the content failed: `[event]`. The error is available through
+  /// `CBLDart_BlobReadStreamer_GetError`.
+  kCBLDart_BlobReadStreamerError,
+} CBLDart_BlobReadStreamerEvent;
+
+typedef struct _CBLDart_BlobReadStreamer* CBLDart_BlobReadStreamer;
+
+/**
+ * Starts reading the content of the [blob] on a background thread, in chunks
+ * of [chunkSize] bytes.
+ *
+ * The chunks are sent to the [callback] as described by
+ * CBLDart_BlobReadStreamerEvent. The streamer reads up to [queueDepth] chunks
+ * ahead of the consumer, which has to call `CBLDart_BlobReadStreamer_Request`
+ * for each chunk it has consumed, to allow the streamer to read more chunks.
+ *
+ * The streamer stops when the [callback] is closed. It is also stopped before
+ * the [database] the blob belongs to is closed, in which case the stream ends
+ * with a `kCBLErrorNotOpen` error.
+ *
+ * Returns `NULL` and sets [errorOut] if the [database] has been closed.
+ */
+CBLDART_EXPORT
+CBLDart_BlobReadStreamer CBLDart_BlobReadStreamer_Start(
+    const CBLDatabase* database, const CBLBlob* blob, uint64_t chunkSize,
+    uint32_t queueDepth, CBLDart_AsyncCallback callback, CBLError* errorOut);
+
+/**
+ * Allows the [streamer] to read [chunks] more chunks ahead.
+ */
+CBLDART_EXPORT
+void CBLDart_BlobReadStreamer_Request(CBLDart_BlobReadStreamer streamer,
+                                      uint32_t chunks);
+
+CBLDART_EXPORT
+void CBLDart_BlobReadStreamer_GetError(CBLDart_BlobReadStreamer streamer,
+                                       CBLError* errorOut);
+
+/**
+ * Stops the [streamer], if it is still running, and releases the handle to it.
+ */
+CBLDART_EXPORT
+void CBLDart_BlobReadStreamer_Delete(CBLDart_BlobReadStreamer streamer);
+
+typedef enum : uint8_t {
+  /// Queued chunks have been written: `[event, int bytesWritten]`.
+  kCBLDart_BlobWriteStreamerWritten,
+  /// The blob has been created: `[event, int blobAddress]`. The receiver of
+  /// the event takes ownership of the blob.
+  kCBLDart_BlobWriteStreamerDone,
+  /// Writing the content failed: `[event]`. The error is available through
+  /// `CBLDart_BlobWriteStreamer_GetError`.
+  kCBLDart_BlobWriteStreamerError,
+} CBLDart_BlobWriteStreamerEvent;
+
+typedef struct _CBLDart_BlobWriteStreamer* CBLDart_BlobWriteStreamer;
+
+/**
+ * Starts writing the content of a new blob in [db] on a background thread.
+ *
+ * Chunks which are queued with `CBLDart_BlobWriteStreamer_Write` are
+ * coalesced into writes of up to [bufferSize] bytes. The progress of the
+ * streamer is sent to the [callback] as described by
+ * CBLDart_BlobWriteStreamerEvent.
+ *
+ * The streamer stops, and discards the content written so far, when the
+ * [callback] is closed before the blob has been created. It is also stopped
+ * before [db] is closed, in which case an unfinished blob fails with a
+ * `kCBLErrorNotOpen` error.
+ */
+CBLDART_EXPORT
+CBLDart_BlobWriteStreamer CBLDart_BlobWriteStreamer_Start(
+    CBLDatabase* db, uint64_t bufferSize, CBLDart_AsyncCallback callback,
+    CBLError* errorOut);
+
+/**
+ * Queues the next [chunk] of the content to be written by the [streamer].
+ *
+ * The [chunk] is retained until it has been written.
+ */
+CBLDART_EXPORT
+void CBLDart_BlobWriteStreamer_Write(CBLDart_BlobWriteStreamer streamer,
+                                     FLSliceResult chunk);
+
+/**
+ * Creates the blob with the given [contentType], once all queued chunks have
+ * been written.
+ */
+CBLDART_EXPORT
+void CBLDart_BlobWriteStreamer_Finish(CBLDart_BlobWriteStreamer streamer,
+                                      FLString contentType);
+
+CBLDART_EXPORT
+void CBLDart_BlobWriteStreamer_GetError(CBLDart_BlobWriteStreamer streamer,
+                                        CBLError* errorOut);
+
+/**
+ * Stops the [streamer], if it is still running, and releases the handle to it.
+ */
 CBLDART_EXPORT
-FLSliceResult CBLDart_CBLBlobReader_Read(CBLBlobReadStream* stream,
-                                         uint64_t bufferSize,
-                                         CBLError* outError);
+void CBLDart_BlobWriteStreamer_Delete(CBLDart_BlobWriteStreamer streamer);
 
 // === Replicator
 
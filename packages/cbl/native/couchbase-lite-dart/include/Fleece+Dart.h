@@ -16,6 +16,26 @@ void CBLDart_FLSliceResult_RetainByBuf(void* buf);
 CBLDART_EXPORT
 void CBLDart_FLSliceResult_ReleaseByBuf(void* buf);
 
+/**
+ * Retains the slice result with the buffer [buf] for sending it by address to
+ * another isolate.
+ *
+ * The receiver must release it with CBLDart_FLSliceResult_ReleaseTransferred.
+ * Both calls are counted in the native metrics, so that transferred buffers
+ * which are never released can be detected.
+ */
+CBLDART_EXPORT
+void CBLDart_FLSliceResult_RetainForTransfer(void* buf);
+
+/**
+ * Releases a slice result which was retained with
+ * CBLDart_FLSliceResult_RetainForTransfer.
+ *
+ * Can be used as a finalizer.
+ */
+CBLDART_EXPORT
+void CBLDart_FLSliceResult_ReleaseTransferred(void* buf);
+
 // === Decoder ================================================================
 
 // An object which remembers which shared keys have been seen. This is used
@@ -1,7 +1,13 @@
 #include "AsyncCallback.h"
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
+#include <thread>
 
+#include "CBL+Dart.h"
+#include "Metrics.h"
+#include "Tracer.h"
 #include "Utils.h"
 
 namespace CBLDart {
@@ -48,6 +54,116 @@ bool AsyncCallbackRegistry::takeBlockingCall(AsyncCallbackCall& call) {
 
 AsyncCallbackRegistry::AsyncCallbackRegistry() {}
 
+// === BlockingCallWatchdog ===================================================
+
+static inline long long CBLDart_NanosToMillis(int64_t nanos) {
+  return static_cast<long long>(nanos / 1000000);
+}
+
+BlockingCallWatchdog& BlockingCallWatchdog::instance() {
+  // Never destroyed, because the watchdog thread is never stopped.
+  static auto watchdog = new BlockingCallWatchdog;
+  return *watchdog;
+}
+
+void BlockingCallWatchdog::setThreshold(int64_t nanos) {
+  std::scoped_lock lock(mutex_);
+  threshold_.store(std::max<int64_t>(nanos, 0), std::memory_order_relaxed);
+  cv_.notify_one();
+}
+
+size_t BlockingCallWatchdog::inFlightCalls() {
+  std::scoped_lock lock(mutex_);
+  return calls_.size();
+}
+
+void BlockingCallWatchdog::watch(const AsyncCallbackCall& call,
+                                 uint32_t callbackId) {
+  std::scoped_lock lock(mutex_);
+  calls_.push_back({&call, callbackId, CBLDart_MonotonicNanos(), false});
+
+  if (!started_) {
+    started_ = true;
+    std::thread([this] { run(); }).detach();
+  } else if (calls_.size() == 1) {
+    cv_.notify_one();
+  }
+}
+
+void BlockingCallWatchdog::unwatch(const AsyncCallbackCall& call) {
+  WatchedCall watchedCall;
+  {
+    std::scoped_lock lock(mutex_);
+    auto position =
+        std::find_if(calls_.begin(), calls_.end(),
+                     [&](const auto& entry) { return entry.call == &call; });
+    assert(position != calls_.end());
+    watchedCall = *position;
+    calls_.erase(position);
+  }
+
+  auto elapsed = CBLDart_MonotonicNanos() - watchedCall.startTime;
+  auto threshold = this->threshold();
+  if (threshold == 0 || elapsed < threshold) {
+    return;
+  }
+
+  CBLDART_METRICS_INCREMENT(kSlowBlockingCalls, 1);
+
+  if (watchedCall.reported) {
+    CBL_Log(kCBLLogDomainDatabase, kCBLLogWarning,
+            "Blocking call to Dart callback %u returned after %lld ms",
+            watchedCall.callbackId, CBLDart_NanosToMillis(elapsed));
+  }
+}
+
+void BlockingCallWatchdog::run() {
+  std::vector<WatchedCall> stalledCalls;
+  std::unique_lock lock(mutex_);
+
+  while (true) {
+    auto threshold = this->threshold();
+    auto now = CBLDart_MonotonicNanos();
+
+    // Find the calls which have exceeded the threshold and the time at which
+    // the next call will exceed it.
+    int64_t deadline = INT64_MAX;
+    if (threshold > 0) {
+      for (auto& call : calls_) {
+        if (call.reported) {
+          continue;
+        }
+        auto callDeadline = call.startTime + threshold;
+        if (callDeadline <= now) {
+          call.reported = true;
+          stalledCalls.push_back(call);
+        } else {
+          deadline = std::min(deadline, callDeadline);
+        }
+      }
+    }
+
+    if (!stalledCalls.empty()) {
+      lock.unlock();
+      for (auto& call : stalledCalls) {
+        CBL_Log(kCBLLogDomainDatabase, kCBLLogWarning,
+                "Blocking call to Dart callback %u has been waiting for a "
+                "result for %lld ms",
+                call.callbackId, CBLDart_NanosToMillis(now - call.startTime));
+      }
+      stalledCalls.clear();
+      lock.lock();
+      continue;
+    }
+
+    if (deadline == INT64_MAX) {
+      cv_.wait(lock);
+    } else {
+      cv_.wait_for(lock, std::chrono::nanoseconds(deadline - now));
+    }
+  }
+}
+
 // === AsyncCallback ==========================================================
 
 AsyncCallback::AsyncCallback(uint32_t id, Dart_Port sendPort, bool debug)
@@ -162,7 +278,7 @@ AsyncCallbackCall::~AsyncCallbackCall() {
   }
 }
 
-void AsyncCallbackCall::execute(Dart_CObject& arguments) {
+bool AsyncCallbackCall::execute(Dart_CObject& arguments) {
   std::unique_lock lock(mutex_);
 
   assert(!isExecuted_);
@@ -172,7 +288,7 @@ void AsyncCallbackCall::execute(Dart_CObject& arguments) {
     // Call was completed early by `close`.
     assert(!hasResultHandler());
     debugLog("not sending request because call is already closed");
-    return;
+    return false;
   }
 
   // The SendPort to signal the return of the callback.
@@ -218,19 +334,24 @@ void AsyncCallbackCall::execute(Dart_CObject& arguments) {
     }
 
     isCompleted_ = true;
-    return;
+    return false;
   }
 
   debugLog("did send request");
+  CBLDART_METRICS_INCREMENT(kCallbacksPosted, 1);
 
   if (isBlocking()) {
     debugLog("waiting for completion");
+    CBLDART_METRICS_INCREMENT(kBlockingCalls, 1);
+    CBLDART_METRICS_TIMER(kBlockingCallWait);
+    TraceScope trace("cbl.callback", "AsyncCallbackCall.wait");
     waitForCompletion(lock);
   } else {
     isCompleted_ = true;
   }
 
   debugLog("finished");
+  return true;
 }
 
 void AsyncCallbackCall::complete(Dart_CObject* result) {
@@ -308,7 +429,10 @@ void AsyncCallbackCall::messageHandler(Dart_Port dest_port_id,
 }
 
 void AsyncCallbackCall::waitForCompletion(std::unique_lock<std::mutex>& lock) {
+  auto& watchdog = BlockingCallWatchdog::instance();
+  watchdog.watch(*this, callback_.id());
   completedCv_.wait(lock, [this] { return isCompleted_; });
+  watchdog.unwatch(*this);
 
   if (didFail_) {
     debugLog("failed");
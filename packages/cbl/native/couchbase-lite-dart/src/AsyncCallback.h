@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <vector>
@@ -36,6 +38,69 @@ class AsyncCallbackRegistry {
   std::vector<AsyncCallbackCall*> blockingCalls_;
 };
 
+// === BlockingCallWatchdog ===================================================
+
+/**
+ * Watches blocking [AsyncCallbackCall]s while they wait for Dart to return a
+ * result and reports calls which wait longer than a threshold through the
+ * log.
+ *
+ * A slow replication filter or conflict resolver, or an isolate which is busy
+ * with other work, blocks the native thread which made the call. The watchdog
+ * makes these stalls visible while they are happening, not just after the
+ * call has returned.
+ *
+ * The watchdog thread is started when the first call is watched and sleeps
+ * until the earliest unreported call exceeds the threshold.
+ */
+class BlockingCallWatchdog {
+ public:
+  static constexpr int64_t kDefaultThreshold = 1000000000;  // 1 s
+
+  static BlockingCallWatchdog& instance();
+
+  /**
+   * Sets the time in nanoseconds after which a blocking call is reported.
+   *
+   * A threshold of 0 disables reporting.
+   */
+  void setThreshold(int64_t nanos);
+  int64_t threshold() const {
+    return threshold_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * The number of blocking calls which are currently waiting for a result.
+   */
+  size_t inFlightCalls();
+
+  void watch(const AsyncCallbackCall& call, uint32_t callbackId);
+
+  /**
+   * Stops watching [call] and reports it, if it waited for longer than the
+   * threshold.
+   */
+  void unwatch(const AsyncCallbackCall& call);
+
+ private:
+  struct WatchedCall {
+    const AsyncCallbackCall* call;
+    uint32_t callbackId;
+    int64_t startTime;
+    bool reported;
+  };
+
+  BlockingCallWatchdog() = default;
+
+  void run();
+
+  std::atomic<int64_t> threshold_{kDefaultThreshold};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool started_ = false;
+  std::vector<WatchedCall> calls_;
+};
+
 // === AsyncCallback ==========================================================
 
 typedef void (*CallbackFinalizer)(void* context);
@@ -97,7 +162,14 @@ class AsyncCallbackCall {
     return isCompleted_;
   }
 
-  void execute(Dart_CObject& arguments);
+  /**
+   * Sends the call with the given [arguments] to the Dart side and, if the
+   * call is blocking, waits for it to complete.
+   *
+   * Returns `false` if the call could not be sent, because the callback has
+   * already been closed.
+   */
+  bool execute(Dart_CObject& arguments);
   void complete(Dart_CObject* result);
   void close();
 
@@ -0,0 +1,422 @@
+#include "BinaryLogSink.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <string_view>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace CBLDart {
+
+/**
+ * The number of records which can be buffered before new records are
+ * dropped.
+ */
+static constexpr size_t kBinaryLogBufferCapacity = 16384;
+
+/**
+ * The interval in which buffered records are written into the segment.
+ */
+static constexpr std::chrono::milliseconds kBinaryLogWriteInterval{100};
+
+/**
+ * The maximum number of messages which are interned per segment.
+ */
+static constexpr size_t kBinaryLogMaxInternedStrings = 16384;
+
+static constexpr uint64_t kBinaryLogMinSegmentSize = 4096;
+static constexpr size_t kSegmentHeaderSize = 16;
+static constexpr char kSegmentMagic[] = "CBLDLOG";
+static constexpr uint8_t kSegmentVersion = 1;
+static constexpr std::string_view kSegmentPrefix = "cbldart-";
+static constexpr std::string_view kSegmentExtension = ".binlog";
+
+enum : uint8_t {
+  kTagEnd = 0,
+  kTagString = 1,
+  kTagLog = 2,
+  kTagDropped = 3,
+};
+
+static void setIOError(CBLError* error, int code) {
+  if (!error) {
+    return;
+  }
+  *error = {};
+#ifdef _WIN32
+  error->domain = kCBLDomain;
+  error->code = kCBLErrorIOError;
+#else
+  error->domain = kCBLPOSIXDomain;
+  error->code = code;
+#endif
+}
+
+static void appendVarint(std::vector<uint8_t>& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+static uint64_t zigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+// === MappedSegment ==========================================================
+
+#ifdef _WIN32
+
+std::unique_ptr<MappedSegment> MappedSegment::create(const std::string& path,
+                                                     size_t capacity,
+                                                     CBLError* error) {
+  std::unique_ptr<MappedSegment> segment(new MappedSegment());
+
+  auto file = CreateFileW(fs::u8path(path).c_str(),
+                          GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                          nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL,
+                          nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    setIOError(error, 0);
+    return nullptr;
+  }
+  segment->file_ = file;
+
+  auto size = static_cast<uint64_t>(capacity);
+  auto mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE,
+                                    static_cast<DWORD>(size >> 32),
+                                    static_cast<DWORD>(size), nullptr);
+  if (!mapping) {
+    setIOError(error, 0);
+    return nullptr;
+  }
+  segment->mapping_ = mapping;
+
+  auto data = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, capacity);
+  if (!data) {
+    setIOError(error, 0);
+    return nullptr;
+  }
+  segment->data_ = static_cast<uint8_t*>(data);
+  segment->capacity_ = capacity;
+
+  return segment;
+}
+
+MappedSegment::~MappedSegment() {
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_) {
+    CloseHandle(mapping_);
+  }
+  if (file_) {
+    LARGE_INTEGER size;
+    size.QuadPart = static_cast<LONGLONG>(size_);
+    SetFilePointerEx(file_, size, nullptr, FILE_BEGIN);
+    SetEndOfFile(file_);
+    CloseHandle(file_);
+  }
+}
+
+#else
+
+std::unique_ptr<MappedSegment> MappedSegment::create(const std::string& path,
+                                                     size_t capacity,
+                                                     CBLError* error) {
+  std::unique_ptr<MappedSegment> segment(new MappedSegment());
+
+  auto file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (file < 0) {
+    setIOError(error, errno);
+    return nullptr;
+  }
+  segment->file_ = file;
+
+  if (::ftruncate(file, static_cast<off_t>(capacity)) != 0) {
+    setIOError(error, errno);
+    return nullptr;
+  }
+
+  auto data =
+      ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+  if (data == MAP_FAILED) {
+    setIOError(error, errno);
+    return nullptr;
+  }
+  segment->data_ = static_cast<uint8_t*>(data);
+  segment->capacity_ = capacity;
+
+  return segment;
+}
+
+MappedSegment::~MappedSegment() {
+  if (data_) {
+    ::munmap(data_, capacity_);
+  }
+  if (file_ >= 0) {
+    // Errors are ignored, since the unused part of the segment is zeroed and
+    // readers stop at the end tag.
+    (void)::ftruncate(file_, static_cast<off_t>(size_));
+    ::close(file_);
+  }
+}
+
+#endif
+
+void MappedSegment::append(const uint8_t* data, size_t size) {
+  std::memcpy(data_ + size_, data, size);
+  size_ += size;
+}
+
+// === BinaryLogSink ==========================================================
+
+BinaryLogSink& BinaryLogSink::instance() {
+  static auto sink = new BinaryLogSink();
+  return *sink;
+}
+
+BinaryLogSink::BinaryLogSink() : buffer_(kBinaryLogBufferCapacity) {}
+
+bool BinaryLogSink::configure(CBLLogLevel level, const std::string& directory,
+                              uint64_t segmentSize, uint32_t maxSegments,
+                              CBLError* error) {
+  std::scoped_lock lock(configureMutex_);
+
+  // Records which have been buffered until now are still written into the
+  // segments of the previous configuration.
+  level_.store(kCBLLogNone, std::memory_order_relaxed);
+  stopWriter();
+
+  if (level == kCBLLogNone) {
+    return true;
+  }
+
+  if (segmentSize < kBinaryLogMinSegmentSize ||
+      segmentSize > std::numeric_limits<size_t>::max()) {
+    if (error) {
+      *error = {};
+      error->domain = kCBLDomain;
+      error->code = kCBLErrorInvalidParameter;
+    }
+    return false;
+  }
+
+  std::error_code errorCode;
+  fs::create_directories(fs::u8path(directory), errorCode);
+  if (errorCode) {
+    setIOError(error, errorCode.value());
+    return false;
+  }
+
+  directory_ = directory;
+  segmentSize_ = segmentSize;
+  maxSegments_ = std::max<uint32_t>(maxSegments, 1);
+
+  // Continue the numbering of segments which have been written by a previous
+  // configuration or process.
+  nextSegmentIndex_ = 0;
+  for (const auto& entry :
+       fs::directory_iterator(fs::u8path(directory_), errorCode)) {
+    auto name = entry.path().filename().u8string();
+    if (name.size() > kSegmentPrefix.size() + kSegmentExtension.size() &&
+        name.compare(0, kSegmentPrefix.size(), kSegmentPrefix) == 0) {
+      auto index = std::strtoull(name.c_str() + kSegmentPrefix.size(),
+                                 nullptr, 10);
+      nextSegmentIndex_ = std::max<uint64_t>(nextSegmentIndex_, index + 1);
+    }
+  }
+
+  writerStopped_ = false;
+  writer_ = std::thread(&BinaryLogSink::run, this);
+  level_.store(level, std::memory_order_relaxed);
+  return true;
+}
+
+void BinaryLogSink::push(CBLLogDomain domain, CBLLogLevel level,
+                         int64_t timestamp, FLString message) {
+  buffer_.push(domain, level, timestamp, message);
+}
+
+void BinaryLogSink::stopWriter() {
+  if (!writer_.joinable()) {
+    return;
+  }
+
+  {
+    std::scoped_lock lock(writerMutex_);
+    writerStopped_ = true;
+  }
+  writerCondition_.notify_one();
+  writer_.join();
+}
+
+void BinaryLogSink::run() {
+  std::vector<LogRecord> records;
+  auto stopped = false;
+
+  while (!stopped) {
+    {
+      std::unique_lock lock(writerMutex_);
+      writerCondition_.wait_for(lock, kBinaryLogWriteInterval,
+                                [this]() { return writerStopped_; });
+      stopped = writerStopped_;
+    }
+
+    records.clear();
+    buffer_.drain(records);
+    write(records, buffer_.takeDropped());
+  }
+
+  segment_.reset();
+}
+
+void BinaryLogSink::write(const std::vector<LogRecord>& records,
+                          uint64_t dropped) {
+  if (dropped > 0) {
+    scratch_.clear();
+    scratch_.push_back(kTagDropped);
+    appendVarint(scratch_, dropped);
+    if (!ensureSegment(scratch_.size())) {
+      return;
+    }
+    segment_->append(scratch_.data(), scratch_.size());
+  }
+
+  // Leave room for the header and the fields of the log record, so that
+  // every record fits into an empty segment.
+  auto maxMessageSize = static_cast<size_t>(segmentSize_) -
+                        kSegmentHeaderSize - 64;
+
+  for (const auto& record : records) {
+    auto message = record.message.size() > maxMessageSize
+                       ? record.message.substr(0, maxMessageSize)
+                       : record.message;
+
+    // The message has to be encoded again, if a new segment is started,
+    // because strings are interned per segment.
+    for (auto attempt = 0; attempt < 2; attempt++) {
+      scratch_.clear();
+
+      uint32_t stringIndex;
+      auto isNewString = false;
+      auto string = strings_.find(message);
+      if (string != strings_.end()) {
+        stringIndex = string->second;
+      } else {
+        isNewString = true;
+        stringIndex = stringCount_;
+        scratch_.push_back(kTagString);
+        appendVarint(scratch_, message.size());
+        scratch_.insert(scratch_.end(), message.begin(), message.end());
+      }
+
+      scratch_.push_back(kTagLog);
+      appendVarint(scratch_, zigZag(record.timestamp - lastTimestamp_));
+      appendVarint(scratch_, record.threadId);
+      scratch_.push_back(static_cast<uint8_t>(record.domain));
+      scratch_.push_back(static_cast<uint8_t>(record.level));
+      appendVarint(scratch_, stringIndex);
+
+      if (segment_ && segment_->remaining() >= scratch_.size()) {
+        segment_->append(scratch_.data(), scratch_.size());
+        lastTimestamp_ = record.timestamp;
+        if (isNewString) {
+          stringCount_++;
+          if (strings_.size() < kBinaryLogMaxInternedStrings) {
+            strings_.emplace(message, stringIndex);
+          }
+        }
+        break;
+      }
+
+      if (!ensureSegment(scratch_.size())) {
+        return;
+      }
+    }
+  }
+}
+
+bool BinaryLogSink::ensureSegment(size_t size) {
+  if (segment_ && segment_->remaining() >= size) {
+    return true;
+  }
+  openSegment();
+  return segment_ != nullptr;
+}
+
+void BinaryLogSink::openSegment() {
+  segment_.reset();
+  strings_.clear();
+  stringCount_ = 0;
+  lastTimestamp_ = 0;
+
+  // If the segment cannot be created, records are discarded until the next
+  // write is attempted.
+  segment_ = MappedSegment::create(segmentPath(nextSegmentIndex_),
+                                   static_cast<size_t>(segmentSize_), nullptr);
+  if (!segment_) {
+    return;
+  }
+  nextSegmentIndex_++;
+
+  uint8_t header[kSegmentHeaderSize]{};
+  std::memcpy(header, kSegmentMagic, sizeof(kSegmentMagic) - 1);
+  header[sizeof(kSegmentMagic) - 1] = kSegmentVersion;
+  segment_->append(header, sizeof(header));
+
+  pruneSegments();
+}
+
+void BinaryLogSink::pruneSegments() {
+  std::vector<fs::path> segments;
+  std::error_code errorCode;
+  for (const auto& entry :
+       fs::directory_iterator(fs::u8path(directory_), errorCode)) {
+    auto name = entry.path().filename().u8string();
+    if (name.compare(0, kSegmentPrefix.size(), kSegmentPrefix) == 0 &&
+        entry.path().extension().u8string() == kSegmentExtension) {
+      segments.push_back(entry.path());
+    }
+  }
+
+  if (segments.size() <= maxSegments_) {
+    return;
+  }
+
+  // Segment names are zero padded, so they sort in the order in which the
+  // segments have been created.
+  std::sort(segments.begin(), segments.end());
+  auto excess = segments.size() - maxSegments_;
+  for (size_t i = 0; i < excess; i++) {
+    fs::remove(segments[i], errorCode);
+  }
+}
+
+std::string BinaryLogSink::segmentPath(uint64_t index) const {
+  char name[32];
+  std::snprintf(name, sizeof(name), "%020llu",
+                static_cast<unsigned long long>(index));
+  auto fileName = std::string(kSegmentPrefix) + name +
+                  std::string(kSegmentExtension);
+  return (fs::u8path(directory_) / fs::u8path(fileName)).u8string();
+}
+
+}  // namespace CBLDart
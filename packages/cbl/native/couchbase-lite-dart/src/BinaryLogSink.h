@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "CBL+Dart.h"
+#include "LogBuffer.h"
+
+namespace CBLDart {
+
+// === MappedSegment ==========================================================
+
+/**
+ * A log segment file of a fixed size, which is written through a memory
+ * mapping.
+ *
+ * When the segment is closed, the file is truncated to the number of bytes
+ * which have been written.
+ */
+class MappedSegment {
+ public:
+  static std::unique_ptr<MappedSegment> create(const std::string& path,
+                                               size_t capacity,
+                                               CBLError* error);
+
+  ~MappedSegment();
+
+  MappedSegment(const MappedSegment&) = delete;
+  MappedSegment& operator=(const MappedSegment&) = delete;
+
+  size_t remaining() const { return capacity_ - size_; }
+
+  void append(const uint8_t* data, size_t size);
+
+ private:
+  MappedSegment() = default;
+
+  uint8_t* data_ = nullptr;
+  size_t capacity_ = 0;
+  size_t size_ = 0;
+#ifdef _WIN32
+  void* file_ = nullptr;
+  void* mapping_ = nullptr;
+#else
+  int file_ = -1;
+#endif
+};
+
+// === BinaryLogSink ==========================================================
+
+/**
+ * A log sink which writes compact binary records into rotating, memory mapped
+ * segment files.
+ *
+ * The logging thread only copies records into a lock-free buffer. A
+ * background thread encodes the records and writes them into the current
+ * segment. Messages are interned per segment, so that repeated messages are
+ * only stored once in each segment.
+ *
+ * Segment format (integers are little endian, varints are LEB128):
+ *
+ * - Header: the magic bytes "CBLDLOG", the format version (1 byte) and
+ *   8 reserved bytes.
+ * - String record: tag 1, varint length, UTF-8 bytes. Strings are numbered in
+ *   the order in which they appear in the segment, starting at 0.
+ * - Log record: tag 2, zig-zag varint of the timestamp delta to the previous
+ *   log record in milliseconds, varint thread id, domain (1 byte), level
+ *   (1 byte), varint string number of the message.
+ * - Dropped record: tag 3, varint number of records which have been dropped
+ *   because the buffer was full.
+ * - Tag 0 marks the end of the records.
+ */
+class BinaryLogSink {
+ public:
+  /** The sink is used by the logging thread and is never destroyed. */
+  static BinaryLogSink& instance();
+
+  /**
+   * Configures the sink and starts writing records with at least the given
+   * [level]. kCBLLogNone disables the sink and closes the current segment.
+   */
+  bool configure(CBLLogLevel level, const std::string& directory,
+                 uint64_t segmentSize, uint32_t maxSegments, CBLError* error);
+
+  CBLLogLevel level() const { return level_.load(std::memory_order_relaxed); }
+
+  void push(CBLLogDomain domain, CBLLogLevel level, int64_t timestamp,
+            FLString message);
+
+ private:
+  BinaryLogSink();
+
+  void stopWriter();
+  void run();
+  void write(const std::vector<LogRecord>& records, uint64_t dropped);
+  void writeRecord(const std::vector<uint8_t>& record);
+  bool ensureSegment(size_t size);
+  void openSegment();
+  void pruneSegments();
+  std::string segmentPath(uint64_t index) const;
+
+  LogBuffer buffer_;
+  std::atomic<CBLLogLevel> level_{kCBLLogNone};
+
+  std::mutex configureMutex_;
+  std::string directory_;
+  uint64_t segmentSize_ = 0;
+  uint32_t maxSegments_ = 0;
+
+  std::thread writer_;
+  std::mutex writerMutex_;
+  std::condition_variable writerCondition_;
+  bool writerStopped_ = false;
+
+  // State of the writer thread.
+  std::unique_ptr<MappedSegment> segment_;
+  uint64_t nextSegmentIndex_ = 0;
+  std::unordered_map<std::string, uint32_t> strings_;
+  uint32_t stringCount_ = 0;
+  int64_t lastTimestamp_ = 0;
+  std::vector<uint8_t> scratch_;
+};
+
+}  // namespace CBLDart
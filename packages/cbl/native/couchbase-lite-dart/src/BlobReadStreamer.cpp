@@ -0,0 +1,208 @@
+#include "BlobReadStreamer.h"
+
+#include <thread>
+
+#include "Fleece+Dart.h"
+#include "Tracer.h"
+
+namespace CBLDart {
+
+// === BlobReadStreamer =======================================================
+
+BlobReadStreamer::BlobReadStreamer(
+    std::shared_ptr<DatabaseState> databaseState, const CBLBlob* blob,
+    uint64_t chunkSize, uint32_t queueDepth, AsyncCallback* callback)
+    : databaseState_(std::move(databaseState)),
+      blob_(blob),
+      chunkSize_(static_cast<size_t>(chunkSize > 0 ? chunkSize : 1)),
+      callback_(callback),
+      credits_(queueDepth > 0 ? queueDepth : 1) {
+  CBLBlob_Retain(blob_);
+}
+
+BlobReadStreamer::~BlobReadStreamer() { CBLBlob_Release(blob_); }
+
+bool BlobReadStreamer::start(CBLError* errorOut) {
+  if (!databaseState_->addWorker(weak_from_this(), errorOut)) {
+    return false;
+  }
+
+  // The callback must not be used after it has been closed, so the streamer
+  // is stopped when that happens.
+  callback_->setFinalizer(
+      new std::weak_ptr<BlobReadStreamer>(shared_from_this()),
+      [](void* context) {
+        auto streamer = static_cast<std::weak_ptr<BlobReadStreamer>*>(context);
+        if (auto streamer_ = streamer->lock()) {
+          streamer_->stop();
+        }
+        delete streamer;
+      });
+
+  // The thread keeps this streamer alive until it has stopped.
+  std::thread([self = shared_from_this()]() { self->run(); }).detach();
+  return true;
+}
+
+void BlobReadStreamer::request(uint32_t chunks) {
+  std::scoped_lock lock(mutex_);
+  credits_ += chunks;
+  creditAvailable_.notify_one();
+}
+
+void BlobReadStreamer::stop() {
+  // Chunks are sent while holding the mutex, so once the mutex has been
+  // acquired here, the thread won't use the callback anymore.
+  std::scoped_lock lock(mutex_);
+  stopped_ = true;
+  creditAvailable_.notify_one();
+}
+
+void BlobReadStreamer::stopAndWait() {
+  std::unique_lock lock(mutex_);
+  databaseClosing_ = true;
+  creditAvailable_.notify_one();
+  finishedCv_.wait(lock, [this] { return finished_; });
+}
+
+CBLError BlobReadStreamer::error() {
+  std::scoped_lock lock(mutex_);
+  return error_;
+}
+
+void BlobReadStreamer::run() {
+  CBLError error{};
+  auto stream = CBLBlob_OpenContentStream(blob_, &error);
+  if (!stream) {
+    fail(error);
+    finish();
+    return;
+  }
+
+  while (waitForCredit()) {
+    auto buffer = FLSliceResult_New(chunkSize_);
+    int bytesRead;
+    {
+      TraceScope trace("cbl.blob", "BlobReader.read", "bufferSize",
+                       static_cast<int64_t>(chunkSize_));
+      bytesRead = CBLBlobReader_Read(stream, const_cast<void*>(buffer.buf),
+                                     chunkSize_, &error);
+    }
+
+    if (bytesRead <= 0) {
+      FLSliceResult_Release(buffer);
+
+      if (bytesRead < 0) {
+        fail(error);
+      } else {
+        sendEnd(kCBLDart_BlobReadStreamerDone);
+      }
+      break;
+    }
+
+    if (!sendChunk(buffer, static_cast<size_t>(bytesRead))) {
+      break;
+    }
+  }
+
+  CBLBlobReader_Close(stream);
+  finish();
+}
+
+void BlobReadStreamer::finish() {
+  std::scoped_lock lock(mutex_);
+  finished_ = true;
+  finishedCv_.notify_all();
+}
+
+bool BlobReadStreamer::waitForCredit() {
+  std::unique_lock lock(mutex_);
+  creditAvailable_.wait(lock, [this] {
+    return stopped_ || databaseClosing_ || credits_ > 0;
+  });
+
+  if (databaseClosing_) {
+    lock.unlock();
+    CBLError error{};
+    error.domain = kCBLDomain;
+    error.code = kCBLErrorNotOpen;
+    fail(error);
+    return false;
+  }
+
+  return !stopped_;
+}
+
+bool BlobReadStreamer::sendChunk(FLSliceResult buffer, size_t size) {
+  Dart_CObject event_{};
+  event_.type = Dart_CObject_kInt32;
+  event_.value.as_int32 = kCBLDart_BlobReadStreamerChunk;
+
+  Dart_CObject chunk_{};
+  chunk_.type = Dart_CObject_kExternalTypedData;
+  chunk_.value.as_external_typed_data.type = Dart_TypedData_kUint8;
+  chunk_.value.as_external_typed_data.length = static_cast<intptr_t>(size);
+  chunk_.value.as_external_typed_data.data =
+      static_cast<uint8_t*>(const_cast<void*>(buffer.buf));
+  chunk_.value.as_external_typed_data.peer = const_cast<void*>(buffer.buf);
+  chunk_.value.as_external_typed_data.callback = [](void*, void* peer) {
+    CBLDart_FLSliceResult_ReleaseByBuf(peer);
+  };
+
+  // The address of the buffer allows the receiver to retain the buffer as an
+  // FLSliceResult, for example to send it to another isolate without copying
+  // it. The chunk keeps owning the reference which is created here.
+  Dart_CObject buf_{};
+  buf_.type = Dart_CObject_kInt64;
+  buf_.value.as_int64 = reinterpret_cast<int64_t>(buffer.buf);
+
+  Dart_CObject* argsValues[] = {&event_, &chunk_, &buf_};
+
+  Dart_CObject args{};
+  args.type = Dart_CObject_kArray;
+  args.value.as_array.length = 3;
+  args.value.as_array.values = argsValues;
+
+  std::scoped_lock lock(mutex_);
+  if (stopped_) {
+    FLSliceResult_Release(buffer);
+    return false;
+  }
+
+  credits_--;
+  if (!AsyncCallbackCall(*callback_).execute(args)) {
+    // The buffer is only owned by Dart if the chunk was sent.
+    FLSliceResult_Release(buffer);
+    stopped_ = true;
+    return false;
+  }
+  return true;
+}
+
+void BlobReadStreamer::sendEnd(CBLDart_BlobReadStreamerEvent event) {
+  Dart_CObject event_{};
+  event_.type = Dart_CObject_kInt32;
+  event_.value.as_int32 = event;
+
+  Dart_CObject* argsValues[] = {&event_};
+
+  Dart_CObject args{};
+  args.type = Dart_CObject_kArray;
+  args.value.as_array.length = 1;
+  args.value.as_array.values = argsValues;
+
+  std::scoped_lock lock(mutex_);
+  if (!stopped_) {
+    AsyncCallbackCall(*callback_).execute(args);
+  }
+}
+
+void BlobReadStreamer::fail(const CBLError& error) {
+  {
+    std::scoped_lock lock(mutex_);
+    error_ = error;
+  }
+  sendEnd(kCBLDart_BlobReadStreamerError);
+}
+
+}  // namespace CBLDart
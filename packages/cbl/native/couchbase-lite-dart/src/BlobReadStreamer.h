@@ -0,0 +1,75 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "AsyncCallback.h"
+#include "CBL+Dart.h"
+#include "DatabaseRegistry.h"
+
+namespace CBLDart {
+
+// === BlobReadStreamer =======================================================
+
+/**
+ * Reads the content of a blob on a background thread and sends it in chunks
+ * to an AsyncCallback.
+ *
+ * The streamer reads ahead while it has credits. Each chunk which is sent
+ * uses up one credit and the consumer grants new credits, once it has
+ * consumed chunks. This limits the number of chunks which are in flight to
+ * the queue depth and pauses reading while the consumer is slow.
+ *
+ * Chunks are sent as external typed data, which is backed by an FLSliceResult
+ * that is released when the Dart object that wraps it is garbage collected.
+ *
+ * The streamer is registered with the [DatabaseState] of the blob's database,
+ * which stops it and waits for it before the database is closed. A stream
+ * which is stopped this way ends with a `kCBLErrorNotOpen` error.
+ */
+class BlobReadStreamer : public DatabaseWorker,
+                         public std::enable_shared_from_this<BlobReadStreamer> {
+ public:
+  BlobReadStreamer(std::shared_ptr<DatabaseState> databaseState,
+                   const CBLBlob* blob, uint64_t chunkSize,
+                   uint32_t queueDepth, AsyncCallback* callback);
+
+  ~BlobReadStreamer() override;
+
+  /**
+   * Starts reading the content of the blob.
+   *
+   * Returns `false` and sets [errorOut] if the database has been closed.
+   */
+  bool start(CBLError* errorOut);
+  void request(uint32_t chunks);
+  void stop();
+  void stopAndWait() override;
+  CBLError error();
+
+ private:
+  void run();
+  void finish();
+  bool waitForCredit();
+  bool sendChunk(FLSliceResult buffer, size_t size);
+  void sendEnd(CBLDart_BlobReadStreamerEvent event);
+  void fail(const CBLError& error);
+
+  std::shared_ptr<DatabaseState> databaseState_;
+  const CBLBlob* blob_;
+  size_t chunkSize_;
+  AsyncCallback* callback_;
+
+  std::mutex mutex_;
+  std::condition_variable creditAvailable_;
+  std::condition_variable finishedCv_;
+  uint32_t credits_;
+  bool stopped_ = false;
+  bool databaseClosing_ = false;
+  bool finished_ = false;
+  CBLError error_{};
+};
+
+}  // namespace CBLDart
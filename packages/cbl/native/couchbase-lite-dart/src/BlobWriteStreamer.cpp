@@ -0,0 +1,271 @@
+#include "BlobWriteStreamer.h"
+
+#include <thread>
+
+#include "Tracer.h"
+
+namespace CBLDart {
+
+// === BlobWriteStreamer ======================================================
+
+BlobWriteStreamer::BlobWriteStreamer(
+    std::shared_ptr<DatabaseState> databaseState, CBLBlobWriteStream* stream,
+    uint64_t bufferSize, AsyncCallback* callback)
+    : databaseState_(std::move(databaseState)),
+      stream_(stream),
+      bufferSize_(static_cast<size_t>(bufferSize > 0 ? bufferSize : 1)),
+      callback_(callback) {
+  buffer_.reserve(bufferSize_);
+}
+
+BlobWriteStreamer::~BlobWriteStreamer() {
+  for (auto chunk : chunks_) {
+    FLSliceResult_Release(chunk);
+  }
+
+  // The thread closes the stream, unless the streamer was never started.
+  if (stream_) {
+    CBLBlobWriter_Close(stream_);
+  }
+}
+
+bool BlobWriteStreamer::start(CBLError* errorOut) {
+  if (!databaseState_->addWorker(weak_from_this(), errorOut)) {
+    return false;
+  }
+
+  // The callback must not be used after it has been closed, so the streamer
+  // is stopped when that happens.
+  callback_->setFinalizer(
+      new std::weak_ptr<BlobWriteStreamer>(shared_from_this()),
+      [](void* context) {
+        auto streamer = static_cast<std::weak_ptr<BlobWriteStreamer>*>(context);
+        if (auto streamer_ = streamer->lock()) {
+          streamer_->stop();
+        }
+        delete streamer;
+      });
+
+  // The thread keeps this streamer alive until it has stopped.
+  std::thread([self = shared_from_this()]() { self->run(); }).detach();
+  return true;
+}
+
+void BlobWriteStreamer::write(FLSliceResult chunk) {
+  std::scoped_lock lock(mutex_);
+  if (stopped_ || contentType_) {
+    return;
+  }
+  chunks_.push_back(FLSliceResult_Retain(chunk));
+  workAvailable_.notify_one();
+}
+
+void BlobWriteStreamer::finish(FLString contentType) {
+  std::scoped_lock lock(mutex_);
+  if (stopped_ || contentType_) {
+    return;
+  }
+  contentType_ = std::string(static_cast<const char*>(contentType.buf),
+                             contentType.size);
+  workAvailable_.notify_one();
+}
+
+void BlobWriteStreamer::stop() {
+  // Events are sent while holding the mutex, so once the mutex has been
+  // acquired here, the thread won't use the callback anymore.
+  std::scoped_lock lock(mutex_);
+  stopped_ = true;
+  workAvailable_.notify_one();
+}
+
+void BlobWriteStreamer::stopAndWait() {
+  std::unique_lock lock(mutex_);
+  databaseClosing_ = true;
+  workAvailable_.notify_one();
+  finishedCv_.wait(lock, [this] { return finished_; });
+}
+
+CBLError BlobWriteStreamer::error() {
+  std::scoped_lock lock(mutex_);
+  return error_;
+}
+
+void BlobWriteStreamer::run() {
+  process();
+
+  // The stream is consumed when the blob is created. If that did not happen,
+  // the partially written content is discarded. This must happen before the
+  // database is closed, which waits for this thread.
+  if (stream_) {
+    CBLBlobWriter_Close(stream_);
+    stream_ = nullptr;
+  }
+
+  std::scoped_lock lock(mutex_);
+  finished_ = true;
+  finishedCv_.notify_all();
+}
+
+void BlobWriteStreamer::process() {
+  std::deque<FLSliceResult> chunks;
+  CBLError error{};
+
+  while (true) {
+    std::optional<std::string> contentType;
+    {
+      std::unique_lock lock(mutex_);
+      workAvailable_.wait(lock, [this] {
+        return stopped_ || databaseClosing_ || !chunks_.empty() ||
+               contentType_;
+      });
+      if (stopped_) {
+        return;
+      }
+      if (databaseClosing_) {
+        lock.unlock();
+        error.domain = kCBLDomain;
+        error.code = kCBLErrorNotOpen;
+        fail(error);
+        return;
+      }
+
+      // Take all chunks which have been queued since the last iteration, so
+      // that small chunks can be coalesced.
+      chunks.swap(chunks_);
+      if (chunks.empty()) {
+        contentType = contentType_;
+      }
+    }
+
+    if (!chunks.empty()) {
+      uint64_t bytesWritten = 0;
+      auto success = true;
+      for (auto chunk : chunks) {
+        if (success) {
+          success = writeChunk(chunk, &error);
+          bytesWritten += chunk.size;
+        }
+        FLSliceResult_Release(chunk);
+      }
+      chunks.clear();
+
+      if (!success) {
+        fail(error);
+        return;
+      }
+
+      sendWritten(bytesWritten);
+      continue;
+    }
+
+    if (contentType) {
+      if (!flushBuffer(&error)) {
+        fail(error);
+        return;
+      }
+
+      FLString contentType_{contentType->data(), contentType->size()};
+      auto blob = CBLBlob_CreateWithStream(contentType_, stream_);
+      stream_ = nullptr;
+      sendDone(blob);
+      return;
+    }
+  }
+}
+
+bool BlobWriteStreamer::writeChunk(FLSliceResult chunk, CBLError* error) {
+  if (buffer_.size() + chunk.size <= bufferSize_) {
+    auto bytes = static_cast<const uint8_t*>(chunk.buf);
+    buffer_.insert(buffer_.end(), bytes, bytes + chunk.size);
+    if (buffer_.size() < bufferSize_) {
+      return true;
+    }
+    return flushBuffer(error);
+  }
+
+  if (!flushBuffer(error)) {
+    return false;
+  }
+
+  // Chunks which are too large to be coalesced are written without copying
+  // them into the buffer.
+  if (chunk.size >= bufferSize_) {
+    TraceScope trace("cbl.blob", "BlobWriter.write", "size",
+                     static_cast<int64_t>(chunk.size));
+    return CBLBlobWriter_Write(stream_, chunk.buf, chunk.size, error);
+  }
+  return writeChunk(chunk, error);
+}
+
+bool BlobWriteStreamer::flushBuffer(CBLError* error) {
+  if (buffer_.empty()) {
+    return true;
+  }
+  TraceScope trace("cbl.blob", "BlobWriter.write", "size",
+                   static_cast<int64_t>(buffer_.size()));
+  auto success =
+      CBLBlobWriter_Write(stream_, buffer_.data(), buffer_.size(), error);
+  buffer_.clear();
+  return success;
+}
+
+void BlobWriteStreamer::fail(const CBLError& error) {
+  {
+    std::scoped_lock lock(mutex_);
+    error_ = error;
+  }
+  sendError();
+}
+
+void BlobWriteStreamer::sendWritten(uint64_t bytes) {
+  Dart_CObject event_{};
+  event_.type = Dart_CObject_kInt32;
+  event_.value.as_int32 = kCBLDart_BlobWriteStreamerWritten;
+
+  Dart_CObject bytes_{};
+  bytes_.type = Dart_CObject_kInt64;
+  bytes_.value.as_int64 = static_cast<int64_t>(bytes);
+
+  Dart_CObject* values[] = {&event_, &bytes_};
+  send(values, 2);
+}
+
+void BlobWriteStreamer::sendDone(CBLBlob* blob) {
+  Dart_CObject event_{};
+  event_.type = Dart_CObject_kInt32;
+  event_.value.as_int32 = kCBLDart_BlobWriteStreamerDone;
+
+  Dart_CObject blob_{};
+  blob_.type = Dart_CObject_kInt64;
+  blob_.value.as_int64 = reinterpret_cast<int64_t>(blob);
+
+  Dart_CObject* values[] = {&event_, &blob_};
+  if (!send(values, 2)) {
+    // The blob is only owned by Dart if the event was sent.
+    CBLBlob_Release(blob);
+  }
+}
+
+void BlobWriteStreamer::sendError() {
+  Dart_CObject event_{};
+  event_.type = Dart_CObject_kInt32;
+  event_.value.as_int32 = kCBLDart_BlobWriteStreamerError;
+
+  Dart_CObject* values[] = {&event_};
+  send(values, 1);
+}
+
+bool BlobWriteStreamer::send(Dart_CObject* values[], intptr_t count) {
+  Dart_CObject args{};
+  args.type = Dart_CObject_kArray;
+  args.value.as_array.length = count;
+  args.value.as_array.values = values;
+
+  std::scoped_lock lock(mutex_);
+  if (stopped_) {
+    return false;
+  }
+  return AsyncCallbackCall(*callback_).execute(args);
+}
+
+}  // namespace CBLDart
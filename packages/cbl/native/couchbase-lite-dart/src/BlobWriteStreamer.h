@@ -0,0 +1,85 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "AsyncCallback.h"
+#include "CBL+Dart.h"
+#include "DatabaseRegistry.h"
+
+namespace CBLDart {
+
+// === BlobWriteStreamer ======================================================
+
+/**
+ * Writes the content of a new blob on a background thread.
+ *
+ * Chunks are queued by the consumer and written by the background thread,
+ * which also computes the digest of the content while it writes. Chunks which
+ * are smaller than the buffer size are coalesced, so that the blob is written
+ * in large writes, independently of how the content was chunked.
+ *
+ * Progress, the finished blob and errors are sent to an AsyncCallback.
+ *
+ * The write stream belongs to the database, so the streamer is registered
+ * with its [DatabaseState], which stops the streamer and waits for it to
+ * close the stream before the database is closed. A blob which has not been
+ * finished at that point fails with a `kCBLErrorNotOpen` error.
+ */
+class BlobWriteStreamer
+    : public DatabaseWorker,
+      public std::enable_shared_from_this<BlobWriteStreamer> {
+ public:
+  BlobWriteStreamer(std::shared_ptr<DatabaseState> databaseState,
+                    CBLBlobWriteStream* stream, uint64_t bufferSize,
+                    AsyncCallback* callback);
+
+  ~BlobWriteStreamer() override;
+
+  /**
+   * Starts writing queued chunks.
+   *
+   * Returns `false` and sets [errorOut] if the database has been closed.
+   */
+  bool start(CBLError* errorOut);
+  void write(FLSliceResult chunk);
+  void finish(FLString contentType);
+  void stop();
+  void stopAndWait() override;
+  CBLError error();
+
+ private:
+  void run();
+  void process();
+  bool writeChunk(FLSliceResult chunk, CBLError* error);
+  bool flushBuffer(CBLError* error);
+  void fail(const CBLError& error);
+  void sendWritten(uint64_t bytes);
+  void sendDone(CBLBlob* blob);
+  void sendError();
+  bool send(Dart_CObject* values[], intptr_t count);
+
+  std::shared_ptr<DatabaseState> databaseState_;
+  CBLBlobWriteStream* stream_;
+  std::vector<uint8_t> buffer_;
+  size_t bufferSize_;
+  AsyncCallback* callback_;
+
+  std::mutex mutex_;
+  std::condition_variable workAvailable_;
+  std::condition_variable finishedCv_;
+  std::deque<FLSliceResult> chunks_;
+  std::optional<std::string> contentType_;
+  bool stopped_ = false;
+  bool databaseClosing_ = false;
+  bool finished_ = false;
+  CBLError error_{};
+};
+
+}  // namespace CBLDart
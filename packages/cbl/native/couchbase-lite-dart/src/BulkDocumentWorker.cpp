@@ -0,0 +1,233 @@
+#include "BulkDocumentWorker.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace CBLDart {
+
+// === BulkDocumentWorker =====================================================
+
+BulkDocumentWorker::BulkDocumentWorker(
+    std::shared_ptr<DatabaseState> databaseState,
+    CBLDart_BulkDocumentOperation operation, FLSlice ids,
+    CBLTimestamp expiration, uint32_t chunkSize, AsyncCallback* callback)
+    : databaseState_(std::move(databaseState)),
+      operation_(operation),
+      idsDoc_(FLDoc_FromResultData(FLSlice_Copy(ids), kFLTrusted, nullptr,
+                                   kFLSliceNull)),
+      ids_(FLValue_AsArray(FLDoc_GetRoot(idsDoc_))),
+      expiration_(expiration),
+      chunkSize_(chunkSize > 0 ? chunkSize : 1),
+      callback_(callback) {}
+
+BulkDocumentWorker::~BulkDocumentWorker() { FLDoc_Release(idsDoc_); }
+
+bool BulkDocumentWorker::start(CBLCollection* collection, CBLError* errorOut) {
+  database_ = databaseState_->acquireConnection(
+      CBLCollection_Database(collection), weak_from_this(), errorOut);
+  if (!database_) {
+    return false;
+  }
+
+  auto scope = CBLCollection_Scope(collection);
+  collection_ =
+      CBLDatabase_Collection(database_, CBLCollection_Name(collection),
+                             CBLScope_Name(scope), errorOut);
+  CBLScope_Release(scope);
+  if (!collection_) {
+    if (errorOut->code == 0) {
+      // The collection has been deleted.
+      errorOut->domain = kCBLDomain;
+      errorOut->code = kCBLErrorNotFound;
+    }
+    finish();
+    return false;
+  }
+
+  // The callback must not be used after it has been closed, so the worker is
+  // stopped when that happens.
+  callback_->setFinalizer(
+      new std::weak_ptr<BulkDocumentWorker>(shared_from_this()),
+      [](void* context) {
+        auto worker = static_cast<std::weak_ptr<BulkDocumentWorker>*>(context);
+        if (auto worker_ = worker->lock()) {
+          worker_->stop();
+        }
+        delete worker;
+      });
+
+  // The thread keeps this worker alive until it has stopped.
+  std::thread([self = shared_from_this()]() { self->run(); }).detach();
+  return true;
+}
+
+void BulkDocumentWorker::stop() {
+  stopRequested_ = true;
+
+  // Events are sent while holding the mutex, so once the mutex has been
+  // acquired here, the thread won't use the callback anymore.
+  std::scoped_lock lock(mutex_);
+  stopped_ = true;
+}
+
+void BulkDocumentWorker::stopAndWait() {
+  stop();
+
+  std::unique_lock lock(mutex_);
+  finishedCv_.wait(lock, [this] { return finished_; });
+}
+
+CBLError BulkDocumentWorker::error() {
+  std::scoped_lock lock(mutex_);
+  return error_;
+}
+
+void BulkDocumentWorker::run() {
+  auto count = FLArray_Count(ids_);
+  CBLError error{};
+
+  for (uint32_t begin = 0; begin < count && !stopRequested_;
+       begin += chunkSize_) {
+    auto end = static_cast<uint32_t>(
+        std::min<uint64_t>(static_cast<uint64_t>(begin) + chunkSize_, count));
+    if (!processChunk(begin, end, &error)) {
+      fail(error);
+      finish();
+      return;
+    }
+    sendCounts(kCBLDart_BulkDocumentWorkerProgress);
+  }
+
+  sendDone();
+  finish();
+}
+
+void BulkDocumentWorker::finish() {
+  if (collection_) {
+    CBLCollection_Release(collection_);
+    collection_ = nullptr;
+  }
+  databaseState_->releaseConnection(database_);
+  database_ = nullptr;
+
+  std::scoped_lock lock(mutex_);
+  finished_ = true;
+  finishedCv_.notify_all();
+}
+
+bool BulkDocumentWorker::processChunk(uint32_t begin, uint32_t end,
+                                      CBLError* error) {
+  if (!CBLDatabase_BeginTransaction(database_, error)) {
+    return false;
+  }
+
+  uint64_t processed = 0;
+  uint64_t affected = 0;
+  auto success = true;
+  // A chunk which has been started is processed completely, even if the
+  // worker is stopped in the meantime.
+  for (auto i = begin; i < end; i++) {
+    auto affectedDocument = false;
+    auto id = FLValue_AsString(FLArray_Get(ids_, i));
+    if (!processDocument(id, &affectedDocument, error)) {
+      success = false;
+      break;
+    }
+    processed++;
+    if (affectedDocument) {
+      affected++;
+    }
+  }
+
+  CBLError endError{};
+  if (!CBLDatabase_EndTransaction(database_, success, &endError) && success) {
+    *error = endError;
+    return false;
+  }
+
+  if (success) {
+    processed_ += processed;
+    affected_ += affected;
+  }
+  return success;
+}
+
+bool BulkDocumentWorker::processDocument(FLString id, bool* affected,
+                                         CBLError* error) {
+  CBLError documentError{};
+  switch (operation_) {
+    case kCBLDart_BulkDocumentOperationPurge:
+      *affected =
+          CBLCollection_PurgeDocumentByID(collection_, id, &documentError);
+      break;
+    case kCBLDart_BulkDocumentOperationSetExpiration:
+      *affected = CBLCollection_SetDocumentExpiration(
+          collection_, id, expiration_, &documentError);
+      break;
+  }
+
+  // Documents which don't exist are skipped.
+  if (*affected || (documentError.domain == kCBLDomain &&
+                    documentError.code == kCBLErrorNotFound)) {
+    return true;
+  }
+  *error = documentError;
+  return false;
+}
+
+void BulkDocumentWorker::fail(const CBLError& error) {
+  {
+    std::scoped_lock lock(mutex_);
+    error_ = error;
+  }
+  sendError();
+}
+
+void BulkDocumentWorker::sendCounts(CBLDart_BulkDocumentWorkerEvent event) {
+  Dart_CObject event_{};
+  event_.type = Dart_CObject_kInt32;
+  event_.value.as_int32 = event;
+
+  Dart_CObject processed{};
+  processed.type = Dart_CObject_kInt64;
+  processed.value.as_int64 = static_cast<int64_t>(processed_);
+
+  Dart_CObject affected{};
+  affected.type = Dart_CObject_kInt64;
+  affected.value.as_int64 = static_cast<int64_t>(affected_);
+
+  Dart_CObject* values[] = {&event_, &processed, &affected};
+  send(values, 3);
+}
+
+void BulkDocumentWorker::sendDone() {
+  sendEvent(kCBLDart_BulkDocumentWorkerDone);
+}
+
+void BulkDocumentWorker::sendError() {
+  sendEvent(kCBLDart_BulkDocumentWorkerError);
+}
+
+void BulkDocumentWorker::sendEvent(CBLDart_BulkDocumentWorkerEvent event) {
+  Dart_CObject event_{};
+  event_.type = Dart_CObject_kInt32;
+  event_.value.as_int32 = event;
+
+  Dart_CObject* values[] = {&event_};
+  send(values, 1);
+}
+
+bool BulkDocumentWorker::send(Dart_CObject* values[], intptr_t count) {
+  Dart_CObject args{};
+  args.type = Dart_CObject_kArray;
+  args.value.as_array.length = count;
+  args.value.as_array.values = values;
+
+  std::scoped_lock lock(mutex_);
+  if (stopped_) {
+    return false;
+  }
+  return AsyncCallbackCall(*callback_).execute(args);
+}
+
+}  // namespace CBLDart
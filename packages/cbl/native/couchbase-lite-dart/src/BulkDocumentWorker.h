@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "AsyncCallback.h"
+#include "CBL+Dart.h"
+#include "DatabaseRegistry.h"
+
+namespace CBLDart {
+
+// === BulkDocumentWorker =====================================================
+
+/**
+ * Purges documents or sets their expiration on a background thread.
+ *
+ * The documents are processed in chunks, each in its own transaction, on a
+ * secondary connection to the database. This way the write lock is released
+ * between chunks and transactions of the connection which is used by Dart
+ * are not affected by the worker. The connection is provided by the
+ * [DatabaseState] of the database, which stops the worker and waits for it
+ * before the database is closed.
+ *
+ * Progress, completion and errors are sent to an AsyncCallback.
+ */
+class BulkDocumentWorker
+    : public DatabaseWorker,
+      public std::enable_shared_from_this<BulkDocumentWorker> {
+ public:
+  BulkDocumentWorker(std::shared_ptr<DatabaseState> databaseState,
+                     CBLDart_BulkDocumentOperation operation, FLSlice ids,
+                     CBLTimestamp expiration, uint32_t chunkSize,
+                     AsyncCallback* callback);
+
+  ~BulkDocumentWorker() override;
+
+  /**
+   * Starts processing the documents in the secondary connection's instance of
+   * [collection].
+   *
+   * Returns `false` and sets [errorOut] if the worker could not be started.
+   */
+  bool start(CBLCollection* collection, CBLError* errorOut);
+  void stop();
+  void stopAndWait() override;
+  CBLError error();
+
+ private:
+  void run();
+  void finish();
+  bool processChunk(uint32_t begin, uint32_t end, CBLError* error);
+  bool processDocument(FLString id, bool* affected, CBLError* error);
+  void fail(const CBLError& error);
+  void sendCounts(CBLDart_BulkDocumentWorkerEvent event);
+  void sendDone();
+  void sendError();
+  void sendEvent(CBLDart_BulkDocumentWorkerEvent event);
+  bool send(Dart_CObject* values[], intptr_t count);
+
+  std::shared_ptr<DatabaseState> databaseState_;
+  CBLDatabase* database_ = nullptr;
+  CBLCollection* collection_ = nullptr;
+  CBLDart_BulkDocumentOperation operation_;
+  FLDoc idsDoc_;
+  FLArray ids_;
+  CBLTimestamp expiration_;
+  uint32_t chunkSize_;
+  AsyncCallback* callback_;
+
+  std::atomic<bool> stopRequested_{false};
+  uint64_t processed_ = 0;
+  uint64_t affected_ = 0;
+
+  std::mutex mutex_;
+  std::condition_variable finishedCv_;
+  bool stopped_ = false;
+  bool finished_ = false;
+  CBLError error_{};
+};
+
+}  // namespace CBLDart
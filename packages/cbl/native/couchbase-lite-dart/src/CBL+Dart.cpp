@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <chrono>
 #include <future>
 #include <map>
 #include <mutex>
@@ -8,9 +9,24 @@
 #include <vector>
 
 #include "AsyncCallback.h"
+#include "BinaryLogSink.h"
+#include "BlobReadStreamer.h"
+#include "BlobWriteStreamer.h"
+#include "BulkDocumentWorker.h"
 #include "CBL+Dart.h"
+#include "Completer.h"
 #include "CpuSupport.h"
+#include "DatabasePool.h"
+#include "DatabaseRegistry.h"
+#include "MaintenanceScheduler.h"
+#include "IndexUpdaterWorker.h"
+#include "LogBuffer.h"
+#include "Metrics.h"
+#include "PredictiveModel.h"
+#include "QueryProfiler.h"
+#include "Tracer.h"
 #include "Utils.h"
+#include "VectorDistance.h"
 #include "dart/dart_api.h"
 
 bool CBLDart_CpuSupportsAVX2() { return CBLDart::CpuSupportsAVX2(); }
@@ -93,28 +109,20 @@ void CBLDart_AsyncCallback_CallForTest(CBLDart_AsyncCallback callback,
   }).detach();
 }
 
-// === Completer
-
-namespace CBLDart {
-
-class Completer {
- public:
-  Completer() : future(promise.get_future()) {}
-
-  void complete(uint64_t result) { promise.set_value(result); }
-  uint64_t wait() { return future.get(); }
-
- private:
-  std::promise<uint64_t> promise;
-  std::future<uint64_t> future;
-};
+void CBLDart_AsyncCallback_SetBlockingCallThreshold(int64_t thresholdMicros) {
+  auto& watchdog = CBLDart::BlockingCallWatchdog::instance();
+  watchdog.setThreshold(thresholdMicros * 1000);
+}
 
-}  // namespace CBLDart
+int64_t CBLDart_AsyncCallback_GetBlockingCallThreshold() {
+  return CBLDart::BlockingCallWatchdog::instance().threshold() / 1000;
+}
 
-#define COMPLETER_FROM_C(completer) \
-  reinterpret_cast<CBLDart::Completer*>(completer)
+size_t CBLDart_AsyncCallback_BlockingCallsInFlight() {
+  return CBLDart::BlockingCallWatchdog::instance().inFlightCalls();
+}
 
-#define COMPLETER_TO_C(completer) reinterpret_cast<CBLDart_Completer>(completer)
+// === Completer
 
 void CBLDart_Completer_Complete(CBLDart_Completer completer, uint64_t result) {
   COMPLETER_FROM_C(completer)->complete(result);
@@ -170,22 +178,21 @@ CBLDart_IsolateId CBLDart_GetCurrentIsolateId() { return currentIsolateId; }
  */
 
 /**
- * Mapping of objects to the mutex that is used for database level locking of
- * the database the objects belong to.
+ * The database level lock is part of the `DatabaseState` of a database, which
+ * the `DatabaseRegistry` maps to the database and to the objects that belong to
+ * it.
  *
- * Every object in this mapping owns a shared_ptr to the database level mutex.
- *
- * `CBLDart_CreateDatabaseLock`, `CBLDart_CloneDatabaseLock`,
+ * `CBLDart_RegisterOpenDatabase`, `CBLDart_CloneDatabaseLock`,
  * `CBLDart_AcquireDatabaseLock` and `CBLDart_ReleaseDatabaseLock` are used
- * to create, clone and acquire and release (the shared_ptr, not the lock)
+ * to create, clone and acquire and release (the state, not the lock)
  * database level locks.
  *
- * When a database is opened it uses `CBLDart_CreateDatabaseLock` to create the
- * mutex that belongs to the database.
+ * When a database is opened it uses `CBLDart_RegisterOpenDatabase` to create
+ * the state that belongs to the database.
  *
  * Other objects that need to lock access to the database use
- * `CBLDart_CloneDatabaseLock` to create a shared_ptr to the mutex of the
- * database they belong to.
+ * `CBLDart_CloneDatabaseLock` to share the state of the database they belong
+ * to.
  *
  * Callers of `CBLDart_CloneDatabaseLock` must ensure that the database is
  * still open when they call `CBLDart_CloneDatabaseLock`.
@@ -196,30 +203,22 @@ CBLDart_IsolateId CBLDart_GetCurrentIsolateId() { return currentIsolateId; }
  * When an object that has cloned a lock is destroyed it must call
  * `CBLDart_ReleaseDatabaseLock`.
  */
-static std::map<void*, std::shared_ptr<std::mutex>> databaseMutexes;
-static std::mutex databaseMutexesMutex;
-
-static void CBLDart_CreateDatabaseLock(CBLDatabase* database) {
-  std::scoped_lock lock(databaseMutexesMutex);
-  databaseMutexes[database] = std::make_shared<std::mutex>();
-}
-
 static void CBLDart_CloneDatabaseLock(const CBLDatabase* database,
-                                      void* owner) {
-  std::scoped_lock lock(databaseMutexesMutex);
-  assert(databaseMutexes.find(const_cast<CBLDatabase*>(database)) !=
-         databaseMutexes.end());
-  databaseMutexes[owner] = databaseMutexes[const_cast<CBLDatabase*>(database)];
+                                      const void* owner) {
+  CBLDart::DatabaseRegistry::instance().clone(database, owner);
 }
 
-static std::scoped_lock<std::mutex> CBLDart_AcquireDatabaseLock(void* owner) {
-  std::scoped_lock lock(databaseMutexesMutex);
-  return std::scoped_lock(*databaseMutexes[owner]);
+static CBLDart::DatabaseLock CBLDart_AcquireDatabaseLock(const void* owner) {
+  CBLDART_METRICS_INCREMENT(kDatabaseLocksAcquired, 1);
+  // Records the wait until the returned lock has been acquired.
+  CBLDART_METRICS_TIMER(kDatabaseLockWait);
+  auto state = CBLDart::DatabaseRegistry::instance().find(owner);
+  assert(state);
+  return CBLDart::DatabaseLock(std::move(state));
 }
 
-static void CBLDart_ReleaseDatabaseLock(void* owner) {
-  std::scoped_lock lock(databaseMutexesMutex);
-  databaseMutexes.erase(owner);
+static void CBLDart_ReleaseDatabaseLock(const void* owner) {
+  CBLDart::DatabaseRegistry::instance().remove(owner);
 }
 
 // === Base
@@ -239,70 +238,232 @@ static void CBLDart_CBLListenerFinalizer(void* context) {
 
 // === Log
 
+/**
+ * The number of log records which can be buffered before new records are
+ * dropped.
+ */
+static constexpr size_t kLogBufferCapacity = 4096;
+
+/**
+ * The interval in which buffered log records are delivered to Dart.
+ */
+static constexpr std::chrono::milliseconds kLogDrainInterval{50};
+
+/**
+ * How long the drain thread waits for a record before it checks the buffer
+ * again, in case it missed a wake up.
+ */
+static constexpr std::chrono::milliseconds kLogIdleTimeout{1000};
+
 static std::shared_mutex loggingMutex;
 
+static constexpr size_t kLogDomainCount = kCBLLogDomainListener + 1;
+
 struct LogCallbackEntry {
   CBLDart::AsyncCallback* callback;
-  CBLLogLevel level;
+  /** The minimum level of records to deliver, for each domain. */
+  CBLLogLevel levels[kLogDomainCount];
+  /** The maximum number of records per second, for each domain. */
+  uint32_t rateLimits[kLogDomainCount];
+  /** Only used by the drain thread. */
+  mutable CBLDart::LogRateLimiter rateLimiters[kLogDomainCount];
+
+  LogCallbackEntry(CBLDart::AsyncCallback* callback, CBLLogLevel level)
+      : callback(callback), rateLimits{} {
+    std::fill(std::begin(levels), std::end(levels), level);
+  }
+
+  bool accepts(CBLLogDomain domain, CBLLogLevel level) const {
+    return domain < kLogDomainCount && level >= levels[domain];
+  }
 };
 static std::vector<LogCallbackEntry> logCallbacks;
 
+/**
+ * The union of the filters of all callbacks for a domain.
+ *
+ * The filter is evaluated on the logging thread, so records which no callback
+ * accepts are discarded before they are buffered.
+ */
+struct LogDomainFilter {
+  std::atomic<CBLLogLevel> level{kCBLLogNone};
+  std::atomic<uint32_t> rateLimit{0};
+  CBLDart::LogRateLimiter rateLimiter;
+};
+static LogDomainFilter logDomainFilters[kLogDomainCount];
+
 static CBLFileLogSink* logFileSink = nullptr;
 
+// The buffer is used by the drain thread, which is never stopped, so it is
+// intentionally never destroyed.
+static CBLDart::LogBuffer* logBuffer =
+    new CBLDart::LogBuffer(kLogBufferCapacity);
+
 static void CBLDart_UpdateEffectiveCustomLogSink();
-static void CBLDart_CallDartLogCallback(CBLDart::AsyncCallback* callback,
-                                        CBLLogDomain domain, CBLLogLevel level,
-                                        FLString message);
+static void CBLDart_CallDartLogCallback(
+    const LogCallbackEntry& entry,
+    const std::vector<CBLDart::LogRecord>& records, uint64_t dropped);
 
 static void CBLDart_LogCallback(CBLLogDomain domain, CBLLogLevel level,
                                 FLString message) {
-  std::shared_lock lock(loggingMutex);
+  if (domain >= kLogDomainCount) {
+    return;
+  }
+
+  auto timestamp = CBLDart::LogTimestampNow();
+
+  auto& binaryLogSink = CBLDart::BinaryLogSink::instance();
+  if (level >= binaryLogSink.level()) {
+    binaryLogSink.push(domain, level, timestamp, message);
+  }
+
+  auto& filter = logDomainFilters[domain];
+  if (level < filter.level.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  if (!filter.rateLimiter.tryAcquire(
+          filter.rateLimit.load(std::memory_order_relaxed), timestamp)) {
+    return;
+  }
 
-  for (const auto& entry : logCallbacks) {
-    if (level >= entry.level) {
-      CBLDart_CallDartLogCallback(entry.callback, domain, level, message);
+  // The logging thread only copies the record into the buffer. Records are
+  // delivered to the Dart callbacks in batches by the drain thread.
+  logBuffer->push(domain, level, timestamp, message);
+}
+
+static void CBLDart_DrainLogBuffer() {
+  std::vector<CBLDart::LogRecord> records;
+  while (true) {
+    logBuffer->waitForRecords(kLogIdleTimeout);
+    // Collect the records which are logged during the interval into a single
+    // batch.
+    std::this_thread::sleep_for(kLogDrainInterval);
+
+    records.clear();
+    logBuffer->drain(records);
+    auto dropped = logBuffer->takeDropped();
+    if (records.empty() && dropped == 0) {
+      continue;
+    }
+
+    std::shared_lock lock(loggingMutex);
+    for (const auto& entry : logCallbacks) {
+      CBLDart_CallDartLogCallback(entry, records, dropped);
     }
   }
 }
 
+static void CBLDart_StartLogDrainThread() {
+  static std::once_flag startDrainThread;
+  std::call_once(startDrainThread,
+                 []() { std::thread(CBLDart_DrainLogBuffer).detach(); });
+}
+
 static void CBLDart_UpdateEffectiveCustomLogSink() {
   CBLCustomLogSink sink{};
-  if (!logCallbacks.empty()) {
+  sink.level = kCBLLogNone;
+
+  for (size_t domain = 0; domain < kLogDomainCount; domain++) {
+    CBLLogLevel level = kCBLLogNone;
+    // A domain is only rate limited if all callbacks which accept records
+    // from it are rate limited.
+    uint32_t rateLimit = 0;
+    auto isRateLimited = true;
+
+    for (const auto& entry : logCallbacks) {
+      if (entry.levels[domain] == kCBLLogNone) {
+        continue;
+      }
+      level = std::min(level, entry.levels[domain]);
+      if (entry.rateLimits[domain] == 0) {
+        isRateLimited = false;
+      } else {
+        rateLimit = std::max(rateLimit, entry.rateLimits[domain]);
+      }
+    }
+
+    auto& filter = logDomainFilters[domain];
+    filter.level.store(level, std::memory_order_relaxed);
+    filter.rateLimit.store(isRateLimited ? rateLimit : 0,
+                           std::memory_order_relaxed);
+
+    if (level != kCBLLogNone) {
+      sink.level = std::min(sink.level, level);
+      sink.domains |= static_cast<CBLLogDomainMask>(1 << domain);
+    }
+  }
+
+  // The binary log sink receives the records of all domains.
+  auto binaryLogLevel = CBLDart::BinaryLogSink::instance().level();
+  if (binaryLogLevel != kCBLLogNone) {
+    sink.level = std::min(sink.level, binaryLogLevel);
+    sink.domains = kCBLLogDomainMaskAll;
+  }
+
+  if (sink.level != kCBLLogNone) {
     sink.callback = CBLDart_LogCallback;
-    auto minIt = std::min_element(
-        logCallbacks.begin(), logCallbacks.end(),
-        [](const LogCallbackEntry& a, const LogCallbackEntry& b) {
-          return a.level < b.level;
-        });
-    sink.level = minIt->level;
-  } else {
-    sink.level = kCBLLogNone;
   }
   CBLLogSinks_SetCustom(sink);
 }
 
-static void CBLDart_CallDartLogCallback(CBLDart::AsyncCallback* callback,
-                                        CBLLogDomain domain, CBLLogLevel level,
-                                        FLString message) {
-  Dart_CObject domain_{};
-  domain_.type = Dart_CObject_kInt32;
-  domain_.value.as_int32 = static_cast<int32_t>(domain);
+static void CBLDart_CallDartLogCallback(
+    const LogCallbackEntry& entry,
+    const std::vector<CBLDart::LogRecord>& records, uint64_t dropped) {
+  // The message is a flat list of the number of dropped records, followed by
+  // the domain, level, timestamp and message of each record.
+  std::vector<Dart_CObject> values;
+  values.reserve(1 + records.size() * 4);
+
+  Dart_CObject dropped_{};
+  dropped_.type = Dart_CObject_kInt64;
+  dropped_.value.as_int64 = static_cast<int64_t>(dropped);
+  values.push_back(dropped_);
+
+  for (const auto& record : records) {
+    if (!entry.accepts(record.domain, record.level) ||
+        !entry.rateLimiters[record.domain].tryAcquire(
+            entry.rateLimits[record.domain], record.timestamp)) {
+      continue;
+    }
 
-  Dart_CObject level_{};
-  level_.type = Dart_CObject_kInt32;
-  level_.value.as_int32 = static_cast<int32_t>(level);
+    Dart_CObject domain{};
+    domain.type = Dart_CObject_kInt32;
+    domain.value.as_int32 = static_cast<int32_t>(record.domain);
+    values.push_back(domain);
+
+    Dart_CObject level{};
+    level.type = Dart_CObject_kInt32;
+    level.value.as_int32 = static_cast<int32_t>(record.level);
+    values.push_back(level);
+
+    Dart_CObject timestamp{};
+    timestamp.type = Dart_CObject_kInt64;
+    timestamp.value.as_int64 = record.timestamp;
+    values.push_back(timestamp);
+
+    Dart_CObject message{};
+    CBLDart_CObject_SetFLString(
+        &message, {record.message.data(), record.message.size()});
+    values.push_back(message);
+  }
 
-  Dart_CObject message_{};
-  CBLDart_CObject_SetFLString(&message_, message);
+  if (values.size() == 1 && dropped == 0) {
+    return;
+  }
 
-  Dart_CObject* argsValues[] = {&domain_, &level_, &message_};
+  std::vector<Dart_CObject*> argsValues;
+  argsValues.reserve(values.size());
+  for (auto& value : values) {
+    argsValues.push_back(&value);
+  }
 
   Dart_CObject args{};
   args.type = Dart_CObject_kArray;
-  args.value.as_array.length = 3;
-  args.value.as_array.values = argsValues;
+  args.value.as_array.length = static_cast<intptr_t>(argsValues.size());
+  args.value.as_array.values = argsValues.data();
 
-  CBLDart::AsyncCallbackCall(*callback).execute(args);
+  CBLDart::AsyncCallbackCall(*entry.callback).execute(args);
 }
 
 static void CBLDart_LogCallbackFinalizer(void* context) {
@@ -320,8 +481,9 @@ void CBLDart_CBLLog_AddCallback(CBLDart_AsyncCallback callback,
                                 CBLLogLevel level) {
   std::unique_lock lock(loggingMutex);
   auto callback_ = ASYNC_CALLBACK_FROM_C(callback);
-  logCallbacks.push_back({callback_, level});
+  logCallbacks.emplace_back(callback_, level);
   callback_->setFinalizer(callback_, CBLDart_LogCallbackFinalizer);
+  CBLDart_StartLogDrainThread();
   CBLDart_UpdateEffectiveCustomLogSink();
 }
 
@@ -331,7 +493,35 @@ void CBLDart_CBLLog_SetCallbackLevel(CBLDart_AsyncCallback callback,
   auto callback_ = ASYNC_CALLBACK_FROM_C(callback);
   for (auto& entry : logCallbacks) {
     if (entry.callback == callback_) {
-      entry.level = level;
+      std::fill(std::begin(entry.levels), std::end(entry.levels), level);
+      break;
+    }
+  }
+  CBLDart_UpdateEffectiveCustomLogSink();
+}
+
+void CBLDart_CBLLog_SetCallbackDomainLevel(CBLDart_AsyncCallback callback,
+                                           CBLLogDomain domain,
+                                           CBLLogLevel level) {
+  std::unique_lock lock(loggingMutex);
+  auto callback_ = ASYNC_CALLBACK_FROM_C(callback);
+  for (auto& entry : logCallbacks) {
+    if (entry.callback == callback_ && domain < kLogDomainCount) {
+      entry.levels[domain] = level;
+      break;
+    }
+  }
+  CBLDart_UpdateEffectiveCustomLogSink();
+}
+
+void CBLDart_CBLLog_SetCallbackDomainRateLimit(CBLDart_AsyncCallback callback,
+                                               CBLLogDomain domain,
+                                               uint32_t maxRecordsPerSecond) {
+  std::unique_lock lock(loggingMutex);
+  auto callback_ = ASYNC_CALLBACK_FROM_C(callback);
+  for (auto& entry : logCallbacks) {
+    if (entry.callback == callback_ && domain < kLogDomainCount) {
+      entry.rateLimits[domain] = maxRecordsPerSecond;
       break;
     }
   }
@@ -358,6 +548,17 @@ void CBLDart_CBLLog_SetFileSink(CBLFileLogSink* sink_) {
   }
 }
 
+bool CBLDart_CBLLog_SetBinarySink(CBLLogLevel level, FLString directory,
+                                  uint64_t segmentSize, uint32_t maxSegments,
+                                  CBLError* errorOut) {
+  std::unique_lock lock(loggingMutex);
+  auto success = CBLDart::BinaryLogSink::instance().configure(
+      level, CBLDart_FLStringToString(directory), segmentSize, maxSegments,
+      errorOut);
+  CBLDart_UpdateEffectiveCustomLogSink();
+  return success;
+}
+
 CBLFileLogSink* CBLDart_CBLLog_GetFileSink() {
   std::shared_lock lock(loggingMutex);
   return logFileSink;
@@ -379,40 +580,80 @@ static void CBLDart_CheckFileLogging() {
 
 // === Database
 
+static void CBLDart_RegisterOpenDatabase(CBLDatabase* database,
+                                         CBLDart::DatabasePool::Key poolKey) {
+  CBLDart::DatabaseRegistry::instance().add(database, std::move(poolKey));
+}
+
 /**
- * A list of all the currently open database.
+ * Marks [database] as closed and returns its state, or returns `nullptr` if
+ * the database has already been closed.
  *
  * Used to ensure that databases are closed only once.
  */
-static std::vector<CBLDatabase*> openDatabases;
-static std::mutex openDatabasesMutex;
+static std::shared_ptr<CBLDart::DatabaseState> CBLDart_UnregisterOpenDatabase(
+    CBLDatabase* database) {
+  auto state = CBLDart::DatabaseRegistry::instance().find(database);
+  if (!state || !state->isOpen.exchange(false)) {
+    return nullptr;
+  }
+  CBLDart::MaintenanceScheduler::instance().unschedule(database);
+  state->stopWorkers();
+  return state;
+}
 
-static void CBLDart_RegisterOpenDatabase(CBLDatabase* database) {
-  std::scoped_lock lock(openDatabasesMutex);
-  openDatabases.push_back(database);
+static void CBLDart_LogDatabaseCloseError(CBLDatabase* database,
+                                          const CBLError& error,
+                                          const char* context) {
+  auto errorMessage = CBLError_Message(&error);
+  CBL_Log(kCBLLogDomainDatabase, kCBLLogError,
+          "Error closing database %p %s: %.*s", database, context,
+          static_cast<int>(errorMessage.size), (char*)errorMessage.buf);
+  FLSliceResult_Release(errorMessage);
 }
 
-static bool CBLDart_UnregisterOpenDatabase(CBLDatabase* database) {
-  std::scoped_lock lock(openDatabasesMutex);
-  // Check if the database is still open.
-  auto it = std::find(openDatabases.begin(), openDatabases.end(), database);
-  if (it == openDatabases.end()) {
-    // The database has already been closed.
-    return false;
+/**
+ * Closes and releases a database handle which is evicted from the pool.
+ *
+ * The pool owns a reference to and the database lock of pooled handles.
+ */
+static void CBLDart_ClosePooledDatabase(CBLDatabase* database) {
+  CBLError error;
+  bool success;
+  {
+    auto databaseLock = CBLDart_AcquireDatabaseLock(database);
+    success = CBLDatabase_Close(database, &error);
   }
-
-  // Remove the database from the list of open database and close it.
-  openDatabases.erase(it);
-  return true;
+  if (!success) {
+    CBLDart_LogDatabaseCloseError(database, error, "evicted from pool");
+  }
+  CBLDart_ReleaseDatabaseLock(database);
+  CBLDatabase_Release(database);
 }
 
+/**
+ * Databases which have recently been closed and are kept open to be reopened.
+ *
+ * Never destroyed, because pooled databases are closed from a background
+ * thread.
+ */
+static auto databasePool =
+    new CBLDart::DatabasePool(CBLDart_ClosePooledDatabase);
+
 bool CBLDart_CBLDatabase_Close(CBLDatabase* database, bool andDelete,
                                CBLError* errorOut) {
-  if (!CBLDart_UnregisterOpenDatabase(database)) {
+  auto state = CBLDart_UnregisterOpenDatabase(database);
+  if (!state) {
     // Return early since the database has already been closed.
     return true;
   }
 
+  if (andDelete) {
+    // Pooled handles of the same database would prevent it from being
+    // deleted.
+    databasePool->evict(state->poolKey.name, state->poolKey.directory);
+  }
+
   // We close the database under a lock to ensure that certain finalizers are
   // not running while the database is being closed.
   auto databaseLock = CBLDart_AcquireDatabaseLock(database);
@@ -423,6 +664,33 @@ bool CBLDart_CBLDatabase_Close(CBLDatabase* database, bool andDelete,
   }
 }
 
+bool CBLDart_CBLDatabase_CloseAndRelease(CBLDatabase* database,
+                                         CBLError* errorOut) {
+  auto success = true;
+  if (auto state = CBLDart_UnregisterOpenDatabase(database)) {
+    if (databasePool->put(database, state->poolKey)) {
+      // The pool has taken over the reference and the database lock.
+      return true;
+    }
+
+    // We close the database under a lock to ensure that certain finalizers
+    // are not running while the database is being closed.
+    auto databaseLock = CBLDart_AcquireDatabaseLock(database);
+    success = CBLDatabase_Close(database, errorOut);
+  }
+  CBLDart_ReleaseDatabaseLock(database);
+  CBLDatabase_Release(database);
+  return success;
+}
+
+bool CBLDart_CBL_DeleteDatabase(FLString name, FLString inDirectory,
+                                CBLError* errorOut) {
+  databasePool->evict(
+      std::string(static_cast<const char*>(name.buf), name.size),
+      std::string(static_cast<const char*>(inDirectory.buf), inDirectory.size));
+  return CBL_DeleteDatabase(name, inDirectory, errorOut);
+}
+
 #ifdef COUCHBASE_ENTERPRISE
 static CBLEncryptionKey CBLEncryptionKey_FromCBLDart(
     CBLDart_CBLEncryptionKey key) {
@@ -468,11 +736,14 @@ CBLDatabase* CBLDart_CBLDatabase_Open(FLString name,
   auto config_ = config ? CBLDatabaseConfiguration_FromCBLDart(*config)
                         : CBLDatabaseConfiguration_Default();
 
-  auto database = CBLDatabase_Open(name, &config_, errorOut);
+  auto poolKey = CBLDart::DatabasePool::Key::make(name, config_);
+  auto database = databasePool->take(poolKey);
+  if (!database) {
+    database = CBLDatabase_Open(name, &config_, errorOut);
+  }
 
   if (database) {
-    CBLDart_RegisterOpenDatabase(database);
-    CBLDart_CreateDatabaseLock(database);
+    CBLDart_RegisterOpenDatabase(database, std::move(poolKey));
   }
 
   return database;
@@ -480,21 +751,44 @@ CBLDatabase* CBLDart_CBLDatabase_Open(FLString name,
 
 void CBLDart_CBLDatabase_Release(CBLDatabase* database) {
   CBLError error;
-  if (!CBLDart_CBLDatabase_Close(database, false, &error)) {
-    auto errorMessage = CBLError_Message(&error);
-    CBL_Log(kCBLLogDomainDatabase, kCBLLogError,
-            "Error closing database %p in Dart finalizer: %*.s", database,
-            static_cast<int>(errorMessage.size), (char*)errorMessage.buf);
-    FLSliceResult_Release(errorMessage);
+  if (!CBLDart_CBLDatabase_CloseAndRelease(database, &error)) {
+    CBLDart_LogDatabaseCloseError(database, error, "in Dart finalizer");
   }
-  CBLDart_ReleaseDatabaseLock(database);
-  CBLDatabase_Release(database);
+}
+
+// === Database Pool
+
+void CBLDart_DatabasePool_Configure(size_t capacity, int64_t timeToLiveMillis) {
+  databasePool->configure(capacity, timeToLiveMillis);
+}
+
+size_t CBLDart_DatabasePool_Size() { return databasePool->size(); }
+
+void CBLDart_DatabasePool_Clear() { databasePool->clear(); }
+
+// === Maintenance Scheduler
+
+void CBLDart_MaintenanceScheduler_Schedule(CBLDatabase* database,
+                                           CBLMaintenanceType type,
+                                           uint64_t writeThreshold,
+                                           int64_t idleMillis) {
+  CBLDart::MaintenanceScheduler::instance().schedule(
+      database, {type, writeThreshold, idleMillis});
+}
+
+void CBLDart_MaintenanceScheduler_Unschedule(CBLDatabase* database) {
+  CBLDart::MaintenanceScheduler::instance().unschedule(database);
+}
+
+int64_t CBLDart_MaintenanceScheduler_PendingWrites(CBLDatabase* database) {
+  return CBLDart::MaintenanceScheduler::instance().pendingWrites(database);
 }
 
 // === Collection
 
 static void CBLDart_CollectionDocumentChangeListenerWrapper(
     void* context, const CBLDocumentChange* change) {
+  CBLDart::TraceScope trace("cbl.listener", "DocumentChangeListener");
   auto callback = ASYNC_CALLBACK_FROM_C(context);
 
   Dart_CObject args{};
@@ -520,6 +814,8 @@ static void CBLDart_CollectionChangeListenerWrapper(
     void* context, const CBLCollectionChange* change) {
   auto callback = ASYNC_CALLBACK_FROM_C(context);
   auto numDocs = change->numDocs;
+  CBLDart::TraceScope trace("cbl.listener", "CollectionChangeListener",
+                            "numDocs", numDocs);
   auto docIDs = change->docIDs;
 
   std::vector<Dart_CObject> docIdObjects(numDocs);
@@ -594,10 +890,123 @@ bool CBLDart_CBLCollection_CreateIndex(CBLCollection* collection, FLString name,
   return 0;
 }
 
+bool CBLDart_CBLCollection_SaveDocuments(CBLCollection* collection,
+                                         CBLDart_SaveDocumentEntry* entries,
+                                         size_t count, FLSlice properties,
+                                         CBLError* errorOut) {
+  // The mutable copies of the properties reference the values in the doc,
+  // which keeps it alive as long as they need it.
+  auto doc = FLDoc_FromResultData(FLSlice_Copy(properties), kFLTrusted,
+                                   nullptr, kFLSliceNull);
+  auto propertiesArray = FLValue_AsArray(FLDoc_GetRoot(doc));
+
+  auto success = true;
+  for (size_t i = 0; i < count; i++) {
+    auto& entry = entries[i];
+
+    auto documentProperties =
+        FLDict_MutableCopy(FLValue_AsDict(FLArray_Get(propertiesArray, i)),
+                           kFLDefaultCopy);
+    CBLDocument_SetProperties(entry.document, documentProperties);
+    FLMutableDict_Release(documentProperties);
+
+    CBLError error{};
+    entry.saved = CBLCollection_SaveDocumentWithConcurrencyControl(
+        collection, entry.document, entry.concurrencyControl, &error);
+    if (!entry.saved &&
+        !(error.domain == kCBLDomain && error.code == kCBLErrorConflict)) {
+      *errorOut = error;
+      success = false;
+      break;
+    }
+  }
+
+  FLDoc_Release(doc);
+  return success;
+}
+
+FLSliceResult CBLDart_CBLCollection_GetDocuments(CBLCollection* collection,
+                                                 const FLString* ids,
+                                                 size_t count,
+                                                 CBLError* errorOut) {
+  auto encoder = FLEncoder_New();
+  FLEncoder_BeginArray(encoder, count);
+
+  for (size_t i = 0; i < count; i++) {
+    CBLError error{};
+    auto document = CBLCollection_GetDocument(collection, ids[i], &error);
+    if (!document) {
+      if (error.code != 0) {
+        *errorOut = error;
+        FLEncoder_Free(encoder);
+        return {};
+      }
+      FLEncoder_WriteNull(encoder);
+      continue;
+    }
+
+    FLEncoder_BeginArray(encoder, 4);
+    FLEncoder_WriteString(encoder, CBLDocument_RevisionID(document));
+    FLEncoder_WriteUInt(encoder, CBLDocument_Sequence(document));
+    FLEncoder_WriteUInt(encoder, CBLDocument_Timestamp(document));
+    FLEncoder_WriteValue(encoder, (FLValue)CBLDocument_Properties(document));
+    FLEncoder_EndArray(encoder);
+
+    CBLDocument_Release(document);
+  }
+
+  FLEncoder_EndArray(encoder);
+  auto result = FLEncoder_Finish(encoder, nullptr);
+  FLEncoder_Free(encoder);
+  return result;
+}
+
+#define BULK_DOCUMENT_WORKER_FROM_C(worker) \
+  reinterpret_cast<std::shared_ptr<CBLDart::BulkDocumentWorker>*>(worker)
+
+#define BULK_DOCUMENT_WORKER_TO_C(worker) \
+  reinterpret_cast<CBLDart_BulkDocumentWorker>(worker)
+
+CBLDart_BulkDocumentWorker CBLDart_BulkDocumentWorker_Start(
+    CBLCollection* collection, CBLDart_BulkDocumentOperation operation,
+    FLSlice ids, CBLTimestamp expiration, uint32_t chunkSize,
+    CBLDart_AsyncCallback callback, CBLError* errorOut) {
+  // The worker uses a secondary connection of the database, so that its
+  // transactions don't interfere with transactions of the caller.
+  auto state = CBLDart::DatabaseRegistry::instance().find(
+      CBLCollection_Database(collection));
+  if (!state) {
+    errorOut->domain = kCBLDomain;
+    errorOut->code = kCBLErrorNotOpen;
+    return nullptr;
+  }
+
+  auto worker = std::make_shared<CBLDart::BulkDocumentWorker>(
+      std::move(state), operation, ids, expiration, chunkSize,
+      ASYNC_CALLBACK_FROM_C(callback));
+  if (!worker->start(collection, errorOut)) {
+    return nullptr;
+  }
+  return BULK_DOCUMENT_WORKER_TO_C(
+      new std::shared_ptr<CBLDart::BulkDocumentWorker>(worker));
+}
+
+void CBLDart_BulkDocumentWorker_GetError(CBLDart_BulkDocumentWorker worker,
+                                         CBLError* errorOut) {
+  *errorOut = (*BULK_DOCUMENT_WORKER_FROM_C(worker))->error();
+}
+
+void CBLDart_BulkDocumentWorker_Delete(CBLDart_BulkDocumentWorker worker) {
+  auto worker_ = BULK_DOCUMENT_WORKER_FROM_C(worker);
+  (*worker_)->stop();
+  delete worker_;
+}
+
 // === Query
 
 static void CBLDart_QueryChangeListenerWrapper(void* context, CBLQuery* query,
                                                CBLListenerToken* token) {
+  CBLDart::TraceScope trace("cbl.listener", "QueryChangeListener");
   auto callback = ASYNC_CALLBACK_FROM_C(context);
 
   Dart_CObject args{};
@@ -619,118 +1028,229 @@ CBLListenerToken* CBLDart_CBLQuery_AddChangeListener(
   return listenerToken;
 }
 
-// === Prediction
+CBLQuery* CBLDart_CBLDatabase_CreateQuery(const CBLDatabase* db,
+                                          CBLQueryLanguage language,
+                                          FLString queryString,
+                                          int* errorPosOut,
+                                          CBLError* errorOut) {
+  CBLDart::TraceScope trace("cbl.query", "Query.create");
+  return CBLDart::QueryProfiler::instance.createQuery(
+      db, language, queryString, errorPosOut, errorOut);
+}
 
-#ifdef COUCHBASE_ENTERPRISE
+void CBLDart_CBLQuery_Release(CBLQuery* query) {
+  CBLDart::QueryProfiler::instance.releaseQuery(query);
+}
 
-namespace CBLDart {
+#define QUERY_EXECUTION_FROM_C(execution) \
+  reinterpret_cast<CBLDart::QueryProfiler::Execution*>(execution)
 
-struct PredictiveModel {
- public:
-  PredictiveModel(FLString name, CBLDart_IsolateId isolateId,
-                  CBLDart_PredictiveModel_PredictionSync predictionSync,
-                  CBLDart_PredictiveModel_PredictionAsync predictionAsync,
-                  CBLDart_PredictiveModel_Unregistered unregistered);
+#define QUERY_EXECUTION_TO_C(execution) \
+  reinterpret_cast<CBLDart_QueryExecution>(execution)
 
-  ~PredictiveModel();
+CBLResultSet* CBLDart_CBLQuery_Execute(CBLQuery* query,
+                                       CBLDart_QueryExecution* executionOut,
+                                       CBLError* errorOut) {
+  CBLDart::TraceScope trace("cbl.query", "Query.execute");
+  CBLDart::QueryProfiler::Execution* execution;
+  auto resultSet =
+      CBLDart::QueryProfiler::instance.execute(query, &execution, errorOut);
+  *executionOut = QUERY_EXECUTION_TO_C(execution);
+  return resultSet;
+}
 
- private:
-  FLMutableDict prediction(FLDict input);
-  void unregistered();
-
-  FLStringResult name;
-  CBLDart_IsolateId isolateId;
-  CBLDart_PredictiveModel_PredictionSync predictionSync;
-  CBLDart_PredictiveModel_PredictionAsync predictionAsync;
-  CBLDart_PredictiveModel_Unregistered unregistered_;
-  std::mutex unregisteredMutex;
-};
+bool CBLDart_CBLResultSet_Next(CBLResultSet* resultSet,
+                               CBLDart_QueryExecution execution) {
+  return CBLDart::QueryProfiler::instance.next(
+      resultSet, QUERY_EXECUTION_FROM_C(execution));
+}
 
-}  // namespace CBLDart
+void CBLDart_CBLResultSet_Release(CBLResultSet* resultSet) {
+  CBLDart::QueryProfiler::instance.release(resultSet);
+}
 
-#define PREDICTIVE_MODEL_FROM_C(model) \
-  reinterpret_cast<CBLDart::PredictiveModel*>(model)
+// === Query Profiler
 
-#define PREDICTIVE_MODEL_TO_C(model) \
-  reinterpret_cast<CBLDart_PredictiveModel>(model)
+void CBLDart_QueryProfiler_Enable(size_t capacity) {
+  CBLDart::QueryProfiler::instance.enable(capacity);
+}
 
-namespace CBLDart {
+void CBLDart_QueryProfiler_Disable() {
+  CBLDart::QueryProfiler::instance.disable();
+}
 
-PredictiveModel::PredictiveModel(
-    FLString name, CBLDart_IsolateId isolateId,
-    CBLDart_PredictiveModel_PredictionSync predictionSync,
-    CBLDart_PredictiveModel_PredictionAsync predictionAsync,
-    CBLDart_PredictiveModel_Unregistered unregistered)
-    : name(FLSlice_Copy(name)),
-      isolateId(isolateId),
-      predictionSync(predictionSync),
-      predictionAsync(predictionAsync),
-      unregistered_(unregistered) {
-  CBLPredictiveModel model{};
-  model.context = this;
-  model.prediction = [](void* context, FLDict input) {
-    return PREDICTIVE_MODEL_FROM_C(context)->prediction(input);
-  };
-  model.unregistered = [](void* context) {
-    PREDICTIVE_MODEL_FROM_C(context)->unregistered();
-  };
-  CBL_RegisterPredictiveModel((FLString)name, model);
+bool CBLDart_QueryProfiler_IsEnabled() {
+  return CBLDart::QueryProfiler::instance.isEnabled();
 }
 
-PredictiveModel::~PredictiveModel() {
-  bool wasUnregistered = true;
-  {
-    std::scoped_lock lock(unregisteredMutex);
-    wasUnregistered = unregistered_ == nullptr;
-    unregistered_ = nullptr;
-  }
+void CBLDart_QueryProfiler_Clear() {
+  CBLDart::QueryProfiler::instance.clear();
+}
 
-  if (!wasUnregistered) {
-    CBL_UnregisterPredictiveModel((FLString)name);
-  }
+FLSliceResult CBLDart_QueryProfiler_Snapshot() {
+  return CBLDart::QueryProfiler::instance.snapshot();
+}
 
-  FLSliceResult_Release(name);
+FLSliceResult CBLDart_QueryProfiler_ChromeTrace() {
+  return CBLDart::QueryProfiler::instance.chromeTrace();
 }
 
-FLMutableDict PredictiveModel::prediction(FLDict input) {
-  if (isolateId == CBLDart_GetCurrentIsolateId()) {
-    // Use the synchronous prediction function since we are on the same
-    // thread as the isolate where the model was registered.
-    return predictionSync(input);
-  } else {
-    // Use the asynchronous prediction function since we are on a different
-    // thread as the isolate where the model was registered.
-    auto completer = CBLDart::Completer();
-    predictionAsync(input, COMPLETER_TO_C(&completer));
-    return (FLMutableDict)completer.wait();
-  }
+// === Metrics
+
+FLSliceResult CBLDart_Metrics_Snapshot() {
+  return CBLDart::Metrics::snapshot();
 }
 
-void PredictiveModel::unregistered() {
-  CBLDart_PredictiveModel_Unregistered unregistered;
-  {
-    std::scoped_lock lock(unregisteredMutex);
-    unregistered = unregistered_;
-    unregistered_ = nullptr;
+void CBLDart_Metrics_Reset() { CBLDart::Metrics::reset(); }
+
+// === Trace
+
+void CBLDart_Trace_Enable(size_t capacityPerThread) {
+  CBLDart::Tracer::enable(capacityPerThread);
+}
+
+void CBLDart_Trace_Disable() { CBLDart::Tracer::disable(); }
+
+bool CBLDart_Trace_IsEnabled() { return CBLDart::Tracer::isEnabled(); }
+
+void CBLDart_Trace_Clear() { CBLDart::Tracer::clear(); }
+
+FLSliceResult CBLDart_Trace_Dump() { return CBLDart::Tracer::dump(); }
+
+// === Index Updater Worker
+
+#ifdef COUCHBASE_ENTERPRISE
+
+#define INDEX_UPDATER_WORKER_FROM_C(worker) \
+  reinterpret_cast<std::shared_ptr<CBLDart::IndexUpdaterWorker>*>(worker)
+
+#define INDEX_UPDATER_WORKER_TO_C(worker) \
+  reinterpret_cast<CBLDart_IndexUpdaterWorker>(worker)
+
+#endif
+
+CBLDart_IndexUpdaterWorker CBLDart_IndexUpdaterWorker_Start(
+    CBLQueryIndex* index, uint32_t batchSize,
+    CBLDart_IndexUpdaterWorker_Embed embed,
+    CBLDart_IndexUpdaterWorker_Done done, CBLError* errorOut) {
+#ifdef COUCHBASE_ENTERPRISE
+  auto state = CBLDart::DatabaseRegistry::instance().find(
+      CBLCollection_Database(CBLQueryIndex_Collection(index)));
+  if (!state) {
+    errorOut->domain = kCBLDomain;
+    errorOut->code = kCBLErrorNotOpen;
+    return nullptr;
   }
 
-  if (unregistered) {
-    unregistered();
+  auto worker = std::make_shared<CBLDart::IndexUpdaterWorker>(
+      std::move(state), batchSize, embed, done);
+  if (!worker->start(index, errorOut)) {
+    return nullptr;
   }
+  return INDEX_UPDATER_WORKER_TO_C(
+      new std::shared_ptr<CBLDart::IndexUpdaterWorker>(worker));
+#else
+  throw std::runtime_error("This code should be unreachable.");
+#endif
 }
 
-}  // namespace CBLDart
+void CBLDart_IndexUpdaterWorker_Stop(CBLDart_IndexUpdaterWorker worker) {
+#ifdef COUCHBASE_ENTERPRISE
+  (*INDEX_UPDATER_WORKER_FROM_C(worker))->stop();
+#else
+  throw std::runtime_error("This code should be unreachable.");
+#endif
+}
 
+void CBLDart_IndexUpdaterWorker_GetProgress(
+    CBLDart_IndexUpdaterWorker worker,
+    CBLDart_IndexUpdaterWorkerProgress* progressOut) {
+#ifdef COUCHBASE_ENTERPRISE
+  *progressOut = (*INDEX_UPDATER_WORKER_FROM_C(worker))->progress();
+#else
+  throw std::runtime_error("This code should be unreachable.");
+#endif
+}
+
+void CBLDart_IndexUpdaterWorker_Delete(CBLDart_IndexUpdaterWorker worker) {
+#ifdef COUCHBASE_ENTERPRISE
+  auto worker_ = INDEX_UPDATER_WORKER_FROM_C(worker);
+  (*worker_)->close();
+  delete worker_;
+#else
+  throw std::runtime_error("This code should be unreachable.");
 #endif
+}
+
+// === Vector Distance
+
+CBLDart_SimdLevel CBLDart_VectorDistance_GetSimdLevel() {
+  return CBLDart::VectorDistance::simdLevel();
+}
+
+bool CBLDart_VectorDistance_SetSimdLevel(CBLDart_SimdLevel level) {
+  return CBLDart::VectorDistance::setSimdLevel(level);
+}
+
+float CBLDart_VectorDistance(CBLDart_VectorDistanceMetric metric,
+                             CBLDart_VectorElementType elementType,
+                             const void* a, const void* b,
+                             uint32_t dimensions) {
+  return CBLDart::VectorDistance::distance(metric, elementType, a, b,
+                                           dimensions);
+}
+
+void CBLDart_VectorDistance_Batch(CBLDart_VectorDistanceMetric metric,
+                                  CBLDart_VectorElementType elementType,
+                                  const void* query, const void* candidates,
+                                  uint32_t count, uint32_t dimensions,
+                                  float* distancesOut) {
+  CBLDart::VectorDistance::batch(metric, elementType, query, candidates, count,
+                                 dimensions, distancesOut);
+}
+
+uint32_t CBLDart_VectorDistance_TopK(CBLDart_VectorDistanceMetric metric,
+                                     CBLDart_VectorElementType elementType,
+                                     const void* query, const void* candidates,
+                                     uint32_t count, uint32_t dimensions,
+                                     uint32_t k, uint32_t* indexesOut,
+                                     float* distancesOut) {
+  return static_cast<uint32_t>(
+      CBLDart::VectorDistance::topK(metric, elementType, query, candidates,
+                                    count, dimensions, k, indexesOut,
+                                    distancesOut));
+}
+
+// === Prediction
 
 CBLDart_PredictiveModel CBLDart_PredictiveModel_New(
     FLString name, CBLDart_IsolateId isolateId,
     CBLDart_PredictiveModel_PredictionSync predictionSync,
     CBLDart_PredictiveModel_PredictionAsync predictionAsync,
+    CBLDart_PredictiveModel_PredictionBatchAsync predictionBatchAsync,
+    uint32_t maxBatchSize, uint64_t cacheMaxSize, uint64_t cacheTtl,
     CBLDart_PredictiveModel_Unregistered unregistered) {
 #ifdef COUCHBASE_ENTERPRISE
   return PREDICTIVE_MODEL_TO_C(new CBLDart::PredictiveModel(
-      name, isolateId, predictionSync, predictionAsync, unregistered));
+      name, isolateId, predictionSync, predictionAsync, predictionBatchAsync,
+      maxBatchSize, cacheMaxSize, cacheTtl, unregistered));
+#else
+  throw std::runtime_error("This code should be unreachable.");
+#endif
+}
+
+bool CBLDart_PredictiveModel_GetCacheStats(
+    CBLDart_PredictiveModel model, CBLDart_PredictionCacheStats* statsOut) {
+#ifdef COUCHBASE_ENTERPRISE
+  return PREDICTIVE_MODEL_FROM_C(model)->cacheStats(statsOut);
+#else
+  throw std::runtime_error("This code should be unreachable.");
+#endif
+}
+
+void CBLDart_PredictiveModel_ClearCache(CBLDart_PredictiveModel model) {
+#ifdef COUCHBASE_ENTERPRISE
+  PREDICTIVE_MODEL_FROM_C(model)->clearCache();
 #else
   throw std::runtime_error("This code should be unreachable.");
 #endif
@@ -746,24 +1266,106 @@ void CBLDart_PredictiveModel_Delete(CBLDart_PredictiveModel model) {
 
 // === Blob
 
-FLSliceResult CBLDart_CBLBlobReader_Read(CBLBlobReadStream* stream,
-                                         uint64_t bufferSize,
-                                         CBLError* outError) {
-  auto bufferSize_t = static_cast<size_t>(bufferSize);
-  auto buffer = FLSliceResult_New(bufferSize_t);
+int64_t CBLDart_CBLBlobReader_ReadInto(CBLBlobReadStream* stream,
+                                       uint8_t* buffer, uint64_t bufferSize,
+                                       CBLError* outError) {
+  CBLDart::TraceScope trace("cbl.blob", "BlobReader.read", "bufferSize",
+                            static_cast<int64_t>(bufferSize));
+  return CBLBlobReader_Read(stream, buffer, static_cast<size_t>(bufferSize),
+                            outError);
+}
+
+#define BLOB_READ_STREAMER_FROM_C(streamer) \
+  reinterpret_cast<std::shared_ptr<CBLDart::BlobReadStreamer>*>(streamer)
+
+#define BLOB_READ_STREAMER_TO_C(streamer) \
+  reinterpret_cast<CBLDart_BlobReadStreamer>(streamer)
+
+CBLDart_BlobReadStreamer CBLDart_BlobReadStreamer_Start(
+    const CBLDatabase* database, const CBLBlob* blob, uint64_t chunkSize,
+    uint32_t queueDepth, CBLDart_AsyncCallback callback, CBLError* errorOut) {
+  auto state = CBLDart::DatabaseRegistry::instance().find(database);
+  if (!state) {
+    errorOut->domain = kCBLDomain;
+    errorOut->code = kCBLErrorNotOpen;
+    return nullptr;
+  }
+
+  auto streamer = std::make_shared<CBLDart::BlobReadStreamer>(
+      std::move(state), blob, chunkSize, queueDepth,
+      ASYNC_CALLBACK_FROM_C(callback));
+  if (!streamer->start(errorOut)) {
+    return nullptr;
+  }
+  return BLOB_READ_STREAMER_TO_C(
+      new std::shared_ptr<CBLDart::BlobReadStreamer>(streamer));
+}
+
+void CBLDart_BlobReadStreamer_Request(CBLDart_BlobReadStreamer streamer,
+                                      uint32_t chunks) {
+  (*BLOB_READ_STREAMER_FROM_C(streamer))->request(chunks);
+}
 
-  auto bytesRead = CBLBlobReader_Read(stream, const_cast<void*>(buffer.buf),
-                                      bufferSize_t, outError);
+void CBLDart_BlobReadStreamer_GetError(CBLDart_BlobReadStreamer streamer,
+                                       CBLError* errorOut) {
+  *errorOut = (*BLOB_READ_STREAMER_FROM_C(streamer))->error();
+}
+
+void CBLDart_BlobReadStreamer_Delete(CBLDart_BlobReadStreamer streamer) {
+  auto streamer_ = BLOB_READ_STREAMER_FROM_C(streamer);
+  (*streamer_)->stop();
+  delete streamer_;
+}
+
+#define BLOB_WRITE_STREAMER_FROM_C(streamer) \
+  reinterpret_cast<std::shared_ptr<CBLDart::BlobWriteStreamer>*>(streamer)
+
+#define BLOB_WRITE_STREAMER_TO_C(streamer) \
+  reinterpret_cast<CBLDart_BlobWriteStreamer>(streamer)
+
+CBLDart_BlobWriteStreamer CBLDart_BlobWriteStreamer_Start(
+    CBLDatabase* db, uint64_t bufferSize, CBLDart_AsyncCallback callback,
+    CBLError* errorOut) {
+  auto state = CBLDart::DatabaseRegistry::instance().find(db);
+  if (!state) {
+    errorOut->domain = kCBLDomain;
+    errorOut->code = kCBLErrorNotOpen;
+    return nullptr;
+  }
 
-  // Handle error
-  if (bytesRead == -1) {
-    FLSliceResult_Release(buffer);
-    return {nullptr, 0};
+  auto stream = CBLBlobWriter_Create(db, errorOut);
+  if (!stream) {
+    return nullptr;
   }
 
-  buffer.size = bytesRead;
+  auto streamer = std::make_shared<CBLDart::BlobWriteStreamer>(
+      std::move(state), stream, bufferSize, ASYNC_CALLBACK_FROM_C(callback));
+  if (!streamer->start(errorOut)) {
+    return nullptr;
+  }
+  return BLOB_WRITE_STREAMER_TO_C(
+      new std::shared_ptr<CBLDart::BlobWriteStreamer>(streamer));
+}
+
+void CBLDart_BlobWriteStreamer_Write(CBLDart_BlobWriteStreamer streamer,
+                                     FLSliceResult chunk) {
+  (*BLOB_WRITE_STREAMER_FROM_C(streamer))->write(chunk);
+}
+
+void CBLDart_BlobWriteStreamer_Finish(CBLDart_BlobWriteStreamer streamer,
+                                      FLString contentType) {
+  (*BLOB_WRITE_STREAMER_FROM_C(streamer))->finish(contentType);
+}
+
+void CBLDart_BlobWriteStreamer_GetError(CBLDart_BlobWriteStreamer streamer,
+                                        CBLError* errorOut) {
+  *errorOut = (*BLOB_WRITE_STREAMER_FROM_C(streamer))->error();
+}
 
-  return buffer;
+void CBLDart_BlobWriteStreamer_Delete(CBLDart_BlobWriteStreamer streamer) {
+  auto streamer_ = BLOB_WRITE_STREAMER_FROM_C(streamer);
+  (*streamer_)->stop();
+  delete streamer_;
 }
 
 // === Replicator
@@ -810,6 +1412,7 @@ static std::mutex replicatorCallbackWrapperContextsMutex;
 static bool CBLDart_ReplicatorFilterWrapper(CBLDart::AsyncCallback* callback,
                                             CBLDocument* document,
                                             CBLDocumentFlags flags) {
+  CBLDart::TraceScope trace("cbl.callback", "ReplicationFilter");
   Dart_CObject document_{};
   CBLDart_CObject_SetPointer(&document_, document);
 
@@ -858,6 +1461,7 @@ static bool CBLDart_ReplicatorPullFilterWrapper(void* context,
 static const CBLDocument* CBLDart_ReplicatorConflictResolverWrapper(
     void* context, FLString documentID, const CBLDocument* localDocument,
     const CBLDocument* remoteDocument) {
+  CBLDart::TraceScope trace("cbl.callback", "ConflictResolver");
   auto wrapperContext =
       reinterpret_cast<ReplicatorCallbackWrapperContext*>(context);
   auto collection =
@@ -1097,6 +1701,7 @@ class ReplicatorStatus_CObject_Helper {
 static void CBLDart_Replicator_ChangeListenerWrapper(
     void* context, CBLReplicator* replicator,
     const CBLReplicatorStatus* status) {
+  CBLDart::TraceScope trace("cbl.listener", "ReplicatorChangeListener");
   auto callback = ASYNC_CALLBACK_FROM_C(context);
 
   ReplicatorStatus_CObject_Helper cObjectStatus;
@@ -1191,6 +1796,8 @@ class ReplicatedDocument_CObject_Helper {
 static void CBLDart_Replicator_DocumentReplicationListenerWrapper(
     void* context, CBLReplicator* replicator, bool isPush,
     unsigned numDocuments, const CBLReplicatedDocument* documents) {
+  CBLDart::TraceScope trace("cbl.listener", "DocumentReplicationListener",
+                            "numDocuments", numDocuments);
   auto callback = ASYNC_CALLBACK_FROM_C(context);
 
   Dart_CObject isPush_{};
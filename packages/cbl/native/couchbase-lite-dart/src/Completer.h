@@ -0,0 +1,55 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#include "CBL+Dart.h"
+
+namespace CBLDart {
+
+// === Completer ==============================================================
+
+/**
+ * A completer which native code waits on, while Dart computes the result of an
+ * asynchronous call and passes it to `CBLDart_Completer_Complete`.
+ *
+ * Only the first completion has an effect, so that a waiting thread can be
+ * unblocked with [cancel] and Dart can still complete the completer later.
+ */
+class Completer {
+ public:
+  void complete(uint64_t result) {
+    {
+      std::scoped_lock lock(mutex_);
+      if (isCompleted_) {
+        return;
+      }
+      result_ = result;
+      isCompleted_ = true;
+    }
+    completedCv_.notify_all();
+  }
+
+  /// Completes the completer with `0`, unless it has already been completed.
+  void cancel() { complete(0); }
+
+  uint64_t wait() {
+    std::unique_lock lock(mutex_);
+    completedCv_.wait(lock, [this] { return isCompleted_; });
+    return result_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable completedCv_;
+  bool isCompleted_ = false;
+  uint64_t result_ = 0;
+};
+
+}  // namespace CBLDart
+
+#define COMPLETER_FROM_C(completer) \
+  reinterpret_cast<CBLDart::Completer*>(completer)
+
+#define COMPLETER_TO_C(completer) reinterpret_cast<CBLDart_Completer>(completer)
@@ -48,4 +48,22 @@ bool CpuSupportsAVX2() {
 #endif
 }
 
+bool CpuSupportsF16C() {
+#if defined(__x86_64__) || defined(_M_X64)
+  const size_t CPU_INFO_SIZE = 4;
+  const unsigned int FEATURES_LEAF = 1;
+  const unsigned int F16C_BIT = 29;
+  const unsigned int F16C_MASK = 1U << F16C_BIT;
+
+  int32_t cpuInfo[CPU_INFO_SIZE];
+
+  __cross_cpuid(FEATURES_LEAF, cpuInfo);
+  return (cpuInfo[2] & F16C_MASK) != 0;
+#else
+  // F16C is only supported on Intel architectures and we only support 64-bit
+  // on those architectures.
+  return false;
+#endif
+}
+
 }  // namespace CBLDart
@@ -4,4 +4,6 @@ namespace CBLDart {
 
 bool CpuSupportsAVX2();
 
+bool CpuSupportsF16C();
+
 }
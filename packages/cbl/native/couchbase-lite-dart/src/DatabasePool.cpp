@@ -0,0 +1,195 @@
+#include "DatabasePool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "Utils.h"
+
+namespace CBLDart {
+
+static constexpr int64_t kNanosPerMilli = 1000000;
+
+static inline std::string CBLDart_FLStringToStdString(FLString string) {
+  return std::string(static_cast<const char*>(string.buf), string.size);
+}
+
+// === DatabasePool::Key ======================================================
+
+DatabasePool::Key DatabasePool::Key::make(
+    FLString name, const CBLDatabaseConfiguration& config) {
+  Key key{};
+  key.name = CBLDart_FLStringToStdString(name);
+  key.directory = CBLDart_FLStringToStdString(config.directory);
+  key.fullSync = config.fullSync;
+#ifdef COUCHBASE_ENTERPRISE
+  key.encryptionKey = config.encryptionKey;
+#endif
+  return key;
+}
+
+bool DatabasePool::Key::operator==(const Key& other) const {
+#ifdef COUCHBASE_ENTERPRISE
+  if (encryptionKey.algorithm != other.encryptionKey.algorithm ||
+      (encryptionKey.algorithm != kCBLEncryptionNone &&
+       memcmp(encryptionKey.bytes, other.encryptionKey.bytes,
+              sizeof(encryptionKey.bytes)) != 0)) {
+    return false;
+  }
+#endif
+  return name == other.name && directory == other.directory &&
+         fullSync == other.fullSync;
+}
+
+// === DatabasePool ===========================================================
+
+DatabasePool::DatabasePool(CloseHandle closeHandle)
+    : closeHandle_(closeHandle) {}
+
+void DatabasePool::configure(size_t capacity, int64_t timeToLiveMillis) {
+  std::vector<CBLDatabase*> evicted;
+  {
+    std::scoped_lock lock(mutex_);
+    capacity_ = capacity;
+    timeToLive_ = std::max<int64_t>(timeToLiveMillis, 0) * kNanosPerMilli;
+
+    while (entries_.size() > capacity_) {
+      evicted.push_back(entries_.front().database);
+      entries_.pop_front();
+    }
+
+    cv_.notify_one();
+  }
+  closeAll(evicted);
+}
+
+size_t DatabasePool::size() {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+void DatabasePool::clear() {
+  std::vector<CBLDatabase*> evicted;
+  {
+    std::scoped_lock lock(mutex_);
+    for (auto& entry : entries_) {
+      evicted.push_back(entry.database);
+    }
+    entries_.clear();
+  }
+  closeAll(evicted);
+}
+
+CBLDatabase* DatabasePool::take(const Key& key) {
+  std::scoped_lock lock(mutex_);
+  // Prefer the most recently pooled handle, which is the least likely to
+  // expire soon.
+  for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+    if (it->key == key) {
+      auto database = it->database;
+      entries_.erase(std::next(it).base());
+      return database;
+    }
+  }
+  return nullptr;
+}
+
+bool DatabasePool::put(CBLDatabase* database, const Key& key) {
+  std::vector<CBLDatabase*> evicted;
+  {
+    std::scoped_lock lock(mutex_);
+    if (capacity_ == 0) {
+      return false;
+    }
+
+    auto expirationTime = timeToLive_ > 0
+                              ? CBLDart_MonotonicNanos() + timeToLive_
+                              : INT64_MAX;
+    entries_.push_back({database, key, expirationTime});
+
+    while (entries_.size() > capacity_) {
+      evicted.push_back(entries_.front().database);
+      entries_.pop_front();
+    }
+
+    ensureThreadStarted();
+    cv_.notify_one();
+  }
+  closeAll(evicted);
+  return true;
+}
+
+void DatabasePool::evict(const std::string& name,
+                         const std::string& directory) {
+  std::vector<CBLDatabase*> evicted;
+  {
+    std::scoped_lock lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->key.name == name && it->key.directory == directory) {
+        evicted.push_back(it->database);
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  closeAll(evicted);
+}
+
+void DatabasePool::evictExpired(std::vector<CBLDatabase*>& evicted) {
+  auto now = CBLDart_MonotonicNanos();
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->expirationTime <= now) {
+      evicted.push_back(it->database);
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void DatabasePool::closeAll(const std::vector<CBLDatabase*>& databases) {
+  for (auto database : databases) {
+    closeHandle_(database);
+  }
+}
+
+void DatabasePool::ensureThreadStarted() {
+  if (!threadStarted_) {
+    threadStarted_ = true;
+    // The pool is never destroyed, so the thread can run detached.
+    std::thread([this] { run(); }).detach();
+  }
+}
+
+void DatabasePool::run() {
+  std::vector<CBLDatabase*> evicted;
+  std::unique_lock lock(mutex_);
+
+  while (true) {
+    evictExpired(evicted);
+
+    if (!evicted.empty()) {
+      lock.unlock();
+      closeAll(evicted);
+      evicted.clear();
+      lock.lock();
+      continue;
+    }
+
+    int64_t nextExpirationTime = INT64_MAX;
+    for (auto& entry : entries_) {
+      nextExpirationTime = std::min(nextExpirationTime, entry.expirationTime);
+    }
+
+    if (nextExpirationTime == INT64_MAX) {
+      cv_.wait(lock);
+    } else {
+      cv_.wait_for(lock, std::chrono::nanoseconds(nextExpirationTime -
+                                                  CBLDart_MonotonicNanos()));
+    }
+  }
+}
+
+}  // namespace CBLDart
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "CBL+Dart.h"
+
+namespace CBLDart {
+
+// === DatabasePool ===========================================================
+
+/**
+ * Keeps databases open for a while after they have been closed by Dart, so
+ * that reopening a database with the same name and configuration is nearly
+ * free.
+ *
+ * When a pooled database is closed, the pool takes over the reference and the
+ * database lock of the caller, instead of closing the database. Opening a
+ * database with the same name and configuration hands the most recently
+ * pooled handle back. Handles are closed when they have been pooled for
+ * longer than the time to live, or when the pool is full, starting with the
+ * least recently pooled handle.
+ */
+class DatabasePool {
+ public:
+  /**
+   * Identifies databases which can be used interchangeably.
+   */
+  struct Key {
+    std::string name;
+    std::string directory;
+    bool fullSync;
+#ifdef COUCHBASE_ENTERPRISE
+    CBLEncryptionKey encryptionKey;
+#endif
+
+    static Key make(FLString name, const CBLDatabaseConfiguration& config);
+
+    bool operator==(const Key& other) const;
+    bool operator!=(const Key& other) const { return !(*this == other); }
+  };
+
+  /**
+   * Closes and releases a database which is evicted from the pool.
+   */
+  typedef void (*CloseHandle)(CBLDatabase* database);
+
+  explicit DatabasePool(CloseHandle closeHandle);
+
+  /**
+   * Sets the maximum number of pooled handles and the time in milliseconds
+   * for which handles are kept open.
+   *
+   * A capacity of 0 disables the pool and closes all pooled handles. A time to
+   * live of 0 keeps handles open until they are evicted because the pool is
+   * full.
+   */
+  void configure(size_t capacity, int64_t timeToLiveMillis);
+
+  size_t size();
+
+  /**
+   * Closes all pooled handles.
+   */
+  void clear();
+
+  /**
+   * Takes a pooled handle for [key] out of the pool, or returns `nullptr`.
+   */
+  CBLDatabase* take(const Key& key);
+
+  /**
+   * Pools [database], which was opened with [key], instead of closing it, if
+   * the pool is enabled.
+   *
+   * Returns whether the pool took over the database, including the reference
+   * and database lock of the caller.
+   */
+  bool put(CBLDatabase* database, const Key& key);
+
+  /**
+   * Closes all pooled handles of the database with the given [name] in
+   * [directory], for example before the database is deleted.
+   */
+  void evict(const std::string& name, const std::string& directory);
+
+ private:
+  struct Entry {
+    CBLDatabase* database;
+    Key key;
+    int64_t expirationTime;
+  };
+
+  void evictExpired(std::vector<CBLDatabase*>& evicted);
+  void closeAll(const std::vector<CBLDatabase*>& databases);
+  void ensureThreadStarted();
+  void run();
+
+  CloseHandle closeHandle_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool threadStarted_ = false;
+  size_t capacity_ = 0;
+  int64_t timeToLive_ = 0;
+  /// Pooled handles, from least to most recently pooled.
+  std::list<Entry> entries_;
+};
+
+}  // namespace CBLDart
@@ -0,0 +1,141 @@
+#include "DatabaseRegistry.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace CBLDart {
+
+// === DatabaseState ==========================================================
+
+bool DatabaseState::addWorker(std::weak_ptr<DatabaseWorker> worker,
+                              CBLError* errorOut) {
+  std::scoped_lock lock(workersMutex_);
+  return addWorkerLocked(std::move(worker), errorOut);
+}
+
+CBLDatabase* DatabaseState::acquireConnection(
+    const CBLDatabase* database, std::weak_ptr<DatabaseWorker> worker,
+    CBLError* errorOut) {
+  CBLDatabase* connection = nullptr;
+  {
+    std::scoped_lock lock(workersMutex_);
+    if (!addWorkerLocked(std::move(worker), errorOut)) {
+      return nullptr;
+    }
+    std::swap(connection, idleConnection_);
+  }
+
+  if (!connection) {
+    auto config = CBLDatabase_Config(database);
+    connection =
+        CBLDatabase_Open(CBLDatabase_Name(database), &config, errorOut);
+  }
+  return connection;
+}
+
+bool DatabaseState::addWorkerLocked(std::weak_ptr<DatabaseWorker> worker,
+                                    CBLError* errorOut) {
+  // Checked under the workers lock, so that a worker is either rejected or
+  // stopped by `stopWorkers`.
+  if (!isOpen) {
+    errorOut->domain = kCBLDomain;
+    errorOut->code = kCBLErrorNotOpen;
+    return false;
+  }
+
+  workers_.erase(
+      std::remove_if(workers_.begin(), workers_.end(),
+                     [](const auto& worker) { return worker.expired(); }),
+      workers_.end());
+  workers_.push_back(std::move(worker));
+  return true;
+}
+
+void DatabaseState::releaseConnection(CBLDatabase* connection) {
+  {
+    std::scoped_lock lock(workersMutex_);
+    if (isOpen && !idleConnection_) {
+      idleConnection_ = connection;
+      return;
+    }
+  }
+  CBLDatabase_Close(connection, nullptr);
+  CBLDatabase_Release(connection);
+}
+
+void DatabaseState::stopWorkers() {
+  std::vector<std::weak_ptr<DatabaseWorker>> workers;
+  CBLDatabase* idleConnection = nullptr;
+  {
+    std::scoped_lock lock(workersMutex_);
+    assert(!isOpen);
+    std::swap(workers, workers_);
+    std::swap(idleConnection, idleConnection_);
+  }
+
+  for (auto& worker : workers) {
+    if (auto worker_ = worker.lock()) {
+      worker_->stopAndWait();
+    }
+  }
+
+  if (idleConnection) {
+    CBLDatabase_Close(idleConnection, nullptr);
+    CBLDatabase_Release(idleConnection);
+  }
+}
+
+// === DatabaseRegistry =======================================================
+
+DatabaseRegistry& DatabaseRegistry::instance() {
+  // Never destroyed, because finalizers can run after static destructors
+  // have run.
+  static auto registry = new DatabaseRegistry;
+  return *registry;
+}
+
+void DatabaseRegistry::add(const CBLDatabase* database,
+                           DatabasePool::Key poolKey) {
+  std::unique_lock lock(mutex_);
+  auto it = states_.find(database);
+  if (it != states_.end()) {
+    // A handle which is reused from the pool keeps its state, because objects
+    // of the previous session may still share its lock.
+    assert(it->second->poolKey == poolKey);
+    it->second->isOpen = true;
+    return;
+  }
+  states_.emplace(database,
+                  std::make_shared<DatabaseState>(std::move(poolKey)));
+}
+
+std::shared_ptr<DatabaseState> DatabaseRegistry::find(const void* owner) {
+  std::shared_lock lock(mutex_);
+  auto it = states_.find(owner);
+  return it == states_.end() ? nullptr : it->second;
+}
+
+void DatabaseRegistry::clone(const CBLDatabase* database, const void* owner) {
+  std::unique_lock lock(mutex_);
+  auto it = states_.find(database);
+  assert(it != states_.end());
+  auto state = it->second;
+  states_.insert_or_assign(owner, std::move(state));
+}
+
+void DatabaseRegistry::remove(const void* owner) {
+  std::shared_ptr<DatabaseState> state;
+  {
+    std::unique_lock lock(mutex_);
+    auto it = states_.find(owner);
+    if (it == states_.end()) {
+      return;
+    }
+    state = std::move(it->second);
+    states_.erase(it);
+  }
+  // The state is destroyed outside of the registry lock, if this was the last
+  // reference.
+}
+
+}  // namespace CBLDart
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "CBL+Dart.h"
+#include "DatabasePool.h"
+
+namespace CBLDart {
+
+// === DatabaseWorker =========================================================
+
+/**
+ * Background work which uses a secondary connection to a database.
+ */
+class DatabaseWorker {
+ public:
+  virtual ~DatabaseWorker() = default;
+
+  /**
+   * Stops the worker and waits until it has returned its connection.
+   */
+  virtual void stopAndWait() = 0;
+};
+
+// === DatabaseState ==========================================================
+
+/**
+ * The native state of an open database handle.
+ *
+ * The state is shared by the database and by all objects which belong to the
+ * database and need to lock it, such as listener tokens and replicators. It
+ * stays alive until the last of them has been released.
+ *
+ * The state does not keep a set of these objects. They are indexed by the
+ * [DatabaseRegistry], which is what finds the state of an object, and they are
+ * registered with and removed from Couchbase Lite by the Dart side. A set in
+ * the state would only duplicate the registry, at the cost of taking the lock
+ * of the state whenever a listener is added or removed.
+ */
+struct DatabaseState {
+  explicit DatabaseState(DatabasePool::Key poolKey)
+      : poolKey(std::move(poolKey)) {}
+
+  /// The database level lock. See the documentation of database level locking
+  /// in `CBL+Dart.cpp`.
+  std::mutex mutex;
+
+  /// Whether the database is open, as far as Dart is concerned. Used to
+  /// ensure that databases are closed only once.
+  std::atomic<bool> isOpen{true};
+
+  /// The name and configuration the database was opened with.
+  const DatabasePool::Key poolKey;
+
+  /**
+   * Registers [worker], so that it is stopped before the database is closed.
+   *
+   * For workers which use the database through objects which belong to it,
+   * instead of through a secondary connection.
+   *
+   * Returns `false` and sets [errorOut] if the database has been closed.
+   */
+  bool addWorker(std::weak_ptr<DatabaseWorker> worker, CBLError* errorOut);
+
+  /**
+   * Registers [worker] and returns a secondary connection to [database] for
+   * it to use, or `nullptr` if the database has been closed or opening the
+   * connection failed.
+   *
+   * The connection must be returned with [releaseConnection].
+   */
+  CBLDatabase* acquireConnection(const CBLDatabase* database,
+                                 std::weak_ptr<DatabaseWorker> worker,
+                                 CBLError* errorOut);
+
+  /**
+   * Returns a connection which has been acquired with [acquireConnection].
+   *
+   * One connection is kept open to be reused, while the database is open.
+   */
+  void releaseConnection(CBLDatabase* connection);
+
+  /**
+   * Stops all workers, waits for them, and closes the connections they used.
+   *
+   * Must be called after the database has been marked as closed and before it
+   * is closed, so that the database file is not kept open.
+   */
+  void stopWorkers();
+
+ private:
+  bool addWorkerLocked(std::weak_ptr<DatabaseWorker> worker,
+                       CBLError* errorOut);
+
+  std::mutex workersMutex_;
+  std::vector<std::weak_ptr<DatabaseWorker>> workers_;
+  CBLDatabase* idleConnection_ = nullptr;
+};
+
+/**
+ * Holds the lock of a [DatabaseState] and keeps the state alive while the
+ * lock is held.
+ */
+class DatabaseLock {
+ public:
+  explicit DatabaseLock(std::shared_ptr<DatabaseState> state)
+      : state_(std::move(state)), lock_(state_->mutex) {}
+
+ private:
+  // Declared before the lock, so that the lock is released first.
+  std::shared_ptr<DatabaseState> state_;
+  std::unique_lock<std::mutex> lock_;
+};
+
+// === DatabaseRegistry =======================================================
+
+/**
+ * Maps open databases, and objects which belong to them, to the
+ * [DatabaseState] of the database.
+ *
+ * Lookups only take a shared lock on the registry, so that threads which
+ * lock different databases do not contend with each other.
+ */
+class DatabaseRegistry {
+ public:
+  static DatabaseRegistry& instance();
+
+  /**
+   * Creates the state of a database which has just been opened.
+   *
+   * A database handle which is reused from the [DatabasePool] keeps its
+   * state, including the lock which objects of the previous session share,
+   * and is only marked as open again.
+   */
+  void add(const CBLDatabase* database, DatabasePool::Key poolKey);
+
+  /**
+   * Returns the state of [owner], or `nullptr` if it has been removed.
+   */
+  std::shared_ptr<DatabaseState> find(const void* owner);
+
+  /**
+   * Makes the state of [database] available under [owner].
+   *
+   * The database must be registered.
+   */
+  void clone(const CBLDatabase* database, const void* owner);
+
+  void remove(const void* owner);
+
+ private:
+  DatabaseRegistry() = default;
+
+  std::shared_mutex mutex_;
+  std::unordered_map<const void*, std::shared_ptr<DatabaseState>> states_;
+};
+
+}  // namespace CBLDart
@@ -1,6 +1,7 @@
 #include <bitset>
 
 #include "Fleece+Dart.h"
+#include "Metrics.h"
 #include "Utils.h"
 
 // === Fleece =================================================================
@@ -15,6 +16,16 @@ void CBLDart_FLSliceResult_ReleaseByBuf(void* buf) {
   (void)FLSliceResult_Release({buf, 0});
 }
 
+void CBLDart_FLSliceResult_RetainForTransfer(void* buf) {
+  CBLDART_METRICS_INCREMENT(kSliceResultsTransferred, 1);
+  (void)FLSliceResult_Retain({buf, 0});
+}
+
+void CBLDart_FLSliceResult_ReleaseTransferred(void* buf) {
+  CBLDART_METRICS_INCREMENT(kTransferredSliceResultsReleased, 1);
+  (void)FLSliceResult_Release({buf, 0});
+}
+
 // === Decoder ================================================================
 
 static const size_t kMaxSharedKeys = 2048;
@@ -104,10 +115,12 @@ void CBLDart_GetLoadedFLValue(FLValue value, CBLDart_LoadedFLValue* out) {
       auto string = FLValue_AsString(value);
       out->stringBuf = string.buf;
       out->stringSize = string.size;
+      CBLDART_METRICS_INCREMENT(kBytesDecoded, string.size);
       break;
     }
     case kFLData: {
       out->asData = FLValue_AsData(value);
+      CBLDART_METRICS_INCREMENT(kBytesDecoded, out->asData.size);
       break;
     }
     case kFLArray: {
@@ -149,6 +162,7 @@ CBLDart_FLDictIterator* CBLDart_FLDictIterator_Begin(
     CBLDart_LoadedDictKey* keyOut, CBLDart_LoadedFLValue* valueOut,
     bool deleteOnDone, bool preLoad) {
   auto iterator = new CBLDart_FLDictIterator{};
+  CBLDART_METRICS_INCREMENT(kDictIteratorsAllocated, 1);
   iterator->_keyOut = keyOut;
   iterator->_valueOut = valueOut;
   iterator->_knownSharedKeys = knownSharedKeys;
@@ -206,6 +220,7 @@ struct CBLDart_FLArrayIterator {
 CBLDart_FLArrayIterator* CBLDart_FLArrayIterator_Begin(
     FLArray array, CBLDart_LoadedFLValue* valueOut, bool deleteOnDone) {
   auto iterator = new CBLDart_FLArrayIterator{};
+  CBLDART_METRICS_INCREMENT(kArrayIteratorsAllocated, 1);
   iterator->_valueOut = valueOut;
   iterator->_deleteOnDone = deleteOnDone;
 
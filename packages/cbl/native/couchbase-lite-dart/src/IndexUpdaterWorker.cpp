@@ -0,0 +1,289 @@
+#include "IndexUpdaterWorker.h"
+
+#ifdef COUCHBASE_ENTERPRISE
+
+#include <thread>
+
+#include "Utils.h"
+
+namespace CBLDart {
+
+// === IndexUpdaterWorker =====================================================
+
+IndexUpdaterWorker::IndexUpdaterWorker(
+    std::shared_ptr<DatabaseState> databaseState, uint32_t batchSize,
+    CBLDart_IndexUpdaterWorker_Embed embed,
+    CBLDart_IndexUpdaterWorker_Done done)
+    : databaseState_(std::move(databaseState)),
+      batchSize_(batchSize > 0 ? batchSize : 1),
+      embed_(embed),
+      done_(done) {}
+
+IndexUpdaterWorker::~IndexUpdaterWorker() {
+  // A batch which was pending when the worker was stopped might have been
+  // completed by Dart since.
+  releaseBatch();
+}
+
+bool IndexUpdaterWorker::start(CBLQueryIndex* index, CBLError* errorOut) {
+  auto collection = CBLQueryIndex_Collection(index);
+  database_ = databaseState_->acquireConnection(
+      CBLCollection_Database(collection), weak_from_this(), errorOut);
+  if (!database_) {
+    return false;
+  }
+
+  auto scope = CBLCollection_Scope(collection);
+  collection_ =
+      CBLDatabase_Collection(database_, CBLCollection_Name(collection),
+                             CBLScope_Name(scope), errorOut);
+  CBLScope_Release(scope);
+  if (collection_) {
+    index_ = CBLCollection_GetIndex(collection_, CBLQueryIndex_Name(index),
+                                    errorOut);
+  }
+  if (!index_) {
+    if (errorOut->code == 0) {
+      // The collection or the index has been deleted.
+      errorOut->domain = kCBLDomain;
+      errorOut->code = kCBLErrorNotFound;
+    }
+    finish();
+    return false;
+  }
+
+  isRunning_ = true;
+  startTime_ = CBLDart_MonotonicNanos();
+
+  // The thread keeps this worker alive until it has stopped.
+  std::thread([self = shared_from_this()]() { self->run(); }).detach();
+  return true;
+}
+
+void IndexUpdaterWorker::stop() {
+  stopRequested_ = true;
+
+  // The completer is created while holding the mutex, after checking whether
+  // the worker has been stopped, so a pending batch is always unblocked.
+  std::scoped_lock lock(mutex_);
+  if (completer_) {
+    completer_->cancel();
+  }
+}
+
+void IndexUpdaterWorker::stopAndWait() {
+  stop();
+
+  std::unique_lock lock(mutex_);
+  finishedCv_.wait(lock, [this] { return finished_; });
+}
+
+void IndexUpdaterWorker::close() {
+  {
+    std::scoped_lock lock(mutex_);
+    closed_ = true;
+  }
+  stop();
+}
+
+CBLDart_IndexUpdaterWorkerProgress IndexUpdaterWorker::progress() {
+  CBLDart_IndexUpdaterWorkerProgress progress{};
+  progress.isRunning = isRunning_;
+  progress.batches = batches_;
+  progress.values = values_;
+  progress.vectorsSet = vectorsSet_;
+  progress.vectorsRemoved = vectorsRemoved_;
+  progress.vectorsSkipped = vectorsSkipped_;
+  progress.vectorsFailed = vectorsFailed_;
+
+  auto endTime =
+      progress.isRunning ? CBLDart_MonotonicNanos() : endTime_.load();
+  progress.elapsedTime = (endTime - startTime_) / 1000;
+  progress.embeddingTime = embeddingTime_ / 1000;
+  progress.indexingTime = indexingTime_ / 1000;
+
+  {
+    std::scoped_lock lock(errorMutex_);
+    progress.error = error_;
+  }
+
+  return progress;
+}
+
+void IndexUpdaterWorker::run() {
+  while (!stopRequested_) {
+    CBLError error{};
+    auto updater = CBLQueryIndex_BeginUpdate(index_, batchSize_, &error);
+    if (!updater) {
+      // The index is either up-to-date or the update could not be started.
+      if (error.code != 0) {
+        setError(error);
+      }
+      break;
+    }
+
+    auto madeProgress = updateBatch(updater);
+    CBLIndexUpdater_Release(updater);
+
+    if (!madeProgress) {
+      break;
+    }
+  }
+
+  endTime_ = CBLDart_MonotonicNanos();
+  isRunning_ = false;
+
+  finish();
+
+  std::scoped_lock lock(mutex_);
+  if (!closed_) {
+    done_();
+  }
+}
+
+void IndexUpdaterWorker::finish() {
+  if (index_) {
+    CBLQueryIndex_Release(index_);
+    index_ = nullptr;
+  }
+  if (collection_) {
+    CBLCollection_Release(collection_);
+    collection_ = nullptr;
+  }
+  databaseState_->releaseConnection(database_);
+  database_ = nullptr;
+
+  std::scoped_lock lock(mutex_);
+  finished_ = true;
+  finishedCv_.notify_all();
+}
+
+bool IndexUpdaterWorker::updateBatch(CBLIndexUpdater* updater) {
+  auto count = CBLIndexUpdater_Count(updater);
+
+  // Encode all values into a single Fleece array, so that they can be read in
+  // Dart in one go.
+  auto encoder = FLEncoder_New();
+  FLEncoder_BeginArray(encoder, count);
+  for (size_t i = 0; i < count; i++) {
+    FLEncoder_WriteValue(encoder, CBLIndexUpdater_Value(updater, i));
+  }
+  FLEncoder_EndArray(encoder);
+  batchValues_ = FLEncoder_Finish(encoder, nullptr);
+  FLEncoder_Free(encoder);
+
+  batch_ = {};
+  batch_.values = FLSliceResult_AsSlice(batchValues_);
+  batch_.count = static_cast<uint32_t>(count);
+
+  auto embeddingStart = CBLDart_MonotonicNanos();
+  auto didEmbed = embedBatch();
+  embeddingTime_ += CBLDart_MonotonicNanos() - embeddingStart;
+
+  if (!didEmbed) {
+    // The batch is not released here, since Dart might still complete it if
+    // the worker has been stopped.
+    return false;
+  }
+
+  if (batch_.statuses.size < count ||
+      batch_.vectors.size < count * batch_.dimensions * sizeof(float)) {
+    releaseBatch();
+    CBLError error{};
+    error.domain = kCBLDomain;
+    error.code = kCBLErrorInvalidParameter;
+    setError(error);
+    return false;
+  }
+
+  auto indexingStart = CBLDart_MonotonicNanos();
+  auto statuses = static_cast<const uint8_t*>(batch_.statuses.buf);
+  auto vectors = static_cast<const float*>(batch_.vectors.buf);
+  uint64_t vectorsSet = 0;
+  uint64_t vectorsRemoved = 0;
+  uint64_t vectorsSkipped = 0;
+  uint64_t vectorsFailed = 0;
+  CBLError error{};
+
+  for (size_t i = 0; i < count; i++) {
+    switch (statuses[i]) {
+      case kCBLDart_IndexVectorSet:
+        if (CBLIndexUpdater_SetVector(updater, i,
+                                      vectors + i * batch_.dimensions,
+                                      batch_.dimensions, &error)) {
+          vectorsSet++;
+          continue;
+        }
+        break;
+      case kCBLDart_IndexVectorRemove:
+        if (CBLIndexUpdater_SetVector(updater, i, nullptr, 0, &error)) {
+          vectorsRemoved++;
+          continue;
+        }
+        break;
+      default:
+        CBLIndexUpdater_SkipVector(updater, i);
+        vectorsSkipped++;
+        continue;
+    }
+
+    // A vector which could not be set is skipped, so that it does not fail
+    // the rest of the batch, and is returned again by the next update.
+    setError(error);
+    CBLIndexUpdater_SkipVector(updater, i);
+    vectorsFailed++;
+  }
+
+  vectorsFailed_ += vectorsFailed;
+
+  auto success = CBLIndexUpdater_Finish(updater, &error);
+
+  indexingTime_ += CBLDart_MonotonicNanos() - indexingStart;
+  releaseBatch();
+
+  if (!success) {
+    setError(error);
+    return false;
+  }
+
+  batches_++;
+  values_ += count;
+  vectorsSet_ += vectorsSet;
+  vectorsRemoved_ += vectorsRemoved;
+  vectorsSkipped_ += vectorsSkipped;
+
+  // If no vector has been set or removed, the next update would return the
+  // same values again.
+  return vectorsSkipped + vectorsFailed < count;
+}
+
+bool IndexUpdaterWorker::embedBatch() {
+  Completer* completer;
+  {
+    std::scoped_lock lock(mutex_);
+    if (stopRequested_ || closed_) {
+      return false;
+    }
+    completer_ = std::make_unique<Completer>();
+    completer = completer_.get();
+    embed_(&batch_, COMPLETER_TO_C(completer));
+  }
+  return completer->wait() != 0;
+}
+
+void IndexUpdaterWorker::releaseBatch() {
+  FLSliceResult_Release(batchValues_);
+  FLSliceResult_Release(batch_.statuses);
+  FLSliceResult_Release(batch_.vectors);
+  batchValues_ = {};
+  batch_ = {};
+}
+
+void IndexUpdaterWorker::setError(const CBLError& error) {
+  std::scoped_lock lock(errorMutex_);
+  error_ = error;
+}
+
+}  // namespace CBLDart
+
+#endif
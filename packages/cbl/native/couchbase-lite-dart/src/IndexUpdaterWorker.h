@@ -0,0 +1,108 @@
+#pragma once
+
+#ifdef COUCHBASE_ENTERPRISE
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "CBL+Dart.h"
+#include "Completer.h"
+#include "DatabaseRegistry.h"
+
+namespace CBLDart {
+
+// === IndexUpdaterWorker =====================================================
+
+/**
+ * Updates a lazy vector index on a background thread.
+ *
+ * The worker repeatedly begins an update of the index, passes all values of
+ * the update as one batch to the embedding function, sets the returned vectors
+ * and finishes the update, until the index is up-to-date. Vectors which can
+ * not be set are skipped, counted and their error is reported in the progress.
+ *
+ * The index is updated through a secondary connection to the database, which
+ * is provided by the [DatabaseState] of the database. It stops the worker and
+ * waits for it before the database is closed. Stopping the worker unblocks a
+ * batch for which Dart has not yet returned vectors.
+ *
+ * The background thread keeps the worker alive until it has stopped, so that
+ * the handle which is owned by Dart can be released at any time.
+ */
+class IndexUpdaterWorker
+    : public DatabaseWorker,
+      public std::enable_shared_from_this<IndexUpdaterWorker> {
+ public:
+  IndexUpdaterWorker(std::shared_ptr<DatabaseState> databaseState,
+                     uint32_t batchSize, CBLDart_IndexUpdaterWorker_Embed embed,
+                     CBLDart_IndexUpdaterWorker_Done done);
+
+  ~IndexUpdaterWorker() override;
+
+  /**
+   * Starts updating the secondary connection's instance of [index].
+   *
+   * Returns `false` and sets [errorOut] if the worker could not be started.
+   */
+  bool start(CBLQueryIndex* index, CBLError* errorOut);
+  void stop();
+  void stopAndWait() override;
+
+  /**
+   * Stops the worker and prevents it from calling the Dart callbacks, which
+   * might not exist anymore.
+   */
+  void close();
+
+  CBLDart_IndexUpdaterWorkerProgress progress();
+
+ private:
+  void run();
+  void finish();
+  bool updateBatch(CBLIndexUpdater* updater);
+  bool embedBatch();
+  void releaseBatch();
+  void setError(const CBLError& error);
+
+  std::shared_ptr<DatabaseState> databaseState_;
+  CBLDatabase* database_ = nullptr;
+  CBLCollection* collection_ = nullptr;
+  CBLQueryIndex* index_ = nullptr;
+  uint32_t batchSize_;
+  CBLDart_IndexUpdaterWorker_Embed embed_;
+  CBLDart_IndexUpdaterWorker_Done done_;
+
+  // The batch and its completer are written by Dart, possibly after the
+  // worker has been stopped, so they live as long as the worker.
+  FLSliceResult batchValues_{};
+  CBLDart_IndexUpdateBatch batch_{};
+  std::unique_ptr<Completer> completer_;
+
+  std::mutex mutex_;
+  std::condition_variable finishedCv_;
+  bool closed_ = false;
+  bool finished_ = false;
+
+  std::atomic<bool> isRunning_{false};
+  std::atomic<bool> stopRequested_{false};
+  std::atomic<int64_t> startTime_{0};
+  std::atomic<int64_t> endTime_{0};
+  std::atomic<uint64_t> batches_{0};
+  std::atomic<uint64_t> values_{0};
+  std::atomic<uint64_t> vectorsSet_{0};
+  std::atomic<uint64_t> vectorsRemoved_{0};
+  std::atomic<uint64_t> vectorsSkipped_{0};
+  std::atomic<uint64_t> vectorsFailed_{0};
+  std::atomic<int64_t> embeddingTime_{0};
+  std::atomic<int64_t> indexingTime_{0};
+
+  std::mutex errorMutex_;
+  CBLError error_{};
+};
+
+}  // namespace CBLDart
+
+#endif
@@ -0,0 +1,142 @@
+#include "LogBuffer.h"
+
+namespace CBLDart {
+
+static size_t roundUpToPowerOfTwo(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+int64_t LogTimestampNow() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+uint32_t LogThreadId() {
+  static std::atomic<uint32_t> nextId{1};
+  thread_local uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+  return id;
+}
+
+// === LogRateLimiter =========================================================
+
+LogRateLimiter::LogRateLimiter(const LogRateLimiter& other) { *this = other; }
+
+LogRateLimiter& LogRateLimiter::operator=(const LogRateLimiter& other) {
+  window_.store(other.window_.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+  count_.store(other.count_.load(std::memory_order_relaxed),
+               std::memory_order_relaxed);
+  return *this;
+}
+
+bool LogRateLimiter::tryAcquire(uint32_t limit, int64_t timestamp) {
+  if (limit == 0) {
+    return true;
+  }
+
+  auto window = timestamp / 1000;
+  auto currentWindow = window_.load(std::memory_order_relaxed);
+  if (currentWindow != window &&
+      window_.compare_exchange_strong(currentWindow, window,
+                                      std::memory_order_relaxed)) {
+    count_.store(0, std::memory_order_relaxed);
+  }
+
+  return count_.fetch_add(1, std::memory_order_relaxed) < limit;
+}
+
+// === LogBuffer ==============================================================
+
+LogBuffer::LogBuffer(size_t capacity)
+    : slots_(roundUpToPowerOfTwo(capacity)), mask_(slots_.size() - 1) {
+  for (size_t i = 0; i < slots_.size(); i++) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool LogBuffer::push(CBLLogDomain domain, CBLLogLevel level,
+                     int64_t timestamp, FLString message) {
+  auto position = enqueuePosition_.load(std::memory_order_relaxed);
+  Slot* slot;
+  while (true) {
+    slot = &slots_[position & mask_];
+    auto sequence = slot->sequence.load(std::memory_order_acquire);
+    auto difference =
+        static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+
+    if (difference == 0) {
+      // The slot is free. Try to claim it.
+      if (enqueuePosition_.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      // The slot still holds a record which has not been drained.
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      // Another producer claimed the slot.
+      position = enqueuePosition_.load(std::memory_order_relaxed);
+    }
+  }
+
+  auto wasEmpty =
+      position == dequeuePosition_.load(std::memory_order_relaxed);
+
+  auto& record = slot->record;
+  record.domain = domain;
+  record.level = level;
+  record.timestamp = timestamp;
+  record.threadId = LogThreadId();
+  record.message.assign(static_cast<const char*>(message.buf), message.size);
+  slot->sequence.store(position + 1, std::memory_order_release);
+
+  // Only the first record after the buffer has been drained wakes up the
+  // consumer, which then collects records for the rest of its interval.
+  if (wasEmpty) {
+    waitCondition_.notify_one();
+  }
+
+  return true;
+}
+
+void LogBuffer::drain(std::vector<LogRecord>& out) {
+  auto position = dequeuePosition_.load(std::memory_order_relaxed);
+  while (true) {
+    auto& slot = slots_[position & mask_];
+    auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != position + 1) {
+      // The slot is empty or still being written.
+      break;
+    }
+
+    // Copying the record leaves the slot with the capacity of its message.
+    out.push_back(slot.record);
+    slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+    position++;
+  }
+  dequeuePosition_.store(position, std::memory_order_relaxed);
+}
+
+uint64_t LogBuffer::takeDropped() {
+  return dropped_.exchange(0, std::memory_order_relaxed);
+}
+
+void LogBuffer::waitForRecords(std::chrono::milliseconds timeout) {
+  std::unique_lock lock(waitMutex_);
+  waitCondition_.wait_for(lock, timeout, [this]() { return !isEmpty(); });
+}
+
+bool LogBuffer::isEmpty() const {
+  auto position = dequeuePosition_.load(std::memory_order_relaxed);
+  auto sequence =
+      slots_[position & mask_].sequence.load(std::memory_order_acquire);
+  return sequence != position + 1;
+}
+
+}  // namespace CBLDart
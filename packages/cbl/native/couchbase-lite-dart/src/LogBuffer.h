@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "CBL+Dart.h"
+
+namespace CBLDart {
+
+// === LogRecord ==============================================================
+
+struct LogRecord {
+  CBLLogDomain domain;
+  CBLLogLevel level;
+  /** Milliseconds since the Unix epoch. */
+  int64_t timestamp;
+  /** The id of the thread which logged the record. See LogThreadId. */
+  uint32_t threadId;
+  std::string message;
+};
+
+/** Returns the current time in milliseconds since the Unix epoch. */
+int64_t LogTimestampNow();
+
+/**
+ * Returns a small id for the current thread, which is unique for the lifetime
+ * of the process. Ids are assigned in the order in which threads first log.
+ */
+uint32_t LogThreadId();
+
+// === LogRateLimiter =========================================================
+
+/**
+ * Limits the number of log records which are accepted per second.
+ *
+ * The limiter counts records in fixed one second windows and can be used
+ * concurrently by multiple threads. Under contention at the start of a window
+ * slightly more records than the limit can be accepted.
+ */
+class LogRateLimiter {
+ public:
+  LogRateLimiter() = default;
+  LogRateLimiter(const LogRateLimiter& other);
+  LogRateLimiter& operator=(const LogRateLimiter& other);
+
+  /**
+   * Returns whether a record logged at [timestamp] is accepted, given a
+   * [limit] of records per second. A [limit] of `0` accepts all records.
+   */
+  bool tryAcquire(uint32_t limit, int64_t timestamp);
+
+ private:
+  std::atomic<int64_t> window_{0};
+  std::atomic<uint32_t> count_{0};
+};
+
+// === LogBuffer ==============================================================
+
+/**
+ * A bounded, multi-producer, single-consumer queue of log records.
+ *
+ * Pushing a record never blocks the logging thread. When the buffer is full,
+ * the record is dropped and counted instead. The consumer drains all pending
+ * records at once.
+ *
+ * Each slot is guarded by a sequence number, which producers use to claim the
+ * slot and the consumer uses to detect that a slot has been fully written.
+ * Slots keep the capacity of their message strings, so that after warm up,
+ * pushing a record usually does not allocate.
+ */
+class LogBuffer {
+ public:
+  /**
+   * Creates a buffer which holds at least [capacity] records. The capacity
+   * is rounded up to the next power of two.
+   */
+  explicit LogBuffer(size_t capacity);
+
+  /**
+   * Copies a record into the buffer.
+   *
+   * Returns `false` if the buffer is full and the record was dropped.
+   */
+  bool push(CBLLogDomain domain, CBLLogLevel level, int64_t timestamp,
+            FLString message);
+
+  /**
+   * Moves all pending records into [out], from oldest to newest.
+   *
+   * Must only be called by a single consumer at a time.
+   */
+  void drain(std::vector<LogRecord>& out);
+
+  /**
+   * Returns the number of records which have been dropped since the last
+   * call and resets the count.
+   */
+  uint64_t takeDropped();
+
+  /**
+   * Blocks the consumer until a record has been pushed into the empty buffer
+   * or the [timeout] has expired.
+   *
+   * Producers notify the consumer without acquiring a lock, so a wake up can
+   * be missed. The [timeout] bounds how long records can go unnoticed.
+   */
+  void waitForRecords(std::chrono::milliseconds timeout);
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    LogRecord record{};
+  };
+
+  bool isEmpty() const;
+
+  std::vector<Slot> slots_;
+  uint64_t mask_;
+  std::atomic<uint64_t> enqueuePosition_{0};
+  std::atomic<uint64_t> dequeuePosition_{0};
+  std::atomic<uint64_t> dropped_{0};
+
+  std::mutex waitMutex_;
+  std::condition_variable waitCondition_;
+};
+
+}  // namespace CBLDart
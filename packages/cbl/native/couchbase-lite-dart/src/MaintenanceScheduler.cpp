@@ -0,0 +1,260 @@
+#include "MaintenanceScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "DatabaseRegistry.h"
+#include "Tracer.h"
+#include "Utils.h"
+
+namespace CBLDart {
+
+static constexpr int64_t kNanosPerMilli = 1000000;
+
+// === MaintenanceScheduler::Schedule =========================================
+
+MaintenanceScheduler::Schedule::Schedule(CBLDatabase* database)
+    : database(database) {
+  CBLDatabase_Retain(database);
+}
+
+MaintenanceScheduler::Schedule::~Schedule() {
+  for (auto collection : collections) {
+    CBLCollection_Release(collection);
+  }
+  CBLDatabase_Release(database);
+}
+
+// === MaintenanceScheduler::Run ==============================================
+
+void MaintenanceScheduler::Run::stopAndWait() {
+  // Maintenance cannot be interrupted, so closing the database waits for it.
+  std::unique_lock lock(mutex_);
+  finishedCv_.wait(lock, [this] { return finished_; });
+}
+
+void MaintenanceScheduler::Run::finish() {
+  std::scoped_lock lock(mutex_);
+  finished_ = true;
+  finishedCv_.notify_all();
+}
+
+// === MaintenanceScheduler ===================================================
+
+MaintenanceScheduler& MaintenanceScheduler::instance() {
+  // Never destroyed, because the scheduler thread runs detached.
+  static auto scheduler = new MaintenanceScheduler;
+  return *scheduler;
+}
+
+void MaintenanceScheduler::schedule(CBLDatabase* database,
+                                    const Config& config) {
+  {
+    std::scoped_lock lock(mutex_);
+    auto it = schedules_.find(database);
+    if (it != schedules_.end()) {
+      it->second->config = config;
+      cv_.notify_one();
+      return;
+    }
+  }
+
+  // Listeners are added without holding the scheduler lock, because change
+  // listeners acquire it.
+  auto schedule = std::make_shared<Schedule>(database);
+  schedule->config = config;
+  addListeners(*schedule);
+
+  bool inserted;
+  {
+    std::scoped_lock lock(mutex_);
+    auto result = schedules_.try_emplace(database, schedule);
+    inserted = result.second;
+    if (!inserted) {
+      // The database has been scheduled concurrently.
+      result.first->second->config = config;
+    } else {
+      ensureThreadStarted();
+    }
+    cv_.notify_one();
+  }
+
+  if (!inserted) {
+    removeListeners(*schedule);
+  }
+}
+
+void MaintenanceScheduler::unschedule(CBLDatabase* database) {
+  std::shared_ptr<Schedule> schedule;
+  {
+    std::scoped_lock lock(mutex_);
+    auto it = schedules_.find(database);
+    if (it == schedules_.end()) {
+      return;
+    }
+    schedule = std::move(it->second);
+    schedules_.erase(it);
+  }
+  removeListeners(*schedule);
+}
+
+int64_t MaintenanceScheduler::pendingWrites(CBLDatabase* database) {
+  std::scoped_lock lock(mutex_);
+  auto it = schedules_.find(database);
+  if (it == schedules_.end()) {
+    return -1;
+  }
+  return static_cast<int64_t>(it->second->writes.load());
+}
+
+void MaintenanceScheduler::collectionChanged(
+    void* context, const CBLCollectionChange* change) {
+  auto& schedule = *static_cast<Schedule*>(context);
+  schedule.writes += change->numDocs;
+  schedule.lastWriteTime = CBLDart_MonotonicNanos();
+
+  // Synchronize with the scheduler thread, so that the notification is not
+  // lost while the thread is about to wait.
+  auto& scheduler = instance();
+  { std::scoped_lock lock(scheduler.mutex_); }
+  scheduler.cv_.notify_one();
+}
+
+void MaintenanceScheduler::addListeners(Schedule& schedule) {
+  auto scopeNames = CBLDatabase_ScopeNames(schedule.database, nullptr);
+  if (!scopeNames) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < FLArray_Count(scopeNames); i++) {
+    auto scopeName = FLValue_AsString(FLArray_Get(scopeNames, i));
+    auto collectionNames =
+        CBLDatabase_CollectionNames(schedule.database, scopeName, nullptr);
+    if (!collectionNames) {
+      continue;
+    }
+
+    for (uint32_t j = 0; j < FLArray_Count(collectionNames); j++) {
+      auto collectionName = FLValue_AsString(FLArray_Get(collectionNames, j));
+      auto collection = CBLDatabase_Collection(
+          schedule.database, collectionName, scopeName, nullptr);
+      if (!collection) {
+        continue;
+      }
+
+      schedule.collections.push_back(collection);
+      schedule.listenerTokens.push_back(CBLCollection_AddChangeListener(
+          collection, collectionChanged, &schedule));
+    }
+
+    FLMutableArray_Release(collectionNames);
+  }
+
+  FLMutableArray_Release(scopeNames);
+}
+
+void MaintenanceScheduler::removeListeners(Schedule& schedule) {
+  for (auto listenerToken : schedule.listenerTokens) {
+    CBLListener_Remove(listenerToken);
+  }
+  schedule.listenerTokens.clear();
+}
+
+void MaintenanceScheduler::perform(Schedule& schedule,
+                                   CBLMaintenanceType type) {
+  auto writes = schedule.writes.load();
+
+  // The schedule holds a reference to the database, so the registry cannot
+  // have reused its address for another database.
+  if (auto state = DatabaseRegistry::instance().find(schedule.database)) {
+    // Maintenance runs on a secondary connection, so that it does not hold
+    // the lock of the connection which is used by Dart. Closing the database
+    // waits for the run to finish.
+    auto run = std::make_shared<Run>();
+    CBLError error{};
+    auto success = false;
+    if (auto connection =
+            state->acquireConnection(schedule.database, run, &error)) {
+      TraceScope trace("cbl.database", "Database.performMaintenance", "type",
+                       type);
+      success = CBLDatabase_PerformMaintenance(connection, type, &error);
+      state->releaseConnection(connection);
+    }
+    run->finish();
+
+    // Maintenance is skipped if the database has been closed in the meantime.
+    if (!success &&
+        !(error.domain == kCBLDomain && error.code == kCBLErrorNotOpen)) {
+      auto errorMessage = CBLError_Message(&error);
+      CBL_Log(kCBLLogDomainDatabase, kCBLLogWarning,
+              "Scheduled maintenance of database %p failed: %.*s",
+              schedule.database, static_cast<int>(errorMessage.size),
+              (char*)errorMessage.buf);
+      FLSliceResult_Release(errorMessage);
+    }
+  }
+
+  // Writes are consumed even if maintenance was skipped or failed, so that it
+  // is not retried in a tight loop.
+  schedule.writes -= writes;
+}
+
+void MaintenanceScheduler::ensureThreadStarted() {
+  if (!threadStarted_) {
+    threadStarted_ = true;
+    std::thread([this] { run(); }).detach();
+  }
+}
+
+void MaintenanceScheduler::run() {
+  std::unique_lock lock(mutex_);
+
+  while (true) {
+    auto now = CBLDart_MonotonicNanos();
+    int64_t nextIdleTime = INT64_MAX;
+    std::shared_ptr<Schedule> due;
+
+    for (auto& [database, schedule] : schedules_) {
+      auto writes = schedule->writes.load();
+      if (writes == 0) {
+        continue;
+      }
+
+      auto& config = schedule->config;
+      if (config.writeThreshold > 0 && writes >= config.writeThreshold) {
+        due = schedule;
+        break;
+      }
+
+      if (config.idleMillis > 0) {
+        auto idleTime =
+            schedule->lastWriteTime + config.idleMillis * kNanosPerMilli;
+        if (idleTime <= now) {
+          due = schedule;
+          break;
+        }
+        nextIdleTime = std::min(nextIdleTime, idleTime);
+      }
+    }
+
+    if (due) {
+      auto type = due->config.type;
+      lock.unlock();
+      perform(*due, type);
+      // The schedule may be the last owner of the database, which must not be
+      // released while holding the scheduler lock.
+      due.reset();
+      lock.lock();
+      continue;
+    }
+
+    if (nextIdleTime == INT64_MAX) {
+      cv_.wait(lock);
+    } else {
+      cv_.wait_for(lock, std::chrono::nanoseconds(nextIdleTime - now));
+    }
+  }
+}
+
+}  // namespace CBLDart
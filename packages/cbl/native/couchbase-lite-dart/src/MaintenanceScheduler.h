@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "CBL+Dart.h"
+#include "DatabaseRegistry.h"
+
+namespace CBLDart {
+
+// === MaintenanceScheduler ===================================================
+
+/**
+ * Performs database maintenance in the background, driven by the number of
+ * documents which have been written to a database.
+ *
+ * Writes are counted with collection change listeners, which are registered
+ * for the collections which exist when the database is scheduled. Maintenance
+ * runs on a background thread when the number of writes since the last
+ * maintenance reaches the write threshold, or when no writes have happened for
+ * the idle delay. It runs on a secondary connection, which is provided by the
+ * [DatabaseState] of the database, and is skipped if the database has been
+ * closed in the meantime.
+ */
+class MaintenanceScheduler {
+ public:
+  struct Config {
+    CBLMaintenanceType type;
+    /// The number of writes after which maintenance runs, or 0.
+    uint64_t writeThreshold;
+    /// The time without writes after which maintenance runs, or 0.
+    int64_t idleMillis;
+  };
+
+  static MaintenanceScheduler& instance();
+
+  /**
+   * Schedules maintenance for [database], or updates the configuration of an
+   * existing schedule.
+   */
+  void schedule(CBLDatabase* database, const Config& config);
+
+  /**
+   * Stops scheduling maintenance for [database].
+   *
+   * Must be called before the database is closed.
+   */
+  void unschedule(CBLDatabase* database);
+
+  /**
+   * Returns the number of writes to [database] since maintenance last ran, or
+   * -1 if the database is not scheduled.
+   */
+  int64_t pendingWrites(CBLDatabase* database);
+
+ private:
+  struct Schedule {
+    explicit Schedule(CBLDatabase* database);
+    ~Schedule();
+
+    CBLDatabase* database;
+    Config config{};
+    std::vector<CBLCollection*> collections;
+    std::vector<CBLListenerToken*> listenerTokens;
+    std::atomic<uint64_t> writes{0};
+    std::atomic<int64_t> lastWriteTime{0};
+  };
+
+  /// A single run of maintenance, which closing the database waits for.
+  class Run : public DatabaseWorker {
+   public:
+    void stopAndWait() override;
+    void finish();
+
+   private:
+    std::mutex mutex_;
+    std::condition_variable finishedCv_;
+    bool finished_ = false;
+  };
+
+  MaintenanceScheduler() = default;
+
+  static void collectionChanged(void* context,
+                                const CBLCollectionChange* change);
+  static void addListeners(Schedule& schedule);
+  static void removeListeners(Schedule& schedule);
+  static void perform(Schedule& schedule, CBLMaintenanceType type);
+
+  void ensureThreadStarted();
+  void run();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool threadStarted_ = false;
+  std::unordered_map<const CBLDatabase*, std::shared_ptr<Schedule>> schedules_;
+};
+
+}  // namespace CBLDart
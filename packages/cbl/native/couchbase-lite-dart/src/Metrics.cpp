@@ -0,0 +1,260 @@
+#include "Metrics.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace CBLDart {
+
+static constexpr size_t kCounterCount = static_cast<size_t>(Counter::kCount);
+static constexpr size_t kHistogramCount =
+    static_cast<size_t>(Histogram::kCount);
+
+static const char* const kCounterNames[kCounterCount] = {
+    "callbacksPosted",
+    "blockingCalls",
+    "slowBlockingCalls",
+    "databaseLocksAcquired",
+    "bytesDecoded",
+    "dictIteratorsAllocated",
+    "arrayIteratorsAllocated",
+    "sliceResultsTransferred",
+    "transferredSliceResultsReleased",
+};
+
+static const char* const kHistogramNames[kHistogramCount] = {
+    "blockingCallWait",
+    "databaseLockWait",
+};
+
+// === MetricValues ===========================================================
+
+/**
+ * Plain values of all metrics, which are used to aggregate the values of
+ * multiple threads.
+ */
+struct MetricValues {
+  struct HistogramValues {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t buckets[Metrics::kBuckets] = {};
+  };
+
+  uint64_t counters[kCounterCount] = {};
+  HistogramValues histograms[kHistogramCount] = {};
+};
+
+// === ThreadMetrics ==========================================================
+
+/**
+ * The metrics of a single thread.
+ *
+ * Only the owning thread writes to the values, so updates don't need atomic
+ * read-modify-write operations. The values are atomic, so that they can be
+ * read from other threads while they are updated. The block is aligned to a
+ * cache line, so that the blocks of different threads never share one.
+ */
+struct alignas(64) ThreadMetrics {
+  struct HistogramValues {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> buckets[Metrics::kBuckets] = {};
+  };
+
+  std::atomic<uint64_t> counters[kCounterCount] = {};
+  HistogramValues histograms[kHistogramCount];
+
+  void addTo(MetricValues& values) const {
+    for (size_t i = 0; i < kCounterCount; i++) {
+      values.counters[i] += counters[i].load(std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < kHistogramCount; i++) {
+      auto& source = histograms[i];
+      auto& target = values.histograms[i];
+      target.count += source.count.load(std::memory_order_relaxed);
+      target.sum += source.sum.load(std::memory_order_relaxed);
+      for (size_t j = 0; j < Metrics::kBuckets; j++) {
+        target.buckets[j] += source.buckets[j].load(std::memory_order_relaxed);
+      }
+    }
+  }
+};
+
+static inline void CBLDart_AddRelaxed(std::atomic<uint64_t>& value,
+                                      uint64_t delta) {
+  value.store(value.load(std::memory_order_relaxed) + delta,
+              std::memory_order_relaxed);
+}
+
+// === MetricsRegistry ========================================================
+
+/**
+ * Keeps track of the metrics of all live threads and the aggregated metrics
+ * of threads which have exited.
+ */
+class MetricsRegistry {
+ public:
+  static MetricsRegistry& instance() {
+    // Never destroyed, because threads can exit after static destructors
+    // have run.
+    static auto registry = new MetricsRegistry;
+    return *registry;
+  }
+
+  void add(ThreadMetrics* metrics) {
+    std::scoped_lock lock(mutex_);
+    threads_.push_back(metrics);
+  }
+
+  void remove(ThreadMetrics* metrics) {
+    std::scoped_lock lock(mutex_);
+    metrics->addTo(exited_);
+    threads_.erase(std::remove(threads_.begin(), threads_.end(), metrics),
+                   threads_.end());
+  }
+
+  MetricValues collect() {
+    std::scoped_lock lock(mutex_);
+    auto values = collectLocked();
+    subtract(values, baseline_);
+    return values;
+  }
+
+  void reset() {
+    std::scoped_lock lock(mutex_);
+    baseline_ = collectLocked();
+  }
+
+ private:
+  MetricValues collectLocked() const {
+    auto values = exited_;
+    for (auto thread : threads_) {
+      thread->addTo(values);
+    }
+    return values;
+  }
+
+  static void subtract(MetricValues& values, const MetricValues& baseline) {
+    for (size_t i = 0; i < kCounterCount; i++) {
+      values.counters[i] -= baseline.counters[i];
+    }
+    for (size_t i = 0; i < kHistogramCount; i++) {
+      auto& target = values.histograms[i];
+      auto& source = baseline.histograms[i];
+      target.count -= source.count;
+      target.sum -= source.sum;
+      for (size_t j = 0; j < Metrics::kBuckets; j++) {
+        target.buckets[j] -= source.buckets[j];
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  std::vector<ThreadMetrics*> threads_;
+  MetricValues exited_;
+  MetricValues baseline_;
+};
+
+/**
+ * Registers the metrics of the current thread while the thread is alive.
+ */
+class ThreadMetricsRegistration {
+ public:
+  ThreadMetricsRegistration() { MetricsRegistry::instance().add(&metrics); }
+
+  ~ThreadMetricsRegistration() {
+    MetricsRegistry::instance().remove(&metrics);
+  }
+
+  ThreadMetrics metrics;
+};
+
+static ThreadMetrics& CBLDart_CurrentThreadMetrics() {
+  thread_local ThreadMetricsRegistration registration;
+  return registration.metrics;
+}
+
+static inline size_t CBLDart_HistogramBucket(uint64_t nanos) {
+  size_t bucket = 0;
+  while (nanos > 1 && bucket < Metrics::kBuckets - 1) {
+    nanos >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+// === Metrics ================================================================
+
+void Metrics::increment(Counter counter, uint64_t value) {
+  auto& metrics = CBLDart_CurrentThreadMetrics();
+  CBLDart_AddRelaxed(metrics.counters[static_cast<size_t>(counter)], value);
+}
+
+void Metrics::record(Histogram histogram, int64_t nanos) {
+  auto duration = static_cast<uint64_t>(std::max<int64_t>(nanos, 0));
+  auto& values =
+      CBLDart_CurrentThreadMetrics().histograms[static_cast<size_t>(histogram)];
+  CBLDart_AddRelaxed(values.count, 1);
+  CBLDart_AddRelaxed(values.sum, duration);
+  CBLDart_AddRelaxed(values.buckets[CBLDart_HistogramBucket(duration)], 1);
+}
+
+FLSliceResult Metrics::snapshot() {
+  auto encoder = FLEncoder_NewWithOptions(kFLEncodeJSON, 0, false);
+  FLEncoder_BeginDict(encoder, 3);
+  FLEncoder_WriteKey(encoder, FLStr("enabled"));
+  FLEncoder_WriteBool(encoder, CBLDART_METRICS != 0);
+
+#if CBLDART_METRICS
+  auto values = MetricsRegistry::instance().collect();
+#else
+  MetricValues values;
+#endif
+
+  FLEncoder_WriteKey(encoder, FLStr("counters"));
+  FLEncoder_BeginDict(encoder, kCounterCount);
+  for (size_t i = 0; i < kCounterCount; i++) {
+    FLEncoder_WriteKey(encoder, FLStr(kCounterNames[i]));
+    FLEncoder_WriteUInt(encoder, values.counters[i]);
+  }
+  FLEncoder_EndDict(encoder);
+
+  FLEncoder_WriteKey(encoder, FLStr("histograms"));
+  FLEncoder_BeginDict(encoder, kHistogramCount);
+  for (size_t i = 0; i < kHistogramCount; i++) {
+    auto& histogram = values.histograms[i];
+    FLEncoder_WriteKey(encoder, FLStr(kHistogramNames[i]));
+    FLEncoder_BeginDict(encoder, 3);
+    FLEncoder_WriteKey(encoder, FLStr("count"));
+    FLEncoder_WriteUInt(encoder, histogram.count);
+    FLEncoder_WriteKey(encoder, FLStr("sum"));
+    FLEncoder_WriteUInt(encoder, histogram.sum);
+    // Trailing empty buckets are omitted.
+    size_t bucketCount = kBuckets;
+    while (bucketCount > 0 && histogram.buckets[bucketCount - 1] == 0) {
+      bucketCount--;
+    }
+    FLEncoder_WriteKey(encoder, FLStr("buckets"));
+    FLEncoder_BeginArray(encoder, bucketCount);
+    for (size_t j = 0; j < bucketCount; j++) {
+      FLEncoder_WriteUInt(encoder, histogram.buckets[j]);
+    }
+    FLEncoder_EndArray(encoder);
+    FLEncoder_EndDict(encoder);
+  }
+  FLEncoder_EndDict(encoder);
+
+  FLEncoder_EndDict(encoder);
+
+  auto result = FLEncoder_Finish(encoder, nullptr);
+  FLEncoder_Free(encoder);
+  return result;
+}
+
+void Metrics::reset() {
+#if CBLDART_METRICS
+  MetricsRegistry::instance().reset();
+#endif
+}
+
+}  // namespace CBLDart
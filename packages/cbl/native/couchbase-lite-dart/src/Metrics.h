@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "CBL+Dart.h"
+#include "Utils.h"
+
+/**
+ * Whether the native metrics are compiled in.
+ *
+ * When this is defined as 0, the `CBLDART_METRICS_*` macros expand to nothing
+ * and the instrumented code paths have no overhead at all.
+ */
+#ifndef CBLDART_METRICS
+#define CBLDART_METRICS 1
+#endif
+
+namespace CBLDart {
+
+// === Metrics ================================================================
+
+enum class Counter : uint8_t {
+  /// Requests which have been posted to Dart by async callbacks.
+  kCallbacksPosted,
+  /// Async callback calls which blocked until Dart returned a result.
+  kBlockingCalls,
+  /// Blocking async callback calls which waited longer than the threshold of
+  /// the `BlockingCallWatchdog`.
+  kSlowBlockingCalls,
+  /// Acquisitions of database level locks.
+  kDatabaseLocksAcquired,
+  /// Bytes of strings and data which have been loaded for decoding in Dart.
+  kBytesDecoded,
+  kDictIteratorsAllocated,
+  kArrayIteratorsAllocated,
+  /// Slice results which have been sent by address to another isolate.
+  kSliceResultsTransferred,
+  /// Transferred slice results which have been released by the receiver.
+  kTransferredSliceResultsReleased,
+  kCount,
+};
+
+enum class Histogram : uint8_t {
+  /// Time a blocking async callback call waited for the result from Dart.
+  kBlockingCallWait,
+  /// Time spent waiting to acquire a database level lock.
+  kDatabaseLockWait,
+  kCount,
+};
+
+/**
+ * Per-thread counters and latency histograms for the hot paths of the shim
+ * layer.
+ *
+ * Every thread records into its own cache line aligned block of values, which
+ * only that thread writes to, so recording a value never contends with other
+ * threads. Snapshots sum up the blocks of all live threads and the values of
+ * threads which have exited.
+ *
+ * Histograms have [kBuckets] buckets with power of two bounds: bucket `i`
+ * counts durations in the range `[2^i, 2^(i+1))` nanoseconds and bucket 0
+ * also counts durations of 0. The last bucket counts all longer durations.
+ *
+ * Use the `CBLDART_METRICS_*` macros to record values, so that recording is
+ * compiled out when `CBLDART_METRICS` is 0.
+ */
+class Metrics {
+ public:
+  static constexpr size_t kBuckets = 40;
+
+  static void increment(Counter counter, uint64_t value = 1);
+  static void record(Histogram histogram, int64_t nanos);
+
+  /**
+   * Returns the values which have been recorded since the last [reset], as
+   * JSON.
+   */
+  static FLSliceResult snapshot();
+
+  /**
+   * Resets all values to 0.
+   *
+   * Threads are not interrupted while they record values. Instead, the
+   * current values are subtracted from subsequent snapshots.
+   */
+  static void reset();
+};
+
+/**
+ * Records the time from its construction to its destruction in a [Histogram].
+ */
+class MetricsTimer {
+ public:
+  explicit MetricsTimer(Histogram histogram)
+      : histogram_(histogram), start_(CBLDart_MonotonicNanos()) {}
+
+  ~MetricsTimer() {
+    Metrics::record(histogram_, CBLDart_MonotonicNanos() - start_);
+  }
+
+  MetricsTimer(const MetricsTimer&) = delete;
+  MetricsTimer& operator=(const MetricsTimer&) = delete;
+
+ private:
+  Histogram histogram_;
+  int64_t start_;
+};
+
+}  // namespace CBLDart
+
+#if CBLDART_METRICS
+#define CBLDART_METRICS_INCREMENT(counter, value) \
+  ::CBLDart::Metrics::increment(::CBLDart::Counter::counter, value)
+#define CBLDART_METRICS_TIMER(histogram)            \
+  ::CBLDart::MetricsTimer metricsTimer_##histogram( \
+      ::CBLDart::Histogram::histogram)
+#else
+#define CBLDART_METRICS_INCREMENT(counter, value) ((void)0)
+#define CBLDART_METRICS_TIMER(histogram) ((void)0)
+#endif
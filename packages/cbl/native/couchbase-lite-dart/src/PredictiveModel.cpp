@@ -0,0 +1,303 @@
+#include "PredictiveModel.h"
+
+#ifdef COUCHBASE_ENTERPRISE
+
+#include <algorithm>
+#include <vector>
+
+#include "Completer.h"
+#include "Utils.h"
+#include "fleece/FLExpert.h"
+
+namespace CBLDart {
+
+// === PredictionCache ========================================================
+
+// Approximate overhead of an entry in the list and the index, in addition to
+// the key and the output.
+static constexpr uint64_t kPredictionCacheEntryOverhead = 128;
+
+PredictionCache::PredictionCache(uint64_t maxSize, uint64_t ttlMillis)
+    : maxSize(maxSize), ttlNanos(ttlMillis * 1000000) {}
+
+PredictionCache::~PredictionCache() { clear(); }
+
+std::string PredictionCache::encodeKey(FLDict input) {
+  auto encoder = FLEncoder_New();
+  FLEncoder_WriteValue(encoder, (FLValue)input);
+  auto data = FLEncoder_Finish(encoder, nullptr);
+  FLEncoder_Free(encoder);
+
+  std::string key(static_cast<const char*>(data.buf), data.size);
+  FLSliceResult_Release(data);
+  return key;
+}
+
+uint64_t PredictionCache::hashKey(const std::string& key) {
+  // 64-bit FNV-1a, which is stable across processes and platforms, unlike
+  // std::hash.
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (unsigned char byte : key) {
+    hash ^= byte;
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+FLMutableDict PredictionCache::lookup(const std::string& key) {
+  FLSliceResult output;
+  {
+    std::scoped_lock lock(mutex);
+
+    auto it = index.find(hashKey(key));
+    if (it == index.end() || it->second->key != key) {
+      misses++;
+      return nullptr;
+    }
+
+    auto entry = it->second;
+    if (ttlNanos > 0 && entry->expiresAt <= now()) {
+      removeEntry(entry);
+      misses++;
+      return nullptr;
+    }
+
+    hits++;
+    entries.splice(entries.begin(), entries, entry);
+    // Keep the output alive while it is copied, even if the entry is evicted
+    // concurrently.
+    output = FLSliceResult_Retain(entry->output);
+  }
+
+  auto dict = FLValue_AsDict(FLValue_FromData(FLSliceResult_AsSlice(output),
+                                              kFLTrusted));
+  // Copy all values, so that the result does not reference the encoded
+  // output.
+  auto copy = FLDict_MutableCopy(dict, kFLDeepCopyImmutables);
+  FLSliceResult_Release(output);
+  return copy;
+}
+
+void PredictionCache::insert(std::string key, FLDict output) {
+  auto encoder = FLEncoder_New();
+  FLEncoder_WriteValue(encoder, (FLValue)output);
+  auto data = FLEncoder_Finish(encoder, nullptr);
+  FLEncoder_Free(encoder);
+  if (!data.buf) {
+    return;
+  }
+
+  auto hash = hashKey(key);
+  auto size = key.size() + data.size + kPredictionCacheEntryOverhead;
+  if (size > maxSize) {
+    FLSliceResult_Release(data);
+    return;
+  }
+
+  std::scoped_lock lock(mutex);
+
+  auto it = index.find(hash);
+  if (it != index.end()) {
+    // Either the same input has been predicted concurrently or the hash
+    // collides with a different input. In both cases the newer entry wins.
+    removeEntry(it->second);
+  }
+
+  auto expiresAt = ttlNanos > 0 ? now() + ttlNanos : 0;
+  entries.push_front({hash, std::move(key), data, size, expiresAt});
+  index[hash] = entries.begin();
+  this->size += size;
+
+  while (this->size > maxSize) {
+    removeEntry(std::prev(entries.end()));
+    evictions++;
+  }
+}
+
+void PredictionCache::clear() {
+  std::scoped_lock lock(mutex);
+  while (!entries.empty()) {
+    removeEntry(entries.begin());
+  }
+}
+
+CBLDart_PredictionCacheStats PredictionCache::stats() {
+  std::scoped_lock lock(mutex);
+  return {hits, misses, evictions, entries.size(), size};
+}
+
+uint64_t PredictionCache::now() {
+  return static_cast<uint64_t>(CBLDart_MonotonicNanos());
+}
+
+void PredictionCache::removeEntry(EntryList::iterator entry) {
+  size -= entry->size;
+  FLSliceResult_Release(entry->output);
+  index.erase(entry->hash);
+  entries.erase(entry);
+}
+
+// === PredictiveModel ========================================================
+
+PredictiveModel::PredictiveModel(
+    FLString name, CBLDart_IsolateId isolateId,
+    CBLDart_PredictiveModel_PredictionSync predictionSync,
+    CBLDart_PredictiveModel_PredictionAsync predictionAsync,
+    CBLDart_PredictiveModel_PredictionBatchAsync predictionBatchAsync,
+    uint32_t maxBatchSize, uint64_t cacheMaxSize, uint64_t cacheTtl,
+    CBLDart_PredictiveModel_Unregistered unregistered)
+    : name(FLSlice_Copy(name)),
+      isolateId(isolateId),
+      predictionSync(predictionSync),
+      predictionAsync(predictionAsync),
+      predictionBatchAsync(predictionBatchAsync),
+      maxBatchSize(std::max<size_t>(maxBatchSize, 1)),
+      unregistered_(unregistered) {
+  if (cacheMaxSize > 0) {
+    cache = std::make_unique<PredictionCache>(cacheMaxSize, cacheTtl);
+  }
+
+  CBLPredictiveModel model{};
+  model.context = this;
+  model.prediction = [](void* context, FLDict input) {
+    return PREDICTIVE_MODEL_FROM_C(context)->prediction(input);
+  };
+  model.unregistered = [](void* context) {
+    PREDICTIVE_MODEL_FROM_C(context)->unregistered();
+  };
+  CBL_RegisterPredictiveModel((FLString)name, model);
+}
+
+PredictiveModel::~PredictiveModel() {
+  bool wasUnregistered = true;
+  {
+    std::scoped_lock lock(unregisteredMutex);
+    wasUnregistered = unregistered_ == nullptr;
+    unregistered_ = nullptr;
+  }
+
+  if (!wasUnregistered) {
+    CBL_UnregisterPredictiveModel((FLString)name);
+  }
+
+  FLSliceResult_Release(name);
+}
+
+bool PredictiveModel::cacheStats(CBLDart_PredictionCacheStats* statsOut) {
+  if (!cache) {
+    return false;
+  }
+  *statsOut = cache->stats();
+  return true;
+}
+
+void PredictiveModel::clearCache() {
+  if (cache) {
+    cache->clear();
+  }
+}
+
+FLMutableDict PredictiveModel::prediction(FLDict input) {
+  if (!cache) {
+    return computePrediction(input);
+  }
+
+  auto key = PredictionCache::encodeKey(input);
+  if (auto output = cache->lookup(key)) {
+    return output;
+  }
+
+  auto output = computePrediction(input);
+  // Missing outputs are not cached, since they are also the result of
+  // exceptions in the model, which might be transient.
+  if (output) {
+    cache->insert(std::move(key), output);
+  }
+  return output;
+}
+
+FLMutableDict PredictiveModel::computePrediction(FLDict input) {
+  if (isolateId == CBLDart_GetCurrentIsolateId()) {
+    // Use the synchronous prediction function since we are on the same
+    // thread as the isolate where the model was registered.
+    return predictionSync(input);
+  }
+
+  if (predictionBatchAsync) {
+    return batchedPrediction(input);
+  }
+
+  // Use the asynchronous prediction function since we are on a different
+  // thread as the isolate where the model was registered.
+  auto completer = CBLDart::Completer();
+  predictionAsync(input, COMPLETER_TO_C(&completer));
+  return (FLMutableDict)completer.wait();
+}
+
+FLMutableDict PredictiveModel::batchedPrediction(FLDict input) {
+  // The pending prediction lives on the stack of this thread, which is blocked
+  // until the prediction is done. That also keeps the input alive until the
+  // batch that contains it has been computed.
+  PendingPrediction pending{input};
+
+  std::unique_lock lock(batchMutex);
+  pendingPredictions.push_back(&pending);
+
+  while (!pending.done) {
+    if (batchInFlight) {
+      batchCompleted.wait(lock);
+    } else {
+      runBatch(lock);
+    }
+  }
+
+  return pending.output;
+}
+
+void PredictiveModel::runBatch(std::unique_lock<std::mutex>& lock) {
+  auto count = std::min(pendingPredictions.size(), maxBatchSize);
+  std::vector<PendingPrediction*> batch(pendingPredictions.begin(),
+                                        pendingPredictions.begin() + count);
+  pendingPredictions.erase(pendingPredictions.begin(),
+                           pendingPredictions.begin() + count);
+  batchInFlight = true;
+  lock.unlock();
+
+  std::vector<FLDict> inputs;
+  inputs.reserve(count);
+  for (auto pending : batch) {
+    inputs.push_back(pending->input);
+  }
+  std::vector<FLMutableDict> outputs(count, nullptr);
+
+  auto completer = CBLDart::Completer();
+  predictionBatchAsync(inputs.data(), outputs.data(),
+                       static_cast<uint32_t>(count),
+                       COMPLETER_TO_C(&completer));
+  completer.wait();
+
+  lock.lock();
+  for (size_t i = 0; i < count; i++) {
+    batch[i]->output = outputs[i];
+    batch[i]->done = true;
+  }
+  batchInFlight = false;
+  batchCompleted.notify_all();
+}
+
+void PredictiveModel::unregistered() {
+  CBLDart_PredictiveModel_Unregistered unregistered;
+  {
+    std::scoped_lock lock(unregisteredMutex);
+    unregistered = unregistered_;
+    unregistered_ = nullptr;
+  }
+
+  if (unregistered) {
+    unregistered();
+  }
+}
+
+}  // namespace CBLDart
+
+#endif
@@ -0,0 +1,158 @@
+#pragma once
+
+#ifdef COUCHBASE_ENTERPRISE
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "CBL+Dart.h"
+
+namespace CBLDart {
+
+// === PredictionCache ========================================================
+
+/**
+ * An LRU cache for the outputs of a predictive model.
+ *
+ * Entries are keyed by the Fleece encoding of the input dictionary. Since the
+ * Fleece encoder sorts the keys of dictionaries, equal inputs have equal
+ * encodings. The outputs are stored Fleece encoded and a new mutable copy is
+ * returned for each hit, so that callers don't share mutable state.
+ */
+class PredictionCache {
+ public:
+  PredictionCache(uint64_t maxSize, uint64_t ttlMillis);
+
+  ~PredictionCache();
+
+  /**
+   * Returns the Fleece encoding of [input], which is used as its key.
+   */
+  static std::string encodeKey(FLDict input);
+
+  /**
+   * Returns a retained copy of the cached output for [key] or `nullptr` if
+   * there is no entry for [key] or it has expired.
+   */
+  FLMutableDict lookup(const std::string& key);
+
+  /**
+   * Caches [output] for [key], evicting the least recently used entries until
+   * the cache fits into its maximum size.
+   */
+  void insert(std::string key, FLDict output);
+
+  void clear();
+
+  CBLDart_PredictionCacheStats stats();
+
+ private:
+  struct Entry {
+    uint64_t hash;
+    std::string key;
+    FLSliceResult output;
+    uint64_t size;
+    uint64_t expiresAt;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  static uint64_t hashKey(const std::string& key);
+  static uint64_t now();
+
+  void removeEntry(EntryList::iterator entry);
+
+  uint64_t maxSize;
+  uint64_t ttlNanos;
+
+  std::mutex mutex;
+  // Most recently used entries are at the front.
+  EntryList entries;
+  std::unordered_map<uint64_t, EntryList::iterator> index;
+  uint64_t size = 0;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+};
+
+// === PredictiveModel ========================================================
+
+/**
+ * A predictive model which is implemented in Dart.
+ *
+ * Predictions which are requested on the thread of the isolate which
+ * registered the model are computed synchronously. Predictions which are
+ * requested from other threads, for example while a query is executed on a
+ * background thread, are computed asynchronously by the isolate, while the
+ * requesting thread waits for the result.
+ *
+ * If the model supports batches, predictions which are requested concurrently
+ * are combined into batches, so that the isolate is called once per batch
+ * instead of once per prediction. A thread which requests a prediction while
+ * no batch is in flight sends all pending predictions as the next batch.
+ * While a batch is in flight, new predictions accumulate in the queue.
+ *
+ * If the model has a cache, predictions which are found in the cache are
+ * returned without calling into the isolate.
+ */
+class PredictiveModel {
+ public:
+  PredictiveModel(FLString name, CBLDart_IsolateId isolateId,
+                  CBLDart_PredictiveModel_PredictionSync predictionSync,
+                  CBLDart_PredictiveModel_PredictionAsync predictionAsync,
+                  CBLDart_PredictiveModel_PredictionBatchAsync
+                      predictionBatchAsync,
+                  uint32_t maxBatchSize, uint64_t cacheMaxSize,
+                  uint64_t cacheTtl,
+                  CBLDart_PredictiveModel_Unregistered unregistered);
+
+  ~PredictiveModel();
+
+  bool cacheStats(CBLDart_PredictionCacheStats* statsOut);
+  void clearCache();
+
+ private:
+  struct PendingPrediction {
+    FLDict input;
+    FLMutableDict output = nullptr;
+    bool done = false;
+  };
+
+  FLMutableDict prediction(FLDict input);
+  FLMutableDict computePrediction(FLDict input);
+  FLMutableDict batchedPrediction(FLDict input);
+  void runBatch(std::unique_lock<std::mutex>& lock);
+  void unregistered();
+
+  FLStringResult name;
+  CBLDart_IsolateId isolateId;
+  CBLDart_PredictiveModel_PredictionSync predictionSync;
+  CBLDart_PredictiveModel_PredictionAsync predictionAsync;
+  CBLDart_PredictiveModel_PredictionBatchAsync predictionBatchAsync;
+  size_t maxBatchSize;
+  CBLDart_PredictiveModel_Unregistered unregistered_;
+  std::mutex unregisteredMutex;
+
+  std::unique_ptr<PredictionCache> cache;
+
+  std::mutex batchMutex;
+  std::condition_variable batchCompleted;
+  std::deque<PendingPrediction*> pendingPredictions;
+  bool batchInFlight = false;
+};
+
+}  // namespace CBLDart
+
+#define PREDICTIVE_MODEL_FROM_C(model) \
+  reinterpret_cast<CBLDart::PredictiveModel*>(model)
+
+#define PREDICTIVE_MODEL_TO_C(model) \
+  reinterpret_cast<CBLDart_PredictiveModel>(model)
+
+#endif
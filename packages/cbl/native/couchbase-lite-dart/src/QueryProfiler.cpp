@@ -0,0 +1,446 @@
+#include "QueryProfiler.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#include "Utils.h"
+
+namespace CBLDart {
+
+static uint64_t CBLDart_CurrentThreadId() {
+  return std::hash<std::thread::id>{}(std::this_thread::get_id());
+}
+
+/**
+ * Returns the approximate number of bytes which are needed to materialize the
+ * given value in Dart.
+ */
+static uint64_t CBLDart_ApproximateValueSize(FLValue value) {
+  switch (FLValue_GetType(value)) {
+    case kFLUndefined:
+      return 0;
+    case kFLNull:
+    case kFLBoolean:
+      return 1;
+    case kFLNumber:
+      return 8;
+    case kFLString:
+      return FLValue_AsString(value).size;
+    case kFLData:
+      return FLValue_AsData(value).size;
+    case kFLArray: {
+      uint64_t size = 0;
+      FLArrayIterator iterator;
+      FLArrayIterator_Begin(FLValue_AsArray(value), &iterator);
+      FLValue element;
+      while ((element = FLArrayIterator_GetValue(&iterator))) {
+        size += CBLDart_ApproximateValueSize(element);
+        FLArrayIterator_Next(&iterator);
+      }
+      return size;
+    }
+    case kFLDict: {
+      uint64_t size = 0;
+      FLDictIterator iterator;
+      FLDictIterator_Begin(FLValue_AsDict(value), &iterator);
+      FLValue element;
+      while ((element = FLDictIterator_GetValue(&iterator))) {
+        size += FLDictIterator_GetKeyString(&iterator).size;
+        size += CBLDart_ApproximateValueSize(element);
+        FLDictIterator_Next(&iterator);
+      }
+      return size;
+    }
+  }
+
+  return 0;
+}
+
+static inline int64_t CBLDart_NanosToMicros(int64_t nanos) {
+  return nanos < 0 ? nanos : nanos / 1000;
+}
+
+static inline void CBLDart_WriteKey(FLEncoder encoder, const char* key) {
+  FLEncoder_WriteKey(encoder, FLStr(key));
+}
+
+static inline void CBLDart_WriteString(FLEncoder encoder,
+                                       const std::string& string) {
+  FLEncoder_WriteString(encoder, {string.data(), string.size()});
+}
+
+// === QueryProfiler ==========================================================
+
+QueryProfiler QueryProfiler::instance;
+
+void QueryProfiler::enable(size_t capacity) {
+  std::scoped_lock lock(mutex_);
+
+  if (!records_ || capacity_ != capacity) {
+    std::atomic_store(
+        &records_, std::make_shared<RingBuffer<QueryProfileRecord>>(capacity));
+    capacity_ = capacity;
+  }
+
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void QueryProfiler::disable() {
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+void QueryProfiler::clear() {
+  std::scoped_lock lock(mutex_);
+  if (records_) {
+    records_->clear();
+  }
+}
+
+std::shared_ptr<RingBuffer<QueryProfileRecord>> QueryProfiler::records() {
+  return std::atomic_load(&records_);
+}
+
+CBLQuery* QueryProfiler::createQuery(const CBLDatabase* db,
+                                     CBLQueryLanguage language,
+                                     FLString queryString, int* errorPosOut,
+                                     CBLError* errorOut) {
+  if (!isEnabled()) {
+    return CBLDatabase_CreateQuery(db, language, queryString, errorPosOut,
+                                   errorOut);
+  }
+
+  auto threadId = CBLDart_CurrentThreadId();
+  auto start = CBLDart_MonotonicNanos();
+  auto query =
+      CBLDatabase_CreateQuery(db, language, queryString, errorPosOut, errorOut);
+  auto end = CBLDart_MonotonicNanos();
+
+  if (!query) {
+    return nullptr;
+  }
+
+  auto planSlice = CBLQuery_Explain(query);
+  auto plan = CBLDart_FLStringToString(FLSliceResult_AsSlice(planSlice));
+  FLSliceResult_Release(planSlice);
+
+  QueryProfileRecord record{};
+  record.kind = QueryProfileRecord::kCompile;
+  {
+    std::scoped_lock lock(mutex_);
+    record.queryId = registerQuery(
+        query, CBLDart_FLStringToString(queryString), std::move(plan));
+  }
+  record.threadId = threadId;
+  record.startTime = start;
+  record.duration = end - start;
+  record.firstRowTime = -1;
+
+  if (auto buffer = records()) {
+    buffer->push(record);
+  }
+
+  return query;
+}
+
+uint64_t QueryProfiler::registerQuery(const CBLQuery* query,
+                                      std::string queryString,
+                                      std::string plan) {
+  auto queryId = nextQueryId_++;
+  queryIds_[query] = queryId;
+  queryInfos_[queryId] = {query, std::move(queryString), std::move(plan)};
+  queryInfoOrder_.push_back(queryId);
+
+  // Only keep information about as many queries as there are records.
+  while (queryInfoOrder_.size() > std::max<size_t>(capacity_, 1)) {
+    auto evictedId = queryInfoOrder_.front();
+    queryInfoOrder_.pop_front();
+
+    auto info = queryInfos_.find(evictedId);
+    if (info != queryInfos_.end()) {
+      auto id = queryIds_.find(info->second.query);
+      if (id != queryIds_.end() && id->second == evictedId) {
+        queryIds_.erase(id);
+      }
+      queryInfos_.erase(info);
+    }
+  }
+
+  return queryId;
+}
+
+CBLResultSet* QueryProfiler::execute(CBLQuery* query, Execution** executionOut,
+                                     CBLError* errorOut) {
+  *executionOut = nullptr;
+
+  if (!isEnabled()) {
+    return CBLQuery_Execute(query, errorOut);
+  }
+
+  auto threadId = CBLDart_CurrentThreadId();
+  auto start = CBLDart_MonotonicNanos();
+  auto resultSet = CBLQuery_Execute(query, errorOut);
+  auto end = CBLDart_MonotonicNanos();
+
+  auto execution = std::make_unique<Execution>();
+  execution->executeEndTime = end;
+  auto& record = execution->record;
+  record.kind = QueryProfileRecord::kExecute;
+  record.threadId = threadId;
+  record.startTime = start;
+  record.duration = end - start;
+  record.firstRowTime = -1;
+
+  std::scoped_lock lock(mutex_);
+
+  auto id = queryIds_.find(query);
+  if (id != queryIds_.end()) {
+    record.queryId = id->second;
+  } else {
+    // The query was created while the profiler was disabled.
+    record.queryId = registerQuery(query, {}, {});
+  }
+
+  if (!resultSet) {
+    commit(*execution, true);
+    return nullptr;
+  }
+
+  *executionOut = execution.get();
+  executions_[resultSet] = std::move(execution);
+  activeExecutions_.fetch_add(1, std::memory_order_relaxed);
+
+  return resultSet;
+}
+
+bool QueryProfiler::next(CBLResultSet* resultSet, Execution* execution) {
+  auto hasRow = CBLResultSet_Next(resultSet);
+
+  if (!execution || execution->committed) {
+    return hasRow;
+  }
+
+  auto now = CBLDart_MonotonicNanos();
+  auto& record = execution->record;
+
+  if (hasRow) {
+    if (record.rows == 0) {
+      record.firstRowTime = now - record.startTime;
+    }
+    record.rows++;
+    record.bytes += CBLDart_ApproximateValueSize(
+        (FLValue)CBLResultSet_ResultArray(resultSet));
+  } else {
+    record.iterationTime = now - execution->executeEndTime;
+    std::scoped_lock lock(mutex_);
+    commit(*execution, true);
+  }
+
+  return hasRow;
+}
+
+void QueryProfiler::release(CBLResultSet* resultSet) {
+  if (activeExecutions_.load(std::memory_order_relaxed) > 0) {
+    auto now = CBLDart_MonotonicNanos();
+
+    std::scoped_lock lock(mutex_);
+
+    auto it = executions_.find(resultSet);
+    if (it != executions_.end()) {
+      auto& execution = *it->second;
+      if (!execution.committed) {
+        execution.record.iterationTime = now - execution.executeEndTime;
+        commit(execution, false);
+      }
+      executions_.erase(it);
+      activeExecutions_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  CBLResultSet_Release(resultSet);
+}
+
+void QueryProfiler::releaseQuery(CBLQuery* query) {
+  {
+    std::scoped_lock lock(mutex_);
+    queryIds_.erase(query);
+  }
+
+  CBLQuery_Release(query);
+}
+
+void QueryProfiler::commit(Execution& execution, bool exhausted) {
+  execution.committed = true;
+  execution.record.exhausted = exhausted;
+  if (records_) {
+    records_->push(execution.record);
+  }
+}
+
+void QueryProfiler::collect(
+    std::vector<QueryProfileRecord>& records,
+    std::unordered_map<uint64_t, QueryInfo>& queryInfos) {
+  std::scoped_lock lock(mutex_);
+
+  if (!records_) {
+    return;
+  }
+
+  records_->snapshot(records);
+
+  for (const auto& record : records) {
+    auto info = queryInfos_.find(record.queryId);
+    if (info != queryInfos_.end()) {
+      queryInfos.emplace(info->first, info->second);
+    }
+  }
+}
+
+FLSliceResult QueryProfiler::snapshot() {
+  std::vector<QueryProfileRecord> records;
+  std::unordered_map<uint64_t, QueryInfo> queryInfos;
+  collect(records, queryInfos);
+
+  auto buffer = this->records();
+
+  auto encoder = FLEncoder_NewWithOptions(kFLEncodeJSON, 0, false);
+  FLEncoder_BeginDict(encoder, 5);
+  CBLDart_WriteKey(encoder, "enabled");
+  FLEncoder_WriteBool(encoder, isEnabled());
+  CBLDart_WriteKey(encoder, "capacity");
+  FLEncoder_WriteUInt(encoder, buffer ? buffer->capacity() : 0);
+  CBLDart_WriteKey(encoder, "recorded");
+  FLEncoder_WriteUInt(encoder, buffer ? buffer->pushed() : 0);
+  CBLDart_WriteKey(encoder, "overwritten");
+  FLEncoder_WriteUInt(encoder, buffer ? buffer->overwritten() : 0);
+
+  CBLDart_WriteKey(encoder, "records");
+  FLEncoder_BeginArray(encoder, records.size());
+  for (const auto& record : records) {
+    FLEncoder_BeginDict(encoder, 0);
+    CBLDart_WriteKey(encoder, "kind");
+    FLEncoder_WriteString(
+        encoder,
+        FLStr(record.kind == QueryProfileRecord::kCompile ? "compile"
+                                                          : "execute"));
+    CBLDart_WriteKey(encoder, "queryId");
+    FLEncoder_WriteUInt(encoder, record.queryId);
+
+    auto info = queryInfos.find(record.queryId);
+    if (info != queryInfos.end() && !info->second.queryString.empty()) {
+      CBLDart_WriteKey(encoder, "query");
+      CBLDart_WriteString(encoder, info->second.queryString);
+      CBLDart_WriteKey(encoder, "plan");
+      CBLDart_WriteString(encoder, info->second.plan);
+    }
+
+    CBLDart_WriteKey(encoder, "threadId");
+    FLEncoder_WriteUInt(encoder, record.threadId);
+    CBLDart_WriteKey(encoder, "startTime");
+    FLEncoder_WriteInt(encoder, CBLDart_NanosToMicros(record.startTime));
+    CBLDart_WriteKey(encoder, "duration");
+    FLEncoder_WriteInt(encoder, CBLDart_NanosToMicros(record.duration));
+
+    if (record.kind == QueryProfileRecord::kExecute) {
+      CBLDart_WriteKey(encoder, "firstRowTime");
+      FLEncoder_WriteInt(encoder, CBLDart_NanosToMicros(record.firstRowTime));
+      CBLDart_WriteKey(encoder, "iterationTime");
+      FLEncoder_WriteInt(encoder, CBLDart_NanosToMicros(record.iterationTime));
+      CBLDart_WriteKey(encoder, "rows");
+      FLEncoder_WriteUInt(encoder, record.rows);
+      CBLDart_WriteKey(encoder, "bytes");
+      FLEncoder_WriteUInt(encoder, record.bytes);
+      CBLDart_WriteKey(encoder, "exhausted");
+      FLEncoder_WriteBool(encoder, record.exhausted);
+    }
+    FLEncoder_EndDict(encoder);
+  }
+  FLEncoder_EndArray(encoder);
+  FLEncoder_EndDict(encoder);
+
+  auto result = FLEncoder_Finish(encoder, nullptr);
+  FLEncoder_Free(encoder);
+  return result;
+}
+
+FLSliceResult QueryProfiler::chromeTrace() {
+  std::vector<QueryProfileRecord> records;
+  std::unordered_map<uint64_t, QueryInfo> queryInfos;
+  collect(records, queryInfos);
+
+  auto encoder = FLEncoder_NewWithOptions(kFLEncodeJSON, 0, false);
+
+  auto beginEvent = [&](const char* name, int64_t start, int64_t duration,
+                        const QueryProfileRecord& record) {
+    FLEncoder_BeginDict(encoder, 0);
+    CBLDart_WriteKey(encoder, "name");
+    FLEncoder_WriteString(encoder, FLStr(name));
+    CBLDart_WriteKey(encoder, "cat");
+    FLEncoder_WriteString(encoder, FLStr("cbl.query"));
+    CBLDart_WriteKey(encoder, "ph");
+    FLEncoder_WriteString(encoder, FLStr("X"));
+    CBLDart_WriteKey(encoder, "ts");
+    FLEncoder_WriteInt(encoder, CBLDart_NanosToMicros(start));
+    CBLDart_WriteKey(encoder, "dur");
+    FLEncoder_WriteInt(encoder, CBLDart_NanosToMicros(duration));
+    CBLDart_WriteKey(encoder, "pid");
+    FLEncoder_WriteInt(encoder, 0);
+    CBLDart_WriteKey(encoder, "tid");
+    FLEncoder_WriteUInt(encoder, record.threadId);
+
+    CBLDart_WriteKey(encoder, "args");
+    FLEncoder_BeginDict(encoder, 0);
+    CBLDart_WriteKey(encoder, "queryId");
+    FLEncoder_WriteUInt(encoder, record.queryId);
+    auto info = queryInfos.find(record.queryId);
+    if (info != queryInfos.end() && !info->second.queryString.empty()) {
+      CBLDart_WriteKey(encoder, "query");
+      CBLDart_WriteString(encoder, info->second.queryString);
+    }
+  };
+
+  auto endEvent = [&]() {
+    FLEncoder_EndDict(encoder);  // args
+    FLEncoder_EndDict(encoder);
+  };
+
+  FLEncoder_BeginDict(encoder, 2);
+  CBLDart_WriteKey(encoder, "traceEvents");
+  FLEncoder_BeginArray(encoder, records.size());
+  for (const auto& record : records) {
+    if (record.kind == QueryProfileRecord::kCompile) {
+      beginEvent("Query.compile", record.startTime, record.duration, record);
+      auto info = queryInfos.find(record.queryId);
+      if (info != queryInfos.end() && !info->second.plan.empty()) {
+        CBLDart_WriteKey(encoder, "plan");
+        CBLDart_WriteString(encoder, info->second.plan);
+      }
+      endEvent();
+    } else {
+      beginEvent("Query.execute", record.startTime, record.duration, record);
+      endEvent();
+
+      beginEvent("Query.iterate", record.startTime + record.duration,
+                 record.iterationTime, record);
+      CBLDart_WriteKey(encoder, "rows");
+      FLEncoder_WriteUInt(encoder, record.rows);
+      CBLDart_WriteKey(encoder, "bytes");
+      FLEncoder_WriteUInt(encoder, record.bytes);
+      CBLDart_WriteKey(encoder, "firstRowTime");
+      FLEncoder_WriteInt(encoder, CBLDart_NanosToMicros(record.firstRowTime));
+      CBLDart_WriteKey(encoder, "exhausted");
+      FLEncoder_WriteBool(encoder, record.exhausted);
+      endEvent();
+    }
+  }
+  FLEncoder_EndArray(encoder);
+  CBLDart_WriteKey(encoder, "displayTimeUnit");
+  FLEncoder_WriteString(encoder, FLStr("ms"));
+  FLEncoder_EndDict(encoder);
+
+  auto result = FLEncoder_Finish(encoder, nullptr);
+  FLEncoder_Free(encoder);
+  return result;
+}
+
+}  // namespace CBLDart
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CBL+Dart.h"
+#include "RingBuffer.h"
+
+namespace CBLDart {
+
+// === QueryProfileRecord =====================================================
+
+struct QueryProfileRecord {
+  enum Kind : uint8_t {
+    kCompile,
+    kExecute,
+  };
+
+  Kind kind;
+  /// Whether all rows of the result set have been read.
+  bool exhausted;
+  uint64_t queryId;
+  uint64_t threadId;
+  /// Start of the operation in nanoseconds on the monotonic clock.
+  int64_t startTime;
+  /// Duration of CBLDatabase_CreateQuery or CBLQuery_Execute.
+  int64_t duration;
+  /// Time from the start of the execution to the first row, or -1 if the
+  /// result set had no rows.
+  int64_t firstRowTime;
+  /// Time spent iterating over the result set, after the execution.
+  int64_t iterationTime;
+  uint64_t rows;
+  /// Approximate number of bytes of the values of all rows which were read.
+  uint64_t bytes;
+};
+
+// === QueryProfiler ==========================================================
+
+/**
+ * Records how long it takes to compile and execute queries and how many rows
+ * and bytes are read from their result sets.
+ *
+ * Records are stored in a lock-free ring buffer, so that the most recent
+ * records can be exported at any time, either as a JSON snapshot or in the
+ * Chrome trace event format.
+ *
+ * When the profiler is disabled, the overhead of the query wrappers is a
+ * single atomic load.
+ *
+ * Each profiled execution is tracked by an [Execution], which is returned
+ * together with the result set and passed to [next] by the caller. Rows are
+ * counted without synchronization, since a result set is only read by one
+ * thread at a time. The profiler's lock is only acquired when an execution is
+ * started, committed or released.
+ */
+class QueryProfiler {
+ public:
+  struct Execution {
+    QueryProfileRecord record;
+    int64_t executeEndTime;
+    /// Whether the record has been committed, because all rows have been read.
+    bool committed;
+  };
+
+  static QueryProfiler instance;
+
+  void enable(size_t capacity);
+  void disable();
+  bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+  void clear();
+
+  CBLQuery* createQuery(const CBLDatabase* db, CBLQueryLanguage language,
+                        FLString queryString, int* errorPosOut,
+                        CBLError* errorOut);
+  /**
+   * Executes [query] and returns the execution which tracks the result set in
+   * [executionOut], or `nullptr` if the profiler is disabled.
+   */
+  CBLResultSet* execute(CBLQuery* query, Execution** executionOut,
+                        CBLError* errorOut);
+  /**
+   * Moves [resultSet] to the next row and records it in [execution], if it is
+   * not `nullptr`.
+   */
+  bool next(CBLResultSet* resultSet, Execution* execution);
+  void release(CBLResultSet* resultSet);
+  /**
+   * Forgets the id of [query], which is about to be released, so that it is
+   * not assigned to another query which is allocated at the same address.
+   */
+  void releaseQuery(CBLQuery* query);
+
+  FLSliceResult snapshot();
+  FLSliceResult chromeTrace();
+
+ private:
+  struct QueryInfo {
+    const CBLQuery* query;
+    std::string queryString;
+    std::string plan;
+  };
+
+  QueryProfiler() = default;
+
+  std::shared_ptr<RingBuffer<QueryProfileRecord>> records();
+  /// Must be called while holding [mutex_].
+  uint64_t registerQuery(const CBLQuery* query, std::string queryString,
+                         std::string plan);
+  /// Must be called while holding [mutex_].
+  void commit(Execution& execution, bool exhausted);
+  void collect(std::vector<QueryProfileRecord>& records,
+               std::unordered_map<uint64_t, QueryInfo>& queryInfos);
+
+  std::atomic<bool> enabled_{false};
+  size_t capacity_ = 0;
+  std::shared_ptr<RingBuffer<QueryProfileRecord>> records_;
+  std::atomic<size_t> activeExecutions_{0};
+
+  std::mutex mutex_;
+  uint64_t nextQueryId_ = 1;
+  std::unordered_map<const CBLQuery*, uint64_t> queryIds_;
+  std::unordered_map<uint64_t, QueryInfo> queryInfos_;
+  std::deque<uint64_t> queryInfoOrder_;
+  std::unordered_map<const CBLResultSet*, std::unique_ptr<Execution>>
+      executions_;
+};
+
+}  // namespace CBLDart
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace CBLDart {
+
+// === RingBuffer =============================================================
+
+/**
+ * A fixed capacity, lock-free buffer which records the most recent values
+ * pushed into it.
+ *
+ * Any number of threads can push values concurrently. When the buffer is full,
+ * the oldest values are overwritten. Readers take a consistent snapshot of the
+ * values which are currently in the buffer, without blocking writers. Each slot
+ * is guarded by a sequence number (a seqlock), which allows readers to skip
+ * slots that are being written while they are being read.
+ */
+template <typename T>
+class RingBuffer {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "RingBuffer values must be trivially copyable");
+
+ public:
+  explicit RingBuffer(size_t capacity) : slots_(capacity > 0 ? capacity : 1) {}
+
+  size_t capacity() const { return slots_.size(); }
+
+  /**
+   * The total number of values which have been pushed into this buffer.
+   */
+  uint64_t pushed() const { return head_.load(std::memory_order_acquire); }
+
+  /**
+   * Whether no values have been pushed since the buffer was last cleared.
+   */
+  bool empty() const {
+    return pushed() == tail_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * The number of values which have been overwritten before they could be
+   * read by a snapshot.
+   */
+  uint64_t overwritten() const {
+    auto head = pushed();
+    auto tail = tail_.load(std::memory_order_acquire);
+    auto size = head - tail;
+    return size > capacity() ? size - capacity() : 0;
+  }
+
+  void push(const T& value) {
+    auto index = head_.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = slots_[index % slots_.size()];
+
+    // An odd sequence number marks the slot as being written.
+    slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.value = value;
+    slot.sequence.store(index * 2 + 2, std::memory_order_release);
+  }
+
+  /**
+   * Copies the values which are currently in the buffer, from oldest to
+   * newest, into [out].
+   */
+  void snapshot(std::vector<T>& out) const {
+    auto head = head_.load(std::memory_order_acquire);
+    auto tail = tail_.load(std::memory_order_acquire);
+    auto begin = head - tail > capacity() ? head - capacity() : tail;
+
+    out.reserve(out.size() + static_cast<size_t>(head - begin));
+
+    for (auto index = begin; index < head; index++) {
+      auto& slot = slots_[index % slots_.size()];
+      auto expectedSequence = index * 2 + 2;
+
+      if (slot.sequence.load(std::memory_order_acquire) != expectedSequence) {
+        // The slot is being written or has already been overwritten.
+        continue;
+      }
+
+      T value = slot.value;
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      if (slot.sequence.load(std::memory_order_relaxed) != expectedSequence) {
+        // The slot was overwritten while we were reading it.
+        continue;
+      }
+
+      out.push_back(value);
+    }
+  }
+
+  /**
+   * Discards all values which are currently in the buffer.
+   */
+  void clear() {
+    tail_.store(head_.load(std::memory_order_acquire),
+                std::memory_order_release);
+  }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    T value{};
+  };
+
+  std::vector<Slot> slots_;
+  std::atomic<uint64_t> head_{0};
+  std::atomic<uint64_t> tail_{0};
+};
+
+}  // namespace CBLDart
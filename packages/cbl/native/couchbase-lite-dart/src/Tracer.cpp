@@ -0,0 +1,301 @@
+#include "Tracer.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RingBuffer.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+namespace CBLDart {
+
+/**
+ * Returns the id the OS uses for the current thread, which is also the id the
+ * Dart VM uses for threads in its timeline.
+ */
+static uint64_t CBLDart_OsThreadId() {
+#if defined(_WIN32)
+  return GetCurrentThreadId();
+#elif defined(__APPLE__)
+  uint64_t id = 0;
+  pthread_threadid_np(nullptr, &id);
+  return id;
+#elif defined(__linux__)
+  return static_cast<uint64_t>(syscall(SYS_gettid));
+#else
+  return std::hash<std::thread::id>{}(std::this_thread::get_id());
+#endif
+}
+
+static int64_t CBLDart_ProcessId() {
+#ifdef _WIN32
+  return GetCurrentProcessId();
+#else
+  return getpid();
+#endif
+}
+
+static inline int64_t CBLDart_NanosToMicros(int64_t nanos) {
+  return nanos / 1000;
+}
+
+// === TraceRegistry ==========================================================
+
+/**
+ * Keeps track of the event buffers of all threads which have recorded events.
+ *
+ * Buffers are shared with the threads that record into them, so that the
+ * events of threads which have exited are still available. The buffer of an
+ * exited thread is dropped once its events have been dumped or cleared, and
+ * only the buffers of the most recently exited threads are kept, since many
+ * short-lived threads are spawned for blob streams and other workers.
+ */
+class TraceRegistry {
+ public:
+  struct ThreadBuffer {
+    uint64_t generation;
+    uint64_t threadId;
+    RingBuffer<TraceEvent> events;
+    /// Whether the thread has exited. Guarded by the registry's mutex.
+    bool exited = false;
+
+    ThreadBuffer(uint64_t generation, uint64_t threadId, size_t capacity)
+        : generation(generation), threadId(threadId), events(capacity) {}
+  };
+
+  /// The maximum number of buffers of exited threads which are kept.
+  static constexpr size_t kMaxExitedThreadBuffers = 32;
+
+  static TraceRegistry& instance() {
+    // Never destroyed, because threads can exit after static destructors
+    // have run.
+    static auto registry = new TraceRegistry;
+    return *registry;
+  }
+
+  void setCapacity(size_t capacity) {
+    std::scoped_lock lock(mutex_);
+    if (capacity_ != capacity) {
+      // Threads replace their buffers with buffers of the new capacity, the
+      // next time they record an event.
+      capacity_ = capacity;
+      buffers_.clear();
+      generation_.fetch_add(1, std::memory_order_release);
+    }
+  }
+
+  void clear() {
+    std::scoped_lock lock(mutex_);
+    for (auto& buffer : buffers_) {
+      buffer->events.clear();
+    }
+    removeBuffers([](auto& buffer) { return buffer->exited; });
+  }
+
+  void record(const TraceEvent& event) {
+    thread_local ThreadBufferHolder holder;
+    auto& buffer = holder.buffer;
+
+    auto generation = generation_.load(std::memory_order_acquire);
+    if (!buffer || buffer->generation != generation) {
+      buffer = createThreadBuffer(generation);
+      if (!buffer) {
+        return;
+      }
+    }
+
+    buffer->events.push(event);
+  }
+
+  /**
+   * Returns the buffers of all threads and which of them belong to threads
+   * that have already exited. Those don't receive events anymore and are
+   * dropped with [dropDumpedBuffers], after they have been dumped.
+   */
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers(
+      std::vector<std::shared_ptr<ThreadBuffer>>& exited) {
+    std::scoped_lock lock(mutex_);
+    for (auto& buffer : buffers_) {
+      if (buffer->exited) {
+        exited.push_back(buffer);
+      }
+    }
+    return buffers_;
+  }
+
+  void dropDumpedBuffers(
+      const std::vector<std::shared_ptr<ThreadBuffer>>& exited) {
+    std::scoped_lock lock(mutex_);
+    removeBuffers([&](auto& buffer) {
+      return std::find(exited.begin(), exited.end(), buffer) != exited.end();
+    });
+  }
+
+ private:
+  /**
+   * Owns the buffer of a thread and tells the registry when the thread exits.
+   */
+  struct ThreadBufferHolder {
+    std::shared_ptr<ThreadBuffer> buffer;
+
+    ~ThreadBufferHolder() {
+      if (buffer) {
+        instance().threadExited(buffer);
+      }
+    }
+  };
+
+  void threadExited(const std::shared_ptr<ThreadBuffer>& buffer) {
+    std::scoped_lock lock(mutex_);
+    buffer->exited = true;
+    if (buffer->events.empty()) {
+      removeBuffers([&](auto& other) { return other == buffer; });
+      return;
+    }
+
+    // Buffers are ordered by creation, so the oldest buffers of exited threads
+    // are dropped first.
+    size_t exitedCount = std::count_if(
+        buffers_.begin(), buffers_.end(),
+        [](auto& buffer) { return buffer->exited; });
+    removeBuffers([&](auto& buffer) {
+      if (exitedCount > kMaxExitedThreadBuffers && buffer->exited) {
+        exitedCount--;
+        return true;
+      }
+      return false;
+    });
+  }
+
+  template <typename Predicate>
+  void removeBuffers(Predicate predicate) {
+    buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(), predicate),
+                   buffers_.end());
+  }
+
+  std::shared_ptr<ThreadBuffer> createThreadBuffer(uint64_t generation) {
+    std::scoped_lock lock(mutex_);
+    if (generation != generation_.load(std::memory_order_relaxed)) {
+      // The capacity has changed since the event was recorded.
+      return nullptr;
+    }
+
+    auto buffer = std::make_shared<ThreadBuffer>(
+        generation, CBLDart_OsThreadId(), capacity_);
+    buffers_.push_back(buffer);
+    return buffer;
+  }
+
+  std::mutex mutex_;
+  /// Incremented every time the capacity changes.
+  std::atomic<uint64_t> generation_{0};
+  size_t capacity_ = 0;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+// === Tracer =================================================================
+
+void Tracer::enable(size_t capacityPerThread) {
+  TraceRegistry::instance().setCapacity(capacityPerThread);
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::disable() { enabled_.store(false, std::memory_order_relaxed); }
+
+void Tracer::clear() { TraceRegistry::instance().clear(); }
+
+void Tracer::record(const TraceEvent& event) {
+  TraceRegistry::instance().record(event);
+}
+
+FLSliceResult Tracer::dump() {
+  auto& registry = TraceRegistry::instance();
+  std::vector<std::shared_ptr<TraceRegistry::ThreadBuffer>> exited;
+  auto buffers = registry.buffers(exited);
+
+  auto pid = CBLDart_ProcessId();
+  auto encoder = FLEncoder_NewWithOptions(kFLEncodeJSON, 0, false);
+
+  FLEncoder_BeginDict(encoder, 2);
+  FLEncoder_WriteKey(encoder, FLStr("traceEvents"));
+  FLEncoder_BeginArray(encoder, 0);
+
+  std::vector<TraceEvent> events;
+  for (auto& buffer : buffers) {
+    events.clear();
+    buffer->events.snapshot(events);
+    if (events.empty()) {
+      continue;
+    }
+
+    FLEncoder_BeginDict(encoder, 5);
+    FLEncoder_WriteKey(encoder, FLStr("name"));
+    FLEncoder_WriteString(encoder, FLStr("thread_name"));
+    FLEncoder_WriteKey(encoder, FLStr("ph"));
+    FLEncoder_WriteString(encoder, FLStr("M"));
+    FLEncoder_WriteKey(encoder, FLStr("pid"));
+    FLEncoder_WriteInt(encoder, pid);
+    FLEncoder_WriteKey(encoder, FLStr("tid"));
+    FLEncoder_WriteUInt(encoder, buffer->threadId);
+    FLEncoder_WriteKey(encoder, FLStr("args"));
+    FLEncoder_BeginDict(encoder, 1);
+    FLEncoder_WriteKey(encoder, FLStr("name"));
+    auto threadName = "cblitedart " + std::to_string(buffer->threadId);
+    FLEncoder_WriteString(encoder, {threadName.data(), threadName.size()});
+    FLEncoder_EndDict(encoder);
+    FLEncoder_EndDict(encoder);
+
+    for (auto& event : events) {
+      FLEncoder_BeginDict(encoder, 0);
+      FLEncoder_WriteKey(encoder, FLStr("name"));
+      FLEncoder_WriteString(encoder, FLStr(event.name));
+      FLEncoder_WriteKey(encoder, FLStr("cat"));
+      FLEncoder_WriteString(encoder, FLStr(event.category));
+      FLEncoder_WriteKey(encoder, FLStr("ph"));
+      FLEncoder_WriteString(encoder, FLStr("X"));
+      FLEncoder_WriteKey(encoder, FLStr("ts"));
+      FLEncoder_WriteInt(encoder, CBLDart_NanosToMicros(event.startTime));
+      FLEncoder_WriteKey(encoder, FLStr("dur"));
+      FLEncoder_WriteInt(encoder, CBLDart_NanosToMicros(event.duration));
+      FLEncoder_WriteKey(encoder, FLStr("pid"));
+      FLEncoder_WriteInt(encoder, pid);
+      FLEncoder_WriteKey(encoder, FLStr("tid"));
+      FLEncoder_WriteUInt(encoder, buffer->threadId);
+      if (event.argName) {
+        FLEncoder_WriteKey(encoder, FLStr("args"));
+        FLEncoder_BeginDict(encoder, 1);
+        FLEncoder_WriteKey(encoder, FLStr(event.argName));
+        FLEncoder_WriteInt(encoder, event.arg);
+        FLEncoder_EndDict(encoder);
+      }
+      FLEncoder_EndDict(encoder);
+    }
+  }
+
+  FLEncoder_EndArray(encoder);
+  FLEncoder_WriteKey(encoder, FLStr("displayTimeUnit"));
+  FLEncoder_WriteString(encoder, FLStr("ms"));
+  FLEncoder_EndDict(encoder);
+
+  auto result = FLEncoder_Finish(encoder, nullptr);
+  FLEncoder_Free(encoder);
+
+  registry.dropDumpedBuffers(exited);
+  return result;
+}
+
+}  // namespace CBLDart
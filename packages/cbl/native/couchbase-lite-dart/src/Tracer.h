@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "CBL+Dart.h"
+#include "Utils.h"
+
+namespace CBLDart {
+
+// === TraceEvent =============================================================
+
+struct TraceEvent {
+  /// The name of the event. Must be a string literal.
+  const char* name;
+  /// The category of the event. Must be a string literal.
+  const char* category;
+  /// The name of [arg], or `nullptr` if the event has no argument. Must be a
+  /// string literal.
+  const char* argName;
+  int64_t arg;
+  /// Start of the event in nanoseconds on the monotonic clock.
+  int64_t startTime;
+  int64_t duration;
+};
+
+// === Tracer =================================================================
+
+/**
+ * Records trace events of the native code paths, which are interesting when
+ * looking at where time goes across the FFI boundary: listener dispatch,
+ * blocking callbacks, query compilation and execution and blob I/O.
+ *
+ * Every thread records into its own ring buffer, which keeps the most recent
+ * events of that thread. Timestamps are taken from the monotonic clock that is
+ * also used by `dart:developer`'s `Timeline` and threads are identified by
+ * their OS thread id, so the exported trace can be merged with a trace of the
+ * Dart VM.
+ *
+ * When the tracer is disabled, the overhead of a trace point is a single
+ * atomic load.
+ */
+class Tracer {
+ public:
+  static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * Enables recording of trace events, keeping the last [capacityPerThread]
+   * events of each thread.
+   *
+   * If the capacity changes, previously recorded events are discarded.
+   */
+  static void enable(size_t capacityPerThread);
+  static void disable();
+
+  /**
+   * Discards all recorded events.
+   */
+  static void clear();
+
+  static void record(const TraceEvent& event);
+
+  /**
+   * Returns the recorded events in the Chrome trace event JSON format, which
+   * is understood by Perfetto and `chrome://tracing`.
+   */
+  static FLSliceResult dump();
+
+ private:
+  static inline std::atomic<bool> enabled_{false};
+};
+
+/**
+ * Records the time from its construction to its destruction as a trace event,
+ * if the [Tracer] is enabled at construction.
+ */
+class TraceScope {
+ public:
+  TraceScope(const char* category, const char* name,
+             const char* argName = nullptr, int64_t arg = 0)
+      : enabled_(Tracer::isEnabled()) {
+    if (enabled_) {
+      event_ = {name, category, argName, arg, CBLDart_MonotonicNanos(), 0};
+    }
+  }
+
+  ~TraceScope() {
+    if (enabled_) {
+      event_.duration = CBLDart_MonotonicNanos() - event_.startTime;
+      Tracer::record(event_);
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  bool enabled_;
+  TraceEvent event_;
+};
+
+}  // namespace CBLDart
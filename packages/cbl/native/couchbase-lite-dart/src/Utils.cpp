@@ -1,5 +1,7 @@
 #include "Utils.h"
 
+#include <chrono>
+
 // === Dart Native ============================================================
 
 int64_t CBLDart_CObject_getIntValueAsInt64(Dart_CObject* object) {
@@ -40,3 +42,11 @@ void CBLDart_CObject_SetFLString(Dart_CObject* object, const FLString string) {
 std::string CBLDart_FLStringToString(FLString slice) {
   return std::string((char*)slice.buf, slice.size);
 }
+
+// === Time ===================================================================
+
+int64_t CBLDart_MonotonicNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
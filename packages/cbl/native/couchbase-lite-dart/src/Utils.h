@@ -33,3 +33,13 @@ void CBLDart_CObject_SetFLString(Dart_CObject* object, const FLString string);
 // === Fleece =================================================================
 
 std::string CBLDart_FLStringToString(FLString slice);
+
+// === Time ===================================================================
+
+/**
+ * Returns the current time of the monotonic clock in nanoseconds.
+ *
+ * On the platforms supported by Dart, this is the same clock that is used by
+ * `dart:developer`'s `Timeline`.
+ */
+int64_t CBLDart_MonotonicNanos();
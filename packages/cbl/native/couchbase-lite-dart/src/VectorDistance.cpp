@@ -0,0 +1,710 @@
+#include "VectorDistance.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "CpuSupport.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CBLDART_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define CBLDART_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Allows AVX2 functions to be compiled without enabling AVX2 for the whole
+// library. MSVC does not require this to use the intrinsics.
+#if defined(CBLDART_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CBLDART_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#else
+#define CBLDART_TARGET_AVX2
+#endif
+
+namespace CBLDart {
+
+namespace {
+
+// === Kernels ================================================================
+
+/// Computes the dot product of two vectors and their squared norms.
+using DotKernel = void (*)(const void* a, const void* b, size_t n, float* dot,
+                           float* normA, float* normB);
+
+/// Computes the squared Euclidean distance of two vectors.
+using SquaredDistanceKernel = float (*)(const void* a, const void* b,
+                                        size_t n);
+
+/// Computes the number of differing bits of two byte arrays.
+using HammingKernel = float (*)(const void* a, const void* b, size_t bytes);
+
+constexpr size_t kElementTypeCount = 3;
+
+struct Kernels {
+  CBLDart_SimdLevel level;
+  DotKernel dot[kElementTypeCount];
+  SquaredDistanceKernel squaredDistance[kElementTypeCount];
+  HammingKernel hamming;
+};
+
+// Integer accumulators of the SIMD int8 kernels are flushed after this many
+// elements, so that they cannot overflow.
+constexpr size_t kInt8BlockSize = 4096;
+
+size_t elementSize(CBLDart_VectorElementType elementType) {
+  switch (elementType) {
+    case kCBLDart_VectorElementFloat16:
+      return 2;
+    case kCBLDart_VectorElementInt8:
+      return 1;
+    default:
+      return 4;
+  }
+}
+
+float halfToFloat(uint16_t half) {
+  uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+  uint32_t exponent = (half >> 10) & 0x1f;
+  uint32_t mantissa = half & 0x3ff;
+  uint32_t bits;
+
+  if (exponent == 0) {
+    if (mantissa == 0) {
+      bits = sign;
+    } else {
+      // Normalize the subnormal number.
+      exponent = 127 - 15 + 1;
+      while ((mantissa & 0x400) == 0) {
+        mantissa <<= 1;
+        exponent--;
+      }
+      bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+    }
+  } else if (exponent == 0x1f) {
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  } else {
+    bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+  }
+
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+/// Converts an element to the type in which it is accumulated.
+inline float widen(float value) { return value; }
+inline float widen(uint16_t value) { return halfToFloat(value); }
+inline int64_t widen(int8_t value) { return value; }
+
+// === Scalar
+
+template <typename T>
+void dotScalar(const void* a_, const void* b_, size_t n, float* dot,
+               float* normA, float* normB) {
+  // int8 vectors are accumulated exactly.
+  using Acc = std::conditional_t<std::is_same_v<T, int8_t>, int64_t, float>;
+
+  auto a = static_cast<const T*>(a_);
+  auto b = static_cast<const T*>(b_);
+  Acc d = 0, na = 0, nb = 0;
+  for (size_t i = 0; i < n; i++) {
+    Acc x = widen(a[i]);
+    Acc y = widen(b[i]);
+    d += x * y;
+    na += x * x;
+    nb += y * y;
+  }
+  *dot = static_cast<float>(d);
+  *normA = static_cast<float>(na);
+  *normB = static_cast<float>(nb);
+}
+
+template <typename T>
+float squaredDistanceScalar(const void* a_, const void* b_, size_t n) {
+  using Acc = std::conditional_t<std::is_same_v<T, int8_t>, int64_t, float>;
+
+  auto a = static_cast<const T*>(a_);
+  auto b = static_cast<const T*>(b_);
+  Acc sum = 0;
+  for (size_t i = 0; i < n; i++) {
+    Acc diff = widen(a[i]) - widen(b[i]);
+    sum += diff * diff;
+  }
+  return static_cast<float>(sum);
+}
+
+float hammingScalar(const void* a_, const void* b_, size_t bytes) {
+  auto a = static_cast<const uint8_t*>(a_);
+  auto b = static_cast<const uint8_t*>(b_);
+  uint64_t count = 0;
+  size_t i = 0;
+  for (; i + 8 <= bytes; i += 8) {
+    uint64_t x, y;
+    std::memcpy(&x, a + i, 8);
+    std::memcpy(&y, b + i, 8);
+    count += std::bitset<64>(x ^ y).count();
+  }
+  for (; i < bytes; i++) {
+    count += std::bitset<8>(a[i] ^ b[i]).count();
+  }
+  return static_cast<float>(count);
+}
+
+const Kernels scalarKernels = {
+    kCBLDart_SimdScalar,
+    {dotScalar<float>, dotScalar<uint16_t>, dotScalar<int8_t>},
+    {squaredDistanceScalar<float>, squaredDistanceScalar<uint16_t>,
+     squaredDistanceScalar<int8_t>},
+    hammingScalar,
+};
+
+#ifdef CBLDART_SIMD_X86
+
+// === SSE
+
+inline float sum128(__m128 v) {
+  __m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+  __m128 sums = _mm_add_ps(v, shuffled);
+  shuffled = _mm_movehl_ps(shuffled, sums);
+  return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+}
+
+inline int64_t sum128i(__m128i v) {
+  alignas(16) int32_t lanes[4];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+  return static_cast<int64_t>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+}
+
+/// Sign extends the low and high 8 bytes of [v] to 16 bit integers.
+inline void widen128(__m128i v, __m128i* low, __m128i* high) {
+  *low = _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+  *high = _mm_srai_epi16(_mm_unpackhi_epi8(v, v), 8);
+}
+
+void dotF32SSE(const void* a_, const void* b_, size_t n, float* dot,
+               float* normA, float* normB) {
+  auto a = static_cast<const float*>(a_);
+  auto b = static_cast<const float*>(b_);
+  __m128 d = _mm_setzero_ps(), na = _mm_setzero_ps(), nb = _mm_setzero_ps();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 x = _mm_loadu_ps(a + i);
+    __m128 y = _mm_loadu_ps(b + i);
+    d = _mm_add_ps(d, _mm_mul_ps(x, y));
+    na = _mm_add_ps(na, _mm_mul_ps(x, x));
+    nb = _mm_add_ps(nb, _mm_mul_ps(y, y));
+  }
+  dotScalar<float>(a + i, b + i, n - i, dot, normA, normB);
+  *dot += sum128(d);
+  *normA += sum128(na);
+  *normB += sum128(nb);
+}
+
+float squaredDistanceF32SSE(const void* a_, const void* b_, size_t n) {
+  auto a = static_cast<const float*>(a_);
+  auto b = static_cast<const float*>(b_);
+  __m128 sum = _mm_setzero_ps();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 diff = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+    sum = _mm_add_ps(sum, _mm_mul_ps(diff, diff));
+  }
+  return sum128(sum) + squaredDistanceScalar<float>(a + i, b + i, n - i);
+}
+
+void dotI8SSE(const void* a_, const void* b_, size_t n, float* dot,
+              float* normA, float* normB) {
+  auto a = static_cast<const int8_t*>(a_);
+  auto b = static_cast<const int8_t*>(b_);
+  int64_t d = 0, na = 0, nb = 0;
+  size_t i = 0;
+  while (i + 16 <= n) {
+    __m128i blockD = _mm_setzero_si128();
+    __m128i blockNa = _mm_setzero_si128();
+    __m128i blockNb = _mm_setzero_si128();
+    size_t blockEnd = std::min(n, i + kInt8BlockSize);
+    for (; i + 16 <= blockEnd; i += 16) {
+      __m128i xLow, xHigh, yLow, yHigh;
+      widen128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+               &xLow, &xHigh);
+      widen128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)),
+               &yLow, &yHigh);
+      blockD = _mm_add_epi32(blockD, _mm_madd_epi16(xLow, yLow));
+      blockD = _mm_add_epi32(blockD, _mm_madd_epi16(xHigh, yHigh));
+      blockNa = _mm_add_epi32(blockNa, _mm_madd_epi16(xLow, xLow));
+      blockNa = _mm_add_epi32(blockNa, _mm_madd_epi16(xHigh, xHigh));
+      blockNb = _mm_add_epi32(blockNb, _mm_madd_epi16(yLow, yLow));
+      blockNb = _mm_add_epi32(blockNb, _mm_madd_epi16(yHigh, yHigh));
+    }
+    d += sum128i(blockD);
+    na += sum128i(blockNa);
+    nb += sum128i(blockNb);
+  }
+  dotScalar<int8_t>(a + i, b + i, n - i, dot, normA, normB);
+  *dot += static_cast<float>(d);
+  *normA += static_cast<float>(na);
+  *normB += static_cast<float>(nb);
+}
+
+float squaredDistanceI8SSE(const void* a_, const void* b_, size_t n) {
+  auto a = static_cast<const int8_t*>(a_);
+  auto b = static_cast<const int8_t*>(b_);
+  int64_t sum = 0;
+  size_t i = 0;
+  while (i + 16 <= n) {
+    __m128i block = _mm_setzero_si128();
+    size_t blockEnd = std::min(n, i + kInt8BlockSize);
+    for (; i + 16 <= blockEnd; i += 16) {
+      __m128i xLow, xHigh, yLow, yHigh;
+      widen128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+               &xLow, &xHigh);
+      widen128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)),
+               &yLow, &yHigh);
+      __m128i diffLow = _mm_sub_epi16(xLow, yLow);
+      __m128i diffHigh = _mm_sub_epi16(xHigh, yHigh);
+      block = _mm_add_epi32(block, _mm_madd_epi16(diffLow, diffLow));
+      block = _mm_add_epi32(block, _mm_madd_epi16(diffHigh, diffHigh));
+    }
+    sum += sum128i(block);
+  }
+  return static_cast<float>(sum) +
+         squaredDistanceScalar<int8_t>(a + i, b + i, n - i);
+}
+
+// SSE2 has neither half precision conversions nor a population count, so the
+// scalar kernels are used for those.
+const Kernels sseKernels = {
+    kCBLDart_SimdSSE,
+    {dotF32SSE, dotScalar<uint16_t>, dotI8SSE},
+    {squaredDistanceF32SSE, squaredDistanceScalar<uint16_t>,
+     squaredDistanceI8SSE},
+    hammingScalar,
+};
+
+// === AVX2
+
+CBLDART_TARGET_AVX2 inline float sum256(__m256 v) {
+  return sum128(
+      _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+}
+
+CBLDART_TARGET_AVX2 inline int64_t sum256i(__m256i v) {
+  return sum128i(_mm_add_epi32(_mm256_castsi256_si128(v),
+                               _mm256_extracti128_si256(v, 1)));
+}
+
+CBLDART_TARGET_AVX2 inline __m256 loadAVX2(const float* p) {
+  return _mm256_loadu_ps(p);
+}
+
+CBLDART_TARGET_AVX2 inline __m256 loadAVX2(const uint16_t* p) {
+  return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+template <typename T>
+CBLDART_TARGET_AVX2 void dotFloatAVX2(const void* a_, const void* b_, size_t n,
+                                      float* dot, float* normA, float* normB) {
+  auto a = static_cast<const T*>(a_);
+  auto b = static_cast<const T*>(b_);
+  __m256 d = _mm256_setzero_ps();
+  __m256 na = _mm256_setzero_ps();
+  __m256 nb = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 x = loadAVX2(a + i);
+    __m256 y = loadAVX2(b + i);
+    d = _mm256_add_ps(d, _mm256_mul_ps(x, y));
+    na = _mm256_add_ps(na, _mm256_mul_ps(x, x));
+    nb = _mm256_add_ps(nb, _mm256_mul_ps(y, y));
+  }
+  dotScalar<T>(a + i, b + i, n - i, dot, normA, normB);
+  *dot += sum256(d);
+  *normA += sum256(na);
+  *normB += sum256(nb);
+}
+
+template <typename T>
+CBLDART_TARGET_AVX2 float squaredDistanceFloatAVX2(const void* a_,
+                                                   const void* b_, size_t n) {
+  auto a = static_cast<const T*>(a_);
+  auto b = static_cast<const T*>(b_);
+  __m256 sum = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 diff = _mm256_sub_ps(loadAVX2(a + i), loadAVX2(b + i));
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(diff, diff));
+  }
+  return sum256(sum) + squaredDistanceScalar<T>(a + i, b + i, n - i);
+}
+
+CBLDART_TARGET_AVX2 inline __m256i loadI8AVX2(const int8_t* p) {
+  return _mm256_cvtepi8_epi16(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+CBLDART_TARGET_AVX2 void dotI8AVX2(const void* a_, const void* b_, size_t n,
+                                   float* dot, float* normA, float* normB) {
+  auto a = static_cast<const int8_t*>(a_);
+  auto b = static_cast<const int8_t*>(b_);
+  int64_t d = 0, na = 0, nb = 0;
+  size_t i = 0;
+  while (i + 16 <= n) {
+    __m256i blockD = _mm256_setzero_si256();
+    __m256i blockNa = _mm256_setzero_si256();
+    __m256i blockNb = _mm256_setzero_si256();
+    size_t blockEnd = std::min(n, i + kInt8BlockSize);
+    for (; i + 16 <= blockEnd; i += 16) {
+      __m256i x = loadI8AVX2(a + i);
+      __m256i y = loadI8AVX2(b + i);
+      blockD = _mm256_add_epi32(blockD, _mm256_madd_epi16(x, y));
+      blockNa = _mm256_add_epi32(blockNa, _mm256_madd_epi16(x, x));
+      blockNb = _mm256_add_epi32(blockNb, _mm256_madd_epi16(y, y));
+    }
+    d += sum256i(blockD);
+    na += sum256i(blockNa);
+    nb += sum256i(blockNb);
+  }
+  dotScalar<int8_t>(a + i, b + i, n - i, dot, normA, normB);
+  *dot += static_cast<float>(d);
+  *normA += static_cast<float>(na);
+  *normB += static_cast<float>(nb);
+}
+
+CBLDART_TARGET_AVX2 float squaredDistanceI8AVX2(const void* a_,
+                                                const void* b_, size_t n) {
+  auto a = static_cast<const int8_t*>(a_);
+  auto b = static_cast<const int8_t*>(b_);
+  int64_t sum = 0;
+  size_t i = 0;
+  while (i + 16 <= n) {
+    __m256i block = _mm256_setzero_si256();
+    size_t blockEnd = std::min(n, i + kInt8BlockSize);
+    for (; i + 16 <= blockEnd; i += 16) {
+      __m256i diff = _mm256_sub_epi16(loadI8AVX2(a + i), loadI8AVX2(b + i));
+      block = _mm256_add_epi32(block, _mm256_madd_epi16(diff, diff));
+    }
+    sum += sum256i(block);
+  }
+  return static_cast<float>(sum) +
+         squaredDistanceScalar<int8_t>(a + i, b + i, n - i);
+}
+
+/// Counts bits with a lookup table for each nibble (Mula's algorithm).
+CBLDART_TARGET_AVX2 float hammingAVX2(const void* a_, const void* b_,
+                                      size_t bytes) {
+  auto a = static_cast<const uint8_t*>(a_);
+  auto b = static_cast<const uint8_t*>(b_);
+  const __m256i lookup =
+      _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1,
+                       1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i lowMask = _mm256_set1_epi8(0x0f);
+  __m256i counts = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 32 <= bytes; i += 32) {
+    __m256i x = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+    __m256i low = _mm256_and_si256(x, lowMask);
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(x, 4), lowMask);
+    __m256i popcount = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low),
+                                       _mm256_shuffle_epi8(lookup, high));
+    counts = _mm256_add_epi64(
+        counts, _mm256_sad_epu8(popcount, _mm256_setzero_si256()));
+  }
+  alignas(32) uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), counts);
+  return static_cast<float>(lanes[0] + lanes[1] + lanes[2] + lanes[3]) +
+         hammingScalar(a + i, b + i, bytes - i);
+}
+
+const Kernels avx2Kernels = {
+    kCBLDart_SimdAVX2,
+    {dotFloatAVX2<float>, dotFloatAVX2<uint16_t>, dotI8AVX2},
+    {squaredDistanceFloatAVX2<float>, squaredDistanceFloatAVX2<uint16_t>,
+     squaredDistanceI8AVX2},
+    hammingAVX2,
+};
+
+#endif  // CBLDART_SIMD_X86
+
+#ifdef CBLDART_SIMD_NEON
+
+// === NEON
+
+inline float32x4_t loadF32NEON(const float* p) { return vld1q_f32(p); }
+
+inline float32x4_t loadF32NEON(const uint16_t* p) {
+  return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(p)));
+}
+
+template <typename T>
+void dotFloatNEON(const void* a_, const void* b_, size_t n, float* dot,
+                  float* normA, float* normB) {
+  auto a = static_cast<const T*>(a_);
+  auto b = static_cast<const T*>(b_);
+  float32x4_t d = vdupq_n_f32(0), na = vdupq_n_f32(0), nb = vdupq_n_f32(0);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t x = loadF32NEON(a + i);
+    float32x4_t y = loadF32NEON(b + i);
+    d = vfmaq_f32(d, x, y);
+    na = vfmaq_f32(na, x, x);
+    nb = vfmaq_f32(nb, y, y);
+  }
+  dotScalar<T>(a + i, b + i, n - i, dot, normA, normB);
+  *dot += vaddvq_f32(d);
+  *normA += vaddvq_f32(na);
+  *normB += vaddvq_f32(nb);
+}
+
+template <typename T>
+float squaredDistanceFloatNEON(const void* a_, const void* b_, size_t n) {
+  auto a = static_cast<const T*>(a_);
+  auto b = static_cast<const T*>(b_);
+  float32x4_t sum = vdupq_n_f32(0);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t diff = vsubq_f32(loadF32NEON(a + i), loadF32NEON(b + i));
+    sum = vfmaq_f32(sum, diff, diff);
+  }
+  return vaddvq_f32(sum) + squaredDistanceScalar<T>(a + i, b + i, n - i);
+}
+
+void dotI8NEON(const void* a_, const void* b_, size_t n, float* dot,
+               float* normA, float* normB) {
+  auto a = static_cast<const int8_t*>(a_);
+  auto b = static_cast<const int8_t*>(b_);
+  int64_t d = 0, na = 0, nb = 0;
+  size_t i = 0;
+  while (i + 16 <= n) {
+    int32x4_t blockD = vdupq_n_s32(0);
+    int32x4_t blockNa = vdupq_n_s32(0);
+    int32x4_t blockNb = vdupq_n_s32(0);
+    size_t blockEnd = std::min(n, i + kInt8BlockSize);
+    for (; i + 16 <= blockEnd; i += 16) {
+      int8x16_t x = vld1q_s8(a + i);
+      int8x16_t y = vld1q_s8(b + i);
+      blockD = vpadalq_s16(blockD, vmull_s8(vget_low_s8(x), vget_low_s8(y)));
+      blockD = vpadalq_s16(blockD, vmull_high_s8(x, y));
+      blockNa = vpadalq_s16(blockNa, vmull_s8(vget_low_s8(x), vget_low_s8(x)));
+      blockNa = vpadalq_s16(blockNa, vmull_high_s8(x, x));
+      blockNb = vpadalq_s16(blockNb, vmull_s8(vget_low_s8(y), vget_low_s8(y)));
+      blockNb = vpadalq_s16(blockNb, vmull_high_s8(y, y));
+    }
+    d += vaddvq_s32(blockD);
+    na += vaddvq_s32(blockNa);
+    nb += vaddvq_s32(blockNb);
+  }
+  dotScalar<int8_t>(a + i, b + i, n - i, dot, normA, normB);
+  *dot += static_cast<float>(d);
+  *normA += static_cast<float>(na);
+  *normB += static_cast<float>(nb);
+}
+
+float squaredDistanceI8NEON(const void* a_, const void* b_, size_t n) {
+  auto a = static_cast<const int8_t*>(a_);
+  auto b = static_cast<const int8_t*>(b_);
+  int64_t sum = 0;
+  size_t i = 0;
+  while (i + 16 <= n) {
+    int32x4_t block = vdupq_n_s32(0);
+    size_t blockEnd = std::min(n, i + kInt8BlockSize);
+    for (; i + 16 <= blockEnd; i += 16) {
+      int8x16_t x = vld1q_s8(a + i);
+      int8x16_t y = vld1q_s8(b + i);
+      int16x8_t diffLow = vsubl_s8(vget_low_s8(x), vget_low_s8(y));
+      int16x8_t diffHigh = vsubl_high_s8(x, y);
+      block = vmlal_s16(block, vget_low_s16(diffLow), vget_low_s16(diffLow));
+      block = vmlal_high_s16(block, diffLow, diffLow);
+      block =
+          vmlal_s16(block, vget_low_s16(diffHigh), vget_low_s16(diffHigh));
+      block = vmlal_high_s16(block, diffHigh, diffHigh);
+    }
+    sum += vaddvq_s32(block);
+  }
+  return static_cast<float>(sum) +
+         squaredDistanceScalar<int8_t>(a + i, b + i, n - i);
+}
+
+float hammingNEON(const void* a_, const void* b_, size_t bytes) {
+  auto a = static_cast<const uint8_t*>(a_);
+  auto b = static_cast<const uint8_t*>(b_);
+  uint64_t count = 0;
+  size_t i = 0;
+  for (; i + 16 <= bytes; i += 16) {
+    uint8x16_t x = veorq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+    count += vaddlvq_u8(vcntq_u8(x));
+  }
+  return static_cast<float>(count) + hammingScalar(a + i, b + i, bytes - i);
+}
+
+const Kernels neonKernels = {
+    kCBLDart_SimdNEON,
+    {dotFloatNEON<float>, dotFloatNEON<uint16_t>, dotI8NEON},
+    {squaredDistanceFloatNEON<float>, squaredDistanceFloatNEON<uint16_t>,
+     squaredDistanceI8NEON},
+    hammingNEON,
+};
+
+#endif  // CBLDART_SIMD_NEON
+
+// === Dispatch ===============================================================
+
+const Kernels* kernelsForLevel(CBLDart_SimdLevel level) {
+  switch (level) {
+    case kCBLDart_SimdScalar:
+      return &scalarKernels;
+#ifdef CBLDART_SIMD_X86
+    case kCBLDart_SimdSSE:
+      // SSE2 is part of the x86-64 baseline.
+      return &sseKernels;
+    case kCBLDart_SimdAVX2:
+      return CpuSupportsAVX2() && CpuSupportsF16C() ? &avx2Kernels : nullptr;
+#endif
+#ifdef CBLDART_SIMD_NEON
+    case kCBLDart_SimdNEON:
+      // NEON is part of the AArch64 baseline.
+      return &neonKernels;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+const Kernels* detectKernels() {
+  for (auto level : {kCBLDart_SimdAVX2, kCBLDart_SimdNEON, kCBLDart_SimdSSE}) {
+    if (auto kernels = kernelsForLevel(level)) {
+      return kernels;
+    }
+  }
+  return &scalarKernels;
+}
+
+std::atomic<const Kernels*> activeKernels{nullptr};
+
+const Kernels& kernels() {
+  auto kernels = activeKernels.load(std::memory_order_acquire);
+  if (!kernels) {
+    // Detection is idempotent, so racing threads can all store their result.
+    kernels = detectKernels();
+    activeKernels.store(kernels, std::memory_order_release);
+  }
+  return *kernels;
+}
+
+float distanceWith(const Kernels& kernels, CBLDart_VectorDistanceMetric metric,
+                   CBLDart_VectorElementType elementType, const void* a,
+                   const void* b, size_t dimensions) {
+  if (elementType >= kElementTypeCount) {
+    return std::numeric_limits<float>::quiet_NaN();
+  }
+
+  switch (metric) {
+    case kCBLDart_VectorDistanceEuclideanSquared:
+      return kernels.squaredDistance[elementType](a, b, dimensions);
+    case kCBLDart_VectorDistanceEuclidean:
+      return std::sqrt(kernels.squaredDistance[elementType](a, b, dimensions));
+    case kCBLDart_VectorDistanceCosine: {
+      float dot, normA, normB;
+      kernels.dot[elementType](a, b, dimensions, &dot, &normA, &normB);
+      auto norms = std::sqrt(normA) * std::sqrt(normB);
+      return norms == 0 ? 1.f : 1.f - dot / norms;
+    }
+    case kCBLDart_VectorDistanceDot: {
+      float dot, normA, normB;
+      kernels.dot[elementType](a, b, dimensions, &dot, &normA, &normB);
+      return -dot;
+    }
+    case kCBLDart_VectorDistanceHamming:
+      return kernels.hamming(a, b, dimensions * elementSize(elementType));
+    default:
+      return std::numeric_limits<float>::quiet_NaN();
+  }
+}
+
+}  // namespace
+
+// === VectorDistance =========================================================
+
+CBLDart_SimdLevel VectorDistance::simdLevel() { return kernels().level; }
+
+bool VectorDistance::setSimdLevel(CBLDart_SimdLevel level) {
+  auto kernels = kernelsForLevel(level);
+  if (!kernels) {
+    return false;
+  }
+  activeKernels.store(kernels, std::memory_order_release);
+  return true;
+}
+
+float VectorDistance::distance(CBLDart_VectorDistanceMetric metric,
+                               CBLDart_VectorElementType elementType,
+                               const void* a, const void* b,
+                               size_t dimensions) {
+  return distanceWith(kernels(), metric, elementType, a, b, dimensions);
+}
+
+void VectorDistance::batch(CBLDart_VectorDistanceMetric metric,
+                           CBLDart_VectorElementType elementType,
+                           const void* query, const void* candidates,
+                           size_t count, size_t dimensions,
+                           float* distancesOut) {
+  auto& kernels_ = kernels();
+  auto stride = dimensions * elementSize(elementType);
+  auto candidate = static_cast<const uint8_t*>(candidates);
+  for (size_t i = 0; i < count; i++, candidate += stride) {
+    distancesOut[i] =
+        distanceWith(kernels_, metric, elementType, query, candidate,
+                     dimensions);
+  }
+}
+
+size_t VectorDistance::topK(CBLDart_VectorDistanceMetric metric,
+                            CBLDart_VectorElementType elementType,
+                            const void* query, const void* candidates,
+                            size_t count, size_t dimensions, size_t k,
+                            uint32_t* indexesOut, float* distancesOut) {
+  k = std::min(k, count);
+  if (k == 0) {
+    return 0;
+  }
+
+  using Match = std::pair<float, uint32_t>;
+
+  // Max-heap of the k closest matches found so far, with the farthest one at
+  // the front.
+  std::vector<Match> heap;
+  heap.reserve(k);
+
+  auto& kernels_ = kernels();
+  auto stride = dimensions * elementSize(elementType);
+  auto candidate = static_cast<const uint8_t*>(candidates);
+  for (size_t i = 0; i < count; i++, candidate += stride) {
+    Match match{distanceWith(kernels_, metric, elementType, query, candidate,
+                             dimensions),
+                static_cast<uint32_t>(i)};
+    if (heap.size() < k) {
+      heap.push_back(match);
+      std::push_heap(heap.begin(), heap.end());
+    } else if (match < heap.front()) {
+      std::pop_heap(heap.begin(), heap.end());
+      heap.back() = match;
+      std::push_heap(heap.begin(), heap.end());
+    }
+  }
+
+  std::sort_heap(heap.begin(), heap.end());
+  for (size_t i = 0; i < heap.size(); i++) {
+    distancesOut[i] = heap[i].first;
+    indexesOut[i] = heap[i].second;
+  }
+  return heap.size();
+}
+
+}  // namespace CBLDart
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CBL+Dart.h"
+
+namespace CBLDart {
+
+// === VectorDistance =========================================================
+
+/**
+ * Distance functions for vectors of floats, half precision floats or signed
+ * bytes.
+ *
+ * Each function has a scalar implementation and implementations for SSE2,
+ * AVX2 and NEON. The best implementation which is supported by the CPU is
+ * selected at runtime, when the functions are first used.
+ */
+class VectorDistance {
+ public:
+  static CBLDart_SimdLevel simdLevel();
+  static bool setSimdLevel(CBLDart_SimdLevel level);
+
+  static float distance(CBLDart_VectorDistanceMetric metric,
+                        CBLDart_VectorElementType elementType, const void* a,
+                        const void* b, size_t dimensions);
+
+  static void batch(CBLDart_VectorDistanceMetric metric,
+                    CBLDart_VectorElementType elementType, const void* query,
+                    const void* candidates, size_t count, size_t dimensions,
+                    float* distancesOut);
+
+  static size_t topK(CBLDart_VectorDistanceMetric metric,
+                     CBLDart_VectorElementType elementType, const void* query,
+                     const void* candidates, size_t count, size_t dimensions,
+                     size_t k, uint32_t* indexesOut, float* distancesOut);
+};
+
+}  // namespace CBLDart
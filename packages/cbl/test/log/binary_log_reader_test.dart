@@ -0,0 +1,135 @@
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:cbl/cbl.dart';
+import 'package:test/test.dart';
+
+void main() {
+  group('BinaryLogReader', () {
+    test('reads log and dropped records', () {
+      final segment = _SegmentBuilder()
+        ..string('a')
+        ..log(timestampDelta: 1000, threadId: 1, domain: 1, level: 2, string: 0)
+        ..dropped(3)
+        ..string('b')
+        ..log(timestampDelta: -10, threadId: 2, domain: 4, level: 4, string: 1)
+        ..log(timestampDelta: 200, threadId: 1, domain: 1, level: 2, string: 0)
+        ..end();
+
+      expect(BinaryLogReader.readSegment(segment.bytes).toList(), [
+        BinaryLogRecord(
+          timestamp: DateTime.fromMillisecondsSinceEpoch(1000),
+          threadId: 1,
+          domain: LogDomain.values[1],
+          level: LogLevel.values[2],
+          message: 'a',
+        ),
+        const BinaryLogDroppedRecords(3),
+        BinaryLogRecord(
+          timestamp: DateTime.fromMillisecondsSinceEpoch(990),
+          threadId: 2,
+          domain: LogDomain.values[4],
+          level: LogLevel.values[4],
+          message: 'b',
+        ),
+        BinaryLogRecord(
+          timestamp: DateTime.fromMillisecondsSinceEpoch(1190),
+          threadId: 1,
+          domain: LogDomain.values[1],
+          level: LogLevel.values[2],
+          message: 'a',
+        ),
+      ]);
+    });
+
+    test('stops at the unwritten rest of a segment', () {
+      final segment = _SegmentBuilder()
+        ..string('a')
+        ..log(timestampDelta: 1, threadId: 1, domain: 0, level: 0, string: 0);
+      final bytes = Uint8List(segment.bytes.length + 64)
+        ..setAll(0, segment.bytes);
+
+      expect(BinaryLogReader.readSegment(bytes), hasLength(1));
+    });
+
+    test('rejects data which is not a log segment', () {
+      expect(
+        () => BinaryLogReader.readSegment(Uint8List(16)).toList(),
+        throwsFormatException,
+      );
+    });
+
+    test('rejects unsupported versions', () {
+      final segment = _SegmentBuilder(version: 2)..end();
+
+      expect(
+        () => BinaryLogReader.readSegment(segment.bytes).toList(),
+        throwsFormatException,
+      );
+    });
+
+    test('rejects truncated records', () {
+      final segment = _SegmentBuilder()
+        ..string('abc')
+        ..end();
+      final bytes = Uint8List.sublistView(segment.bytes, 0, 19);
+
+      expect(
+        () => BinaryLogReader.readSegment(bytes).toList(),
+        throwsFormatException,
+      );
+    });
+  });
+}
+
+final class _SegmentBuilder {
+  _SegmentBuilder({int version = 1}) {
+    _bytes
+      ..addAll(ascii.encode('CBLDLOG'))
+      ..add(version)
+      ..addAll(List.filled(8, 0));
+  }
+
+  final _bytes = <int>[];
+
+  Uint8List get bytes => Uint8List.fromList(_bytes);
+
+  void string(String value) {
+    final encoded = utf8.encode(value);
+    _bytes.add(1);
+    _varint(encoded.length);
+    _bytes.addAll(encoded);
+  }
+
+  void log({
+    required int timestampDelta,
+    required int threadId,
+    required int domain,
+    required int level,
+    required int string,
+  }) {
+    _bytes.add(2);
+    _varint((timestampDelta << 1) ^ (timestampDelta >> 63));
+    _varint(threadId);
+    _bytes
+      ..add(domain)
+      ..add(level);
+    _varint(string);
+  }
+
+  void dropped(int count) {
+    _bytes.add(3);
+    _varint(count);
+  }
+
+  void end() => _bytes.add(0);
+
+  void _varint(int value) {
+    var rest = value;
+    while (rest >= 0x80) {
+      _bytes.add((rest & 0x7f) | 0x80);
+      rest >>>= 7;
+    }
+    _bytes.add(rest);
+  }
+}
@@ -2,8 +2,11 @@ import 'bindings/bindings_test.dart' as bindings_bindings;
 import 'database/collection_test.dart' as database_collection;
 import 'database/database_configuration_test.dart'
     as database_database_configuration;
+import 'database/database_pool_test.dart' as database_database_pool;
 import 'database/database_test.dart' as database_database;
 import 'database/document_change_test.dart' as database_document_change;
+import 'database/maintenance_scheduler_test.dart'
+    as database_maintenance_scheduler;
 import 'database/typed_collection_test.dart' as typed_collection;
 import 'document/array_test.dart' as document_array_test;
 import 'document/blob_test.dart' as document_blob_test;
@@ -15,6 +18,7 @@ import 'fleece/coding_test.dart' as fleece_coding;
 import 'fleece/containers_test.dart' as fleece_containers;
 import 'fleece/integration_test.dart' as fleece_integration;
 import 'fleece/slice_test.dart' as fleece_slice;
+import 'log/binary_logger_test.dart' as log_binary_logger;
 import 'log/consoler_logger_test.dart' as log_console_logger;
 import 'log/file_logger_test.dart' as log_file_logger;
 import 'log/logger_test.dart' as log_logger;
@@ -23,8 +27,10 @@ import 'query/index/index_configuration_test.dart'
     as query_index_index_configuration;
 import 'query/parameters_test.dart' as query_parameters;
 import 'query/query_builder_test.dart' as query_builder;
+import 'query/query_profiler_test.dart' as query_query_profiler;
 import 'query/query_test.dart' as query_query;
 import 'query/result_test.dart' as query_result;
+import 'query/vector_distance_test.dart' as query_vector_distance;
 import 'replication/authenticator_test.dart' as replication_authenticator;
 import 'replication/configuration_test.dart' as replication_configuration;
 import 'replication/conflict_test.dart' as replication_conflict;
@@ -41,6 +47,8 @@ import 'service/channel_test.dart' as service_channel;
 import 'service/isolate_worker_test.dart' as service_isolate_worker;
 import 'support/app_directory_test.dart' as support_app_directory;
 import 'support/async_callback_test.dart' as support_async_callback;
+import 'support/native_metrics_test.dart' as support_native_metrics;
+import 'support/native_tracing_test.dart' as support_native_tracing;
 import 'tracing_test.dart' as tracing;
 import 'typed_data/collection_test.dart' as typed_data_collection;
 import 'typed_data/conversion_test.dart' as typed_data_conversion;
@@ -51,8 +59,10 @@ final tests = [
   bindings_bindings.main,
   database_collection.main,
   database_database_configuration.main,
+  database_database_pool.main,
   database_database.main,
   database_document_change.main,
+  database_maintenance_scheduler.main,
   document_array_test.main,
   document_blob_test.main,
   document_dictionary_test.main,
@@ -63,6 +73,7 @@ final tests = [
   fleece_containers.main,
   fleece_integration.main,
   fleece_slice.main,
+  log_binary_logger.main,
   log_console_logger.main,
   log_file_logger.main,
   log_logger.main,
@@ -70,8 +81,10 @@ final tests = [
   query_builder.main,
   query_index_index_configuration.main,
   query_parameters.main,
+  query_query_profiler.main,
   query_query.main,
   query_result.main,
+  query_vector_distance.main,
   replication_authenticator.main,
   replication_configuration.main,
   replication_conflict.main,
@@ -84,6 +97,8 @@ final tests = [
   service_isolate_worker.main,
   support_app_directory.main,
   support_async_callback.main,
+  support_native_metrics.main,
+  support_native_tracing.main,
   tls_identity.main,
   tracing.main,
   typed_data_collection.main,
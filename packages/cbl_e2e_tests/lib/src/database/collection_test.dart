@@ -96,6 +96,114 @@ void main() {
       });
     });
 
+    group('documents', () {
+      apiTest('returns the existing documents in order', () async {
+        final db = await openTestDatabase();
+        final collection = await db.defaultCollection;
+
+        final docA = MutableDocument({'a': 'b'});
+        final docB = MutableDocument({'c': 4});
+        await collection.saveDocuments([docA, docB]);
+
+        final docs = await collection.documents([docB.id, 'x', docA.id]);
+
+        expect(docs, [docB, isNull, docA]);
+        expect(docs[0]!.revisionId, docB.revisionId);
+        expect(docs[0]!.sequence, docB.sequence);
+        expect(docs[2]!.toPlainMap(), {'a': 'b'});
+        expect(await collection.documents([]), isEmpty);
+      });
+
+      apiTest('returns documents which can be updated', () async {
+        final db = await openTestDatabase();
+        final collection = await db.defaultCollection;
+
+        final doc = MutableDocument({'a': 'b'});
+        await collection.saveDocument(doc);
+
+        final mutableDoc = (await collection.documents([
+          doc.id,
+        ])).single!.toMutable()..setValue('c', key: 'a');
+        await collection.saveDocument(mutableDoc, .failOnConflict);
+
+        expect((await collection.document(doc.id))!.value('a'), 'c');
+      });
+
+      apiTest('detects conflicts with documents which have changed', () async {
+        final db = await openTestDatabase();
+        final collection = await db.defaultCollection;
+
+        final doc = MutableDocument({'a': 'b'});
+        await collection.saveDocument(doc);
+
+        final loadedDoc = (await collection.documents([doc.id])).single!;
+        await collection.saveDocument(doc..setValue('c', key: 'a'));
+
+        final mutableDoc = loadedDoc.toMutable();
+        expect(mutableDoc.value('a'), 'b');
+        expect(mutableDoc.revisionId, loadedDoc.revisionId);
+        await expectLater(
+          () => collection.saveDocument(mutableDoc, .failOnConflict),
+          throwsA(
+            isA<DatabaseException>().having(
+              (it) => it.code,
+              'code',
+              DatabaseErrorCode.conflict,
+            ),
+          ),
+        );
+        final saved = await collection.saveDocuments([
+          mutableDoc,
+        ], .failOnConflict);
+        expect(saved, [false]);
+      });
+
+      apiTest('overwrites changed documents with lastWriteWins', () async {
+        final db = await openTestDatabase();
+        final collection = await db.defaultCollection;
+
+        final doc = MutableDocument({'a': 'b'});
+        await collection.saveDocument(doc);
+
+        final loadedDoc = (await collection.documents([doc.id])).single!;
+        await collection.saveDocument(doc..setValue('c', key: 'a'));
+
+        final mutableDoc = loadedDoc.toMutable()..setValue('d', key: 'e');
+        await collection.saveDocument(mutableDoc);
+
+        final storedDoc = (await collection.document(doc.id))!;
+        expect(storedDoc.toPlainMap(), {'a': 'b', 'e': 'd'});
+        expect(storedDoc.revisionId, mutableDoc.revisionId);
+        expect(storedDoc.revisionId, isNot(doc.revisionId));
+      });
+
+      apiTest('deletes documents which have changed', () async {
+        final db = await openTestDatabase();
+        final collection = await db.defaultCollection;
+
+        final doc = MutableDocument({'a': 'b'});
+        await collection.saveDocument(doc);
+
+        final loadedDoc = (await collection.documents([doc.id])).single!;
+        await collection.saveDocument(doc..setValue('c', key: 'a'));
+
+        await expectLater(
+          () => collection.deleteDocument(loadedDoc, .failOnConflict),
+          throwsA(
+            isA<DatabaseException>().having(
+              (it) => it.code,
+              'code',
+              DatabaseErrorCode.conflict,
+            ),
+          ),
+        );
+        expect(await collection.document(doc.id), isNotNull);
+
+        await collection.deleteDocument(loadedDoc);
+        expect(await collection.document(doc.id), isNull);
+      });
+    });
+
     apiTest('saveDocument saves the document', () async {
       final db = await openTestDatabase();
       final collection = await db.defaultCollection;
@@ -109,6 +217,84 @@ void main() {
       );
     });
 
+    apiTest('saveDocuments saves the documents', () async {
+      final db = await openTestDatabase();
+      final collection = await db.defaultCollection;
+
+      final existingDoc = MutableDocument({'a': 'b'});
+      await collection.saveDocument(existingDoc);
+      existingDoc.setValue('c', key: 'a');
+
+      final docs = [
+        existingDoc,
+        for (var i = 0; i < 10; i++) MutableDocument({'i': i}),
+      ];
+      expect(await collection.saveDocuments(docs), everyElement(isTrue));
+
+      expect(await collection.count, 11);
+      for (final doc in docs) {
+        expect(doc.revisionId, isNotNull);
+        expect(
+          (await collection.document(doc.id))!.toPlainMap(),
+          doc.toPlainMap(),
+        );
+      }
+    });
+
+    apiTest('saveDocuments reports conflicting documents', () async {
+      final db = await openTestDatabase();
+      final collection = await db.defaultCollection;
+
+      final doc = MutableDocument({'a': 'b'});
+      await collection.saveDocument(doc);
+
+      final conflictingDoc = (await collection.document(doc.id))!.toMutable()
+        ..setValue('c', key: 'a');
+      await collection.saveDocument(doc..setValue('d', key: 'a'));
+
+      final newDoc = MutableDocument({'e': 'f'});
+      final saved = await collection.saveDocuments([
+        conflictingDoc,
+        newDoc,
+      ], .failOnConflict);
+
+      expect(saved, [isFalse, isTrue]);
+      expect((await collection.document(doc.id))!.value('a'), 'd');
+      expect(await collection.document(newDoc.id), isNotNull);
+    });
+
+    apiTest('saveDocumentsWithConcurrencyControl per document', () async {
+      final db = await openTestDatabase();
+      final collection = await db.defaultCollection;
+
+      final docA = MutableDocument({'a': 'b'});
+      final docB = MutableDocument({'a': 'b'});
+      await collection.saveDocuments([docA, docB]);
+
+      final conflictingDocA = (await collection.document(docA.id))!.toMutable()
+        ..setValue('c', key: 'a');
+      final conflictingDocB = (await collection.document(docB.id))!.toMutable()
+        ..setValue('c', key: 'a');
+      await collection.saveDocuments([
+        docA..setValue('d', key: 'a'),
+        docB..setValue('d', key: 'a'),
+      ]);
+
+      final saved = await collection.saveDocumentsWithConcurrencyControl(
+        [conflictingDocA, conflictingDocB],
+        [.failOnConflict, .lastWriteWins],
+      );
+
+      expect(saved, [isFalse, isTrue]);
+      expect((await collection.document(docA.id))!.value('a'), 'd');
+      expect((await collection.document(docB.id))!.value('a'), 'c');
+
+      await expectLater(
+        () => collection.saveDocumentsWithConcurrencyControl([docA], []),
+        throwsArgumentError,
+      );
+    });
+
     apiTest(
       'save mutable document created from unsaved mutable document',
       () async {
@@ -373,6 +559,111 @@ void main() {
       expect(await collection.document(doc.id), isNull);
     });
 
+    group('purgeDocuments', () {
+      apiTest('purges the documents in chunks', () async {
+        final db = await openTestDatabase();
+        final collection = await db.defaultCollection;
+
+        final docs = List.generate(5, (_) => MutableDocument({}));
+        await collection.saveDocuments(docs);
+        final ids = [...docs.map((doc) => doc.id), 'missing'];
+
+        final progress = await collection
+            .purgeDocuments(ids, chunkSize: 2)
+            .toList();
+
+        expect(progress, const [
+          BulkDocumentProgress(processed: 2, affected: 2, total: 6),
+          BulkDocumentProgress(processed: 4, affected: 4, total: 6),
+          BulkDocumentProgress(processed: 6, affected: 5, total: 6),
+        ]);
+        expect(await collection.documents(ids), everyElement(isNull));
+      });
+
+      apiTest('completes immediately without ids', () async {
+        final db = await openTestDatabase();
+        final collection = await db.defaultCollection;
+
+        expect(await collection.purgeDocuments([]).toList(), const [
+          BulkDocumentProgress(processed: 0, affected: 0, total: 0),
+        ]);
+      });
+
+      apiTest('stops when the subscription is canceled', () async {
+        final db = await openTestDatabase(tearDown: false);
+        final collection = await db.defaultCollection;
+
+        final docs = List.generate(1000, (_) => MutableDocument({}));
+        await collection.saveDocuments(docs);
+
+        final progress = await collection
+            .purgeDocuments(docs.map((doc) => doc.id).toList(), chunkSize: 1)
+            .first;
+        expect(progress.isDone, isFalse);
+
+        // Closing the database waits for the stopped worker.
+        final config = db.config;
+        await db.close();
+
+        final reopened = await openTestDatabase(config: config);
+        expect(await (await reopened.defaultCollection).count, greaterThan(0));
+      });
+
+      apiTest('closing the database stops the purge', () async {
+        final db = await openTestDatabase(tearDown: false);
+        final collection = await db.defaultCollection;
+
+        final docs = List.generate(1000, (_) => MutableDocument({}));
+        await collection.saveDocuments(docs);
+
+        final subscription = collection
+            .purgeDocuments(docs.map((doc) => doc.id).toList(), chunkSize: 1)
+            .listen(null, onError: (_) {});
+        // Deleting the database waits for the worker and its connection.
+        await db.delete();
+        await subscription.cancel();
+
+        expect(
+          await Database.exists(db.name, directory: db.config.directory),
+          isFalse,
+        );
+      });
+    });
+
+    group('setDocumentsExpiration', () {
+      apiTest('sets the time of expiration of the documents', () async {
+        final db = await openTestDatabase();
+        final collection = await db.defaultCollection;
+
+        final expiration = DateTime.now().add(const Duration(days: 1));
+        final docs = List.generate(3, (_) => MutableDocument({}));
+        await collection.saveDocuments(docs);
+        final ids = docs.map((doc) => doc.id).toList();
+
+        final progress = await collection
+            .setDocumentsExpiration(ids, expiration)
+            .last;
+        expect(
+          progress,
+          const BulkDocumentProgress(processed: 3, affected: 3, total: 3),
+        );
+
+        for (final id in ids) {
+          final storedExpiration = await collection.getDocumentExpiration(id);
+          expect(
+            storedExpiration!.millisecondsSinceEpoch,
+            expiration.millisecondsSinceEpoch,
+          );
+        }
+
+        await collection.setDocumentsExpiration(ids, null).drain<void>();
+
+        for (final id in ids) {
+          expect(await collection.getDocumentExpiration(id), isNull);
+        }
+      });
+    });
+
     group('getDocumentExpiration', () {
       apiTest('returns null if the document has no expiration', () async {
         final db = await openTestDatabase();
@@ -0,0 +1,119 @@
+import 'package:cbl/cbl.dart';
+
+import '../../test_binding_impl.dart';
+import '../test_binding.dart';
+import '../utils/database_utils.dart';
+
+void main() {
+  setupTestBinding();
+
+  group('DatabasePool', () {
+    setUp(() => DatabasePool.configure(capacity: 2));
+    tearDown(DatabasePool.disable);
+
+    test('reopening a closed database reuses the pooled handle', () async {
+      final db = openSyncTestDatabase(name: 'a', tearDown: false);
+      final config = db.config;
+      db.defaultCollection.saveDocument(MutableDocument.withId('doc'));
+      await db.close();
+      expect(DatabasePool.size, 1);
+
+      final reopened = openSyncTestDatabase(name: 'a', config: config);
+      expect(DatabasePool.size, 0);
+      expect(reopened.defaultCollection.document('doc'), isNotNull);
+    });
+
+    test('does not reuse handles with a different name', () async {
+      final db = openSyncTestDatabase(name: 'a', tearDown: false);
+      final config = db.config;
+      await db.close();
+
+      openSyncTestDatabase(name: 'b', config: config);
+      expect(DatabasePool.size, 1);
+    });
+
+    test('closes the least recently closed handle when full', () async {
+      final a = openSyncTestDatabase(name: 'a', tearDown: false);
+      final b = openSyncTestDatabase(name: 'b', tearDown: false);
+      final c = openSyncTestDatabase(name: 'c', tearDown: false);
+      await a.close();
+      await b.close();
+      await c.close();
+      expect(DatabasePool.size, 2);
+    });
+
+    test('closes handles after their time to live', () async {
+      DatabasePool.configure(
+        capacity: 2,
+        timeToLive: const Duration(milliseconds: 10),
+      );
+      final db = openSyncTestDatabase(name: 'a', tearDown: false);
+      await db.close();
+      expect(DatabasePool.size, 1);
+
+      await Future<void>.delayed(const Duration(milliseconds: 200));
+      expect(DatabasePool.size, 0);
+    });
+
+    test('remove closes pooled handles of the database', () async {
+      final db = openSyncTestDatabase(name: 'a', tearDown: false);
+      final directory = db.config.directory;
+      await db.close();
+      expect(DatabasePool.size, 1);
+
+      Database.removeSync('a', directory: directory);
+      expect(DatabasePool.size, 0);
+      expect(Database.existsSync('a', directory: directory), isFalse);
+    });
+
+    test('delete closes pooled handles of the database', () async {
+      final db = openSyncTestDatabase(name: 'a', tearDown: false);
+      final config = db.config;
+      await db.close();
+
+      final other = openSyncTestDatabase(name: 'a', config: config);
+      final third = openSyncTestDatabase(
+        name: 'a',
+        config: config,
+        tearDown: false,
+      );
+      await third.close();
+      expect(DatabasePool.size, 1);
+
+      await other.delete();
+      expect(DatabasePool.size, 0);
+      expect(Database.existsSync('a', directory: config.directory), isFalse);
+    });
+
+    test('reusing a handle with listeners of a previous session', () async {
+      final db = openSyncTestDatabase(name: 'a', tearDown: false);
+      final config = db.config;
+      db.defaultCollection.addChangeListener((_) {});
+      await db.close();
+      expect(DatabasePool.size, 1);
+
+      final reopened = openSyncTestDatabase(
+        name: 'a',
+        config: config,
+        tearDown: false,
+      );
+      expect(DatabasePool.size, 0);
+      reopened.defaultCollection.addChangeListener((_) {});
+      reopened.defaultCollection.saveDocument(MutableDocument());
+      await reopened.close();
+      expect(DatabasePool.size, 1);
+
+      final third = openSyncTestDatabase(name: 'a', config: config);
+      expect(third.defaultCollection.count, 1);
+    });
+
+    test('disable closes pooled handles', () async {
+      final db = openSyncTestDatabase(name: 'a', tearDown: false);
+      await db.close();
+      expect(DatabasePool.size, 1);
+
+      DatabasePool.disable();
+      expect(DatabasePool.size, 0);
+    });
+  });
+}
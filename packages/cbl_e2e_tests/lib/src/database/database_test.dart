@@ -469,6 +469,29 @@ void main() {
         expect(await loadedBlob!.content(), await blob.content());
       });
 
+      apiTest('save blob from stream of many chunks', () async {
+        final db = await openTestDatabase();
+        // More data than can be queued for writing at once, in chunks which
+        // are small enough to be coalesced.
+        final chunks = [
+          for (var i = 0; i < 1280; i++)
+            Uint8List(4096)..fillRange(0, 4096, i % 256),
+        ];
+        final content = Uint8List.fromList([
+          for (final chunk in chunks) ...chunk,
+        ]);
+        final blob = Blob.fromStream('', Stream.fromIterable(chunks));
+        await db.saveBlob(blob);
+        expect(blob.length, content.length);
+
+        final dataBlob = Blob.fromData('', content);
+        await db.saveBlob(dataBlob);
+        expect(blob.digest, dataBlob.digest);
+
+        final loadedBlob = await db.getBlob(blob.properties);
+        expect(await loadedBlob!.content(), content);
+      });
+
       apiTest(
         'saveBlob throws when using blob with multiple databases',
         () async {
@@ -0,0 +1,102 @@
+import 'package:cbl/cbl.dart';
+
+import '../../test_binding_impl.dart';
+import '../test_binding.dart';
+import '../utils/database_utils.dart';
+
+void main() {
+  setupTestBinding();
+
+  group('MaintenanceScheduler', () {
+    test('counts writes to a scheduled database', () async {
+      final db = openSyncTestDatabase();
+      expect(MaintenanceScheduler.pendingWrites(db), isNull);
+
+      MaintenanceScheduler.schedule(
+        db,
+        const MaintenanceSchedule(writeThreshold: 1000, idleDelay: null),
+      );
+      expect(MaintenanceScheduler.pendingWrites(db), 0);
+
+      db.inBatchSync(() {
+        for (var i = 0; i < 3; i++) {
+          db.defaultCollection.saveDocument(MutableDocument());
+        }
+      });
+      await _waitForPendingWrites(db, 3);
+    });
+
+    test('performs maintenance when the write threshold is reached', () async {
+      final db = openSyncTestDatabase();
+      MaintenanceScheduler.schedule(
+        db,
+        const MaintenanceSchedule(writeThreshold: 2, idleDelay: null),
+      );
+
+      db.defaultCollection.saveDocument(MutableDocument());
+      await _waitForPendingWrites(db, 1);
+
+      db.defaultCollection.saveDocument(MutableDocument());
+      await _waitForPendingWrites(db, 0);
+    });
+
+    test('performs maintenance after the idle delay', () async {
+      final db = openSyncTestDatabase();
+      MaintenanceScheduler.schedule(
+        db,
+        const MaintenanceSchedule(
+          type: MaintenanceType.optimize,
+          writeThreshold: null,
+          idleDelay: Duration(milliseconds: 10),
+        ),
+      );
+
+      db.defaultCollection.saveDocument(MutableDocument());
+      await _waitForPendingWrites(db, 0);
+    });
+
+    test('unschedule stops counting writes', () {
+      final db = openSyncTestDatabase();
+      MaintenanceScheduler.schedule(db);
+      MaintenanceScheduler.unschedule(db);
+      expect(MaintenanceScheduler.pendingWrites(db), isNull);
+    });
+
+    test('closing a database with scheduled maintenance', () async {
+      final db = openSyncTestDatabase(tearDown: false);
+      MaintenanceScheduler.schedule(
+        db,
+        const MaintenanceSchedule(idleDelay: Duration(milliseconds: 1)),
+      );
+      db.defaultCollection.saveDocument(MutableDocument());
+      await db.close();
+    });
+
+    test('rejects a schedule without triggers', () {
+      final db = openSyncTestDatabase();
+      expect(
+        () => MaintenanceScheduler.schedule(
+          db,
+          const MaintenanceSchedule(writeThreshold: null, idleDelay: null),
+        ),
+        throwsArgumentError,
+      );
+      expect(
+        () => MaintenanceScheduler.schedule(
+          db,
+          const MaintenanceSchedule(writeThreshold: 0),
+        ),
+        throwsArgumentError,
+      );
+    });
+  });
+}
+
+Future<void> _waitForPendingWrites(SyncDatabase db, int writes) async {
+  final deadline = DateTime.now().add(const Duration(seconds: 5));
+  while (MaintenanceScheduler.pendingWrites(db) != writes &&
+      DateTime.now().isBefore(deadline)) {
+    await Future<void>.delayed(const Duration(milliseconds: 10));
+  }
+  expect(MaintenanceScheduler.pendingWrites(db), writes);
+}
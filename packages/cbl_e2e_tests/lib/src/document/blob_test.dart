@@ -1,3 +1,4 @@
+import 'dart:async';
 import 'dart:convert' hide json;
 import 'dart:math';
 import 'dart:typed_data';
@@ -162,6 +163,171 @@ void main() {
       }
     }, variants: [writeBlob, readTime, readMode, readBlob, blobSize]);
 
+    test('read large saved blob as paused stream', () async {
+      final db = openSyncTestDatabase();
+      final collection = db.defaultCollection;
+      final content = randomBytes(2 * 1024 * 1024 + 4);
+      final doc = MutableDocument({
+        'blob': Blob.fromData(contentType, content),
+      });
+      collection.saveDocument(doc);
+      final blob = collection.document(doc.id)!.blob('blob')!;
+
+      final chunks = <Uint8List>[];
+      late StreamSubscription<Uint8List> subscription;
+      final done = Completer<void>();
+      subscription = blob.contentStream().listen(
+        (chunk) {
+          chunks.add(chunk);
+          if (chunks.length.isEven) {
+            subscription.pause(Future<void>.delayed(Duration.zero));
+          }
+        },
+        onDone: done.complete,
+        onError: done.completeError,
+      );
+      await done.future;
+
+      expect(chunks.length, greaterThan(1));
+      expect(chunks.expand((chunk) => chunk).toList(), content);
+    });
+
+    apiTest('read saved blob with read ahead options', () async {
+      final db = await openTestDatabase();
+      final collection = await db.defaultCollection;
+      final content = randomBytes(64 * 1024 + 4);
+      final doc = MutableDocument({
+        'blob': Blob.fromData(contentType, content),
+      });
+      await collection.saveDocument(doc);
+      final blob = (await collection.document(doc.id))!.blob('blob')!;
+
+      final chunks = await blob
+          .contentStream(
+            options: const BlobReadOptions(
+              readAheadChunkSize: 1024,
+              readAheadChunks: 2,
+              minReadAheadLength: 0,
+            ),
+          )
+          .toList();
+
+      expect(chunks.length, 65);
+      expect(chunks.map((chunk) => chunk.length), everyElement(lessThan(1025)));
+      expect(chunks.expand((chunk) => chunk).toList(), content);
+    });
+
+    test('closing the database while reading ahead', () async {
+      final db = openSyncTestDatabase(tearDown: false);
+      final collection = db.defaultCollection;
+      final content = randomBytes(64 * 1024 + 4);
+      final doc = MutableDocument({
+        'blob': Blob.fromData(contentType, content),
+      });
+      collection.saveDocument(doc);
+      final blob = collection.document(doc.id)!.blob('blob')!;
+
+      final chunks = <Uint8List>[];
+      final done = Completer<void>();
+      late Future<void> close;
+      blob
+          .contentStream(
+            options: const BlobReadOptions(
+              readAheadChunkSize: 1024,
+              readAheadChunks: 2,
+              minReadAheadLength: 0,
+            ),
+          )
+          .listen(
+            (chunk) {
+              chunks.add(chunk);
+              if (chunks.length == 1) {
+                // The streamer is still reading ahead, when the database is
+                // closed.
+                close = db.close();
+              }
+            },
+            onDone: done.complete,
+            onError: done.completeError,
+          );
+      await done.future;
+
+      // Closing the database waits for the stream and its native streamer.
+      await close;
+      expect(chunks.expand((chunk) => chunk).toList(), content);
+    });
+
+    test('closing the database while writing fails the blob', () async {
+      final db = openSyncTestDatabase(tearDown: false);
+      final content = StreamController<Uint8List>();
+      final blob = Blob.fromStream(contentType, content.stream);
+
+      final save = db.saveBlob(blob);
+      content.add(randomBytes(64 * 1024));
+      await Future<void>.delayed(Duration.zero);
+
+      // The rest of the content never arrives.
+      await db.close();
+      await expectLater(
+        save,
+        throwsA(isDatabaseException.havingCode(DatabaseErrorCode.notOpen)),
+      );
+      unawaited(content.close());
+    });
+
+    test('contentStream rejects invalid read options', () {
+      final blob = blobFromData();
+      expect(
+        () => blob.contentStream(
+          options: const BlobReadOptions(readAheadChunkSize: 0),
+        ),
+        throwsArgumentError,
+      );
+      expect(
+        () => blob.contentStream(
+          options: const BlobReadOptions(readAheadChunks: 0),
+        ),
+        throwsArgumentError,
+      );
+      expect(
+        () => blob.contentStream(
+          options: const BlobReadOptions(minReadAheadLength: -1),
+        ),
+        throwsArgumentError,
+      );
+    });
+
+    test('hands chunks over to and from a worker isolate', () async {
+      final db = await openAsyncTestDatabase();
+      final collection = await db.defaultCollection;
+      const chunkSize = 64 * 1024;
+      final content = randomBytes(2 * 1024 * 1024 + 4);
+      final chunks = [
+        for (var i = 0; i < content.length; i += chunkSize)
+          Uint8List.sublistView(
+            content,
+            i,
+            min(i + chunkSize, content.length),
+          ),
+      ];
+      final doc = MutableDocument({
+        'blob': Blob.fromStream(contentType, Stream.fromIterable(chunks)),
+      });
+
+      NativeMetrics.reset();
+      await collection.saveDocument(doc);
+      final uploaded = NativeMetrics.snapshot().sliceResultsTransferred;
+      expect(uploaded, greaterThanOrEqualTo(chunks.length));
+
+      final blob = (await collection.document(doc.id))!.blob('blob')!;
+      expect(await byteStreamToFuture(blob.contentStream()), content);
+      // The worker reads the blob in chunks of the same size.
+      expect(
+        NativeMetrics.snapshot().sliceResultsTransferred,
+        greaterThanOrEqualTo(uploaded + chunks.length),
+      );
+    });
+
     apiTest('remove from document', () async {
       final db = await openTestDatabase();
       final collection = await db.defaultCollection;
@@ -0,0 +1,132 @@
+import 'dart:io';
+
+import 'package:cbl/cbl.dart';
+import 'package:cbl/src/log/logger.dart';
+
+import '../../test_binding_impl.dart';
+import '../test_binding.dart';
+import '../utils/file_system.dart';
+
+void main() {
+  setupTestBinding();
+
+  group('BinaryLogConfiguration', () {
+    test('validate properties', () {
+      expect(
+        () => BinaryLogConfiguration(directory: 'A', segmentSize: 1024),
+        throwsRangeError,
+      );
+      expect(
+        () => BinaryLogConfiguration(directory: 'A', maxSegments: 0),
+        throwsRangeError,
+      );
+    });
+
+    test('==', () {
+      expect(
+        BinaryLogConfiguration(directory: 'A'),
+        BinaryLogConfiguration(directory: 'A'),
+      );
+      expect(
+        BinaryLogConfiguration(directory: 'A'),
+        isNot(BinaryLogConfiguration(directory: 'A', maxSegments: 2)),
+      );
+    });
+
+    test('toString', () {
+      expect(
+        BinaryLogConfiguration(directory: 'A').toString(),
+        'BinaryLogConfiguration('
+        'directory: A, '
+        'segmentSize: 1024.0 KB, '
+        // ignore: missing_whitespace_between_adjacent_strings
+        'maxSegments: 8'
+        ')',
+      );
+    });
+  });
+
+  group('BinaryLogger', () {
+    tearDown(() {
+      Database.log.binary
+        ..config = null
+        ..level = LogLevel.none;
+    });
+
+    test('get and set config', () {
+      final config = BinaryLogConfiguration(
+        directory: '$tmpDir/GetAndSetBinaryLogConfig',
+      );
+
+      expect(Database.log.binary.config, isNull);
+
+      Database.log.binary.config = config;
+      expect(Database.log.binary.config, config);
+    });
+
+    test('get and set level', () {
+      expect(Database.log.binary.level, LogLevel.none);
+
+      Database.log.binary.level = LogLevel.verbose;
+      expect(Database.log.binary.level, LogLevel.verbose);
+    });
+
+    test('writes messages to segments', () async {
+      final logDir = Directory('$tmpDir/BinaryLogger');
+      await logDir.reset();
+
+      Database.log.binary
+        ..config = BinaryLogConfiguration(directory: logDir.path)
+        ..level = LogLevel.info;
+
+      for (var i = 0; i < 3; i++) {
+        cblLogMessage(LogDomain.network, LogLevel.warning, 'BINARY_LOG_$i');
+      }
+      cblLogMessage(LogDomain.network, LogLevel.warning, 'BINARY_LOG_0');
+      cblLogMessage(LogDomain.network, LogLevel.verbose, 'BINARY_LOG_VERBOSE');
+
+      // Disabling the logger flushes the buffered messages.
+      Database.log.binary.config = null;
+
+      final records = BinaryLogReader.readDirectory(logDir.path)
+          .whereType<BinaryLogRecord>()
+          .where((record) => record.message.startsWith('BINARY_LOG_'))
+          .toList();
+
+      expect(records.map((record) => record.message), [
+        'BINARY_LOG_0',
+        'BINARY_LOG_1',
+        'BINARY_LOG_2',
+        'BINARY_LOG_0',
+      ]);
+      expect(records.first.domain, LogDomain.network);
+      expect(records.first.level, LogLevel.warning);
+    });
+
+    test('starts a new segment when the current one is full', () async {
+      final logDir = Directory('$tmpDir/BinaryLoggerSegments');
+      await logDir.reset();
+
+      Database.log.binary
+        ..config = BinaryLogConfiguration(
+          directory: logDir.path,
+          segmentSize: 4096,
+          maxSegments: 2,
+        )
+        ..level = LogLevel.info;
+
+      for (var i = 0; i < 500; i++) {
+        cblLogMessage(LogDomain.database, LogLevel.info, 'BINARY_LOG_$i');
+      }
+
+      Database.log.binary.config = null;
+
+      expect(BinaryLogReader.segmentsInDirectory(logDir.path), hasLength(2));
+      final messages = BinaryLogReader.readDirectory(logDir.path)
+          .whereType<BinaryLogRecord>()
+          .map((record) => record.message)
+          .toList();
+      expect(messages.last, 'BINARY_LOG_499');
+    });
+  });
+}
@@ -28,6 +28,24 @@ void main() {
       cblLogMessage(LogDomain.network, LogLevel.warning, 'A');
     });
 
+    test('delivers messages in the order in which they were logged', () async {
+      final messages = <String>[];
+      final receivedMessages = Completer<void>();
+      Database.log.custom = TestLogger((level, domain, message) {
+        messages.add(message);
+        if (messages.length == 100) {
+          receivedMessages.complete();
+        }
+      }, level: LogLevel.warning);
+
+      for (var i = 0; i < 100; i++) {
+        cblLogMessage(LogDomain.network, LogLevel.warning, '$i');
+      }
+
+      await receivedMessages.future;
+      expect(messages, [for (var i = 0; i < 100; i++) '$i']);
+    });
+
     test('update level of logger', () {
       final logger = Database.log.custom = TestLogger(
         expectAsync3((level, domain, message) {}),
@@ -43,6 +61,54 @@ void main() {
       cblLogMessage(LogDomain.network, LogLevel.warning, 'A');
     });
 
+    test('domainLevels overrides level for a domain', () async {
+      final messages = <(LogDomain, String)>[];
+      final receivedMessages = Completer<void>();
+      Database.log.custom = TestLogger(
+        (level, domain, message) {
+          messages.add((domain, message));
+          if (message == 'done') {
+            receivedMessages.complete();
+          }
+        },
+        level: LogLevel.error,
+      )..domainLevels = {LogDomain.network: LogLevel.verbose};
+
+      // Won't be logged because it's under the level of the domain.
+      cblLogMessage(LogDomain.query, LogLevel.verbose, 'A');
+      cblLogMessage(LogDomain.network, LogLevel.verbose, 'B');
+      cblLogMessage(LogDomain.query, LogLevel.error, 'done');
+
+      await receivedMessages.future;
+      expect(messages, [(LogDomain.network, 'B'), (LogDomain.query, 'done')]);
+    });
+
+    test('rateLimits limits the messages of a domain', () async {
+      final messages = <(LogDomain, String)>[];
+      final receivedMessages = Completer<void>();
+      Database.log.custom = TestLogger(
+        (level, domain, message) {
+          messages.add((domain, message));
+          if (message == 'done') {
+            receivedMessages.complete();
+          }
+        },
+        level: LogLevel.warning,
+      )..rateLimits = {LogDomain.network: 10};
+
+      for (var i = 0; i < 100; i++) {
+        cblLogMessage(LogDomain.network, LogLevel.warning, '$i');
+      }
+      cblLogMessage(LogDomain.database, LogLevel.warning, 'done');
+
+      await receivedMessages.future;
+      final networkMessages = messages.where(
+        (message) => message.$1 == LogDomain.network,
+      );
+      // The messages can be spread over two one second windows.
+      expect(networkMessages.length, inInclusiveRange(10, 20));
+    });
+
     test('remove logger', () async {
       final receivedMessage = Completer<void>();
 
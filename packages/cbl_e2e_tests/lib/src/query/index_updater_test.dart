@@ -1,3 +1,5 @@
+import 'dart:async';
+
 import 'package:cbl/cbl.dart';
 
 import '../../test_binding_impl.dart';
@@ -102,4 +104,176 @@ void main() {
           : 'Vector search not available on this system',
     );
   });
+
+  group('IndexUpdateWorker', () {
+    test(
+      'update vector index in background',
+      () async {
+        final db = openSyncTestDatabase();
+        final collection = db.defaultCollection
+          ..createIndex(
+            'a',
+            VectorIndexConfiguration(
+              'a',
+              dimensions: 2,
+              centroids: 1,
+              lazy: true,
+            ),
+          );
+        final index = collection.index('a')! as SyncQueryIndex;
+
+        for (var i = 0; i < 10; i++) {
+          collection.saveDocument(MutableDocument({'a': i}));
+        }
+
+        final batches = <List<Object?>>[];
+        final worker = index.startUpdateWorker(
+          batchSize: 4,
+          embed: (values) {
+            batches.add(values);
+            return [
+              for (final value in values)
+                value == 0 ? null : [(value! as int).toDouble(), 1],
+            ];
+          },
+        );
+
+        final progress = await worker.done;
+        expect(progress.isRunning, isFalse);
+        expect(progress.error, isNull);
+        expect(progress.batches, 3);
+        expect(progress.values, 10);
+        expect(progress.vectorsSet, 9);
+        expect(progress.vectorsRemoved, 1);
+        expect(batches.map((batch) => batch.length), [4, 4, 2]);
+        expect(index.beginUpdate(limit: 10), isNull);
+      },
+      skip: vectorSearchAvailable
+          ? null
+          : 'Vector search not available on this system',
+    );
+
+    test(
+      'reports vectors which could not be set',
+      () async {
+        final db = openSyncTestDatabase();
+        final collection = db.defaultCollection
+          ..createIndex(
+            'a',
+            VectorIndexConfiguration(
+              'a',
+              dimensions: 2,
+              centroids: 1,
+              lazy: true,
+            ),
+          );
+        final index = collection.index('a')! as SyncQueryIndex;
+
+        for (var i = 0; i < 3; i++) {
+          collection.saveDocument(MutableDocument({'a': i}));
+        }
+
+        // The vectors do not have the dimensions of the index.
+        final worker = index.startUpdateWorker(
+          embed: (values) => [
+            for (final value in values) [(value! as int).toDouble(), 1, 1],
+          ],
+        );
+
+        await expectLater(worker.done, throwsA(isA<CouchbaseLiteException>()));
+        final progress = worker.progress;
+        expect(progress.vectorsSet, 0);
+        expect(progress.vectorsFailed, 3);
+        expect(index.beginUpdate(limit: 10), isNotNull);
+      },
+      skip: vectorSearchAvailable
+          ? null
+          : 'Vector search not available on this system',
+    );
+
+    test(
+      'stops with error thrown by embedder',
+      () async {
+        final db = openSyncTestDatabase();
+        final collection = db.defaultCollection
+          ..createIndex(
+            'a',
+            VectorIndexConfiguration(
+              'a',
+              dimensions: 2,
+              centroids: 1,
+              lazy: true,
+            ),
+          )
+          ..saveDocument(MutableDocument({'a': 'x'}));
+        final index = collection.index('a')! as SyncQueryIndex;
+
+        final worker = index.startUpdateWorker(
+          embed: (values) => throw StateError('embed'),
+        );
+
+        await expectLater(worker.done, throwsStateError);
+        expect(worker.progress.values, 0);
+        expect(index.beginUpdate(limit: 10), isNotNull);
+      },
+      skip: vectorSearchAvailable
+          ? null
+          : 'Vector search not available on this system',
+    );
+
+    test(
+      'closing the database stops the worker mid-batch',
+      () async {
+        final db = openSyncTestDatabase(tearDown: false);
+        final collection = db.defaultCollection
+          ..createIndex(
+            'a',
+            VectorIndexConfiguration(
+              'a',
+              dimensions: 2,
+              centroids: 1,
+              lazy: true,
+            ),
+          );
+        final index = collection.index('a')! as SyncQueryIndex;
+
+        for (var i = 0; i < 3; i++) {
+          collection.saveDocument(MutableDocument({'a': i}));
+        }
+
+        final embedding = Completer<void>();
+        final vectors = Completer<List<List<double>?>>();
+        final worker = index.startUpdateWorker(
+          batchSize: 1,
+          embed: (values) {
+            embedding.complete();
+            return vectors.future;
+          },
+        );
+
+        // Deleting the database stops the worker while it waits for the
+        // vectors of the first batch.
+        await embedding.future;
+        await db.delete();
+
+        final progress = await worker.done;
+        expect(progress.isRunning, isFalse);
+        expect(progress.batches, 0);
+        expect(
+          await Database.exists(db.name, directory: db.config.directory),
+          isFalse,
+        );
+
+        // Vectors which are returned after the worker has been stopped are
+        // ignored.
+        vectors.complete([
+          [0, 1],
+        ]);
+        await Future<void>.delayed(Duration.zero);
+      },
+      skip: vectorSearchAvailable
+          ? null
+          : 'Vector search not available on this system',
+    );
+  });
 }
@@ -1,3 +1,5 @@
+import 'dart:async';
+import 'dart:io';
 import 'dart:isolate' as isolate;
 
 import 'package:cbl/cbl.dart';
@@ -53,6 +55,128 @@ void main() {
     ]);
   });
 
+  apiTest('batch model in separate isolate', () async {
+    final batchSizes = <int>[];
+    final modelRegistered = Completer<void>();
+    final modelPort = isolate.ReceivePort();
+    addTearDown(modelPort.close);
+    modelPort.listen((message) {
+      if (message == null) {
+        modelRegistered.complete();
+      } else {
+        batchSizes.add(message as int);
+      }
+    });
+
+    final modelIsolate = await isolate.Isolate.spawn(
+      uppercaseBatchModelIsolate,
+      modelPort.sendPort,
+    );
+    addTearDown(modelIsolate.kill);
+    await modelRegistered.future;
+
+    final db = await openTestDatabase();
+    final users = await db.createCollection('users');
+    final names = [for (var i = 0; i < 10; i++) 'user$i'];
+    for (final name in names) {
+      await users.saveDocument(MutableDocument({'name': name}));
+    }
+
+    // Predictions are only combined into batches when they are requested
+    // concurrently, which is why the query is also executed concurrently in
+    // the worker isolates of additional databases.
+    const sql = '''
+      SELECT PREDICTION(uppercase_batch, {"in": name}, "out") AS prediction
+      FROM users
+      ORDER BY name
+      ''';
+    final workerDbs = [
+      for (var i = 0; i < 3; i++)
+        await openAsyncTestDatabase(usePublicApi: true),
+    ];
+    final workerResults = [
+      for (final workerDb in workerDbs)
+        workerDb
+            .createQuery(sql)
+            .then((query) => query.execute())
+            .then((resultSet) => resultSet.allPlainMapResults()),
+    ];
+
+    final query = await db.createQuery(sql);
+    final resultSet = await query.execute();
+    final expectedResults = [
+      for (final name in names) {'prediction': name.toUpperCase()},
+    ];
+    expect(await resultSet.allPlainMapResults(), expectedResults);
+    for (final results in await Future.wait(workerResults)) {
+      expect(results, expectedResults);
+    }
+
+    await pumpEventQueue();
+    expect(batchSizes, everyElement(inInclusiveRange(1, 4)));
+    expect(batchSizes.fold(0, (sum, size) => sum + size), 4 * names.length);
+    expect(batchSizes, contains(greaterThan(1)));
+  });
+
+  test('registering model with invalid maxBatchSize throws', () {
+    expect(
+      () => Database.prediction.registerModel(
+        'uppercase_batch',
+        UppercaseBatchModel(),
+        maxBatchSize: 0,
+      ),
+      throwsArgumentError,
+    );
+  });
+
+  apiTest('cached predictions are returned without calling model', () async {
+    final model = CountingUppercaseModel();
+    Database.prediction.registerModel(
+      'uppercase_cached',
+      model,
+      cache: const PredictionCacheConfiguration(maxSize: 1024 * 1024),
+    );
+    addTearDown(() => Database.prediction.unregisterModel('uppercase_cached'));
+
+    final db = await openTestDatabase();
+    final users = await db.createCollection('users');
+    for (final name in ['Alice', 'Bob', 'Alice']) {
+      await users.saveDocument(MutableDocument({'name': name}));
+    }
+    final query = await db.createQuery('''
+      SELECT PREDICTION(uppercase_cached, {"in": name}, "out") AS prediction
+      FROM users
+      ORDER BY name
+      ''');
+
+    for (var i = 0; i < 2; i++) {
+      final resultSet = await query.execute();
+      final results = await resultSet.allPlainMapResults();
+      expect(results, [
+        {'prediction': 'ALICE'},
+        {'prediction': 'ALICE'},
+        {'prediction': 'BOB'},
+      ]);
+    }
+
+    expect(model.predictions, 2);
+    final stats = Database.prediction.cacheStats('uppercase_cached')!;
+    expect(stats.entryCount, 2);
+    expect(stats.misses, 2);
+    expect(stats.hits, greaterThanOrEqualTo(4));
+    expect(stats.hitRate, stats.hits / (stats.hits + stats.misses));
+    expect(stats.size, greaterThan(0));
+
+    Database.prediction.clearCache('uppercase_cached');
+    expect(Database.prediction.cacheStats('uppercase_cached')!.entryCount, 0);
+  });
+
+  test('model without cache has no cache stats', () {
+    registerModelForTest('uppercase', UppercaseModel());
+    expect(Database.prediction.cacheStats('uppercase'), isNull);
+    expect(Database.prediction.cacheStats('unknown'), isNull);
+  });
+
   apiTest('no output from model is handled as MISSING', () async {
     registerModelForTest('noop', NoOpModel());
 
@@ -97,6 +221,15 @@ void uppercaseModelIsolate(Object? _) {
   Database.prediction.registerModel('uppercase', UppercaseModel());
 }
 
+void uppercaseBatchModelIsolate(isolate.SendPort batchSizes) {
+  Database.prediction.registerModel(
+    'uppercase_batch',
+    RecordingUppercaseBatchModel(batchSizes),
+    maxBatchSize: 4,
+  );
+  batchSizes.send(null);
+}
+
 class UppercaseModel implements PredictiveModel {
   @override
   Dictionary? predict(Dictionary input) =>
@@ -112,3 +245,36 @@ class NoOpModel implements PredictiveModel {
   @override
   Dictionary? predict(Dictionary input) => null;
 }
+
+class UppercaseBatchModel extends UppercaseModel
+    implements BatchPredictiveModel {
+  @override
+  List<Dictionary?> predictBatch(List<Dictionary> inputs) =>
+      inputs.map(predict).toList();
+}
+
+/// Reports the size of each batch to [batchSizes] and takes a while to
+/// compute each batch, so that concurrently requested predictions accumulate
+/// into the next batch.
+class RecordingUppercaseBatchModel extends UppercaseBatchModel {
+  RecordingUppercaseBatchModel(this.batchSizes);
+
+  final isolate.SendPort batchSizes;
+
+  @override
+  List<Dictionary?> predictBatch(List<Dictionary> inputs) {
+    batchSizes.send(inputs.length);
+    sleep(const Duration(milliseconds: 10));
+    return super.predictBatch(inputs);
+  }
+}
+
+class CountingUppercaseModel extends UppercaseModel {
+  var predictions = 0;
+
+  @override
+  Dictionary? predict(Dictionary input) {
+    predictions++;
+    return super.predict(input);
+  }
+}
@@ -0,0 +1,91 @@
+import 'dart:convert';
+
+import 'package:cbl/cbl.dart';
+
+import '../../test_binding_impl.dart';
+import '../test_binding.dart';
+import '../utils/api_variant.dart';
+import '../utils/database_utils.dart';
+
+void main() {
+  setupTestBinding();
+
+  group('QueryProfiler', () {
+    setUp(QueryProfiler.clear);
+    tearDown(QueryProfiler.disable);
+
+    test('enable and disable', () {
+      QueryProfiler.enable();
+      expect(QueryProfiler.isEnabled, isTrue);
+
+      QueryProfiler.disable();
+      expect(QueryProfiler.isEnabled, isFalse);
+    });
+
+    apiTest('records compilation and execution of queries', () async {
+      final db = await openTestDatabase();
+      final collection = await db.defaultCollection;
+      await collection.saveDocument(MutableDocument({'a': 'x'}));
+      await collection.saveDocument(MutableDocument({'a': 'y'}));
+
+      QueryProfiler.enable();
+
+      final query = await db.createQuery('SELECT a FROM _');
+      final resultSet = await query.execute();
+      expect(await resultSet.allResults(), hasLength(2));
+
+      final profiles = QueryProfiler.snapshot();
+      final compile = profiles.singleWhere(
+        (profile) => profile.kind == QueryProfileKind.compile,
+      );
+      expect(compile.query, 'SELECT a FROM _');
+      expect(compile.plan, isNotEmpty);
+
+      final execute = profiles.singleWhere(
+        (profile) =>
+            profile.kind == QueryProfileKind.execute &&
+            profile.queryId == compile.queryId,
+      );
+      expect(execute.rows, 2);
+      expect(execute.bytes, greaterThanOrEqualTo(2));
+      expect(execute.firstRowLatency, isNotNull);
+      expect(execute.exhausted, isTrue);
+    });
+
+    apiTest('does not record while disabled', () async {
+      final db = await openTestDatabase();
+
+      final query = await db.createQuery('SELECT a FROM _');
+      await (await query.execute()).allResults();
+
+      expect(QueryProfiler.snapshot(), isEmpty);
+    });
+
+    apiTest('exports Chrome trace events', () async {
+      final db = await openTestDatabase();
+
+      QueryProfiler.enable();
+
+      final query = await db.createQuery('SELECT a FROM _');
+      await (await query.execute()).allResults();
+
+      final trace =
+          jsonDecode(QueryProfiler.chromeTrace()) as Map<String, Object?>;
+      final events = (trace['traceEvents']! as List<Object?>)
+          .cast<Map<String, Object?>>();
+      expect(
+        events.map((event) => event['name']),
+        containsAll(<String>[
+          'Query.compile',
+          'Query.execute',
+          'Query.iterate',
+        ]),
+      );
+      expect(events.every((event) => event['ph'] == 'X'), isTrue);
+    });
+
+    test('capacity must be positive', () {
+      expect(() => QueryProfiler.enable(capacity: 0), throwsArgumentError);
+    });
+  });
+}
@@ -0,0 +1,235 @@
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:cbl/cbl.dart';
+import 'package:cbl/src/bindings.dart';
+
+import '../../test_binding_impl.dart';
+import '../test_binding.dart';
+
+void main() {
+  setupTestBinding();
+
+  group('VectorDistance', () {
+    final random = Random(0);
+    final supportedLevels = <CBLDartSimdLevel>[];
+    late CBLDartSimdLevel defaultLevel;
+
+    setUpAll(() {
+      defaultLevel = VectorDistanceBindings.simdLevel;
+      supportedLevels.addAll(
+        CBLDartSimdLevel.values.where(VectorDistanceBindings.setSimdLevel),
+      );
+      VectorDistanceBindings.setSimdLevel(defaultLevel);
+    });
+
+    tearDown(() => VectorDistanceBindings.setSimdLevel(defaultLevel));
+
+    Float32List randomFloat32(int dimensions) => Float32List.fromList([
+      for (var i = 0; i < dimensions; i++) random.nextDouble() * 2 - 1,
+    ]);
+
+    Int8List randomInt8(int dimensions) => Int8List.fromList([
+      for (var i = 0; i < dimensions; i++) random.nextInt(256) - 128,
+    ]);
+
+    test('uses SIMD instructions if available', () {
+      expect(supportedLevels, contains(CBLDartSimdLevel.scalar));
+      expect(supportedLevels, contains(defaultLevel));
+    });
+
+    test('float32 distances match Dart implementation', () {
+      for (final dimensions in [1, 3, 8, 17, 128, 1000]) {
+        final a = randomFloat32(dimensions);
+        final b = randomFloat32(dimensions);
+
+        for (final level in supportedLevels) {
+          VectorDistanceBindings.setSimdLevel(level);
+          for (final metric in VectorDistanceMetric.values) {
+            if (metric == VectorDistanceMetric.hamming) {
+              continue;
+            }
+            final expected = _dartDistance(metric, a, b);
+            expect(
+              VectorDistance.distance(a, b, metric: metric),
+              closeTo(expected, max(expected.abs(), 1) * 1e-4),
+              reason: '$level $metric $dimensions',
+            );
+          }
+        }
+      }
+    });
+
+    test('int8 distances match Dart implementation', () {
+      for (final dimensions in [1, 15, 16, 33, 5000]) {
+        final a = randomInt8(dimensions);
+        final b = randomInt8(dimensions);
+
+        for (final level in supportedLevels) {
+          VectorDistanceBindings.setSimdLevel(level);
+          for (final metric in [
+            VectorDistanceMetric.euclideanSquared,
+            VectorDistanceMetric.dot,
+          ]) {
+            // int8 vectors are accumulated exactly, so the only error comes
+            // from converting the result to a float.
+            final expected = _dartDistance(metric, a, b);
+            expect(
+              VectorDistance.distance(a, b, metric: metric),
+              closeTo(expected, expected.abs() * 1e-7),
+              reason: '$level $metric $dimensions',
+            );
+          }
+        }
+      }
+    });
+
+    test('float16 distances', () {
+      // 1.0, 2.0, -0.5 and 0.25, 4.0, 1.0 as IEEE 754 half precision floats.
+      final a = Uint16List.fromList([0x3c00, 0x4000, 0xb800]);
+      final b = Uint16List.fromList([0x3400, 0x4400, 0x3c00]);
+
+      for (final level in supportedLevels) {
+        VectorDistanceBindings.setSimdLevel(level);
+        expect(
+          VectorDistance.distance(a, b, metric: VectorDistanceMetric.dot),
+          -(0.25 + 8 - 0.5),
+        );
+      }
+    });
+
+    test('hamming distance', () {
+      final a = Int8List(100)..[0] = 0x0f;
+      final b = Int8List(100)
+        ..[0] = 0x01
+        ..[99] = -1;
+
+      for (final level in supportedLevels) {
+        VectorDistanceBindings.setSimdLevel(level);
+        expect(
+          VectorDistance.distance(a, b, metric: VectorDistanceMetric.hamming),
+          3 + 8,
+        );
+      }
+    });
+
+    test('distances', () {
+      final query = randomFloat32(16);
+      final candidates = [for (var i = 0; i < 10; i++) randomFloat32(16)];
+
+      final distances = VectorDistance.distances(query, candidates);
+
+      expect(distances, hasLength(10));
+      for (var i = 0; i < candidates.length; i++) {
+        expect(
+          distances[i],
+          closeTo(
+            _dartDistance(VectorDistanceMetric.cosine, query, candidates[i]),
+            1e-5,
+          ),
+        );
+      }
+    });
+
+    test('distances of views into a single list', () {
+      final query = randomFloat32(16);
+      final all = randomFloat32(16 * 11);
+      // Views of consecutive ranges are passed to native code without copying
+      // them, other views are copied.
+      final contiguous = [
+        for (var i = 0; i < 10; i++)
+          Float32List.sublistView(all, i * 16, (i + 1) * 16),
+      ];
+      final shuffled = [...contiguous.reversed];
+
+      for (final candidates in [contiguous, shuffled]) {
+        final distances = VectorDistance.distances(query, candidates);
+        for (var i = 0; i < candidates.length; i++) {
+          expect(
+            distances[i],
+            closeTo(
+              _dartDistance(VectorDistanceMetric.cosine, query, candidates[i]),
+              1e-5,
+            ),
+          );
+        }
+      }
+    });
+
+    test('topK', () {
+      final query = randomFloat32(32);
+      final candidates = [for (var i = 0; i < 100; i++) randomFloat32(32)];
+
+      final matches = VectorDistance.topK(
+        query,
+        candidates,
+        k: 5,
+        metric: VectorDistanceMetric.euclidean,
+      );
+
+      final expected =
+          List.generate(candidates.length, (i) => i)..sort(
+            (a, b) => _dartDistance(
+              VectorDistanceMetric.euclidean,
+              query,
+              candidates[a],
+            ).compareTo(
+              _dartDistance(
+                VectorDistanceMetric.euclidean,
+                query,
+                candidates[b],
+              ),
+            ),
+          );
+      expect(matches.map((match) => match.index), expected.take(5));
+    });
+
+    test('topK with fewer candidates than k', () {
+      final query = randomFloat32(4);
+      final candidates = [randomFloat32(4), randomFloat32(4)];
+
+      expect(VectorDistance.topK(query, candidates, k: 5), hasLength(2));
+      expect(VectorDistance.topK(query, [], k: 5), isEmpty);
+    });
+
+    test('throws for vectors of different types or lengths', () {
+      expect(
+        () => VectorDistance.distance(Float32List(2), Float32List(3)),
+        throwsArgumentError,
+      );
+      expect(
+        () => VectorDistance.distance(Float32List(2), Int8List(8)),
+        throwsArgumentError,
+      );
+      expect(
+        () => VectorDistance.distance(Float64List(2), Float64List(2)),
+        throwsArgumentError,
+      );
+    });
+  });
+}
+
+double _dartDistance(
+  VectorDistanceMetric metric,
+  List<num> a,
+  List<num> b,
+) {
+  var dot = 0.0;
+  var normA = 0.0;
+  var normB = 0.0;
+  var squaredDistance = 0.0;
+  for (var i = 0; i < a.length; i++) {
+    dot += a[i] * b[i];
+    normA += a[i] * a[i];
+    normB += b[i] * b[i];
+    squaredDistance += (a[i] - b[i]) * (a[i] - b[i]);
+  }
+
+  return switch (metric) {
+    VectorDistanceMetric.euclideanSquared => squaredDistance,
+    VectorDistanceMetric.euclidean => sqrt(squaredDistance),
+    VectorDistanceMetric.cosine => 1 - dot / (sqrt(normA) * sqrt(normB)),
+    VectorDistanceMetric.dot => -dot,
+    VectorDistanceMetric.hamming => throw UnimplementedError(),
+  };
+}
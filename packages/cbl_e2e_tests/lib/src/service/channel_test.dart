@@ -4,7 +4,9 @@ import 'dart:async';
 import 'dart:isolate';
 import 'dart:typed_data';
 
+import 'package:cbl/cbl.dart' show NativeMetrics;
 import 'package:cbl/src/bindings.dart';
+import 'package:cbl/src/service/cbl_service_api.dart' as api;
 import 'package:cbl/src/service/channel.dart';
 import 'package:meta/meta.dart';
 import 'package:stream_channel/isolate_channel.dart';
@@ -48,6 +50,62 @@ void main() {
       await expectData(input.toSliceResult().toData(), [42, 1]);
     });
 
+    channelTest('call with handed over data', () async {
+      final channel = await openTestChannel();
+
+      final response = await channel.call(
+        HandOverDataRequest(
+          api.SendableData.handOver(Uint8List.fromList([0, 1]).toData()),
+        ),
+      );
+
+      expect(response.data.toTypedList(), [42, 1]);
+    });
+
+    test('handed over data is released by the receiving isolate', () async {
+      final receivePort = ReceivePort();
+      final isolate = await Isolate.spawn(
+        testIsolateMain,
+        receivePort.sendPort,
+      );
+      final channel = Channel(
+        transport: IsolateChannel.connectReceive(receivePort),
+      );
+      addTearDown(channel.close);
+
+      final before = NativeMetrics.snapshot();
+      expect(
+        await channel.call(
+          DataLengthRequest(
+            api.SendableData.handOver(Uint8List(1024).toData()),
+          ),
+        ),
+        1024,
+      );
+      final after = NativeMetrics.snapshot();
+      expect(
+        after.sliceResultsTransferred - before.sliceResultsTransferred,
+        1,
+      );
+
+      // The receiving isolate drops the data. The reference it holds is
+      // released at the latest when the isolate shuts down.
+      final exited = ReceivePort();
+      isolate
+        ..addOnExitListener(exited.sendPort)
+        ..kill();
+      await exited.first;
+
+      int released() =>
+          NativeMetrics.snapshot().transferredSliceResultsReleased -
+          before.transferredSliceResultsReleased;
+      final deadline = DateTime.now().add(const Duration(seconds: 5));
+      while (released() < 1 && DateTime.now().isBefore(deadline)) {
+        await Future<void>.delayed(const Duration(milliseconds: 10));
+      }
+      expect(released(), 1);
+    });
+
     channelTest('call non-existent endpoint', () async {
       final channel = await openTestChannel();
 
@@ -190,6 +248,14 @@ void registerTestHandlers(Channel channel) {
       result[0] = 42;
       return SendableData(result.toData());
     })
+    ..addCallEndpoint((HandOverDataRequest req) {
+      final result = req.input.data.toTypedList();
+      result[0] = 42;
+      return api.SendableData.handOver(result.toData());
+    })
+    ..addCallEndpoint(
+      (DataLengthRequest req) => req.input.data.toTypedList().length,
+    )
     ..addCallEndpoint(
       (ThrowTestError _) =>
           Future<void>.error(const TestError('Oops'), StackTrace.current),
@@ -235,6 +301,31 @@ final class DataRequest extends Request<SendableData> implements SendAware {
   void didReceive() => input.didReceive();
 }
 
+final class HandOverDataRequest extends Request<api.SendableData>
+    implements SendAware {
+  HandOverDataRequest(this.input);
+
+  final api.SendableData input;
+
+  @override
+  void willSend() => input.willSend();
+
+  @override
+  void didReceive() => input.didReceive();
+}
+
+final class DataLengthRequest extends Request<int> implements SendAware {
+  DataLengthRequest(this.input);
+
+  final api.SendableData input;
+
+  @override
+  void willSend() => input.willSend();
+
+  @override
+  void didReceive() => input.didReceive();
+}
+
 final class SendableData implements SendAware {
   SendableData(Data data) : _data = data;
 
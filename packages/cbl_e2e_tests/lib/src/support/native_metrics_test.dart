@@ -0,0 +1,103 @@
+import 'dart:async';
+
+import 'package:cbl/cbl.dart';
+import 'package:cbl/src/bindings.dart';
+import 'package:cbl/src/fleece/containers.dart';
+import 'package:cbl/src/support/async_callback.dart';
+
+import '../../test_binding_impl.dart';
+import '../log/logger_test.dart' show TestLogger;
+import '../test_binding.dart';
+
+void main() {
+  setupTestBinding();
+
+  group('NativeMetrics', () {
+    setUp(NativeMetrics.reset);
+
+    test('is enabled by default', () {
+      expect(NativeMetrics.snapshot().enabled, isTrue);
+    });
+
+    test('counts allocated iterators', () {
+      final dict = Doc.fromJson('{"a": 1, "b": 2}').root.asDict!;
+      expect(dict.keys.toList(), ['a', 'b']);
+      expect(dict.keys.toList(), ['a', 'b']);
+
+      expect(NativeMetrics.snapshot().dictIteratorsAllocated, 2);
+    });
+
+    test('reset', () {
+      final dict = Doc.fromJson('{"a": 1}').root.asDict!;
+      expect(dict.keys.toList(), ['a']);
+      expect(NativeMetrics.snapshot().dictIteratorsAllocated, 1);
+
+      NativeMetrics.reset();
+      expect(NativeMetrics.snapshot().dictIteratorsAllocated, 0);
+    });
+
+    test('blockingCallThreshold', () {
+      final defaultThreshold = NativeMetrics.blockingCallThreshold;
+      addTearDown(() => NativeMetrics.blockingCallThreshold = defaultThreshold);
+      expect(defaultThreshold, const Duration(seconds: 1));
+
+      NativeMetrics.blockingCallThreshold = const Duration(milliseconds: 50);
+      expect(
+        NativeMetrics.blockingCallThreshold,
+        const Duration(milliseconds: 50),
+      );
+
+      NativeMetrics.blockingCallThreshold = null;
+      expect(NativeMetrics.blockingCallThreshold, isNull);
+
+      expect(
+        () => NativeMetrics.blockingCallThreshold = Duration.zero,
+        throwsArgumentError,
+      );
+    });
+
+    test('no blocking calls are in flight while Dart is idle', () {
+      expect(NativeMetrics.blockingCallsInFlight, 0);
+    });
+
+    test('reports slow blocking calls', () async {
+      final defaultThreshold = NativeMetrics.blockingCallThreshold;
+      addTearDown(() => NativeMetrics.blockingCallThreshold = defaultThreshold);
+      NativeMetrics.blockingCallThreshold = const Duration(milliseconds: 50);
+
+      final originalLogger = Database.log.custom;
+      addTearDown(() => Database.log.custom = originalLogger);
+      final warningLogged = Completer<String>();
+      Database.log.custom = TestLogger((level, domain, message) {
+        if (message.startsWith('Blocking call to Dart callback') &&
+            !warningLogged.isCompleted) {
+          warningLogged.complete(message);
+        }
+      }, level: LogLevel.warning);
+
+      final called = Completer<void>();
+      final result = Completer<void>();
+      final callback = AsyncCallback((_) {
+        called.complete();
+        return result.future;
+      }, debugName: 'Test');
+      addTearDown(callback.close);
+
+      AsyncCallbackBindings.callForTest(callback.pointer, 0);
+      await called.future;
+
+      // The handler keeps the call waiting past the threshold.
+      await Future<void>.delayed(const Duration(milliseconds: 100));
+      expect(NativeMetrics.blockingCallsInFlight, 1);
+      expect(await warningLogged.future, contains('waiting for a result'));
+      expect(NativeMetrics.snapshot().slowBlockingCalls, 0);
+
+      result.complete();
+      while (NativeMetrics.snapshot().slowBlockingCalls == 0) {
+        await Future<void>.delayed(const Duration(milliseconds: 10));
+      }
+      expect(NativeMetrics.snapshot().slowBlockingCalls, 1);
+      expect(NativeMetrics.blockingCallsInFlight, 0);
+    });
+  });
+}
@@ -0,0 +1,94 @@
+import 'dart:convert';
+
+import 'package:cbl/cbl.dart';
+
+import '../../test_binding_impl.dart';
+import '../test_binding.dart';
+import '../utils/database_utils.dart';
+
+void main() {
+  setupTestBinding();
+
+  group('NativeTracing', () {
+    setUp(() {
+      NativeTracing.enable();
+      NativeTracing.clear();
+    });
+
+    tearDown(() {
+      NativeTracing.disable();
+      NativeTracing.clear();
+    });
+
+    test('enable and disable', () {
+      expect(NativeTracing.isEnabled, isTrue);
+      NativeTracing.disable();
+      expect(NativeTracing.isEnabled, isFalse);
+    });
+
+    test('records query execution', () {
+      final db = openSyncTestDatabase();
+      db.createQuery('SELECT * FROM _').execute();
+
+      expect(
+        _eventNames(NativeTracing.dump()),
+        containsAll(['Query.create', 'Query.execute']),
+      );
+    });
+
+    test('does not record events while disabled', () {
+      final db = openSyncTestDatabase();
+      NativeTracing.disable();
+      db.createQuery('SELECT * FROM _').execute();
+
+      expect(_eventNames(NativeTracing.dump()), isEmpty);
+    });
+
+    test('clear discards recorded events', () {
+      final db = openSyncTestDatabase();
+      db.createQuery('SELECT * FROM _').execute();
+      NativeTracing.clear();
+
+      expect(_eventNames(NativeTracing.dump()), isEmpty);
+    });
+
+    test('dump merges native events into existing trace', () {
+      final db = openSyncTestDatabase();
+      db.createQuery('SELECT * FROM _').execute();
+
+      final dartEvent = {
+        'name': 'dart',
+        'ph': 'X',
+        'ts': 0,
+        'dur': 0,
+        'pid': 0,
+        'tid': 0,
+      };
+
+      final dartTrace = jsonEncode({
+        'traceEvents': [dartEvent],
+        'displayTimeUnit': 'ns',
+      });
+      final merged =
+          jsonDecode(NativeTracing.dump(mergeWith: dartTrace))
+              as Map<String, Object?>;
+      expect(merged['displayTimeUnit'], 'ns');
+      expect((merged['traceEvents']! as List<Object?>).first, dartEvent);
+      expect(_eventNames(jsonEncode(merged)), contains('Query.execute'));
+
+      final mergedArray =
+          jsonDecode(NativeTracing.dump(mergeWith: jsonEncode([dartEvent])))
+              as List<Object?>;
+      expect(mergedArray.first, dartEvent);
+      expect(mergedArray.length, greaterThan(1));
+    });
+  });
+}
+
+List<String> _eventNames(String trace) =>
+    ((jsonDecode(trace) as Map<String, Object?>)['traceEvents']!
+            as List<Object?>)
+        .cast<Map<String, Object?>>()
+        .where((event) => event['ph'] == 'X')
+        .map((event) => event['name']! as String)
+        .toList();